@@ -0,0 +1,94 @@
+#include "communicationsettings.h"
+#include "settingsmodel.h"
+
+/*!
+ * Settings without any active connection
+ */
+CommunicationSettings::CommunicationSettings() :
+    _pollTime(0), _bIndependentPolling(false)
+{
+    for (quint8 i = 0u; i < Connection::ID_CNT; i++)
+    {
+        _connectionSettings.append(ConnectionSettings());
+    }
+}
+
+/*!
+ * Copy current settings, must be called from the thread that owns the settings model
+ */
+CommunicationSettings::CommunicationSettings(SettingsModel* pSettingsModel)
+{
+    _pollTime = pSettingsModel->pollTime();
+    _bIndependentPolling = pSettingsModel->independentPolling();
+
+    for (quint8 i = 0u; i < Connection::ID_CNT; i++)
+    {
+        ConnectionSettings settings;
+
+        settings.bConnectionState = pSettingsModel->connectionState(i);
+        settings.connectionType = pSettingsModel->connectionType(i);
+
+        settings.ipAddress = pSettingsModel->ipAddress(i);
+        settings.port = pSettingsModel->port(i);
+
+        settings.portName = pSettingsModel->portName(i);
+        settings.parity = pSettingsModel->parity(i);
+        settings.baudrate = pSettingsModel->baudrate(i);
+        settings.databits = pSettingsModel->databits(i);
+        settings.stopbits = pSettingsModel->stopbits(i);
+
+        settings.slaveId = pSettingsModel->slaveId(i);
+        settings.timeout = pSettingsModel->timeout(i);
+        settings.consecutiveMax = pSettingsModel->consecutiveMax(i);
+        settings.maxGap = pSettingsModel->maxGap(i);
+        settings.pipelineDepth = pSettingsModel->pipelineDepth(i);
+        settings.bInt32LittleEndian = pSettingsModel->int32LittleEndian(i);
+        settings.bPersistentConnection = pSettingsModel->persistentConnection(i);
+
+        settings.readCapability = pSettingsModel->readCapability(i);
+
+        if (settings.connectionType == Connection::TYPE_TCP)
+        {
+            settings.description = QString("%1:%2 - slave id %3")
+                                    .arg(settings.ipAddress)
+                                    .arg(settings.port)
+                                    .arg(settings.slaveId)
+                                    ;
+        }
+        else
+        {
+            QString strParity;
+            QString strDataBits;
+            QString strStopBits;
+            pSettingsModel->serialConnectionStrings(i, strParity, strDataBits, strStopBits);
+
+            settings.description = QString("%1, %2, %3, %4, %5 - slave id %6")
+                                    .arg(settings.portName)
+                                    .arg(settings.baudrate)
+                                    .arg(strParity, strDataBits, strStopBits)
+                                    .arg(settings.slaveId)
+                                    ;
+        }
+
+        _connectionSettings.append(settings);
+    }
+}
+
+quint32 CommunicationSettings::pollTime() const
+{
+    return _pollTime;
+}
+
+bool CommunicationSettings::independentPolling() const
+{
+    return _bIndependentPolling;
+}
+
+/*!
+ * Settings of a connection
+ * \param connectionId     Connection id, defaults to first connection when not supported
+ */
+const CommunicationSettings::ConnectionSettings& CommunicationSettings::connection(quint8 connectionId) const
+{
+    return _connectionSettings[connectionId < static_cast<quint8>(Connection::ID_CNT) ? connectionId : static_cast<quint8>(Connection::ID_1)];
+}
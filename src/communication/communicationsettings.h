@@ -0,0 +1,68 @@
+#ifndef COMMUNICATIONSETTINGS_H
+#define COMMUNICATIONSETTINGS_H
+
+#include <QList>
+#include <QString>
+#include <QSerialPort>
+
+#include "connectiontypes.h"
+#include "readcapability.h"
+
+//Forward declaration
+class SettingsModel;
+
+/*!
+ * Immutable copy of the communication settings
+ * Created in the GUI thread when communication is started and passed to the communication thread,
+ * so polling never accesses the settings model.
+ */
+class CommunicationSettings
+{
+public:
+
+    typedef struct
+    {
+        bool bConnectionState;
+        Connection::type_t connectionType;
+
+        QString ipAddress;
+        quint16 port;
+
+        QString portName;
+        QSerialPort::Parity parity;
+        QSerialPort::BaudRate baudrate;
+        QSerialPort::DataBits databits;
+        QSerialPort::StopBits stopbits;
+
+        quint8 slaveId;
+        quint32 timeout;
+        quint8 consecutiveMax;
+        quint8 maxGap;
+        quint8 pipelineDepth;
+        bool bInt32LittleEndian;
+        bool bPersistentConnection;
+
+        /* Capability learned in previous sessions */
+        ReadCapability readCapability;
+
+        /* Human readable description for the log */
+        QString description;
+
+    } ConnectionSettings;
+
+    CommunicationSettings();
+    explicit CommunicationSettings(SettingsModel* pSettingsModel);
+
+    quint32 pollTime() const;
+    bool independentPolling() const;
+
+    const ConnectionSettings& connection(quint8 connectionId) const;
+
+private:
+    quint32 _pollTime;
+    bool _bIndependentPolling;
+
+    QList<ConnectionSettings> _connectionSettings;
+};
+
+#endif // COMMUNICATIONSETTINGS_H
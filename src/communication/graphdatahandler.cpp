@@ -1,44 +1,71 @@
 #include "graphdatahandler.h"
 
+#include <limits>
+
 #include "scopelogging.h"
-#include "qmuparser.h"
 #include "graphdatamodel.h"
 #include "expressionparser.h"
 
 #include "scopelogging.h"
 
-GraphDataHandler::GraphDataHandler() :
-  _pGraphDataModel(nullptr)
+GraphDataHandler::GraphDataHandler()
 {
 
 }
 
-void GraphDataHandler::processActiveRegisters(GraphDataModel* pGraphDataModel)
+/*!
+ * Copy expression and poll interval of every active graph
+ * Must be called from the thread that owns the graph data model
+ */
+GraphDataHandler::ActiveGraphs GraphDataHandler::activeGraphs(GraphDataModel* pGraphDataModel)
 {
-    QStringList exprList;
-
-    _pGraphDataModel = pGraphDataModel;
+    ActiveGraphs activeGraphs;
+    QList<quint16> activeIndexList;
 
-    _pGraphDataModel->activeGraphIndexList(&_activeIndexList);
-    for(quint16 graphIdx: qAsConst(_activeIndexList))
+    pGraphDataModel->activeGraphIndexList(&activeIndexList);
+    for(quint16 graphIdx: qAsConst(activeIndexList))
     {
-        exprList.append(_pGraphDataModel->expression(graphIdx));
+        activeGraphs.expressionList.append(pGraphDataModel->expression(graphIdx));
+        activeGraphs.pollIntervalList.append(pGraphDataModel->pollInterval(graphIdx));
     }
 
-    ExpressionParser exprParser(exprList);
+    return activeGraphs;
+}
+
+void GraphDataHandler::processActiveRegisters(const ActiveGraphs& activeGraphs)
+{
+    _expressionList = activeGraphs.expressionList;
+
+    ExpressionParser exprParser(_expressionList);
     exprParser.modbusRegisters(_registerList);
 
+    /* Collect poll intervals of all expressions that use a register */
+    _expressionRegisters.clear();
+    exprParser.expressionRegisters(_expressionRegisters);
+
+    _registerPollIntervals.clear();
+    for (qint32 regIdx = 0; regIdx < _registerList.size(); regIdx++)
+    {
+        _registerPollIntervals.append(QList<quint32>());
+    }
+
+    for (qint32 exprIdx = 0; exprIdx < _expressionRegisters.size(); exprIdx++)
+    {
+        const quint32 pollInterval = exprIdx < activeGraphs.pollIntervalList.size() ? activeGraphs.pollIntervalList[exprIdx] : 0;
+        for (quint32 regIdx : qAsConst(_expressionRegisters[exprIdx]))
+        {
+            _registerPollIntervals[regIdx].append(pollInterval);
+        }
+    }
+
+    _lastRegisterResults.clear();
+
     qCInfo(scopeComm) << "Active registers: " << ModbusRegister::dumpListToString(_registerList);
 
     QStringList processedExpList;
     exprParser.processedExpressions(processedExpList);
 
-    _valueParsers.clear();
-
-    for(const QString &expr: qAsConst(processedExpList))
-    {
-        _valueParsers.append(QMuParser(expr));
-    }
+    _expressionEvaluator.setExpressions(processedExpList);
 }
 
 void GraphDataHandler::modbusRegisterList(QList<ModbusRegister>& registerList)
@@ -46,55 +73,146 @@ void GraphDataHandler::modbusRegisterList(QList<ModbusRegister>& registerList)
     registerList = _registerList;
 }
 
-QString GraphDataHandler::expressionParseMsg(qint32 exprIdx) const
+/*!
+ * Get poll interval of each register in modbus register list
+ * When a register is used in multiple expressions, the fastest interval is used
+ * \param pollIntervalList     Poll interval in ms per register (0 is default poll time)
+ * \param defaultPollTime      Poll time of expressions without specific interval
+ */
+void GraphDataHandler::pollIntervalList(QList<quint32>& pollIntervalList, quint32 defaultPollTime)
 {
-    if (exprIdx >= _valueParsers.size())
+    pollIntervalList.clear();
+
+    for (const QList<quint32> &intervals : qAsConst(_registerPollIntervals))
     {
-        return QString();
+        quint32 registerInterval = 0;
+
+        if (intervals.count(0) != intervals.size())
+        {
+            registerInterval = std::numeric_limits<quint32>::max();
+            for (quint32 interval : intervals)
+            {
+                registerInterval = qMin(registerInterval, interval == 0 ? defaultPollTime : interval);
+            }
+        }
+
+        pollIntervalList.append(registerInterval);
     }
+}
 
-    return _valueParsers[exprIdx].msg();
+QString GraphDataHandler::expressionParseMsg(qint32 exprIdx) const
+{
+    return _expressionEvaluator.msg(exprIdx);
 }
 
 qint32 GraphDataHandler::expressionErrorPos(qint32 exprIdx) const
 {
-    if (exprIdx >= _valueParsers.size())
-    {
-        return -1;
-    }
-
-    return _valueParsers[exprIdx].errorPos();
+    return _expressionEvaluator.errorPos(exprIdx);
 }
 
+/*!
+ * Evaluate expressions with register results of a poll cycle
+ * Registers that weren't read in this cycle (not due or polled by another connection) have no value.
+ * An expression only gets a value when at least one of its registers was read, the last value of
+ * its other registers is used for the evaluation. Expressions without a read register are
+ * reported without value (NO_VALUE), so no sample is repeated.
+ * \param results   Result of every register, NO_VALUE when register wasn't read
+ */
 void GraphDataHandler::handleRegisterData(ResultDoubleList results)
 {
     ResultDoubleList registerList;
 
-    QMuParser::setRegistersData(results);
-
-    for(qint32 listIdx = 0; listIdx < _valueParsers.size(); listIdx++)
+    if (_lastRegisterResults.size() != results.size())
     {
-        ResultDouble result;
+        _lastRegisterResults = ResultDoubleList(results.size());
+    }
 
-        if (_valueParsers[listIdx].evaluate())
+    QList<bool> readList(results.size(), false);
+    for (qint32 regIdx = 0; regIdx < results.size(); regIdx++)
+    {
+        if (results[regIdx].state() == ResultState::State::NO_VALUE)
         {
-            result.setValue(_valueParsers[listIdx].value());
+            results[regIdx] = _lastRegisterResults[regIdx];
         }
         else
         {
-            result.setError();
+            _lastRegisterResults[regIdx] = results[regIdx];
+            readList[regIdx] = true;
+        }
+    }
+
+    ResultDoubleList exprResults;
+    _expressionEvaluator.evaluate(results, exprResults);
 
-            const quint16 activeIndex = _activeIndexList[listIdx];
-            auto msg = QString("Expression evaluation failed (%1): expression %2")
-                        .arg(_valueParsers[listIdx].msg(), _pGraphDataModel->expression(activeIndex));
+    bool bHasValue = false;
+    for(qint32 listIdx = 0; listIdx < exprResults.size(); listIdx++)
+    {
+        ResultDouble result = exprResults[listIdx];
 
-            qCWarning(scopeComm) << msg;
+        if (!hasReadRegister(listIdx, readList))
+        {
+            /* None of the registers of the expression was read in this cycle */
+            result = ResultDouble(0, ResultState::State::NO_VALUE);
+        }
+        else
+        {
+            if (!result.isValid())
+            {
+                auto msg = QString("Expression evaluation failed (%1): expression %2")
+                            .arg(_expressionEvaluator.msg(listIdx), _expressionList.value(listIdx));
+
+                qCWarning(scopeComm) << msg;
+            }
+
+            /* Expression is as recent as the most recent register it uses */
+            if (listIdx < _expressionRegisters.size())
+            {
+                qint64 timestamp = 0;
+                for (quint32 regIdx : qAsConst(_expressionRegisters[listIdx]))
+                {
+                    if (regIdx < static_cast<quint32>(results.size()))
+                    {
+                        timestamp = qMax(timestamp, results[regIdx].timestamp());
+                    }
+                }
+                result.setTimestamp(timestamp);
+            }
+
+            bHasValue = true;
         }
 
         registerList.append(result);
     }
 
-    emit graphDataReady(registerList);
+    if (bHasValue)
+    {
+        emit graphDataReady(registerList);
+    }
+}
+
+/*!
+ * Check whether at least one register of an expression was read
+ * Expressions without registers (constants) always have a value.
+ */
+bool GraphDataHandler::hasReadRegister(qint32 exprIdx, const QList<bool>& readList) const
+{
+    if (
+        (exprIdx >= _expressionRegisters.size())
+        || _expressionRegisters[exprIdx].isEmpty()
+    )
+    {
+        return true;
+    }
+
+    for (quint32 regIdx : qAsConst(_expressionRegisters[exprIdx]))
+    {
+        if (readList.value(static_cast<qint32>(regIdx)))
+        {
+            return true;
+        }
+    }
+
+    return false;
 }
 
 
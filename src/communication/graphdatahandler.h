@@ -2,9 +2,10 @@
 #define GRAPHDATAHANDLER_H
 
 #include <QRegularExpression>
+#include <QStringList>
 #include "modbusregister.h"
 #include "result.h"
-#include "qmuparser.h"
+#include "expressionevaluator.h"
 
 //Forward declaration
 class GraphDataModel;
@@ -13,10 +14,23 @@ class GraphDataHandler : public QObject
 {
     Q_OBJECT
 public:
+
+    /*!
+     * Copy of the active graphs, taken by the thread that owns the graph data model
+     */
+    typedef struct
+    {
+        QStringList expressionList;
+        QList<quint32> pollIntervalList;
+    } ActiveGraphs;
+
     GraphDataHandler();
 
-    void processActiveRegisters(GraphDataModel *pGraphDataModel);
+    static ActiveGraphs activeGraphs(GraphDataModel *pGraphDataModel);
+
+    void processActiveRegisters(const ActiveGraphs& activeGraphs);
     void modbusRegisterList(QList<ModbusRegister>& registerList);
+    void pollIntervalList(QList<quint32>& pollIntervalList, quint32 defaultPollTime);
 
     QString expressionParseMsg(qint32 exprIdx) const;
     qint32 expressionErrorPos(qint32 exprIdx) const;
@@ -28,12 +42,15 @@ signals:
     void graphDataReady(ResultDoubleList resultList);
 
 private:
-
-    GraphDataModel* _pGraphDataModel;
+    bool hasReadRegister(qint32 exprIdx, const QList<bool>& readList) const;
 
     QList<ModbusRegister> _registerList;
-    QList<quint16> _activeIndexList;
-    QList<QMuParser> _valueParsers;
+    QList<QList<quint32> > _registerPollIntervals;
+    QList<QList<quint32> > _expressionRegisters;
+    QStringList _expressionList;
+    ExpressionEvaluator _expressionEvaluator;
+
+    ResultDoubleList _lastRegisterResults;
 
 };
 
@@ -5,6 +5,7 @@
 #include <QModbusRtuSerialClient>
 
 #include "modbusaddress.h"
+#include "sampleclock.h"
 #include "scopelogging.h"
 #include "modbusconnection.h"
 
@@ -91,9 +92,18 @@ void ModbusConnection::sendReadRequest(ModbusAddress regAddress, quint16 size, i
     {
         auto type = registerType(regAddress.objectType());
         QModbusDataUnit dataUnit(type, static_cast<int>(regAddress.address(ModbusAddress::Offset::WITHOUT_OFFSET)), size);
-        _connectionList.last()->pReply = _connectionList.last()->pModbusClient->sendReadRequest(dataUnit, serverAddress);
+        QModbusReply * pReply = _connectionList.last()->pModbusClient->sendReadRequest(dataUnit, serverAddress);
 
-        connect(_connectionList.last()->pReply, &QModbusReply::finished, this, &ModbusConnection::handleRequestFinished);
+        if (pReply != nullptr)
+        {
+            _connectionList.last()->pendingReplies.insert(pReply, regAddress);
+
+            connect(pReply, &QModbusReply::finished, this, &ModbusConnection::handleRequestFinished);
+        }
+        else
+        {
+            emit readRequestError(regAddress, _connectionList.last()->pModbusClient->errorString(), QModbusDevice::ReadError);
+        }
     }
     else
     {
@@ -101,6 +111,25 @@ void ModbusConnection::sendReadRequest(ModbusAddress regAddress, quint16 size, i
     }
 }
 
+/*!
+ * Drop all outstanding requests of the current connection
+ * Replies that still arrive afterwards are silently deleted
+ */
+void ModbusConnection::discardPendingRequests(void)
+{
+    if (!_connectionList.isEmpty())
+    {
+        auto replyList = _connectionList.last()->pendingReplies.keys();
+        for (QModbusReply * pReply : qAsConst(replyList))
+        {
+            pReply->disconnect(this);
+            connect(pReply, &QModbusReply::finished, pReply, &QObject::deleteLater);
+        }
+
+        _connectionList.last()->pendingReplies.clear();
+    }
+}
+
 /*!
  *  Return whether connection is ok
  *
@@ -251,36 +280,45 @@ void ModbusConnection::connectionDestroyed()
  */
 void ModbusConnection::handleRequestFinished()
 {
+    /* Time stamp as soon as possible, so processing delays don't influence the sample time */
+    const qint64 timestamp = SampleClock::timestamp();
+
     QModbusReply * pReply = qobject_cast<QModbusReply *>(QObject::sender());
-     auto err = pReply->error();
-
-     // Start deletion of reply object before handling data (and closing connection)
-     pReply->deleteLater();
-
-     /* Check if reply is for valid connection (the last) */
-     if (pReply == _connectionList.last()->pReply)
-     {
-         if (err == QModbusDevice::NoError)
-         {
-             QModbusDataUnit dataUnit = pReply->result();
-             auto addr = ModbusAddress(static_cast<quint16>(dataUnit.startAddress()), objectType(dataUnit.registerType()));
-             emit readRequestSuccess(addr, dataUnit.values().toList());
-         }
-         else if (err == QModbusDevice::ProtocolError)
-         {
-             auto exceptionCode = pReply->rawResult().exceptionCode();
-
-             emit readRequestProtocolError(exceptionCode);
-         }
-         else
-         {
-            emit readRequestError(pReply->errorString(), pReply->error());
-         }
-     }
-     else
-     {
-         // ignore data from reply
-     }
+    auto err = pReply->error();
+
+    // Start deletion of reply object before handling data (and closing connection)
+    pReply->deleteLater();
+
+    /* Check if reply is for valid connection (the last) */
+    if (
+        (!_connectionList.isEmpty())
+        && (_connectionList.last()->pendingReplies.contains(pReply))
+    )
+    {
+        /* Replies can arrive out of order when pipelined, so match on the reply itself */
+        const ModbusAddress startRegister = _connectionList.last()->pendingReplies.take(pReply);
+
+        if (err == QModbusDevice::NoError)
+        {
+            QModbusDataUnit dataUnit = pReply->result();
+            auto addr = ModbusAddress(static_cast<quint16>(dataUnit.startAddress()), objectType(dataUnit.registerType()));
+            emit readRequestSuccess(addr, dataUnit.values().toList(), timestamp);
+        }
+        else if (err == QModbusDevice::ProtocolError)
+        {
+            auto exceptionCode = pReply->rawResult().exceptionCode();
+
+            emit readRequestProtocolError(startRegister, exceptionCode);
+        }
+        else
+        {
+            emit readRequestError(startRegister, pReply->errorString(), pReply->error());
+        }
+    }
+    else
+    {
+        // ignore data from reply
+    }
 }
 
 /*!
@@ -9,6 +9,7 @@
 #include <QModbusReply>
 #include <QModbusClient>
 #include <QPointer>
+#include <QHash>
 
 class ConnectionData : public QObject
 {
@@ -16,7 +17,7 @@ class ConnectionData : public QObject
 public:
 
     explicit ConnectionData(QModbusClient* pModbus):
-        connectionTimeoutTimer(this), bConnectionErrorHandled(false), pReply(nullptr)
+        connectionTimeoutTimer(this), bConnectionErrorHandled(false)
     {
         pModbusClient = pModbus;
     }
@@ -30,7 +31,8 @@ public:
     QModbusClient* pModbusClient;
     bool bConnectionErrorHandled;
 
-    QModbusReply * pReply;
+    /* Outstanding replies with their start register (multiple when pipelined) */
+    QHash<QModbusReply *, ModbusAddress> pendingReplies;
 };
 
 
@@ -60,6 +62,7 @@ public:
     void closeConnection(void);
 
     void sendReadRequest(ModbusAddress regAddress, quint16 size, int serverAddress);
+    void discardPendingRequests(void);
 
     bool isConnected(void);
 
@@ -67,9 +70,9 @@ signals:
     void connectionSuccess(void);
     void connectionError(QModbusDevice::Error error, QString msg);
 
-    void readRequestSuccess(ModbusAddress startRegister, QList<quint16> registerDataList);
-    void readRequestProtocolError(QModbusPdu::ExceptionCode exceptionCode);
-    void readRequestError(QString errorString, QModbusDevice::Error error);
+    void readRequestSuccess(ModbusAddress startRegister, QList<quint16> registerDataList, qint64 timestamp);
+    void readRequestProtocolError(ModbusAddress startRegister, QModbusPdu::ExceptionCode exceptionCode);
+    void readRequestError(ModbusAddress startRegister, QString errorString, QModbusDevice::Error error);
 
 private slots:
     void handleConnectionStateChanged(QModbusDevice::State connectionState);
@@ -1,16 +1,14 @@
 #include "modbusmaster.h"
 #include "modbusresultmap.h"
-#include "settingsmodel.h"
 #include "modbusconnection.h"
 #include "readregisters.h"
+#include "scopelogging.h"
 
 #include <util.h>
 
 Q_DECLARE_METATYPE(Result<quint16>);
 
-using State = ResultState::State;
-
-ModbusMaster::ModbusMaster(SettingsModel * pSettingsModel, quint8 connectionId) : QObject(nullptr), _connectionId(connectionId), _pSettingsModel(pSettingsModel)
+ModbusMaster::ModbusMaster(quint8 connectionId, QObject *parent) : QObject(parent), _connectionId(connectionId)
 {
     qMetaTypeId<Result<quint16> >();
 
@@ -30,48 +28,62 @@ ModbusMaster::~ModbusMaster()
     _modbusConnection.closeConnection();
 }
 
+/*!
+ * Take over settings of connection, the master doesn't access the settings model while polling
+ * The read capability of the settings is only the starting point, the master keeps learning it.
+ */
+void ModbusMaster::startCommunication(const CommunicationSettings& settings)
+{
+    _settings = settings.connection(_connectionId);
+
+    _readRegisters.setCapability(_settings.readCapability);
+}
+
 void ModbusMaster::readRegisterList(QList<ModbusAddress> registerList)
 {
-    if (_pSettingsModel->connectionState(_connectionId) == false)
+    if (_settings.bConnectionState == false)
     {
         ModbusResultMap errMap;
+        errMap.reserve(static_cast<qint32>(registerList.size()));
 
         for (int i = 0; i < registerList.size(); i++)
         {
-            const auto result = Result<quint16>(0, State::INVALID);
-            errMap.insert(registerList.at(i), result);
+            errMap.addErrors(registerList.at(i), 1);
         }
 
-        logError(QStringLiteral("Read failed because connection is disabled"));
+        logEvent(DiagnosticEvent::TYPE_CONNECTION_DISABLED);
         logResults(errMap);
     }
     else if (registerList.size() > 0)
     {
-        logInfo("Register list read: " + dumpToString(registerList));
+        logEvent(DiagnosticEvent::TYPE_READ_LIST, registerList.first(), static_cast<quint16>(registerList.size()));
 
-        _readRegisters.resetRead(registerList, _pSettingsModel->consecutiveMax(_connectionId));
+        _readRegisters.resetRead(registerList,
+                                 _settings.consecutiveMax,
+                                 _settings.maxGap);
+        _bReadActive = true;
 
         /* Open connection */
-        if (_pSettingsModel->connectionType(_connectionId) == Connection::TYPE_SERIAL)
+        if (_settings.connectionType == Connection::TYPE_SERIAL)
         {
             struct ModbusConnection::SerialSettings serialSettings =
             {
-                .portName = _pSettingsModel->portName(_connectionId),
-                .parity = _pSettingsModel->parity(_connectionId),
-                .baudrate = _pSettingsModel->baudrate(_connectionId),
-                .databits = _pSettingsModel->databits(_connectionId),
-                .stopbits = _pSettingsModel->stopbits(_connectionId),
+                .portName = _settings.portName,
+                .parity = _settings.parity,
+                .baudrate = _settings.baudrate,
+                .databits = _settings.databits,
+                .stopbits = _settings.stopbits,
             };
-            _modbusConnection.openSerialConnection(serialSettings, _pSettingsModel->timeout(_connectionId));
+            _modbusConnection.openSerialConnection(serialSettings, _settings.timeout);
         }
         else
         {
             struct ModbusConnection::TcpSettings tcpSettings =
             {
-                .ip = _pSettingsModel->ipAddress(_connectionId),
-                .port = _pSettingsModel->port(_connectionId),
+                .ip = _settings.ipAddress,
+                .port = _settings.port,
             };
-            _modbusConnection.openTcpConnection(tcpSettings, _pSettingsModel->timeout(_connectionId));
+            _modbusConnection.openTcpConnection(tcpSettings, _settings.timeout);
         }
     }
     else
@@ -83,8 +95,20 @@ void ModbusMaster::readRegisterList(QList<ModbusAddress> registerList)
 
 void ModbusMaster::cleanUp()
 {
+    /* Hand confirmed capability over once, the settings model only needs it for the project file */
+    const ReadCapability capability = _readRegisters.persistentCapability();
+    if (capability != _settings.readCapability)
+    {
+        _settings.readCapability = capability;
+
+        emit readCapabilityChanged(_connectionId, capability);
+    }
+
+    /* Device can be changed before next start */
+    _readRegisters.clearUnbridgeableGaps();
+
     /* Close connection when not closing automatically */
-    if (_pSettingsModel->persistentConnection(_connectionId))
+    if (_settings.bPersistentConnection)
     {
         _modbusConnection.closeConnection();
     }
@@ -101,41 +125,51 @@ void ModbusMaster::handlerConnectionError(QModbusDevice::Error error, QString ms
 
     logError(QString("Connection error: ") + msg);
 
+    if (!_bReadActive)
+    {
+        // Read already finished
+        return;
+    }
+
     _readRegisters.addAllErrors();
 
     finishRead(true);
 }
 
-void ModbusMaster::handleRequestSuccess(ModbusAddress startRegister, QList<quint16> registerDataList)
+void ModbusMaster::handleRequestSuccess(ModbusAddress startRegister, QList<quint16> registerDataList, qint64 timestamp)
 {
-    logInfo(QString("Read success"));
+    if (!_readRegisters.isInFlight(startRegister))
+    {
+        // Stale reply of aborted read
+        return;
+    }
+
+    logEvent(DiagnosticEvent::TYPE_READ_SUCCESS, startRegister, static_cast<quint16>(registerDataList.size()));
 
     // Success
-    _readRegisters.addSuccess(startRegister, registerDataList);
+    _readRegisters.addSuccess(startRegister, registerDataList, timestamp);
 
     // Start next read
     emit triggerNextRequest();
 }
 
-void ModbusMaster::handleRequestProtocolError(QModbusPdu::ExceptionCode exceptionCode)
+void ModbusMaster::handleRequestProtocolError(ModbusAddress startRegister, QModbusPdu::ExceptionCode exceptionCode)
 {
-    logError(QString("Modbus Exception: %0").arg(exceptionCode));
+    if (!_readRegisters.isInFlight(startRegister))
+    {
+        // Stale reply of aborted read
+        return;
+    }
+
+    logEvent(DiagnosticEvent::TYPE_READ_EXCEPTION, startRegister, 0, static_cast<quint16>(exceptionCode));
 
     if (
         (exceptionCode == QModbusPdu::IllegalDataAddress)
         || (exceptionCode == QModbusPdu::IllegalDataValue)
         )
     {
-        if (_readRegisters.next().count() > 1)
-        {
-            // Split read into separate reads on specific exception code and count is more than 1
-            _readRegisters.splitNextToSingleReads();
-        }
-        else
-        {
-            // Add error to results
-            _readRegisters.addError();
-        }
+        // Split read in halves on specific exception code, refused single read is added as error
+        _readRegisters.bisectRead(startRegister);
     }
     else if (exceptionCode == QModbusPdu::IllegalFunction)
     {
@@ -144,15 +178,21 @@ void ModbusMaster::handleRequestProtocolError(QModbusPdu::ExceptionCode exceptio
     }
     else
     {
-        _readRegisters.addError();
+        _readRegisters.addError(startRegister);
     }
 
     // Start next read
     emit triggerNextRequest();
 }
 
-void ModbusMaster::handleRequestError(QString errorString, QModbusDevice::Error error)
+void ModbusMaster::handleRequestError(ModbusAddress startRegister, QString errorString, QModbusDevice::Error error)
 {
+    if (!_readRegisters.isInFlight(startRegister))
+    {
+        // Stale reply of aborted read
+        return;
+    }
+
     logError(QString("Request Failed:  %0 (%1)").arg(errorString).arg(error));
 
     // When we don't receive an exception, abort read and close connection
@@ -164,22 +204,55 @@ void ModbusMaster::handleRequestError(QString errorString, QModbusDevice::Error
 
 void ModbusMaster::handleTriggerNextRequest(void)
 {
-    if (_readRegisters.hasNext())
+    if (!_bReadActive)
     {
-        ModbusReadItem readItem = _readRegisters.next();
+        // Trigger of already finished read
+    }
+    else if (_readRegisters.hasNext())
+    {
+        /* Keep up to pipelineDepth requests outstanding */
+        while (
+            _readRegisters.hasNext()
+            && (_readRegisters.inFlightCount() < pipelineDepth())
+        )
+        {
+            ModbusReadItem readItem = _readRegisters.takeNext();
 
-        logInfo("Partial list read: " + QString("Start address (%0) and count (%1)").arg(readItem.address().toString()).arg(readItem.count()));
+            logEvent(DiagnosticEvent::TYPE_READ_PARTIAL, readItem.address(), static_cast<quint16>(readItem.count()));
 
-        _modbusConnection.sendReadRequest(readItem.address(), readItem.count(), _pSettingsModel->slaveId(_connectionId));
+            _modbusConnection.sendReadRequest(readItem.address(), readItem.count(), _settings.slaveId);
+
+            if (!_bReadActive)
+            {
+                // Read aborted on send error
+                break;
+            }
+        }
     }
-    else
+    else if (_readRegisters.inFlightCount() == 0)
     {
         finishRead(false);
     }
+    else
+    {
+        // Wait for outstanding replies
+    }
 }
 
 void ModbusMaster::finishRead(bool bError)
 {
+    _bReadActive = false;
+
+    /* Make sure late replies of this read don't end up in the next read */
+    _modbusConnection.discardPendingRequests();
+
+    if (_readRegisters.learnCapability())
+    {
+        const ReadCapability& capability = _readRegisters.capability();
+
+        logEvent(DiagnosticEvent::TYPE_READ_CAPABILITY, ModbusAddress(), capability.maxBlockSize(), static_cast<quint16>(capability.unreadableList().size()));
+    }
+
     ModbusResultMap results = _readRegisters.resultMap();
 
     logResults(results);
@@ -193,7 +266,7 @@ void ModbusMaster::finishRead(bool bError)
     }
     else
     {
-        bcloseConnection = !_pSettingsModel->persistentConnection(_connectionId);
+        bcloseConnection = !_settings.bPersistentConnection;
     }
 
     if (bcloseConnection)
@@ -202,35 +275,48 @@ void ModbusMaster::finishRead(bool bError)
     }
 }
 
-QString ModbusMaster::dumpToString(ModbusResultMap map) const
+qint32 ModbusMaster::pipelineDepth()
 {
-    QString str;
-    QDebug dStream(&str);
-
-    dStream << map;
-
-    return str;
+    /* Serial line can only handle a single request at a time */
+    if (_settings.connectionType == Connection::TYPE_SERIAL)
+    {
+        return 1;
+    }
+    else
+    {
+        return qMax(static_cast<qint32>(_settings.pipelineDepth), 1);
+    }
 }
 
-QString ModbusMaster::dumpToString(QList<ModbusAddress> list) const
+void ModbusMaster::logResults(ModbusResultMap const &results)
 {
-    QString str;
-    QDebug dStream(&str);
-
-    dStream << &list;
+    /* Only count invalid results when the event is kept */
+    if (ScopeLogging::Logger().isEnabled(Diagnostic::eventSeverity(DiagnosticEvent::TYPE_READ_RESULTS)))
+    {
+        quint16 invalidCount = 0;
+        for (const ModbusResultMap::Block &block : results.blocks())
+        {
+            for (qint32 idx = 0; idx < block.count; idx++)
+            {
+                if (!results.isBlockValueValid(block, idx))
+                {
+                    invalidCount++;
+                }
+            }
+        }
 
-    return str;
-}
+        logEvent(DiagnosticEvent::TYPE_READ_RESULTS, ModbusAddress(), static_cast<quint16>(results.size()), invalidCount);
+    }
 
-void ModbusMaster::logResults(ModbusResultMap const &results)
-{
-    logInfo("Result map: " + dumpToString(results));
     emit modbusPollDone(results, _connectionId);
 }
 
-void ModbusMaster::logInfo(QString msg)
+/*!
+ * Record structured diagnostic, the message is only formatted when it is displayed
+ */
+void ModbusMaster::logEvent(DiagnosticEvent::Type type, ModbusAddress address, quint16 count, quint16 code)
 {
-    emit modbusLogInfo(QString("[Conn %0] %1").arg(_connectionId + 1).arg(msg));
+    ScopeLogging::Logger().logEvent(DiagnosticEvent(type, _connectionId, address, count, code));
 }
 
 void ModbusMaster::logError(QString msg)
@@ -9,17 +9,17 @@
 #include "modbusresultmap.h"
 #include "modbusconnection.h"
 #include "readregisters.h"
-
-/* Forward declaration */
-class SettingsModel;
+#include "diagnosticevent.h"
+#include "communicationsettings.h"
 
 class ModbusMaster : public QObject
 {
     Q_OBJECT
 public:
-    explicit ModbusMaster(SettingsModel * pSettingsModel, quint8 connectionId);
+    explicit ModbusMaster(quint8 connectionId, QObject *parent = nullptr);
     virtual ~ModbusMaster();
 
+    void startCommunication(const CommunicationSettings& settings);
     void readRegisterList(QList<ModbusAddress> registerList);
 
     void cleanUp();
@@ -27,33 +27,33 @@ public:
 signals:
     void modbusPollDone(ModbusResultMap modbusResults, quint8 connectionId);
     void modbusLogError(QString msg);
-    void modbusLogInfo(QString msg);
     void triggerNextRequest();
+    void readCapabilityChanged(quint8 connectionId, ReadCapability capability);
 
 private slots:
     void handleConnectionOpened();
     void handlerConnectionError(QModbusDevice::Error error, QString msg);
 
-    void handleRequestSuccess(ModbusAddress startRegister, QList<quint16> registerDataList);
-    void handleRequestProtocolError(QModbusPdu::ExceptionCode exceptionCode);
-    void handleRequestError(QString errorString, QModbusDevice::Error error);
+    void handleRequestSuccess(ModbusAddress startRegister, QList<quint16> registerDataList, qint64 timestamp);
+    void handleRequestProtocolError(ModbusAddress startRegister, QModbusPdu::ExceptionCode exceptionCode);
+    void handleRequestError(ModbusAddress startRegister, QString errorString, QModbusDevice::Error error);
 
     void handleTriggerNextRequest(void);
 
 private:
     void finishRead(bool bError);
-    QString dumpToString(ModbusResultMap map) const;
-    QString dumpToString(QList<ModbusAddress> list) const;
+    qint32 pipelineDepth();
 
     void logResults(const ModbusResultMap &results);
 
-    void logInfo(QString msg);
+    void logEvent(DiagnosticEvent::Type type, ModbusAddress address = ModbusAddress(), quint16 count = 0, quint16 code = 0);
     void logError(QString msg);
 
     quint8 _connectionId{};
+    bool _bReadActive{false};
 
-    SettingsModel * _pSettingsModel{};
-    ModbusConnection _modbusConnection{};
+    CommunicationSettings::ConnectionSettings _settings{};
+    ModbusConnection _modbusConnection{this};
     ReadRegisters _readRegisters{};
 };
 
@@ -2,32 +2,34 @@
 #include <QDateTime>
 
 #include "modbusmaster.h"
-#include "settingsmodel.h"
 #include "scopelogging.h"
 #include "formatdatetime.h"
 #include "registervaluehandler.h"
 
 #include "modbuspoll.h"
 
-ModbusPoll::ModbusPoll(SettingsModel * pSettingsModel, QObject *parent) :
-    QObject(parent), _bPollActive(false)
+ModbusPoll::ModbusPoll(QObject *parent) :
+    QObject(parent), _bPollActive(false), _bIndependentPolling(false)
 {
 
-    _pPollTimer = new QTimer();
-    _pSettingsModel = pSettingsModel;
+    /* All objects are children, so the complete stack can be moved to the communication thread */
+    _pPollTimer = new QTimer(this);
 
-    _pRegisterValueHandler = new RegisterValueHandler(_pSettingsModel);
+    _pRegisterValueHandler = new RegisterValueHandler(this);
     connect(_pRegisterValueHandler, &RegisterValueHandler::registerDataReady, this, &ModbusPoll::registerDataReady);
 
     /* Setup modbus master */
     for (quint8 i = 0u; i < Connection::ID_CNT; i++)
     {
-        auto modbusData = new ModbusMasterData(new ModbusMaster(_pSettingsModel, i));
+        auto modbusData = new ModbusMasterData(new ModbusMaster(i, this), this);
         _modbusMasters.append(modbusData);
 
         connect(_modbusMasters.last()->pModbusMaster, &ModbusMaster::modbusPollDone, this, &ModbusPoll::handlePollDone);
         connect(_modbusMasters.last()->pModbusMaster, &ModbusMaster::modbusLogError, this, &ModbusPoll::handleModbusError);
-        connect(_modbusMasters.last()->pModbusMaster, &ModbusMaster::modbusLogInfo, this, &ModbusPoll::handleModbusInfo);
+        connect(_modbusMasters.last()->pModbusMaster, &ModbusMaster::readCapabilityChanged, this, &ModbusPoll::readCapabilityChanged);
+
+        _modbusMasters.last()->pollTimer.setSingleShot(true);
+        connect(&_modbusMasters.last()->pollTimer, &QTimer::timeout, this, [this, i]() { triggerConnectionRead(i); });
     }
 
     _activeMastersCount = 0;
@@ -47,46 +49,68 @@ ModbusPoll::~ModbusPoll()
     delete _pPollTimer;
 }
 
-void ModbusPoll::startCommunication(QList<ModbusRegister>& registerList)
+/*!
+ * Start polling
+ * \param settings            Snapshot of the settings, taken by the thread that owns the settings model
+ * \param registerList        Registers to poll
+ * \param pollIntervalList    Poll interval per register (0 is default poll time)
+ */
+void ModbusPoll::startCommunication(const CommunicationSettings& settings, QList<ModbusRegister>& registerList, QList<quint32> pollIntervalList)
 {
-    _pRegisterValueHandler->setRegisters(registerList);
+    _settings = settings;
 
-    // Trigger read immediately
-    _pPollTimer->singleShot(1, this, &ModbusPoll::triggerRegisterRead);
+    _pRegisterValueHandler->setRegisters(registerList, _settings);
+    _pollScheduler.setPollIntervals(pollIntervalList);
 
-    _bPollActive = true;
+    for (quint8 i = 0u; i < Connection::ID_CNT; i++)
+    {
+        _modbusMasters[i]->pModbusMaster->startCommunication(_settings);
+    }
 
-    qCInfo(scopeComm) << QString("Start logging: %1").arg(FormatDateTime::currentDateTime());
+    _bIndependentPolling = _settings.independentPolling();
+    _bPollActive = true;
 
-    for (quint8 i = 0u; i < Connection::ID_CNT; i++)
+    if (_bIndependentPolling)
     {
-        if (_pSettingsModel->connectionState(i))
+        /* Every connection gets its own schedule with only its own registers */
+        for (quint8 i = 0u; i < Connection::ID_CNT; i++)
         {
-            QString str;
-            if (_pSettingsModel->connectionType(i) == Connection::TYPE_TCP)
+            QList<quint32> connPollIntervals;
+
+            _modbusMasters[i]->bActive = false;
+            _modbusMasters[i]->registerIndexList.clear();
+
+            for (qint32 regIdx = 0; regIdx < registerList.size(); regIdx++)
             {
-                str = QString("[Conn %0] %1:%2 - slave id %3")
-                                .arg(i + 1)
-                                .arg(_pSettingsModel->ipAddress(i))
-                                .arg(_pSettingsModel->port(i))
-                                .arg(_pSettingsModel->slaveId(i))
-                                ;
+                if (registerList[regIdx].connectionId() == i)
+                {
+                    _modbusMasters[i]->registerIndexList.append(regIdx);
+                    connPollIntervals.append(regIdx < pollIntervalList.size() ? pollIntervalList[regIdx] : 0);
+                }
             }
-            else
+
+            _modbusMasters[i]->pollScheduler.setPollIntervals(connPollIntervals);
+
+            if (!_modbusMasters[i]->registerIndexList.isEmpty())
             {
-                QString strParity;
-                QString strDataBits;
-                QString strStopBits;
-                _pSettingsModel->serialConnectionStrings(i, strParity, strDataBits, strStopBits);
-
-                str = QString("[Conn %0] %1, %2, %3, %4, %5 - slave id %6")
-                                .arg(i + 1)
-                                .arg(_pSettingsModel->portName(i))
-                                .arg(_pSettingsModel->baudrate(i))
-                                .arg(strParity, strDataBits, strStopBits)
-                                .arg(_pSettingsModel->slaveId(i))
-                                ;
+                // Trigger read immediately
+                _modbusMasters[i]->pollTimer.start(1);
             }
+        }
+    }
+    else
+    {
+        // Trigger read immediately
+        _pPollTimer->singleShot(1, this, &ModbusPoll::triggerRegisterRead);
+    }
+
+    qCInfo(scopeComm) << QString("Start logging: %1").arg(FormatDateTime::currentDateTime());
+
+    for (quint8 i = 0u; i < Connection::ID_CNT; i++)
+    {
+        if (_settings.connection(i).bConnectionState)
+        {
+            QString str = QString("[Conn %0] %1").arg(i + 1).arg(_settings.connection(i).description);
 
             qCInfo(scopeCommConnection) << str;
         }
@@ -102,6 +126,12 @@ void ModbusPoll::resetCommunicationStats()
 
 void ModbusPoll::handlePollDone(ModbusResultMap partialResultMap, quint8 connectionId)
 {
+    if (_bIndependentPolling)
+    {
+        handleConnectionPollDone(partialResultMap, connectionId);
+        return;
+    }
+
     bool lastResult = false;
 
     quint8 activeCnt = 0;
@@ -136,8 +166,9 @@ void ModbusPoll::handlePollDone(ModbusResultMap partialResultMap, quint8 connect
         // Restart timer when previous request has been handled
         uint waitInterval;
         const quint32 passedInterval = static_cast<quint32>(QDateTime::currentMSecsSinceEpoch() - _lastPollStart);
+        const quint32 cycleTime = _pollScheduler.cycleTime(_settings.pollTime());
 
-        if (passedInterval > _pSettingsModel->pollTime())
+        if (passedInterval > cycleTime)
         {
             // Poll again immediately
             waitInterval = 1;
@@ -145,7 +176,7 @@ void ModbusPoll::handlePollDone(ModbusResultMap partialResultMap, quint8 connect
         else
         {
             // Set waitInterval to remaining time
-            waitInterval = _pSettingsModel->pollTime() - passedInterval;
+            waitInterval = cycleTime - passedInterval;
         }
 
         _pPollTimer->singleShot(static_cast<int>(waitInterval), this, &ModbusPoll::triggerRegisterRead);
@@ -157,11 +188,6 @@ void ModbusPoll::handleModbusError(QString msg)
     qCWarning(scopeCommConnection) << msg;
 }
 
-void ModbusPoll::handleModbusInfo(QString msg)
-{
-    qCDebug(scopeCommConnection) << msg;
-}
-
 void ModbusPoll::stopCommunication()
 {
     _bPollActive = false;
@@ -171,6 +197,7 @@ void ModbusPoll::stopCommunication()
 
     for(quint8 i = 0; i < Connection::ID_CNT; i++)
     {
+        _modbusMasters[i]->pollTimer.stop();
         _modbusMasters[i]->pModbusMaster->cleanUp();
     }
 }
@@ -186,7 +213,8 @@ void ModbusPoll::triggerRegisterRead()
     {
         _lastPollStart = QDateTime::currentMSecsSinceEpoch();
 
-        _pRegisterValueHandler->startRead();
+        /* Only read registers of which the poll interval has passed */
+        _pRegisterValueHandler->startRead(_pollScheduler.nextCycle(_settings.pollTime()));
 
         /* Strange construction is required to avoid race condition:
          *
@@ -229,3 +257,83 @@ void ModbusPoll::triggerRegisterRead()
     }
 }
 
+void ModbusPoll::triggerConnectionRead(quint8 connectionId)
+{
+    if (
+        _bPollActive
+        && _bIndependentPolling
+        && (connectionId < Connection::ID_CNT)
+    )
+    {
+        ModbusMasterData * pMasterData = _modbusMasters[connectionId];
+
+        pMasterData->lastPollStart = QDateTime::currentMSecsSinceEpoch();
+
+        /* Convert due flags of connection registers to complete register list */
+        const QList<bool> connDueList = pMasterData->pollScheduler.nextCycle(_settings.pollTime());
+        QList<bool> dueList;
+        for (qint32 idx = 0; idx < pMasterData->registerIndexList.size(); idx++)
+        {
+            const qint32 regIdx = pMasterData->registerIndexList[idx];
+            while (dueList.size() <= regIdx)
+            {
+                dueList.append(false);
+            }
+            dueList[regIdx] = idx < connDueList.size() ? connDueList[idx] : true;
+        }
+
+        _pRegisterValueHandler->startConnectionRead(connectionId, dueList);
+
+        QList<ModbusAddress> regAddrList;
+        _pRegisterValueHandler->registerAddresList(regAddrList, connectionId);
+
+        if (regAddrList.isEmpty())
+        {
+            /* Nothing due in this cycle of the connection */
+            scheduleConnectionRead(connectionId);
+        }
+        else
+        {
+            pMasterData->bActive = true;
+            pMasterData->pModbusMaster->readRegisterList(regAddrList);
+        }
+    }
+}
+
+void ModbusPoll::handleConnectionPollDone(ModbusResultMap partialResultMap, quint8 connectionId)
+{
+    if (connectionId >= Connection::ID_CNT)
+    {
+        return;
+    }
+
+    _modbusMasters[connectionId]->bActive = false;
+
+    _pRegisterValueHandler->processPartialResult(partialResultMap, connectionId);
+    _pRegisterValueHandler->finishConnectionRead(connectionId);
+
+    scheduleConnectionRead(connectionId);
+}
+
+void ModbusPoll::scheduleConnectionRead(quint8 connectionId)
+{
+    ModbusMasterData * pMasterData = _modbusMasters[connectionId];
+
+    // Restart timer of connection when previous request has been handled
+    uint waitInterval;
+    const quint32 passedInterval = static_cast<quint32>(QDateTime::currentMSecsSinceEpoch() - pMasterData->lastPollStart);
+    const quint32 cycleTime = pMasterData->pollScheduler.cycleTime(_settings.pollTime());
+
+    if (passedInterval > cycleTime)
+    {
+        // Poll again immediately
+        waitInterval = 1;
+    }
+    else
+    {
+        // Set waitInterval to remaining time
+        waitInterval = cycleTime - passedInterval;
+    }
+
+    pMasterData->pollTimer.start(static_cast<int>(waitInterval));
+}
@@ -1,13 +1,15 @@
 #ifndef COMMUNICATION_MANAGER_H
 #define COMMUNICATION_MANAGER_H
 
+#include <atomic>
 #include <QStringListModel>
 #include <QTimer>
 #include "modbusresultmap.h"
 #include "modbusregister.h"
+#include "pollscheduler.h"
+#include "communicationsettings.h"
 
 //Forward declaration
-class SettingsModel;
 class RegisterValueHandler;
 class ModbusMaster;
 
@@ -17,24 +19,31 @@ class ModbusMasterData : public QObject
 public:
 
     explicit ModbusMasterData(ModbusMaster * pArgModbusMaster, QObject *parent = nullptr):
-        QObject(parent)
+        QObject(parent), pollTimer(this)
     {
         pModbusMaster = pArgModbusMaster;
         bActive = false;
+        lastPollStart = 0;
     }
 
     ModbusMaster * pModbusMaster;
     bool bActive;
+
+    /* Only used when connections are polled independently */
+    PollScheduler pollScheduler;
+    QTimer pollTimer;
+    QList<qint32> registerIndexList;
+    qint64 lastPollStart;
 };
 
 class ModbusPoll : public QObject
 {
     Q_OBJECT
 public:
-    explicit ModbusPoll(SettingsModel * pSettingsModel, QObject *parent = nullptr);
+    explicit ModbusPoll(QObject *parent = nullptr);
     ~ModbusPoll();
 
-    void startCommunication(QList<ModbusRegister>& registerList);
+    void startCommunication(const CommunicationSettings& settings, QList<ModbusRegister>& registerList, QList<quint32> pollIntervalList = QList<quint32>());
     void stopCommunication();
 
     bool isActive();
@@ -42,25 +51,30 @@ public:
 
 signals:
     void registerDataReady(ResultDoubleList registers);
+    void readCapabilityChanged(quint8 connectionId, ReadCapability capability);
 
 private slots:
     void handlePollDone(ModbusResultMap partialResultMap, quint8 connectionId);
     void handleModbusError(QString msg);
-    void handleModbusInfo(QString msg);
     void triggerRegisterRead();
+    void triggerConnectionRead(quint8 connectionId);
 
 private:
+    void handleConnectionPollDone(ModbusResultMap partialResultMap, quint8 connectionId);
+    void scheduleConnectionRead(quint8 connectionId);
 
     QList<ModbusMasterData *> _modbusMasters;
     quint32 _activeMastersCount;
 
-    bool _bPollActive;
+    std::atomic<bool> _bPollActive;
+    bool _bIndependentPolling;
     QTimer * _pPollTimer;
     qint64 _lastPollStart;
 
     RegisterValueHandler* _pRegisterValueHandler;
+    PollScheduler _pollScheduler;
 
-    SettingsModel * _pSettingsModel;
+    CommunicationSettings _settings;
 };
 
 #endif // COMMUNICATION_MANAGER_H
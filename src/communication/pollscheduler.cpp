@@ -0,0 +1,156 @@
+#include "pollscheduler.h"
+#include "scopelogging.h"
+
+#include <numeric> // std::gcd
+
+PollScheduler::PollScheduler()
+{
+    _cycleIdx = 0;
+    _bScheduleValid = false;
+    _scheduleDefaultPollTime = 0;
+    _cycleTime = 0;
+}
+
+/*!
+ * Set poll interval of each register
+ * \param pollIntervalList  Poll interval in ms per register (0 is default poll time)
+ */
+void PollScheduler::setPollIntervals(QList<quint32> pollIntervalList)
+{
+    _pollIntervalList = pollIntervalList;
+    _bScheduleValid = false;
+
+    reset();
+}
+
+/*!
+ * Return time between poll cycles
+ * This is the greatest common divisor of the poll intervals of all registers, so every interval
+ * is a whole number of cycles. When the divisor would result in a very short cycle, the shortest
+ * poll interval is used instead (see nextCycle()).
+ * \param defaultPollTime   Poll time of registers without specific interval
+ * \return Cycle time in ms
+ */
+quint32 PollScheduler::cycleTime(quint32 defaultPollTime)
+{
+    updateSchedule(defaultPollTime);
+
+    return _cycleTime;
+}
+
+/*!
+ * Start next poll cycle and return which registers are due
+ * All registers are due in the first cycle. A poll interval that isn't a multiple of the cycle
+ * time is rounded down, so the register is never polled slower than requested.
+ * \param defaultPollTime   Poll time of registers without specific interval
+ * \return List with due flag per register
+ */
+QList<bool> PollScheduler::nextCycle(quint32 defaultPollTime)
+{
+    updateSchedule(defaultPollTime);
+
+    QList<bool> dueList;
+    dueList.reserve(_cycleCountList.size());
+
+    for (quint64 cycleCount : qAsConst(_cycleCountList))
+    {
+        dueList.append((_cycleIdx % cycleCount) == 0);
+    }
+
+    _cycleIdx++;
+
+    return dueList;
+}
+
+/*!
+ * Restart schedule, all registers are due in next cycle
+ */
+void PollScheduler::reset()
+{
+    _cycleIdx = 0;
+}
+
+/*!
+ * Calculate cycle time and number of cycles between polls of every register
+ * A poll interval that isn't a multiple of the cycle time is only reported once.
+ * \param defaultPollTime   Poll time of registers without specific interval
+ */
+void PollScheduler::updateSchedule(quint32 defaultPollTime)
+{
+    if (
+        _bScheduleValid
+        && (_scheduleDefaultPollTime == defaultPollTime)
+    )
+    {
+        return;
+    }
+
+    _cycleTime = calculateCycleTime(defaultPollTime);
+    _cycleCountList.clear();
+    _cycleCountList.reserve(_pollIntervalList.size());
+
+    QList<quint32> reportedList;
+    for (quint32 pollInterval : qAsConst(_pollIntervalList))
+    {
+        const quint32 interval = effectiveInterval(pollInterval, defaultPollTime);
+        const quint64 cycleCount = qMax(static_cast<quint64>(interval / _cycleTime), static_cast<quint64>(1));
+
+        if (
+            (interval % _cycleTime != 0)
+            && !reportedList.contains(interval)
+        )
+        {
+            reportedList.append(interval);
+
+            qCWarning(scopeComm) << QString("Poll interval of %1 ms is not a multiple of poll cycle (%2 ms), register is polled every %3 ms")
+                                        .arg(interval)
+                                        .arg(_cycleTime)
+                                        .arg(cycleCount * _cycleTime);
+        }
+
+        _cycleCountList.append(cycleCount);
+    }
+
+    _scheduleDefaultPollTime = defaultPollTime;
+    _bScheduleValid = true;
+}
+
+/*!
+ * Greatest common divisor of the poll intervals, see cycleTime()
+ */
+quint32 PollScheduler::calculateCycleTime(quint32 defaultPollTime)
+{
+    if (_pollIntervalList.isEmpty())
+    {
+        return effectiveInterval(0, defaultPollTime);
+    }
+
+    quint32 minInterval = effectiveInterval(_pollIntervalList.first(), defaultPollTime);
+    quint32 divisor = minInterval;
+
+    for (quint32 pollInterval : qAsConst(_pollIntervalList))
+    {
+        const quint32 interval = effectiveInterval(pollInterval, defaultPollTime);
+
+        minInterval = qMin(minInterval, interval);
+        divisor = std::gcd(divisor, interval);
+    }
+
+    /* Don't poll more often than required for the fastest register */
+    if (divisor < qMin(minInterval, static_cast<quint32>(cMinCycleTime)))
+    {
+        return minInterval;
+    }
+    else
+    {
+        return divisor;
+    }
+}
+
+quint32 PollScheduler::effectiveInterval(quint32 pollInterval, quint32 defaultPollTime)
+{
+    const quint32 interval = pollInterval == 0 ? defaultPollTime : pollInterval;
+
+    /* Avoid division by zero */
+    return qMax(interval, static_cast<quint32>(1));
+}
@@ -0,0 +1,36 @@
+#ifndef POLLSCHEDULER_H
+#define POLLSCHEDULER_H
+
+#include <QList>
+
+class PollScheduler
+{
+public:
+    PollScheduler();
+
+    void setPollIntervals(QList<quint32> pollIntervalList);
+
+    quint32 cycleTime(quint32 defaultPollTime);
+    QList<bool> nextCycle(quint32 defaultPollTime);
+
+    void reset();
+
+private:
+    /* Shortest cycle that is used to poll registers with unrelated intervals */
+    static const quint32 cMinCycleTime = 10;
+
+    void updateSchedule(quint32 defaultPollTime);
+    quint32 calculateCycleTime(quint32 defaultPollTime);
+    quint32 effectiveInterval(quint32 pollInterval, quint32 defaultPollTime);
+
+    QList<quint32> _pollIntervalList;
+    quint64 _cycleIdx;
+
+    /* Schedule is only calculated again when intervals or default poll time change */
+    bool _bScheduleValid;
+    quint32 _scheduleDefaultPollTime;
+    quint32 _cycleTime;
+    QList<quint64> _cycleCountList; /* Number of cycles between polls, per register */
+};
+
+#endif // POLLSCHEDULER_H
@@ -1,24 +1,88 @@
 #include "readregisters.h"
 
-using State = ResultState::State;
+#include <algorithm>
 
 ReadRegisters::ReadRegisters()
 {
 
 }
 
+/*!
+ * Start from read capability of device that is known from earlier sessions
+ * All limits that were learned before are forgotten. The known limits are treated as
+ * confirmed, but are still probed once in a while.
+ * \param capability    Known read capability of device
+ */
+void ReadRegisters::setCapability(const ReadCapability& capability)
+{
+    _unreadableMap.clear();
+    _boundaryMap.clear();
+    _readCycle = 0;
+
+    for (const ModbusAddress &registerAddr : capability.unreadableList())
+    {
+        _unreadableMap.insert(registerAddr, confirmedLimit());
+    }
+
+    for (const ModbusAddress &registerAddr : capability.boundaryList())
+    {
+        _boundaryMap.insert(registerAddr, confirmedLimit());
+    }
+
+    _maxBlockSize = capability.maxBlockSize();
+    _blockSizeLimit = confirmedLimit();
+
+    updateCapability();
+}
+
 /*!
  * Load ReadRegisterCollection with register read list
- * \param registerList  Register read list
+ * Registers are merged in a single read when they are consecutive or when the
+ * gap between them is at most maxGap registers. The registers in the gap are read,
+ * but are not added to the result. Gaps that were refused by the device before are never bridged.
+ * The learned read capability of the device is respected: unreadable registers aren't read (and
+ * are added as error) and reads don't cross learned limits.
+ * \param registerList  Register read list (sorted)
  * \param consecutiveMax Number of consecutive registers that is allowed to read at once
+ * \param maxGap        Maximum number of unused registers between two registers in the same read
  */
-void ReadRegisters::resetRead(QList<ModbusAddress> registerList, quint16 consecutiveMax)
+void ReadRegisters::resetRead(QList<ModbusAddress> registerList, quint16 consecutiveMax, quint16 maxGap)
 {
+    _readItemList.clear();
+    _inFlightList.clear();
+
+    _splitList.clear();
+    _succeededList.clear();
+    _refusedList.clear();
+    _largestSuccess = 0;
+
+    _registerList = registerList;
+    std::sort(_registerList.begin(), _registerList.end());
+
     _resultMap.clear();
+    _resultMap.reserve(static_cast<qint32>(_registerList.size()));
 
-    if (registerList.size() == 0)
+    if (_capability.maxBlockSize() > 0)
     {
-        _readItemList.clear();
+        consecutiveMax = qMin(consecutiveMax, _capability.maxBlockSize());
+    }
+
+    if (!_capability.unreadableList().isEmpty())
+    {
+        QList<ModbusAddress> readableList;
+        for (const ModbusAddress &registerAddr : qAsConst(registerList))
+        {
+            if (_capability.isUnreadable(registerAddr))
+            {
+                _resultMap.addErrors(registerAddr, 1);
+            }
+            else
+            {
+                readableList.append(registerAddr);
+            }
+        }
+
+        registerList = readableList;
     }
 
     while(registerList.size() > 0)
@@ -35,51 +99,65 @@ void ReadRegisters::resetRead(QList<ModbusAddress> registerList, quint16 consecu
         }
         else
         {
+            const ModbusAddress startAddress = registerList.first();
+            const quint32 startAddr = startAddress.address(ModbusAddress::Offset::WITHOUT_OFFSET);
+
             int currentIdx = 0;
+            quint32 count = 1;
 
-            bool bSubsequent = false;
-            do
+            while ((currentIdx + 1) < registerList.size())
             {
+                const ModbusAddress current = registerList.at(currentIdx);
+                const ModbusAddress candidate = registerList.at(currentIdx + 1);
 
-                // if next is current + 1, dan subsequent = true
-                if (registerList.at(currentIdx).next() == registerList.at(currentIdx + 1))
-                {
-                    bSubsequent = true;
-                    currentIdx++;
-                }
-                else
+                if (
+                    (candidate.objectType() != current.objectType())
+                    || !(current < candidate)
+                )
                 {
-                    bSubsequent = false;
+                    break;
                 }
 
-                // Break loop when end of list
-                if (currentIdx >= (registerList.size() - 1))
+                const quint32 currentAddr = current.address(ModbusAddress::Offset::WITHOUT_OFFSET);
+                const quint32 candidateAddr = candidate.address(ModbusAddress::Offset::WITHOUT_OFFSET);
+                const quint32 gap = candidateAddr - currentAddr - 1;
+                const quint32 newCount = candidateAddr - startAddr + 1;
+
+                // Limit number of register in 1 read
+                if (newCount > consecutiveMax)
                 {
                     break;
                 }
 
-                // Limit number of register in 1 read
-                if ((currentIdx + 1) >= consecutiveMax)
+                // Only bridge small gaps that aren't refused by device and respect learned boundaries
+                if (
+                    (gap > maxGap)
+                    || ((gap > 0) && isGapUnbridgeable(current, candidate))
+                    || _capability.isSplit(current, candidate)
+                )
                 {
                     break;
                 }
 
-            } while(bSubsequent == true);
-
-
-            // Convert idx to count
-            quint8 count = static_cast<quint8>(currentIdx) + 1;
+                count = newCount;
+                currentIdx++;
+            }
 
-            _readItemList.append(ModbusReadItem(registerList.first(), count));
+            _readItemList.append(ModbusReadItem(startAddress, static_cast<quint8>(count)));
 
-            for (int idx = 0; idx < count; idx++)
-            {
-                registerList.removeFirst();
-            }
+            registerList.remove(0, currentIdx + 1);
         }
     }
 }
 
+/*!
+ * Forget gaps that were refused by the device
+ */
+void ReadRegisters::clearUnbridgeableGaps()
+{
+    _unbridgeableList.clear();
+}
+
 /*!
  * Return whether there is still a ModbusReadItem left
  * \retval true     Still ModbusReadItemLeft
@@ -107,27 +185,80 @@ ModbusReadItem ReadRegisters::next()
 }
 
 /*!
- * Add success result for current ReadRegister cluster
+ * Take next ModbusReadItem and mark it as in flight
+ * The result is added later with the start register of the item
+ * \return next ModbusReadItem (item with count 0 when no item available)
+ */
+ModbusReadItem ReadRegisters::takeNext()
+{
+    if (hasNext())
+    {
+        ModbusReadItem item = _readItemList.takeFirst();
+        _inFlightList.append(item);
+
+        return item;
+    }
+    else
+    {
+        return ModbusReadItem(0,0);
+    }
+}
+
+/*!
+ * Return number of ModbusReadItems that are sent, but without result
+ * \return Number of in flight items
+ */
+qint32 ReadRegisters::inFlightCount()
+{
+    return static_cast<qint32>(_inFlightList.size());
+}
+
+/*!
+ * Return whether a ModbusReadItem with this start register is in flight
+ * \param startRegister     Start register address
+ * \retval true     Item is in flight
+ * \retval false    No item in flight with this start register
+ */
+bool ReadRegisters::isInFlight(ModbusAddress startRegister)
+{
+    return findInFlight(startRegister) != -1;
+}
+
+/*!
+ * Add success result for ReadRegister cluster
+ * In flight item with matching start register is used, otherwise current cluster
  * \param startRegister     Start register address
  * \param registerDataList  List with result data
+ * \param timestamp         Arrival time of reply (SampleClock)
  */
-void ReadRegisters::addSuccess(ModbusAddress startRegister, QList<quint16> registerDataList)
+void ReadRegisters::addSuccess(ModbusAddress startRegister, QList<quint16> registerDataList, qint64 timestamp)
 {
-    if (
+    const qint32 inFlightIdx = findInFlight(startRegister);
+
+    if (inFlightIdx != -1)
+    {
+        ModbusReadItem item = _inFlightList.takeAt(inFlightIdx);
+
+        if (registerDataList.size() >= item.count())
+        {
+            addItemValues(item, registerDataList, timestamp);
+
+            _succeededList.append(item);
+            _largestSuccess = qMax(_largestSuccess, static_cast<qint32>(item.count()));
+        }
+        else
+        {
+            /* Incomplete response */
+            addItemError(item);
+        }
+    }
+    else if (
         hasNext()
         && (next().address() == startRegister)
         && (registerDataList.size() >= next().count())
     )
     {
-        for (qint32 i = 0; i < next().count(); i++)
-        {
-            const auto registerAddr = startRegister.next(i);
-            const auto result = Result<quint16>(registerDataList[i], State::SUCCESS);
-
-            _resultMap.insert(registerAddr, result);
-        }
-
-        _readItemList.removeFirst();
+        addItemValues(_readItemList.takeFirst(), registerDataList, timestamp);
     }
 }
 
@@ -138,24 +269,34 @@ void ReadRegisters::addError()
 {
     if (hasNext())
     {
-        auto nextRequestData = next();
-        for (quint32 i = 0; i < nextRequestData.count(); i++)
-        {
-            const auto registerAddr = nextRequestData.address().next(i);
-            const auto result = Result<quint16>(0, State::INVALID);
+        addItemError(_readItemList.takeFirst());
+    }
+}
 
-            _resultMap.insert(registerAddr, result);
-        }
+/*!
+ * Add error result for in flight ReadRegister cluster
+ * \param startRegister     Start register address of in flight cluster
+ */
+void ReadRegisters::addError(ModbusAddress startRegister)
+{
+    const qint32 inFlightIdx = findInFlight(startRegister);
 
-        _readItemList.removeFirst();
+    if (inFlightIdx != -1)
+    {
+        addItemError(_inFlightList.takeAt(inFlightIdx));
     }
 }
 
 /*!
- * Mark all remaining register as errors
+ * Mark all remaining register as errors (in flight and not yet sent)
  */
 void ReadRegisters::addAllErrors()
 {
+    while (!_inFlightList.isEmpty())
+    {
+        addItemError(_inFlightList.takeFirst());
+    }
+
     while(hasNext())
     {
         addError();
@@ -169,22 +310,536 @@ void ReadRegisters::splitNextToSingleReads()
 {
     if (hasNext())
     {
-        ModbusReadItem firstItem = _readItemList.first();
+        ModbusReadItem firstItem = _readItemList.takeFirst();
+
+        prependSingleReads(firstItem);
+    }
+}
+
+/*!
+ * Split in flight ModbusReadItem into single reads.
+ * The single reads are scheduled before the remaining items.
+ * An in flight single read can't be split, so it is marked as error.
+ * \param startRegister     Start register address of in flight cluster
+ */
+void ReadRegisters::splitToSingleReads(ModbusAddress startRegister)
+{
+    const qint32 inFlightIdx = findInFlight(startRegister);
+
+    if (inFlightIdx != -1)
+    {
+        ModbusReadItem item = _inFlightList.takeAt(inFlightIdx);
+
+        if (item.count() > 1)
+        {
+            prependSingleReads(item);
+        }
+        else
+        {
+            addItemError(item);
+        }
+    }
+}
+
+/*!
+ * Split refused in flight ModbusReadItem in two halves
+ * The halves are scheduled before the remaining items. A refused single read can't be split,
+ * so it is marked as error and the register is remembered as unreadable.
+ * Which halves succeed is used to learn the read capability of the device (see learnCapability()).
+ * \param startRegister     Start register address of in flight cluster
+ */
+void ReadRegisters::bisectRead(ModbusAddress startRegister)
+{
+    const qint32 inFlightIdx = findInFlight(startRegister);
+
+    if (inFlightIdx == -1)
+    {
+        return;
+    }
+
+    ModbusReadItem item = _inFlightList.takeAt(inFlightIdx);
+
+    if (item.count() > 1)
+    {
+        const qint32 half = item.count() / 2;
 
-        _readItemList.removeFirst();
+        /* Halves start and end with a requested register, first register of item is always requested */
+        qint32 lowCount = half;
+        while (!isRequested(item.address().next(lowCount - 1)))
+        {
+            lowCount--;
+        }
 
-        for(int idx = firstItem.count(); idx > 0; idx--)
+        qint32 highStart = half;
+        while (!isRequested(item.address().next(highStart)))
         {
-            _readItemList.prepend(ModbusReadItem(firstItem.address().next(idx - 1), 1));
+            highStart++;
         }
+
+        const SplitRead split = {
+            item,
+            ModbusReadItem(item.address(), static_cast<quint8>(lowCount)),
+            ModbusReadItem(item.address().next(highStart), static_cast<quint8>(item.count() - highStart))
+        };
+
+        _splitList.append(split);
+
+        _readItemList.prepend(split.high);
+        _readItemList.prepend(split.low);
     }
+    else
+    {
+        _refusedList.append(item.address());
+
+        addItemError(item);
+    }
+}
+
+/*!
+ * Learn read capability of device from the reads that were refused during the last read
+ * When both halves of a refused read succeed, the refused read is explained by:
+ *  - registers that are only read to bridge a gap: the gap is never bridged again
+ *  - size of the read, when no larger read succeeded: the halves are known to succeed
+ *  - otherwise a boundary of the device at the start of the high half
+ * A learned limit is probed after a back-off number of reads. The back-off is doubled each
+ * time the probe confirms the limit, a limit is forgotten when the probe read succeeds.
+ * Unbridgeable gaps are only forgotten by clearUnbridgeableGaps().
+ * \return true when a limit was learned or forgotten
+ */
+bool ReadRegisters::learnCapability()
+{
+    bool bChanged = forgetDisprovedLimits();
+
+    for (const ModbusAddress &registerAddr : qAsConst(_refusedList))
+    {
+        bChanged |= learnLimit(_unreadableMap, registerAddr);
+    }
+
+    for (SplitRead split : qAsConst(_splitList))
+    {
+        if (
+            !isSucceeded(split.low)
+            || !isSucceeded(split.high)
+        )
+        {
+            continue;
+        }
+
+        const ModbusAddress lowEnd = split.low.address().next(split.low.count());
+
+        if (lowEnd < split.high.address())
+        {
+            for (ModbusAddress registerAddr = lowEnd; registerAddr < split.high.address(); registerAddr = registerAddr.next())
+            {
+                if (!_unbridgeableList.contains(registerAddr))
+                {
+                    _unbridgeableList.append(registerAddr);
+                    bChanged = true;
+                }
+            }
+        }
+        else if (split.parent.count() > _largestSuccess)
+        {
+            bChanged |= learnBlockSize(qMax(split.low.count(), split.high.count()));
+        }
+        else
+        {
+            bChanged |= learnLimit(_boundaryMap, split.high.address());
+        }
+    }
+
+    _splitList.clear();
+    _succeededList.clear();
+    _refusedList.clear();
+    _largestSuccess = 0;
+
+    _readCycle++;
+    updateCapability();
+
+    return bChanged;
+}
+
+/*!
+ * Return read capability of device
+ * \return Read capability that is used for the next read, limits that are probed are left out
+ */
+const ReadCapability& ReadRegisters::capability() const
+{
+    return _capability;
+}
+
+/*!
+ * Return read capability that can be stored in the project file
+ * Only limits that are confirmed several times are included. Unreadable registers are
+ * never included, they depend too much on the state of the device.
+ * \return Confirmed read capability
+ */
+ReadCapability ReadRegisters::persistentCapability() const
+{
+    ReadCapability capability;
+
+    if (
+        (_maxBlockSize > 0)
+        && (_blockSizeLimit.confirmCount >= cPersistConfirmCount)
+    )
+    {
+        capability.limitBlockSize(_maxBlockSize);
+    }
+
+    for (auto it = _boundaryMap.constBegin(); it != _boundaryMap.constEnd(); ++it)
+    {
+        if (it.value().confirmCount >= cPersistConfirmCount)
+        {
+            capability.addBoundary(it.key());
+        }
+    }
+
+    return capability;
 }
 
 /*!
  * Return result map
+ * The result map is implicitly shared, so returning it doesn't copy the results
  * \return Result map
  */
 ModbusResultMap ReadRegisters::resultMap()
 {
     return _resultMap;
 }
+
+/*!
+ * Add values of item as blocks of consecutive requested registers
+ * Registers that are only read to bridge a gap are skipped.
+ * \param item                 Read item
+ * \param registerDataList     Result data (at least item count values)
+ * \param timestamp            Arrival time of reply (SampleClock)
+ */
+void ReadRegisters::addItemValues(ModbusReadItem item, const QList<quint16>& registerDataList, qint64 timestamp)
+{
+    qint32 runStart = 0;
+    while (runStart < item.count())
+    {
+        const qint32 runEnd = requestedRunEnd(item, runStart);
+
+        if (runEnd > runStart)
+        {
+            _resultMap.addValues(item.address().next(runStart), registerDataList.constData() + runStart, runEnd - runStart, timestamp);
+            runStart = runEnd;
+        }
+        else
+        {
+            runStart++;
+        }
+    }
+}
+
+/*!
+ * Mark all registers of item as error
+ * \param item     Read item
+ */
+void ReadRegisters::addItemError(ModbusReadItem item)
+{
+    qint32 runStart = 0;
+    while (runStart < item.count())
+    {
+        const qint32 runEnd = requestedRunEnd(item, runStart);
+
+        if (runEnd > runStart)
+        {
+            _resultMap.addErrors(item.address().next(runStart), runEnd - runStart);
+            runStart = runEnd;
+        }
+        else
+        {
+            runStart++;
+        }
+    }
+}
+
+/*!
+ * Find end of run of consecutive requested registers in item
+ * \param item     Read item
+ * \param start    Index of first register of run in item
+ * \return Index after last requested register of run, start when register at start isn't requested
+ */
+qint32 ReadRegisters::requestedRunEnd(ModbusReadItem item, qint32 start)
+{
+    qint32 end = start;
+    while (
+        (end < item.count())
+        && isRequested(item.address().next(end))
+    )
+    {
+        end++;
+    }
+
+    return end;
+}
+
+/*!
+ * Replace item with single reads of the requested registers.
+ * \param item     Read item
+ */
+void ReadRegisters::prependSingleReads(ModbusReadItem item)
+{
+    for(int idx = item.count(); idx > 0; idx--)
+    {
+        const auto registerAddr = item.address().next(idx - 1);
+
+        if (isRequested(registerAddr))
+        {
+            _readItemList.prepend(ModbusReadItem(registerAddr, 1));
+        }
+    }
+}
+
+/*!
+ * Check whether register is part of requested register list
+ * \param registerAddr     Register address
+ * \return true when register is requested
+ */
+bool ReadRegisters::isRequested(ModbusAddress registerAddr)
+{
+    return std::binary_search(_registerList.begin(), _registerList.end(), registerAddr);
+}
+
+/*!
+ * Check whether gap between two registers contains a register that was refused by the device
+ * \param lowRegister      Register before gap
+ * \param highRegister     Register after gap
+ * \return true when gap can't be bridged
+ */
+bool ReadRegisters::isGapUnbridgeable(ModbusAddress lowRegister, ModbusAddress highRegister)
+{
+    for (const ModbusAddress &registerAddr : qAsConst(_unbridgeableList))
+    {
+        if ((lowRegister < registerAddr) && (registerAddr < highRegister))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*!
+ * Check whether item was read successfully during current read
+ * \param item     Read item
+ * \return true when item with same start register and count succeeded
+ */
+bool ReadRegisters::isSucceeded(ModbusReadItem item)
+{
+    for (ModbusReadItem succeededItem : qAsConst(_succeededList))
+    {
+        if (
+            (succeededItem.address() == item.address())
+            && (succeededItem.count() == item.count())
+        )
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*!
+ * Check whether a single read that contains both registers succeeded during current read
+ * \param firstRegister    First register
+ * \param lastRegister     Last register (same as first register to check a single register)
+ * \return true when a succeeded read contains both registers
+ */
+bool ReadRegisters::isReadSucceeded(ModbusAddress firstRegister, ModbusAddress lastRegister)
+{
+    for (ModbusReadItem succeededItem : qAsConst(_succeededList))
+    {
+        if (
+            !(firstRegister < succeededItem.address())
+            && (lastRegister < succeededItem.address().next(succeededItem.count()))
+        )
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+ReadRegisters::LearnedLimit ReadRegisters::newLimit() const
+{
+    return LearnedLimit{1, cFirstProbeBackoff, _readCycle + cFirstProbeBackoff};
+}
+
+/*!
+ * Limit that is known from an earlier session
+ */
+ReadRegisters::LearnedLimit ReadRegisters::confirmedLimit() const
+{
+    return LearnedLimit{cPersistConfirmCount, cMaxProbeBackoff, _readCycle + cMaxProbeBackoff};
+}
+
+/*!
+ * Limit is learned again, so wait longer before probing it again
+ */
+void ReadRegisters::confirmLimit(LearnedLimit& limit) const
+{
+    limit.confirmCount++;
+    limit.backoff = qMin(limit.backoff * 2, cMaxProbeBackoff);
+    limit.probeCycle = _readCycle + limit.backoff;
+}
+
+/*!
+ * Check whether limit is left out of the current read to probe it
+ */
+bool ReadRegisters::isProbed(const LearnedLimit& limit) const
+{
+    return limit.probeCycle <= _readCycle;
+}
+
+/*!
+ * Add learned limit or confirm it when it is already known
+ * \param limitMap    Map with limits of the same kind
+ * \param address     Address of limit
+ * \return true when limit is new
+ */
+bool ReadRegisters::learnLimit(QMap<ModbusAddress, LearnedLimit>& limitMap, ModbusAddress address)
+{
+    auto it = limitMap.find(address);
+    if (it == limitMap.end())
+    {
+        limitMap.insert(address, newLimit());
+        return true;
+    }
+
+    confirmLimit(it.value());
+    return false;
+}
+
+/*!
+ * Add learned maximum number of registers in a single read or confirm it
+ * A larger count confirms the known maximum, a smaller count replaces it.
+ * \param count       Number of registers that is known to succeed
+ * \return true when maximum is new
+ */
+bool ReadRegisters::learnBlockSize(quint16 count)
+{
+    if (
+        (_maxBlockSize == 0)
+        || (count < _maxBlockSize)
+    )
+    {
+        _maxBlockSize = count;
+        _blockSizeLimit = newLimit();
+        return true;
+    }
+
+    confirmLimit(_blockSizeLimit);
+    return false;
+}
+
+/*!
+ * Forget probed limits that didn't stop the current read from succeeding
+ * Probed limits that weren't part of any read are probed again in the next read.
+ * \return true when a limit is forgotten
+ */
+bool ReadRegisters::forgetDisprovedLimits()
+{
+    bool bChanged = false;
+
+    auto unreadableIt = _unreadableMap.begin();
+    while (unreadableIt != _unreadableMap.end())
+    {
+        if (
+            isProbed(unreadableIt.value())
+            && isReadSucceeded(unreadableIt.key(), unreadableIt.key())
+        )
+        {
+            unreadableIt = _unreadableMap.erase(unreadableIt);
+            bChanged = true;
+        }
+        else
+        {
+            ++unreadableIt;
+        }
+    }
+
+    auto boundaryIt = _boundaryMap.begin();
+    while (boundaryIt != _boundaryMap.end())
+    {
+        if (
+            isProbed(boundaryIt.value())
+            && isReadSucceeded(boundaryIt.key().next(-1), boundaryIt.key())
+        )
+        {
+            boundaryIt = _boundaryMap.erase(boundaryIt);
+            bChanged = true;
+        }
+        else
+        {
+            ++boundaryIt;
+        }
+    }
+
+    if (
+        (_maxBlockSize > 0)
+        && isProbed(_blockSizeLimit)
+        && (_largestSuccess > _maxBlockSize)
+    )
+    {
+        _maxBlockSize = 0;
+        bChanged = true;
+    }
+
+    return bChanged;
+}
+
+/*!
+ * Build read capability for the next read from the learned limits that aren't probed
+ */
+void ReadRegisters::updateCapability()
+{
+    _capability.clear();
+
+    for (auto it = _unreadableMap.constBegin(); it != _unreadableMap.constEnd(); ++it)
+    {
+        if (!isProbed(it.value()))
+        {
+            _capability.addUnreadable(it.key());
+        }
+    }
+
+    for (auto it = _boundaryMap.constBegin(); it != _boundaryMap.constEnd(); ++it)
+    {
+        if (!isProbed(it.value()))
+        {
+            _capability.addBoundary(it.key());
+        }
+    }
+
+    if (
+        (_maxBlockSize > 0)
+        && !isProbed(_blockSizeLimit)
+    )
+    {
+        _capability.limitBlockSize(_maxBlockSize);
+    }
+}
+
+/*!
+ * Find index of in flight item with start register
+ * \param startRegister     Start register address
+ * \retval -1       Not found
+ * \retval != -1    Index in in flight list
+ */
+qint32 ReadRegisters::findInFlight(ModbusAddress startRegister)
+{
+    for (qint32 idx = 0; idx < _inFlightList.size(); idx++)
+    {
+        if (_inFlightList[idx].address() == startRegister)
+        {
+            return idx;
+        }
+    }
+
+    return -1;
+}
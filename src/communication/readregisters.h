@@ -2,8 +2,10 @@
 #define READREGISTERCOLLECTION_H
 
 #include <QObject>
+#include <QMap>
 
 #include "modbusresultmap.h"
+#include "readcapability.h"
 
 class ModbusReadItem
 {
@@ -28,25 +30,102 @@ class ReadRegisters
 public:
     ReadRegisters();
 
-    void resetRead(QList<ModbusAddress> registerList, quint16 consecutiveMax);
+    void setCapability(const ReadCapability& capability);
+    void resetRead(QList<ModbusAddress> registerList, quint16 consecutiveMax, quint16 maxGap = 0);
+    void clearUnbridgeableGaps();
 
     bool hasNext();
     ModbusReadItem next();
+    ModbusReadItem takeNext();
 
-    void addSuccess(ModbusAddress startRegister, QList<quint16> registerDataList);
+    qint32 inFlightCount();
+    bool isInFlight(ModbusAddress startRegister);
+
+    void addSuccess(ModbusAddress startRegister, QList<quint16> registerDataList, qint64 timestamp = 0);
     void addError();
+    void addError(ModbusAddress startRegister);
     void addAllErrors();
     void splitNextToSingleReads();
+    void splitToSingleReads(ModbusAddress startRegister);
+    void bisectRead(ModbusAddress startRegister);
+
+    bool learnCapability();
+    const ReadCapability& capability() const;
+    ReadCapability persistentCapability() const;
 
     ModbusResultMap resultMap();
 
 private:
 
+    /* Refused read and the halves it was split in */
+    typedef struct
+    {
+        ModbusReadItem parent;
+        ModbusReadItem low;
+        ModbusReadItem high;
+    } SplitRead;
+
+    /* Learned limit of device, re-probed after back-off number of reads */
+    typedef struct
+    {
+        quint32 confirmCount;
+        quint32 backoff;
+        quint64 probeCycle;
+    } LearnedLimit;
+
+    /* Number of reads before a new limit is probed, doubled on every confirmation */
+    static constexpr quint32 cFirstProbeBackoff = 8;
+    static constexpr quint32 cMaxProbeBackoff = 1024;
+
+    /* Number of times a limit is learned before it is stored in the project file */
+    static constexpr quint32 cPersistConfirmCount = 3;
+
+    void addItemValues(ModbusReadItem item, const QList<quint16>& registerDataList, qint64 timestamp);
+    void addItemError(ModbusReadItem item);
+    qint32 requestedRunEnd(ModbusReadItem item, qint32 start);
+    void prependSingleReads(ModbusReadItem item);
+    qint32 findInFlight(ModbusAddress startRegister);
+    bool isRequested(ModbusAddress registerAddr);
+    bool isGapUnbridgeable(ModbusAddress lowRegister, ModbusAddress highRegister);
+    bool isSucceeded(ModbusReadItem item);
+    bool isReadSucceeded(ModbusAddress firstRegister, ModbusAddress lastRegister);
+
+    LearnedLimit newLimit() const;
+    LearnedLimit confirmedLimit() const;
+    void confirmLimit(LearnedLimit& limit) const;
+    bool isProbed(const LearnedLimit& limit) const;
+    bool learnLimit(QMap<ModbusAddress, LearnedLimit>& limitMap, ModbusAddress address);
+    bool learnBlockSize(quint16 count);
+    bool forgetDisprovedLimits();
+    void updateCapability();
 
     QList<ModbusReadItem> _readItemList;
+    QList<ModbusReadItem> _inFlightList;
+    QList<ModbusAddress> _registerList;
+
+    /* Gap registers that were refused by the device, learned by learnCapability() */
+    QList<ModbusAddress> _unbridgeableList;
 
     ModbusResultMap _resultMap;
 
+    /* Read capability of device that is used for the next read, built from the learned limits */
+    ReadCapability _capability;
+
+    /* Learned limits of device, limits that are probed are left out of _capability */
+    QMap<ModbusAddress, LearnedLimit> _unreadableMap;
+    QMap<ModbusAddress, LearnedLimit> _boundaryMap;
+    quint16 _maxBlockSize{};
+    LearnedLimit _blockSizeLimit{};
+
+    /* Number of reads that are learned from */
+    quint64 _readCycle{};
+
+    /* Observations of current read, used to learn read capability */
+    QList<SplitRead> _splitList;
+    QList<ModbusReadItem> _succeededList;
+    QList<ModbusAddress> _refusedList;
+    qint32 _largestSuccess{};
+
 };
 
 #endif // READREGISTERCOLLECTION_H
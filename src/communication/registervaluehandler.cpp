@@ -1,22 +1,37 @@
 #include "registervaluehandler.h"
 #include "modbusaddress.h"
-#include "settingsmodel.h"
 #include "modbusdatatype.h"
+#include "connectiontypes.h"
+
+#include <algorithm> // std::sort, std::unique, std::lower_bound
 
 using State = ResultState::State;
 
-RegisterValueHandler::RegisterValueHandler(SettingsModel *pSettingsModel) :
-    _pSettingsModel(pSettingsModel)
+RegisterValueHandler::RegisterValueHandler(QObject *parent) :
+    QObject(parent)
 {
 }
 
-void RegisterValueHandler::startRead()
+/*!
+ * Prepare for read cycle
+ * Registers that aren't due in this cycle are not read and have no value in the result
+ * \param dueList  Due flag per register (empty when all registers are due)
+ */
+void RegisterValueHandler::startRead(QList<bool> dueList)
 {
+    _dueList = dueList;
     _resultList.clear();
 
-    for(quint16 listIdx = 0; listIdx < _registerList.size(); listIdx++)
+    for(qint32 listIdx = 0; listIdx < _registerList.size(); listIdx++)
     {
-        _resultList.append(ResultDouble(0, State::INVALID));
+        if (isDue(listIdx))
+        {
+            _resultList.append(ResultDouble(0, State::INVALID));
+        }
+        else
+        {
+            _resultList.append(ResultDouble(0, State::NO_VALUE));
+        }
     }
 }
 
@@ -25,86 +40,303 @@ void RegisterValueHandler::finishRead()
     emit registerDataReady(_resultList);
 }
 
-void RegisterValueHandler::processPartialResult(ModbusResultMap partialResultMap, quint8 connectionId)
+/*!
+ * Prepare for read cycle of a single connection
+ * Results of the other connections are not touched, so connections can be read independently
+ * \param connectionId     Connection id
+ * \param dueList          Due flag per register (only used for registers of this connection)
+ */
+void RegisterValueHandler::startConnectionRead(quint8 connectionId, QList<bool> dueList)
 {
-    for(qint32 listIdx = 0; listIdx < _registerList.size(); listIdx++)
+    if (_resultList.size() != _registerList.size())
     {
-        const ModbusRegister mbReg = _registerList[listIdx];
+        _resultList = ResultDoubleList(_registerList.size());
+    }
 
-        if (
-            (mbReg.connectionId() == connectionId)
-            && (partialResultMap.contains(mbReg.address()))
-            )
-        {
-            Result<quint16> upperRegister;
-            Result<quint16> lowerRegister;
+    if (_dueList.size() != _registerList.size())
+    {
+        _dueList = QList<bool>(_registerList.size(), true);
+    }
 
-            lowerRegister = partialResultMap.value(mbReg.address());
+    for(qint32 listIdx = 0; listIdx < _registerList.size(); listIdx++)
+    {
+        if (_registerList[listIdx].connectionId() == connectionId)
+        {
+            _dueList[listIdx] = listIdx < dueList.size() ? dueList[listIdx] : true;
 
-            if (ModbusDataType::is32Bit(mbReg.type()))
+            if (_dueList[listIdx])
             {
-                const auto addr = mbReg.address().next();
-                if (partialResultMap.contains(addr))
-                {
-                    upperRegister = partialResultMap.value(addr);
-                }
+                _resultList[listIdx] = ResultDouble(0, State::INVALID);
             }
             else
             {
-                /* Dummy valid value */
-                upperRegister = Result<quint16>(0, State::SUCCESS);
+                _resultList[listIdx] = ResultDouble(0, State::NO_VALUE);
             }
+        }
+    }
+}
 
-            bool bSuccess = lowerRegister.isValid() && upperRegister.isValid();
-            ResultDouble result;
-            if (bSuccess)
-            {
-                double processedResult = mbReg.processValue(lowerRegister.value(), upperRegister.value(), _pSettingsModel->int32LittleEndian(connectionId));
-                result.setValue(processedResult);
-            }
-            else
-            {
-                result.setError();
-            }
+/*!
+ * Finish read cycle of a single connection
+ * Only results of this connection are reported, other registers have no value
+ */
+void RegisterValueHandler::finishConnectionRead(quint8 connectionId)
+{
+    ResultDoubleList connectionResults;
 
-            _resultList[listIdx] = result;
+    for(qint32 listIdx = 0; listIdx < _registerList.size(); listIdx++)
+    {
+        if (_registerList[listIdx].connectionId() == connectionId)
+        {
+            connectionResults.append(_resultList[listIdx]);
+        }
+        else
+        {
+            connectionResults.append(ResultDouble(0, State::NO_VALUE));
         }
     }
+
+    emit registerDataReady(connectionResults);
 }
 
-// Get sorted list of active (unique) register addresses for a specific connection id
+/*!
+ * Process results of a connection
+ * The results are decoded once in the slot arrays of the connection, every register then
+ * takes its words from the precomputed slots.
+ * \param partialResultMap     Results of the connection
+ * \param connectionId         Connection id
+ */
+void RegisterValueHandler::processPartialResult(const ModbusResultMap& partialResultMap, quint8 connectionId)
+{
+    if (connectionId >= _connectionPlans.size())
+    {
+        return;
+    }
+
+    ConnectionPlan& plan = _connectionPlans[connectionId];
+
+    decodeResults(partialResultMap, plan);
+
+    const bool bInt32LittleEndian = plan.bInt32LittleEndian;
+
+    for (const RegisterRoute& route : qAsConst(plan.routeList))
+    {
+        const quint8 lowerState = plan.slotStates[route.lowerSlot];
+
+        if (
+            (lowerState == SLOT_ABSENT)
+            || !isDue(route.registerIdx)
+            )
+        {
+            continue;
+        }
+
+        /* 16 bit registers have a dummy valid upper word */
+        quint8 upperState = SLOT_VALID;
+        quint16 upperValue = 0;
+        qint64 upperTimestamp = 0;
+        if (route.upperSlot >= 0)
+        {
+            upperState = plan.slotStates[route.upperSlot];
+            upperValue = plan.slotValues[route.upperSlot];
+            upperTimestamp = plan.slotTimestamps[route.upperSlot];
+        }
+
+        ResultDouble result;
+        if (
+            (lowerState == SLOT_VALID)
+            && (upperState == SLOT_VALID)
+            )
+        {
+            const ModbusRegister& mbReg = _registerList[route.registerIdx];
+            result.setValue(mbReg.processValue(plan.slotValues[route.lowerSlot], upperValue, bInt32LittleEndian));
+
+            /* Value is complete when last part has arrived */
+            result.setTimestamp(qMax(plan.slotTimestamps[route.lowerSlot], upperTimestamp));
+        }
+        else
+        {
+            result.setError();
+        }
+
+        _resultList[route.registerIdx] = result;
+    }
+}
+
+/*!
+ * Get sorted list of active (unique) register addresses for a specific connection id
+ * The address table is precomputed, only the registers that aren't due are filtered out.
+ */
 void RegisterValueHandler::registerAddresList(QList<ModbusAddress>& registerList, quint8 connectionId)
 {
-    QList<ModbusAddress> connRegisterList;
+    registerList.clear();
+
+    if (connectionId >= _connectionPlans.size())
+    {
+        return;
+    }
+
+    const ConnectionPlan& plan = _connectionPlans[connectionId];
 
-    foreach(ModbusRegister mbReg, _registerList)
+    bool bAllDue = true;
+    for (const RegisterRoute& route : plan.routeList)
     {
-        if (mbReg.connectionId() == connectionId)
+        if (!isDue(route.registerIdx))
         {
-            if (!connRegisterList.contains(mbReg.address()))
-            {
-                connRegisterList.append(mbReg.address());
-            }
+            bAllDue = false;
+            break;
+        }
+    }
 
-            /* When reading 32 bit value, also read next address */
-            if (ModbusDataType::is32Bit(mbReg.type()))
+    if (bAllDue)
+    {
+        registerList = plan.addressList;
+    }
+    else
+    {
+        QVector<bool> slotUsed(plan.addressList.size(), false);
+        for (const RegisterRoute& route : plan.routeList)
+        {
+            if (isDue(route.registerIdx))
             {
-                const auto reg = mbReg.address().next();
-                if (!connRegisterList.contains(reg))
+                slotUsed[route.lowerSlot] = true;
+                if (route.upperSlot >= 0)
                 {
-                    connRegisterList.append(reg);
+                    slotUsed[route.upperSlot] = true;
                 }
             }
         }
+
+        for (qint32 slot = 0; slot < slotUsed.size(); slot++)
+        {
+            if (slotUsed[slot])
+            {
+                registerList.append(plan.addressList[slot]);
+            }
+        }
     }
+}
+
+void RegisterValueHandler::setRegisters(QList<ModbusRegister>& registerList, const CommunicationSettings& settings)
+{
+    _registerList = registerList;
+    _dueList.clear();
 
-    // sort qList
-    std::sort(connRegisterList.begin(), connRegisterList.end(), std::less<ModbusAddress>());
+    compilePlans(settings);
+}
 
-    registerList = connRegisterList;
+bool RegisterValueHandler::isDue(qint32 registerIdx)
+{
+    if (registerIdx < _dueList.size())
+    {
+        return _dueList[registerIdx];
+    }
+    else
+    {
+        return true;
+    }
 }
 
-void RegisterValueHandler::setRegisters(QList<ModbusRegister>& registerList)
+/*!
+ * Compile routing plan of every connection
+ * Builds the sorted address table of each connection and the slots of the words of every register.
+ */
+void RegisterValueHandler::compilePlans(const CommunicationSettings& settings)
 {
-    _registerList = registerList;
+    _connectionPlans = QList<ConnectionPlan>(Connection::ID_CNT);
+
+    for (qint32 listIdx = 0; listIdx < _registerList.size(); listIdx++)
+    {
+        const ModbusRegister& mbReg = _registerList[listIdx];
+        if (mbReg.connectionId() >= _connectionPlans.size())
+        {
+            _connectionPlans.resize(mbReg.connectionId() + 1);
+        }
+
+        QList<ModbusAddress>& addressList = _connectionPlans[mbReg.connectionId()].addressList;
+
+        addressList.append(mbReg.address());
+
+        /* When reading 32 bit value, also read next address */
+        if (ModbusDataType::is32Bit(mbReg.type()))
+        {
+            addressList.append(mbReg.address().next());
+        }
+    }
+
+    for (qint32 connectionId = 0; connectionId < _connectionPlans.size(); connectionId++)
+    {
+        ConnectionPlan& plan = _connectionPlans[connectionId];
+
+        plan.bInt32LittleEndian = settings.connection(static_cast<quint8>(connectionId)).bInt32LittleEndian;
+
+        std::sort(plan.addressList.begin(), plan.addressList.end(), std::less<ModbusAddress>());
+        plan.addressList.erase(std::unique(plan.addressList.begin(), plan.addressList.end()), plan.addressList.end());
+
+        plan.slotValues = QVector<quint16>(plan.addressList.size(), 0);
+        plan.slotStates = QVector<quint8>(plan.addressList.size(), SLOT_ABSENT);
+        plan.slotTimestamps = QVector<qint64>(plan.addressList.size(), 0);
+    }
+
+    for (qint32 listIdx = 0; listIdx < _registerList.size(); listIdx++)
+    {
+        const ModbusRegister& mbReg = _registerList[listIdx];
+        ConnectionPlan& plan = _connectionPlans[mbReg.connectionId()];
+
+        auto slotOf = [&plan](const ModbusAddress& address) {
+            return static_cast<qint32>(std::lower_bound(plan.addressList.constBegin(), plan.addressList.constEnd(), address) - plan.addressList.constBegin());
+        };
+
+        RegisterRoute route;
+        route.registerIdx = listIdx;
+        route.lowerSlot = slotOf(mbReg.address());
+        route.upperSlot = ModbusDataType::is32Bit(mbReg.type()) ? slotOf(mbReg.address().next()) : -1;
+
+        plan.routeList.append(route);
+    }
+}
+
+/*!
+ * Decode results in the slot arrays of the connection
+ * Both the result blocks and the address table are sorted, every block maps to a range of slots.
+ */
+void RegisterValueHandler::decodeResults(const ModbusResultMap& partialResultMap, ConnectionPlan& plan)
+{
+    plan.slotStates.fill(SLOT_ABSENT);
+
+    qint32 slot = 0;
+    for (const ModbusResultMap::Block& block : partialResultMap.blocks())
+    {
+        const quint32 blockStart = block.address.address(ModbusAddress::Offset::WITHOUT_OFFSET);
+
+        /* Skip addresses before block */
+        while (
+            (slot < plan.addressList.size())
+            && (plan.addressList[slot] < block.address)
+            )
+        {
+            slot++;
+        }
+
+        /* Addresses of block that aren't used by a register (e.g. bridged gap) are skipped */
+        while (slot < plan.addressList.size())
+        {
+            const ModbusAddress& address = plan.addressList[slot];
+            const quint32 idx = address.address(ModbusAddress::Offset::WITHOUT_OFFSET) - blockStart;
+
+            if (
+                (address.objectType() != block.address.objectType())
+                || (idx >= static_cast<quint32>(block.count))
+                )
+            {
+                break;
+            }
+
+            plan.slotValues[slot] = partialResultMap.blockValue(block, static_cast<qint32>(idx));
+            plan.slotStates[slot] = partialResultMap.isBlockValueValid(block, static_cast<qint32>(idx)) ? SLOT_VALID : SLOT_INVALID;
+            plan.slotTimestamps[slot] = block.timestamp;
+
+            slot++;
+        }
+    }
 }
@@ -2,35 +2,75 @@
 #define REGISTERVALUEHANDLER_H
 
 #include <QObject>
+#include <QVector>
 
 #include "modbusresultmap.h"
 #include "modbusregister.h"
-
-class SettingsModel;
+#include "communicationsettings.h"
 
 class RegisterValueHandler : public QObject
 {
     Q_OBJECT
 public:
 
-    explicit RegisterValueHandler(SettingsModel *pSettingsModel);
+    explicit RegisterValueHandler(QObject *parent = nullptr);
 
-    void setRegisters(QList<ModbusRegister> &registerList);
+    void setRegisters(QList<ModbusRegister> &registerList, const CommunicationSettings& settings);
 
-    void startRead();
-    void processPartialResult(ModbusResultMap partialResultMap, quint8 connectionId);
+    void startRead(QList<bool> dueList = QList<bool>());
+    void processPartialResult(const ModbusResultMap& partialResultMap, quint8 connectionId);
     void finishRead();
 
+    void startConnectionRead(quint8 connectionId, QList<bool> dueList);
+    void finishConnectionRead(quint8 connectionId);
+
     void registerAddresList(QList<ModbusAddress>& registerList, quint8 connectionId);
 
 signals:
     void registerDataReady(ResultDoubleList registers);
 
 private:
-    SettingsModel* _pSettingsModel;
+
+    /* Precomputed location of the words of a register in the address table of its connection */
+    typedef struct
+    {
+        qint32 registerIdx;
+        qint32 lowerSlot;
+        qint32 upperSlot; /* -1 for 16 bit registers */
+    } RegisterRoute;
+
+    typedef enum
+    {
+        SLOT_ABSENT = 0,
+        SLOT_VALID,
+        SLOT_INVALID
+    } SlotState;
+
+    /*!
+     * Routing plan of a connection, compiled once in setRegisters()
+     * Every unique address of the connection has a slot, the words of a result are decoded in
+     * contiguous arrays indexed by slot.
+     */
+    typedef struct
+    {
+        QList<ModbusAddress> addressList; /* Sorted, unique */
+        QList<RegisterRoute> routeList;
+        bool bInt32LittleEndian;
+
+        QVector<quint16> slotValues;
+        QVector<quint8> slotStates;
+        QVector<qint64> slotTimestamps;
+    } ConnectionPlan;
+
+    bool isDue(qint32 registerIdx);
+    void compilePlans(const CommunicationSettings& settings);
+    void decodeResults(const ModbusResultMap& partialResultMap, ConnectionPlan& plan);
 
     QList<ModbusRegister> _registerList;
+    QList<bool> _dueList;
     ResultDoubleList _resultList;
+
+    QList<ConnectionPlan> _connectionPlans;
 };
 
 #endif // REGISTERVALUEHANDLER_H
@@ -0,0 +1,133 @@
+#include "samplequeue.h"
+#include "sampleclock.h"
+#include "scopelogging.h"
+
+/*!
+ * Hand-off of samples between communication thread and gui thread
+ * Samples are collected while the gui thread is busy and are taken in a single batch.
+ * The queue is lock-free: samples must be added from a single thread and taken from a single thread.
+ * When the queue is full, new samples are dropped. Dropped samples never reach the plot or the
+ * data log that is written during logging, the loss is reported by the consuming thread.
+ */
+SampleQueue::SampleQueue(QObject *parent) :
+    SampleQueue(SampleRingBuffer::cDefaultCapacity, parent)
+{
+
+}
+
+/*!
+ * Constructor
+ * \param capacity      Maximum number of queued samples, extra samples are dropped
+ */
+SampleQueue::SampleQueue(quint32 capacity, QObject *parent) :
+    QObject(parent), _ringBuffer(capacity), _bNotifyPending(false), _reportedDropCount(0)
+{
+
+}
+
+/*!
+ * Take all queued samples
+ * Must only be called from the consuming thread
+ * \param timestampList     Receives timestamp (ms since epoch) of each sample
+ * \param resultLists       Receives results of each sample
+ */
+void SampleQueue::takeSamples(QList<double>& timestampList, QList<ResultDoubleList>& resultLists)
+{
+    timestampList.clear();
+    resultLists.clear();
+
+    /* Re-arm notification before taking, so a sample added meanwhile is never missed */
+    _bNotifyPending.store(false);
+
+    _ringBuffer.pop(timestampList, resultLists);
+
+    reportDroppedSamples(false);
+}
+
+/*!
+ * Return number of queued samples
+ */
+qint32 SampleQueue::count()
+{
+    return static_cast<qint32>(_ringBuffer.size());
+}
+
+/*!
+ * Return number of samples dropped because the consumer couldn't keep up
+ */
+quint64 SampleQueue::droppedCount()
+{
+    return _ringBuffer.droppedCount();
+}
+
+/*!
+ * Report samples that were dropped since previous report
+ * Drops are reported at most once per interval, so a full queue doesn't flood the log.
+ * Must only be called from the consuming thread
+ * \param bForce    Report immediately, regardless of interval (for example at end of logging)
+ */
+void SampleQueue::reportDroppedSamples(bool bForce)
+{
+    const quint64 dropCount = _ringBuffer.droppedCount();
+
+    if (dropCount == _reportedDropCount)
+    {
+        // Nothing dropped since previous report
+    }
+    else if (
+        bForce
+        || !_dropReportTimer.isValid()
+        || _dropReportTimer.hasExpired(cDropReportInterval)
+    )
+    {
+        qCWarning(scopeComm) << QString("Sample queue full, %1 samples dropped, they are missing in plot and data log (total: %2)")
+                                .arg(dropCount - _reportedDropCount)
+                                .arg(dropCount);
+
+        _reportedDropCount = dropCount;
+        _dropReportTimer.start();
+    }
+    else
+    {
+        // Wait for end of interval
+    }
+}
+
+/*!
+ * Add sample, time stamped with arrival of the most recent reply
+ * Current time is used when none of the results has a timestamp
+ * \param resultList    Results of sample
+ */
+void SampleQueue::addSample(ResultDoubleList resultList)
+{
+    qint64 timestamp = 0;
+    for (const auto &result: qAsConst(resultList))
+    {
+        timestamp = qMax(timestamp, result.timestamp());
+    }
+
+    if (timestamp == 0)
+    {
+        timestamp = SampleClock::timestamp();
+    }
+
+    addTimedSample(SampleClock::toEpochMsecs(timestamp), resultList);
+}
+
+/*!
+ * Add sample to queue
+ * Must only be called from the producing thread. \ref samplesAvailable is only emitted once until
+ * the samples are taken, so a busy receiver isn't flooded with notifications.
+ * \param timestamp     Timestamp of sample (ms since epoch)
+ * \param resultList    Results of sample
+ */
+void SampleQueue::addTimedSample(double timestamp, ResultDoubleList resultList)
+{
+    /* Dropped samples are counted by ring buffer and reported by consumer */
+    _ringBuffer.push(timestamp, resultList);
+
+    if (!_bNotifyPending.exchange(true))
+    {
+        emit samplesAvailable();
+    }
+}
@@ -0,0 +1,42 @@
+#ifndef SAMPLEQUEUE_H
+#define SAMPLEQUEUE_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <atomic>
+
+#include "result.h"
+#include "sampleringbuffer.h"
+
+class SampleQueue : public QObject
+{
+    Q_OBJECT
+public:
+    explicit SampleQueue(QObject *parent = nullptr);
+    explicit SampleQueue(quint32 capacity, QObject *parent = nullptr);
+
+    void takeSamples(QList<double>& timestampList, QList<ResultDoubleList>& resultLists);
+    qint32 count();
+    quint64 droppedCount();
+    void reportDroppedSamples(bool bForce);
+
+public slots:
+    void addSample(ResultDoubleList resultList);
+    void addTimedSample(double timestamp, ResultDoubleList resultList);
+
+signals:
+    void samplesAvailable();
+
+private:
+
+    SampleRingBuffer _ringBuffer;
+    std::atomic<bool> _bNotifyPending;
+
+    /* Only used by consuming thread */
+    quint64 _reportedDropCount;
+    QElapsedTimer _dropReportTimer;
+
+    static const qint64 cDropReportInterval = 5000;
+};
+
+#endif // SAMPLEQUEUE_H
@@ -0,0 +1,110 @@
+
+#include "sampleringbuffer.h"
+
+/*!
+ * Constructor
+ * \param capacity      Maximum number of queued samples, rounded up to a power of two
+ */
+SampleRingBuffer::SampleRingBuffer(quint32 capacity) :
+    _ring(qMax(capacity, 2u), 1),
+    _droppedCount(0)
+{
+
+}
+
+/*!
+ * Add sample to buffer
+ * Must only be called from the producer thread. The sample is dropped when the buffer is full,
+ * the producer never waits on the consumer.
+ * \param timestamp     Timestamp of sample
+ * \param resultList    Results of sample
+ * \return true when sample is added, false when buffer is full
+ */
+bool SampleRingBuffer::push(double timestamp, const ResultDoubleList& resultList)
+{
+    Cell* pRow = nullptr;
+
+    /* Column count can only change when all queued samples are taken */
+    if (_ring.setStride(static_cast<qint32>(resultList.size()) + 1))
+    {
+        pRow = _ring.pushSlot();
+    }
+
+    if (pRow == nullptr)
+    {
+        _droppedCount.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    pRow[0].value = timestamp;
+    for (qsizetype col = 0; col < resultList.size(); col++)
+    {
+        pRow[col + 1].value = resultList[col].value();
+        pRow[col + 1].state = static_cast<quint8>(resultList[col].state());
+    }
+
+    _ring.commitPush();
+
+    return true;
+}
+
+/*!
+ * Take all samples from buffer
+ * Must only be called from the consumer thread
+ * \param timestampList     Samples timestamps are appended to this list
+ * \param resultLists       Sample results are appended to this list
+ * \return Number of samples taken
+ */
+qint32 SampleRingBuffer::pop(QList<double>& timestampList, QList<ResultDoubleList>& resultLists)
+{
+    const quint32 count = _ring.size();
+
+    if (count > 0)
+    {
+        const qint32 columnCount = _ring.stride() - 1;
+
+        timestampList.reserve(timestampList.size() + count);
+        resultLists.reserve(resultLists.size() + count);
+
+        for (quint32 idx = 0; idx < count; idx++)
+        {
+            const Cell* pRow = _ring.peek(idx);
+
+            ResultDoubleList resultList;
+            resultList.reserve(columnCount);
+            for (qint32 col = 0; col < columnCount; col++)
+            {
+                resultList.append(ResultDouble(pRow[col + 1].value, static_cast<ResultState::State>(pRow[col + 1].state)));
+            }
+
+            timestampList.append(pRow[0].value);
+            resultLists.append(resultList);
+        }
+
+        _ring.commitPop(count);
+    }
+
+    return static_cast<qint32>(count);
+}
+
+/*!
+ * Return number of queued samples
+ * Can be called from any thread, the result is only a snapshot.
+ */
+quint32 SampleRingBuffer::size() const
+{
+    return _ring.size();
+}
+
+quint32 SampleRingBuffer::capacity() const
+{
+    return _ring.capacity();
+}
+
+/*!
+ * Return number of samples that were dropped because the buffer was full
+ */
+quint64 SampleRingBuffer::droppedCount() const
+{
+    return _droppedCount.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,43 @@
+#ifndef SAMPLERINGBUFFER_H
+#define SAMPLERINGBUFFER_H
+
+#include <QtGlobal>
+#include <atomic>
+
+#include "result.h"
+#include "spscring.h"
+
+/*!
+ * Fixed capacity ring buffer of samples
+ * One producer and one consumer thread can access the buffer at the same time without locking.
+ */
+class SampleRingBuffer
+{
+public:
+    explicit SampleRingBuffer(quint32 capacity = cDefaultCapacity);
+
+    bool push(double timestamp, const ResultDoubleList& resultList);
+    qint32 pop(QList<double>& timestampList, QList<ResultDoubleList>& resultLists);
+
+    quint32 size() const;
+    quint32 capacity() const;
+    quint64 droppedCount() const;
+
+    static const quint32 cDefaultCapacity = 16384;
+
+private:
+    Q_DISABLE_COPY(SampleRingBuffer)
+
+    /* A row holds the timestamp in its first cell, followed by one cell per column */
+    typedef struct
+    {
+        double value;
+        quint8 state;
+    } Cell;
+
+    SpscRing<Cell> _ring;
+
+    std::atomic<quint64> _droppedCount;
+};
+
+#endif // SAMPLERINGBUFFER_H
@@ -53,6 +53,8 @@ void ConnectionForm::setState(bool bEnabled)
     _pUi->spinSlaveId->setEnabled(bEnabled);
     _pUi->spinTimeout->setEnabled(bEnabled);
     _pUi->spinConsecutiveMax->setEnabled(bEnabled);
+    _pUi->spinMaxGap->setEnabled(bEnabled);
+    _pUi->spinPipelineDepth->setEnabled(bEnabled);
     _pUi->checkInt32LittleEndian->setEnabled(bEnabled);
     _pUi->checkPersistentConn->setEnabled(bEnabled);
 
@@ -80,6 +82,8 @@ void ConnectionForm::fillSettingsModel(SettingsModel* pSettingsModel, quint8 con
     pSettingsModel->setSlaveId(connectionId, _pUi->spinSlaveId->value());
     pSettingsModel->setTimeout(connectionId, _pUi->spinTimeout->value());
     pSettingsModel->setConsecutiveMax(connectionId, _pUi->spinConsecutiveMax->value());
+    pSettingsModel->setMaxGap(connectionId, _pUi->spinMaxGap->value());
+    pSettingsModel->setPipelineDepth(connectionId, _pUi->spinPipelineDepth->value());
     pSettingsModel->setInt32LittleEndian(connectionId, _pUi->checkInt32LittleEndian->checkState() == Qt::Checked);
     pSettingsModel->setPersistentConnection(connectionId, _pUi->checkPersistentConn->checkState() == Qt::Checked);
 
@@ -170,6 +174,16 @@ void ConnectionForm::setConsecutiveMax(quint8 max)
     _pUi->spinConsecutiveMax->setValue(max);
 }
 
+void ConnectionForm::setMaxGap(quint8 maxGap)
+{
+    _pUi->spinMaxGap->setValue(maxGap);
+}
+
+void ConnectionForm::setPipelineDepth(quint8 pipelineDepth)
+{
+    _pUi->spinPipelineDepth->setValue(pipelineDepth);
+}
+
 void ConnectionForm::setInt32LittleEndian(bool int32LittleEndian)
 {
     _pUi->checkInt32LittleEndian->setChecked(int32LittleEndian);
@@ -191,6 +205,7 @@ void ConnectionForm::enableSpecificSettings()
 
     _pUi->lineIP->setEnabled(bTcp);
     _pUi->spinPort->setEnabled(bTcp);
+    _pUi->spinPipelineDepth->setEnabled(bTcp);
     _pUi->comboPortName->setEnabled(!bTcp);
     _pUi->comboBaud->setEnabled(!bTcp);
     _pUi->comboParity->setEnabled(!bTcp);
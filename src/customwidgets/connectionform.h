@@ -32,6 +32,8 @@ public:
     void setSlaveId(quint8 id);
     void setTimeout(quint32 timeout);
     void setConsecutiveMax(quint8 max);
+    void setMaxGap(quint8 maxGap);
+    void setPipelineDepth(quint8 pipelineDepth);
     void setInt32LittleEndian(bool int32LittleEndian);
     void setPersistentConnection(bool persistentConnection);
 
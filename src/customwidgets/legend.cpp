@@ -164,7 +164,21 @@ void Legend::legendCellDoubleClicked(int row, int column)
 
 void Legend::addLastReceivedDataToLegend(ResultDoubleList resultList)
 {
-    _lastReceivedList = resultList;
+    if (resultList.size() == _lastReceivedList.size())
+    {
+        /* Graphs that weren't read in this sample (e.g. other connection) keep their last value */
+        for (qint32 idx = 0; idx < resultList.size(); idx++)
+        {
+            if (resultList[idx].state() != State::NO_VALUE)
+            {
+                _lastReceivedList[idx] = resultList[idx];
+            }
+        }
+    }
+    else
+    {
+        _lastReceivedList = resultList;
+    }
 
     updateDataInLegend();
 }
@@ -1,8 +1,6 @@
-
-#include <limits>
-
 #include "guimodel.h"
 #include "graphdatamodel.h"
+#include "lazydatasource.h"
 
 #include "util.h"
 #include "markerinfoitem.h"
@@ -68,30 +66,29 @@ void MarkerInfoItem::updateData()
         return;
     }
 
-    QSharedPointer<QCPGraphDataContainer> dataMap = _pGraphDataModel->dataMap(graphIdx);
-
-    if (dataMap->isEmpty())
+    if (!hasData(graphIdx))
     {
         return;
     }
 
     QStringList expressionList;
     const quint32 mask = _pGuiModel->markerExpressionMask();
+    const GraphDataIndex::Statistics statistics = calculateMarkerStatistics();
 
     for(qint32 idx = 0; idx < GuiModel::cMarkerExpressionBits.size(); idx++)
     {
         if (mask & GuiModel::cMarkerExpressionBits[idx])
         {
             QString expression = GuiModel::cMarkerExpressionStrings[idx];
-            const double expressionValue = calculateMarkerExpressionValue(GuiModel::cMarkerExpressionBits[idx]);
+            const double expressionValue = calculateMarkerExpressionValue(GuiModel::cMarkerExpressionBits[idx], statistics);
 
             expressionList.append(expression.arg(Util::formatDoubleForExport(expressionValue)));
         }
     }
 
     /* Add permanent items (y1, y2) */
-    expressionList.prepend(GuiModel::cMarkerExpressionEnd.arg(Util::formatDoubleForExport(dataMap->findBegin(_pGuiModel->endMarkerPos(), false)->value)));
-    expressionList.prepend(GuiModel::cMarkerExpressionStart.arg(Util::formatDoubleForExport(dataMap->findBegin(_pGuiModel->startMarkerPos(), false)->value)));
+    expressionList.prepend(GuiModel::cMarkerExpressionEnd.arg(Util::formatDoubleForExport(markerValue(graphIdx, _pGuiModel->endMarkerPos()))));
+    expressionList.prepend(GuiModel::cMarkerExpressionStart.arg(Util::formatDoubleForExport(markerValue(graphIdx, _pGuiModel->startMarkerPos()))));
 
     /* Construct labels data */
     const qint32 leftRowCount = expressionList.size() - expressionList.size() / 2;
@@ -211,43 +208,53 @@ void MarkerInfoItem::selectGraph(qint32 graphIndex)
     }
 }
 
-double MarkerInfoItem::calculateMarkerExpressionValue(quint32 expressionMask)
+/*!
+ * Calculate statistics of samples between markers
+ * Statistics come from the index of the graph data (or the index of the data file when it is
+ * browsed lazily), so this doesn't depend on the number of samples
+ */
+GraphDataIndex::Statistics MarkerInfoItem::calculateMarkerStatistics()
 {
-    double result = 0;
+    GraphDataIndex::Statistics statistics = {0, 0, 0, 0, 0, 0, 0};
     const qint32 graphIdx = _pGraphCombo->currentData().toInt();
 
-    if (graphIdx < 0)
+    if (
+        (graphIdx < 0)
+        || !hasData(graphIdx)
+    )
     {
-        return 0;
+        return statistics;
     }
 
-    QSharedPointer<QCPGraphDataContainer> pDataMap = _pGraphDataModel->dataMap(graphIdx);
+    /* make sure we go in ascending order */
+    const double startPos = qMin(_pGuiModel->startMarkerPos(), _pGuiModel->endMarkerPos());
+    const double endPos = qMax(_pGuiModel->startMarkerPos(), _pGuiModel->endMarkerPos());
 
-    if (pDataMap->isEmpty())
+    QSharedPointer<LazyDataSource> pSource = _pGraphDataModel->lazyDataSource();
+    if (!pSource.isNull())
     {
-        return 0;
+        return pSource->statistics(graphIdx, startPos, endPos);
     }
 
-    const double valueDiff = pDataMap->findBegin(_pGuiModel->endMarkerPos(), false)->value - pDataMap->findBegin(_pGuiModel->startMarkerPos(), false)->value;
-    const double timeDiff = _pGuiModel->endMarkerPos() - _pGuiModel->startMarkerPos();
+    return _pGraphDataModel->sampleStore()->statistics(graphIdx, startPos, endPos);
+}
 
-    QCPGraphDataContainer::const_iterator dataPoint;
-    QCPGraphDataContainer::const_iterator start;
-    QCPGraphDataContainer::const_iterator end;
+double MarkerInfoItem::calculateMarkerExpressionValue(quint32 expressionMask, const GraphDataIndex::Statistics &statistics)
+{
+    double result = 0;
+    const qint32 graphIdx = _pGraphCombo->currentData().toInt();
 
-    /* make sure we go in ascending order */
-    if (_pGuiModel->endMarkerPos() > _pGuiModel->startMarkerPos())
+    if (
+        (graphIdx < 0)
+        || !hasData(graphIdx)
+    )
     {
-        start = pDataMap->findBegin(_pGuiModel->startMarkerPos(), false);
-        end = pDataMap->findEnd(_pGuiModel->endMarkerPos(), false);
-    }
-    else
-    {
-        /* Change order */
-        start = pDataMap->findBegin(_pGuiModel->endMarkerPos());
-        end = pDataMap->findEnd(_pGuiModel->startMarkerPos());
+        return 0;
     }
 
+    const double valueDiff = markerValue(graphIdx, _pGuiModel->endMarkerPos()) - markerValue(graphIdx, _pGuiModel->startMarkerPos());
+    const double timeDiff = _pGuiModel->endMarkerPos() - _pGuiModel->startMarkerPos();
+
     if (expressionMask == GuiModel::cDifferenceMask)
     {
         result = valueDiff;
@@ -256,58 +263,71 @@ double MarkerInfoItem::calculateMarkerExpressionValue(quint32 expressionMask)
     {
         result = valueDiff / (timeDiff / 1000); // per second, TODO: round?
     }
+    else if (statistics.count == 0)
+    {
+        result = 0;
+    }
     else if (expressionMask == GuiModel::cAverageMask)
     {
-        double avg = 0;
-        quint32 count = 0;
-        for (dataPoint = start; dataPoint != end; ++dataPoint)
-        {
-            count++;
-            avg += dataPoint->value;
-        }
-
-        if (count == 0)
-        {
-            result = 0;
-        }
-        else
-        {
-            result = avg / count;
-        }
+        result = statistics.average;
     }
     else if (expressionMask == GuiModel::cMinimumMask)
     {
-        double min = std::numeric_limits<double>::max();
-
-        for (dataPoint = start; dataPoint != end; ++dataPoint)
-        {
-            if (dataPoint->value < min)
-            {
-                min = dataPoint->value;
-            }
-        }
-
-        result = min;
+        result = statistics.minimum;
     }
     else if (expressionMask == GuiModel::cMaximumMask)
     {
-        double max = std::numeric_limits<double>::lowest();
-
-        for (dataPoint = start; dataPoint != end; ++dataPoint)
-        {
-            if (dataPoint->value > max)
-            {
-                max = dataPoint->value;
-            }
-        }
-
-        result = max;
+        result = statistics.maximum;
+    }
+    else if (expressionMask == GuiModel::cStdDevMask)
+    {
+        result = statistics.standardDeviation;
+    }
+    else if (expressionMask == GuiModel::cRmsMask)
+    {
+        result = statistics.rms;
+    }
+    else if (expressionMask == GuiModel::cIntegralMask)
+    {
+        result = statistics.integral;
     }
     else
     {
         result = 0;
     }
 
-
     return result;
 }
+
+/*!
+ * Check whether graph has samples
+ * When a data file is browsed lazily, the graph only contains the visible window of the file.
+ */
+bool MarkerInfoItem::hasData(qint32 graphIdx)
+{
+    QSharedPointer<LazyDataSource> pSource = _pGraphDataModel->lazyDataSource();
+    if (!pSource.isNull())
+    {
+        return pSource->sampleCount() > 0;
+    }
+    else
+    {
+        return !_pGraphDataModel->sampleStore()->isEmpty();
+    }
+}
+
+/*!
+ * Get value of graph at marker position
+ */
+double MarkerInfoItem::markerValue(qint32 graphIdx, double pos)
+{
+    QSharedPointer<LazyDataSource> pSource = _pGraphDataModel->lazyDataSource();
+    if (!pSource.isNull())
+    {
+        return pSource->valueAt(graphIdx, pos);
+    }
+    else
+    {
+        return _pGraphDataModel->sampleStore()->valueAt(graphIdx, pos);
+    }
+}
@@ -6,6 +6,8 @@
 #include <QComboBox>
 #include <QVBoxLayout>
 
+#include "graphdataindex.h"
+
 
 /* Forward declarations */
 class GuiModel;
@@ -38,7 +40,10 @@ private:
 
     void updateList();
     void selectGraph(qint32 graphIndex);
-    double calculateMarkerExpressionValue(quint32 expressionMask);
+    GraphDataIndex::Statistics calculateMarkerStatistics();
+    double calculateMarkerExpressionValue(quint32 expressionMask, const GraphDataIndex::Statistics &statistics);
+    bool hasData(qint32 graphIdx);
+    double markerValue(qint32 graphIdx, double pos);
 
     QVBoxLayout * _pLayout;
     QComboBox * _pGraphCombo;
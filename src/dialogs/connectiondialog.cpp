@@ -28,6 +28,8 @@ ConnectionDialog::ConnectionDialog(SettingsModel * pSettingsModel, QWidget *pare
     connect(_pSettingsModel, &SettingsModel::slaveIdChanged, this, &ConnectionDialog::updateSlaveId);
     connect(_pSettingsModel, &SettingsModel::timeoutChanged, this, &ConnectionDialog::updateTimeout);
     connect(_pSettingsModel, &SettingsModel::consecutiveMaxChanged, this, &ConnectionDialog::updateConsecutiveMax);
+    connect(_pSettingsModel, &SettingsModel::maxGapChanged, this, &ConnectionDialog::updateMaxGap);
+    connect(_pSettingsModel, &SettingsModel::pipelineDepthChanged, this, &ConnectionDialog::updatePipelineDepth);
     connect(_pSettingsModel, &SettingsModel::connectionStateChanged, this, &ConnectionDialog::updateConnectionState);
     connect(_pSettingsModel, &SettingsModel::int32LittleEndianChanged, this, &ConnectionDialog::updateInt32LittleEndian);
     connect(_pSettingsModel, &SettingsModel::persistentConnectionChanged, this, &ConnectionDialog::updatePersistentConnection);
@@ -154,6 +156,20 @@ void ConnectionDialog::updateConsecutiveMax(quint8 connectionId)
     pConnectionSettings->setConsecutiveMax(_pSettingsModel->consecutiveMax(connectionId));
 }
 
+void ConnectionDialog::updateMaxGap(quint8 connectionId)
+{
+    auto pConnectionSettings = connectionSettingsWidget(connectionId);
+
+    pConnectionSettings->setMaxGap(_pSettingsModel->maxGap(connectionId));
+}
+
+void ConnectionDialog::updatePipelineDepth(quint8 connectionId)
+{
+    auto pConnectionSettings = connectionSettingsWidget(connectionId);
+
+    pConnectionSettings->setPipelineDepth(_pSettingsModel->pipelineDepth(connectionId));
+}
+
 void ConnectionDialog::updateInt32LittleEndian(quint8 connectionId)
 {
     auto pConnectionSettings = connectionSettingsWidget(connectionId);
@@ -38,6 +38,8 @@ private slots:
     void updateSlaveId(quint8 connectionId);
     void updateTimeout(quint8 connectionId);
     void updateConsecutiveMax(quint8 connectionId);
+    void updateMaxGap(quint8 connectionId);
+    void updatePipelineDepth(quint8 connectionId);
     void updateInt32LittleEndian(quint8 connectionId);
     void updatePersistentConnection(quint8 connectionId);
 
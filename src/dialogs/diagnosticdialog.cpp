@@ -201,7 +201,8 @@ void DiagnosticDialog::handleCopyDiagnostics()
     QString clipboardText;
     foreach (QModelIndex index, indexlist)
     {
-        clipboardText.append(QString("%1\n").arg(_pDiagnosticModel->toString(index.row())));
+        const QModelIndex sourceIndex = _pSeverityProxyFilter->mapToSource(index);
+        clipboardText.append(QString("%1\n").arg(_pDiagnosticModel->toString(static_cast<quint32>(sourceIndex.row()))));
     }
 
     QClipboard* pClipboard = QGuiApplication::clipboard();
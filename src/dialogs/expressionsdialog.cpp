@@ -53,7 +53,7 @@ void ExpressionsDialog::handleExpressionChange()
         _localGraphDataModel.add();
         _localGraphDataModel.setExpression(0, _pUi->lineExpression->toPlainText());
 
-        _graphDataHandler.processActiveRegisters(&_localGraphDataModel);
+        _graphDataHandler.processActiveRegisters(GraphDataHandler::activeGraphs(&_localGraphDataModel));
 
         QList<ModbusRegister> registerList;
         _graphDataHandler.modbusRegisterList(registerList);
@@ -28,12 +28,18 @@ LogDialog::LogDialog(SettingsModel * pSettingsModel, GuiModel * pGuiModel, QWidg
     /*-- View connections --*/
     connect(_pUi->checkWriteDuringLog, &QCheckBox::toggled, _pSettingsModel, &SettingsModel::setWriteDuringLog);
     connect(_pUi->buttonWriteDuringLogFile, &QToolButton::clicked, this, &LogDialog::selectLogFile);
+    connect(_pUi->comboLogSync, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &LogDialog::handleLogSyncPolicyChange);
+    connect(_pUi->checkIndependentPolling, &QCheckBox::toggled, _pSettingsModel, &SettingsModel::setIndependentPolling);
 
     /*-- connect model to view --*/
     connect(_pSettingsModel, &SettingsModel::pollTimeChanged, this, &LogDialog::updatePollTime);
     connect(_pSettingsModel, &SettingsModel::writeDuringLogChanged, this, &LogDialog::updateWriteDuringLog);
     connect(_pSettingsModel, &SettingsModel::writeDuringLogFileChanged, this, &LogDialog::updateWriteDuringLogFile);
+    connect(_pSettingsModel, &SettingsModel::logSyncPolicyChanged, this, &LogDialog::updateLogSyncPolicy);
     connect(_pSettingsModel, &SettingsModel::absoluteTimesChanged, this, &LogDialog::timeReferenceUpdated);
+    connect(_pSettingsModel, &SettingsModel::independentPollingChanged, this, &LogDialog::updateIndependentPolling);
+    connect(_pSettingsModel, &SettingsModel::plotRetentionChanged, this, &LogDialog::updatePlotRetention);
+    connect(_pSettingsModel, &SettingsModel::maxFrameRateChanged, this, &LogDialog::updateMaxFrameRate);
 }
 
 LogDialog::~LogDialog()
@@ -47,6 +53,8 @@ void LogDialog::done(int r)
     if(QDialog::Accepted == r)  // ok was pressed
     {
         _pSettingsModel->setPollTime(_pUi->spinPollTime->text().toUInt());
+        _pSettingsModel->setPlotRetention(static_cast<quint32>(_pUi->spinPlotRetention->value()));
+        _pSettingsModel->setMaxFrameRate(static_cast<quint32>(_pUi->spinMaxFrameRate->value()));
         _pSettingsModel->setWriteDuringLogFile(_pUi->lineWriteDuringLogFile->text());
     }
 
@@ -58,7 +66,7 @@ void LogDialog::selectLogFile()
     QFileDialog dialog(this);
     FileSelectionHelper::configureFileDialog(&dialog,
                                              FileSelectionHelper::DIALOG_TYPE_SAVE,
-                                             FileSelectionHelper::FILE_TYPE_CSV);
+                                             FileSelectionHelper::FILE_TYPE_DATA);
 
     if (dialog.exec() == QDialog::Accepted)
     {
@@ -82,12 +90,14 @@ void LogDialog::updateWriteDuringLog()
         _pUi->checkWriteDuringLog->setChecked(true);
         _pUi->lineWriteDuringLogFile->setEnabled(true);
         _pUi->buttonWriteDuringLogFile->setEnabled(true);
+        _pUi->comboLogSync->setEnabled(true);
     }
     else
     {
         _pUi->checkWriteDuringLog->setChecked(false);
         _pUi->lineWriteDuringLogFile->setEnabled(false);
         _pUi->buttonWriteDuringLogFile->setEnabled(false);
+        _pUi->comboLogSync->setEnabled(false);
     }
 }
 
@@ -96,6 +106,34 @@ void LogDialog::updateWriteDuringLogFile()
     _pUi->lineWriteDuringLogFile->setText(_pSettingsModel->writeDuringLogFile());
 }
 
+void LogDialog::updateLogSyncPolicy()
+{
+    _pUi->comboLogSync->setCurrentIndex(static_cast<int>(_pSettingsModel->logSyncPolicy()));
+}
+
+void LogDialog::handleLogSyncPolicyChange(int index)
+{
+    if (index >= 0)
+    {
+        _pSettingsModel->setLogSyncPolicy(static_cast<SettingsModel::LogSyncPolicy>(index));
+    }
+}
+
+void LogDialog::updateIndependentPolling()
+{
+    _pUi->checkIndependentPolling->setChecked(_pSettingsModel->independentPolling());
+}
+
+void LogDialog::updatePlotRetention()
+{
+    _pUi->spinPlotRetention->setValue(static_cast<int>(_pSettingsModel->plotRetention()));
+}
+
+void LogDialog::updateMaxFrameRate()
+{
+    _pUi->spinMaxFrameRate->setValue(static_cast<int>(_pSettingsModel->maxFrameRate()));
+}
+
 void LogDialog::timeReferenceUpdated()
 {
     if (_pSettingsModel->absoluteTimes())
@@ -27,6 +27,11 @@ private slots:
     void updatePollTime();
     void updateWriteDuringLog();
     void updateWriteDuringLogFile();
+    void updateLogSyncPolicy();
+    void handleLogSyncPolicyChange(int index);
+    void updateIndependentPolling();
+    void updatePlotRetention();
+    void updateMaxFrameRate();
 
     void timeReferenceUpdated();
     void updateReferenceTime(int id);
@@ -3,6 +3,9 @@
 #include "qcustomplot.h"
 #include "graphdatahandler.h"
 #include "modbuspoll.h"
+#include "communicationsettings.h"
+#include "samplequeue.h"
+#include "sampleclock.h"
 #include "graphdatamodel.h"
 #include "notemodel.h"
 #include "diagnosticmodel.h"
@@ -53,10 +56,25 @@ MainWindow::MainWindow(QStringList cmdArguments, GuiModel* pGuiModel,
 
     _pNotesDock = new NotesDock(_pNoteModel, _pGuiModel, this);
 
+    /* Communication and expression evaluation run in separate thread */
     _pGraphDataHandler = new GraphDataHandler();
-    _pModbusPoll = new ModbusPoll(_pSettingsModel);
+    _pModbusPoll = new ModbusPoll();
     connect(_pModbusPoll, &ModbusPoll::registerDataReady, _pGraphDataHandler, &GraphDataHandler::handleRegisterData);
 
+    /* Confirmed read capability is handed over when communication stops, only to save it in project file */
+    connect(_pModbusPoll, &ModbusPoll::readCapabilityChanged, _pSettingsModel, &SettingsModel::setReadCapability, Qt::QueuedConnection);
+
+    /* Samples are queued in communication thread and taken in batches by gui thread */
+    _pSampleQueue = new SampleQueue(this);
+    connect(_pGraphDataHandler, &GraphDataHandler::graphDataReady, _pSampleQueue, &SampleQueue::addSample, Qt::DirectConnection);
+    connect(_pSampleQueue, &SampleQueue::samplesAvailable, this, &MainWindow::handleSamplesAvailable, Qt::QueuedConnection);
+
+    _pModbusPoll->moveToThread(&_communicationThread);
+    _pGraphDataHandler->moveToThread(&_communicationThread);
+    connect(&_communicationThread, &QThread::finished, _pModbusPoll, &QObject::deleteLater);
+    connect(&_communicationThread, &QThread::finished, _pGraphDataHandler, &QObject::deleteLater);
+    _communicationThread.start();
+
     _pGraphView = new GraphView(_pGuiModel, _pSettingsModel, _pGraphDataModel, _pNoteModel, _pUi->customPlot, this);
     _pDataFileHandler = new DataFileHandler(_pGuiModel, _pGraphDataModel, _pNoteModel, _pSettingsModel, _pDataParserModel, this);
     _pProjectFileHandler = new ProjectFileHandler(_pGuiModel, _pSettingsModel, _pGraphDataModel);
@@ -121,6 +139,8 @@ MainWindow::MainWindow(QStringList cmdArguments, GuiModel* pGuiModel,
 
     connect(_pGraphDataModel, &GraphDataModel::graphsAddData, _pGraphView, &GraphView::addData);
     connect(_pGraphDataModel, &GraphDataModel::graphsAddData, this, &MainWindow::setAxisToAuto);
+    connect(_pGraphDataModel, &GraphDataModel::graphsAppendData, _pGraphView, &GraphView::appendData);
+    connect(_pGraphDataModel, &GraphDataModel::graphsPreviewData, _pGraphView, &GraphView::showPreviewData);
 
     connect(_pGraphDataModel, &GraphDataModel::activeChanged, this, &MainWindow::rebuildGraphMenu);
     connect(_pGraphDataModel, &GraphDataModel::activeChanged, _pGraphView, &GraphView::updateGraphs);
@@ -143,7 +163,7 @@ MainWindow::MainWindow(QStringList cmdArguments, GuiModel* pGuiModel,
 
     connect(_pGraphDataModel, &GraphDataModel::expressionChanged, _pGraphView, &GraphView::clearGraph);
 
-    connect(_pGraphDataModel, &GraphDataModel::colorChanged, _pDataFileHandler, &DataFileHandler::rewriteDataFile);
+    connect(_pGraphDataModel, &GraphDataModel::colorChanged, _pDataFileHandler, &DataFileHandler::updateDataFileHeader);
     connect(_pGraphView, &GraphView::afterGraphUpdate, _pDataFileHandler, &DataFileHandler::rewriteDataFile);
 
     // Update cursor values in legend
@@ -204,10 +224,6 @@ MainWindow::MainWindow(QStringList cmdArguments, GuiModel* pGuiModel,
 
     handleGraphsCountChanged();
 
-    connect(_pGraphDataHandler, &GraphDataHandler::graphDataReady, _pGraphView, &GraphView::plotResults);
-    connect(_pGraphDataHandler, &GraphDataHandler::graphDataReady, _pLegend, &Legend::addLastReceivedDataToLegend);
-    connect(_pGraphDataHandler, &GraphDataHandler::graphDataReady, this, &MainWindow::updateCommunicationStats);
-
     handleCommandLineArguments(cmdArguments);
 
 #if 0
@@ -223,9 +239,13 @@ MainWindow::MainWindow(QStringList cmdArguments, GuiModel* pGuiModel,
 
 MainWindow::~MainWindow()
 {
+    /* Communication objects are deleted when thread is finished */
+    QMetaObject::invokeMethod(_pModbusPoll, &ModbusPoll::stopCommunication, Qt::BlockingQueuedConnection);
+    _communicationThread.quit();
+    _communicationThread.wait();
+
     delete _pGraphView;
     delete _pConnectionDialog;
-    delete _pModbusPoll;
     delete _pGraphShowHide;
     delete _pGraphBringToFront;
     delete _pDataFileHandler;
@@ -453,9 +473,10 @@ void MainWindow::toggleZoom(bool checked)
 void MainWindow::clearData()
 {
     _pGuiModel->setCommunicationStats(0, 0);
-    _pGuiModel->setCommunicationStartTime(QDateTime::currentMSecsSinceEpoch());
+    /* Use same reference as sample timestamps */
+    _pGuiModel->setCommunicationStartTime(static_cast<qint64>(SampleClock::toEpochMsecs(SampleClock::timestamp())));
 
-    _pModbusPoll->resetCommunicationStats();
+    QMetaObject::invokeMethod(_pModbusPoll, &ModbusPoll::resetCommunicationStats, Qt::QueuedConnection);
     _pGraphView->clearResults();
     _pGuiModel->clearMarkersState();
     _pDataFileHandler->rewriteDataFile();
@@ -496,10 +517,26 @@ void MainWindow::startScope()
         _runtimeTimer.singleShot(250, this, &MainWindow::updateRuntime);
 
         QList<ModbusRegister> registerList;
-        _pGraphDataHandler->processActiveRegisters(_pGraphDataModel);
-        _pGraphDataHandler->modbusRegisterList(registerList);
+        QList<quint32> pollIntervalList;
 
-        _pModbusPoll->startCommunication(registerList);
+        /* Communication thread only gets copies of the models */
+        const GraphDataHandler::ActiveGraphs activeGraphs = GraphDataHandler::activeGraphs(_pGraphDataModel);
+        const CommunicationSettings communicationSettings(_pSettingsModel);
+
+        QMetaObject::invokeMethod(_pGraphDataHandler, [this, &activeGraphs, &communicationSettings, &registerList, &pollIntervalList]() {
+            _pGraphDataHandler->processActiveRegisters(activeGraphs);
+            _pGraphDataHandler->modbusRegisterList(registerList);
+            _pGraphDataHandler->pollIntervalList(pollIntervalList, communicationSettings.pollTime());
+        }, Qt::BlockingQueuedConnection);
+
+        /* Discard samples of previous run */
+        QList<double> timestampList;
+        QList<ResultDoubleList> resultLists;
+        _pSampleQueue->takeSamples(timestampList, resultLists);
+
+        QMetaObject::invokeMethod(_pModbusPoll, [this, communicationSettings, registerList, pollIntervalList]() mutable {
+            _pModbusPoll->startCommunication(communicationSettings, registerList, pollIntervalList);
+        }, Qt::QueuedConnection);
 
         clearData();
 
@@ -516,7 +553,11 @@ void MainWindow::startScope()
 
 void MainWindow::stopScope()
 {
-    _pModbusPoll->stopCommunication();
+    QMetaObject::invokeMethod(_pModbusPoll, &ModbusPoll::stopCommunication, Qt::BlockingQueuedConnection);
+
+    /* Handle samples that were still queued */
+    handleSamplesAvailable();
+    _pSampleQueue->reportDroppedSamples(true);
 
     _pGuiModel->setCommunicationEndTime(QDateTime::currentMSecsSinceEpoch());
 
@@ -942,13 +983,35 @@ void MainWindow::updateRuntime()
     }
 }
 
+void MainWindow::handleSamplesAvailable()
+{
+    QList<double> timestampList;
+    QList<ResultDoubleList> resultLists;
+    _pSampleQueue->takeSamples(timestampList, resultLists);
+
+    if (!resultLists.isEmpty())
+    {
+        _pGraphView->plotResults(timestampList, resultLists);
+
+        for (const auto &resultList: qAsConst(resultLists))
+        {
+            _pLegend->addLastReceivedDataToLegend(resultList);
+            updateCommunicationStats(resultList);
+        }
+    }
+}
+
 void MainWindow::updateCommunicationStats(ResultDoubleList resultList)
 {
     quint32 error = 0;
     quint32 success = 0;
     for(const auto &result: resultList)
     {
-        result.isValid() ? success++ : error++;
+        /* Graph wasn't read in this sample (e.g. other connection) */
+        if (result.state() != ResultState::State::NO_VALUE)
+        {
+            result.isValid() ? success++ : error++;
+        }
     }
 
     _pGuiModel->incrementCommunicationStats(success, error);
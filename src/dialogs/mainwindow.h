@@ -7,6 +7,7 @@
 #include <QTimer>
 #include <QLabel>
 #include <QMenu>
+#include <QThread>
 
 #include "result.h"
 #include "updatenotify.h"
@@ -18,6 +19,7 @@ class MainWindow;
 // Forward declaration
 class ModbusPoll;
 class GraphDataHandler;
+class SampleQueue;
 class QCustomPlot;
 class GraphDataModel;
 class NoteModel;
@@ -97,6 +99,7 @@ private slots:
     void dropEvent(QDropEvent *e);
     void appFocusChanged(QWidget *old, QWidget *now);
     void updateRuntime();
+    void handleSamplesAvailable();
     void updateCommunicationStats(ResultDoubleList resultList);
     void updateDataFileNotes();
 
@@ -120,6 +123,8 @@ private:
 
     UpdateNotify* _pUpdateNotify;
     GraphDataHandler* _pGraphDataHandler;
+    SampleQueue* _pSampleQueue;
+    QThread _communicationThread;
 
     ConnectionDialog * _pConnectionDialog;
     LogDialog * _pLogDialog;
@@ -21,6 +21,9 @@ MarkerInfoDialog::MarkerInfoDialog(GuiModel *pGuiModel, QWidget *parent) :
     connect(_pUi->checkMaximum, &QCheckBox::stateChanged, this, &MarkerInfoDialog::checkBoxStatechanged);
     connect(_pUi->checkMinimum, &QCheckBox::stateChanged, this, &MarkerInfoDialog::checkBoxStatechanged);
     connect(_pUi->checkDifference, &QCheckBox::stateChanged, this, &MarkerInfoDialog::checkBoxStatechanged);
+    connect(_pUi->checkStdDev, &QCheckBox::stateChanged, this, &MarkerInfoDialog::checkBoxStatechanged);
+    connect(_pUi->checkRms, &QCheckBox::stateChanged, this, &MarkerInfoDialog::checkBoxStatechanged);
+    connect(_pUi->checkIntegral, &QCheckBox::stateChanged, this, &MarkerInfoDialog::checkBoxStatechanged);
 
     const quint32 mask = _pGuiModel->markerExpressionMask();
 
@@ -49,6 +52,21 @@ MarkerInfoDialog::MarkerInfoDialog(GuiModel *pGuiModel, QWidget *parent) :
         _pUi->checkSlope->setChecked(true);
     }
 
+    if (mask & GuiModel::cStdDevMask)
+    {
+        _pUi->checkStdDev->setChecked(true);
+    }
+
+    if (mask & GuiModel::cRmsMask)
+    {
+        _pUi->checkRms->setChecked(true);
+    }
+
+    if (mask & GuiModel::cIntegralMask)
+    {
+        _pUi->checkIntegral->setChecked(true);
+    }
+
 }
 
 MarkerInfoDialog::~MarkerInfoDialog()
@@ -82,6 +100,18 @@ void MarkerInfoDialog::checkBoxStatechanged(int state)
     {
          mask = GuiModel::cMaximumMask;
     }
+    else if (pObj == _pUi->checkStdDev)
+    {
+         mask = GuiModel::cStdDevMask;
+    }
+    else if (pObj == _pUi->checkRms)
+    {
+         mask = GuiModel::cRmsMask;
+    }
+    else if (pObj == _pUi->checkIntegral)
+    {
+         mask = GuiModel::cIntegralMask;
+    }
     else
     {
         mask = 0u;
@@ -94,7 +94,7 @@ bool GraphIndicators::determineVisibility(uint32_t activeIdx)
     auto pPos = _axisValueTracers[activeIdx]->position;
 
     bool bVisibility = _pGraphDataModel->isVisible(graphIdx)
-                        && !_pGraphDataModel->dataMap(graphIdx)->isEmpty()
+                        && !_pGraphDataModel->sampleStore()->isEmpty()
                         && (pPos->value() >= pPos->valueAxis()->range().lower)
                         && (pPos->value() <= pPos->valueAxis()->range().upper);
 
@@ -108,7 +108,7 @@ void GraphIndicators::setFrontGraph(quint32 graphIdx)
     if (activeIdx != -1)
     {
         _axisValueTracers[activeIdx]->setLayer("topAxes");
-        _pPlot->replot(QCustomPlot::rpRefreshHint);
+        _pPlot->scheduleReplot();
     }
 }
 
@@ -135,7 +135,7 @@ void GraphIndicators::setTracerPosition(const QCPRange &newRange)
 
     updateVisibility();
 
-    _pPlot->replot(QCustomPlot::rpRefreshHint);
+    _pPlot->scheduleReplot();
 }
 
 void GraphIndicators::updateColor(quint32 graphIdx)
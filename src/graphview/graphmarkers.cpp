@@ -79,7 +79,7 @@ void GraphMarkers::updateMarkersVisibility()
         setTracerVisibility(_startTracerList, false);
         setTracerVisibility(_endTracerList, false);
 
-        _pPlot->replot();
+        _pPlot->scheduleReplot();
     }
 }
 
@@ -94,7 +94,7 @@ void GraphMarkers::setStartMarker()
     setTracerVisibility(_startTracerList, true);
     setTracerPosition(_startTracerList, pos);
 
-    _pPlot->replot();
+    _pPlot->scheduleReplot();
 }
 
 void GraphMarkers::setEndMarker()
@@ -108,7 +108,7 @@ void GraphMarkers::setEndMarker()
     setTracerVisibility(_endTracerList, true);
     setTracerPosition(_endTracerList, pos);
 
-    _pPlot->replot();
+    _pPlot->scheduleReplot();
 }
 
 void GraphMarkers::updateValueAxis(quint32 graphIdx)
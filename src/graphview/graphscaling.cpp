@@ -86,10 +86,10 @@ void GraphScale::rescale()
         const quint64 slidingInterval = static_cast<quint64>(_pGuiModel->xAxisSlidingSec()) * 1000;
         if ((_pPlot->graphCount() != 0) && (_pGraphview->graphDataSize() != 0))
         {
-            auto lastDataIt = _pPlot->graph(0)->data()->constEnd();
-            lastDataIt--; /* Point to last existing item */
+            bool bFound;
+            const QCPRange dataRange = _pGraphview->dataKeyRange(bFound);
 
-            const quint64 lastTime = (quint64)lastDataIt->key;
+            const quint64 lastTime = (quint64)dataRange.upper;
             if (lastTime > slidingInterval)
             {
                 _pPlot->xAxis->setRange(lastTime - slidingInterval, lastTime);
@@ -220,11 +220,17 @@ void GraphScale::timeAxisRangeChanged(const QCPRange &newRange)
     double newLower = newRange.lower;
     double newUpper = newRange.upper;
 
-    QList<QCPGraph*> const graphList = _pPlot->xAxis->graphs();
+    bool bFound = false;
+    QCPRange dataRange;
 
-    if (graphList.size() > 0 && !graphList[0]->data()->isEmpty())
+    if (_pGraphview != nullptr)
     {
-        const double beginKey = graphList[0]->data()->constBegin()->key;
+        dataRange = _pGraphview->dataKeyRange(bFound);
+    }
+
+    if (bFound)
+    {
+        const double beginKey = dataRange.lower;
         if (newLower < 0)
         {
             if (beginKey > 0)
@@ -1,6 +1,7 @@
 
 #include <QVector>
 #include <QtGlobal>
+#include <QtNumeric>
 #include <QLocale>
 #include <QInputDialog>
 
@@ -18,6 +19,7 @@
 #include "graphmarkers.h"
 #include "graphindicators.h"
 #include "notehandling.h"
+#include "lazydatasource.h"
 
 GraphView::GraphView(GuiModel * pGuiModel, SettingsModel *pSettingsModel, GraphDataModel * pGraphDataModel, NoteModel *pNoteModel, ScopePlot * pPlot, QObject *parent) :
     QObject(parent)
@@ -47,6 +49,10 @@ GraphView::GraphView(GuiModel * pGuiModel, SettingsModel *pSettingsModel, GraphD
     // Samples are enabled
     _bEnableSampleHighlight = true;
 
+    _bRescalePending = false;
+    _bWindowUpdatePending = false;
+    _windowVisibleSize = 0;
+
     // Add layer to move graph in front
     _pPlot->addLayer("topMain", _pPlot->layer("main"), QCustomPlot::limAbove);
 
@@ -59,6 +65,13 @@ GraphView::GraphView(GuiModel * pGuiModel, SettingsModel *pSettingsModel, GraphD
     connect(_pPlot, &ScopePlot::mouseWheel, this, &GraphView::mouseWheel);
     connect(_pPlot, &ScopePlot::mouseMove, this, &GraphView::mouseMove);
     connect(_pPlot, &ScopePlot::beforeReplot, this, &GraphView::handleSamplePoints);
+    connect(_pPlot, &ScopePlot::frameStarted, this, &GraphView::handleFrameStarted);
+    connect(_pPlot->xAxis, QOverload<const QCPRange &>::of(&QCPAxis::rangeChanged), this, &GraphView::handleKeyRangeChange);
+
+    connect(_pGraphDataModel, &GraphDataModel::lazyDataSourceChanged, this, &GraphView::handleLazyDataSourceChange);
+
+    connect(_pSettingsModel, &SettingsModel::maxFrameRateChanged, this, &GraphView::updateMaxFrameRate);
+    updateMaxFrameRate();
 
     _pGraphScale = new GraphScale(_pGuiModel, _pPlot, this);
     _pGraphViewZoom = new GraphViewZoom(_pGuiModel, _pPlot, this);
@@ -82,7 +95,15 @@ GraphView::~GraphView()
 
 qint32 GraphView::graphDataSize()
 {
-    return _pPlot->graph(0)->data()->size();
+    return _pGraphDataModel->sampleStore()->size();
+}
+
+/*!
+ * Key range of all samples, not only of the window that is loaded in the graphs
+ */
+QCPRange GraphView::dataKeyRange(bool &foundRange)
+{
+    return _pGraphDataModel->sampleStore()->keyRange(foundRange);
 }
 
 bool GraphView::valuesUnderCursor(QList<double> &valueList)
@@ -96,7 +117,7 @@ bool GraphView::valuesUnderCursor(QList<double> &valueList)
         double tooltipPos = getClosestPoint(xPos);
 
         bool bValid;
-        const QCPRange keyRange = _pPlot->graph(0)->data()->keyRange(bValid);
+        const QCPRange keyRange = dataKeyRange(bValid);
 
         // Check all graphs
         for (qint32 activeGraphIndex = 0; activeGraphIndex < _pPlot->graphCount(); activeGraphIndex++)
@@ -108,8 +129,7 @@ bool GraphView::valuesUnderCursor(QList<double> &valueList)
                 )
             {
                 const qint32 graphIdx = _pGraphDataModel->convertToGraphIndex(activeGraphIndex);
-                QCPGraphDataContainer::const_iterator graphDataIt = _pGraphDataModel->dataMap(graphIdx).data()->findBegin(tooltipPos, false);
-                valueList.append(graphDataIt->value);
+                valueList.append(_pGraphDataModel->sampleStore()->valueAt(graphIdx, tooltipPos));
             }
             else
             {
@@ -147,7 +167,7 @@ void GraphView::updateTooltip()
 void GraphView::enableSamplePoints()
 {
     _bEnableSampleHighlight = _pGuiModel->highlightSamples();
-    _pPlot->replot();
+    _pPlot->scheduleReplot();
 }
 
 void GraphView::clearGraph(const quint32 graphIdx)
@@ -165,23 +185,16 @@ void GraphView::clearGraph(const quint32 graphIdx)
         else if (activeGraphList.size() == 1)
         {
             /* Only one graph active: clear all data */
-            _pGraphDataModel->dataMap(graphIdx)->clear();
+            _pGraphDataModel->sampleStore()->clear();
 
-            _pPlot->replot();
+            requestWindowUpdate();
         }
         else
         {
             /* Several active graph, keep time data but clear data */
-            QCPGraphDataContainer::iterator it = _pGraphDataModel->dataMap(graphIdx)->begin();
-
-            /* Clear all values, keep keys */
-            while(it != _pGraphDataModel->dataMap(graphIdx)->end())
-            {
-                it->value = 0u;
-                it++;
-            }
+            _pGraphDataModel->sampleStore()->clearValues(graphIdx);
 
-            _pPlot->replot();
+            requestWindowUpdate();
         }
     }
 }
@@ -198,57 +211,29 @@ void GraphView::updateGraphs()
 
     if (activeGraphList.size() > 0)
     {
-        // All graphs should have the same amount of points.
-        // Loop over graphs and get maximum count of samples
-        qint32 maxSampleCount = 0;
-        quint32 maxSampleIdx = 0;
-
-        foreach(quint16 graphIdx, activeGraphList)
-        {
-            const qint32 sampleCount = _pGraphDataModel->dataMap(graphIdx)->size();
-            if (sampleCount > maxSampleCount)
-            {
-                maxSampleCount = sampleCount;
-                maxSampleIdx = graphIdx;
-            }
-        }
-
-        // Graph that have less points will be zeroed with that amount of points
+        /* All graphs share the keys of the sample store, graphs without data have zero values */
         foreach(quint16 graphIdx, activeGraphList)
         {
-            QCPGraph * pGraph = _pPlot->addGraph();
+            ScopeGraph * pGraph = _pPlot->addScopeGraph();
             setGraphAxis(pGraph, _pGraphDataModel->valueAxis(graphIdx));
             setGraphColor(pGraph, _pGraphDataModel->color(graphIdx));
 
             pGraph->setVisible(_pGraphDataModel->isVisible(graphIdx));
 
-            QSharedPointer<QCPGraphDataContainer> pMap = _pGraphDataModel->dataMap(graphIdx);
-
-            // Set data to zero when needed
-            if (pMap->size() != maxSampleCount)
-            {
-                const QSharedPointer<QCPGraphDataContainer> pReferenceMap = _pGraphDataModel->dataMap(maxSampleIdx);
-                pMap->clear();
-
-                // Add zero value for every key (x-coordinate)
-                QCPGraphDataContainer::const_iterator refIt = pReferenceMap->constBegin();
-                while(refIt != pReferenceMap->constEnd())
-                {
-                    pMap->add(QCPGraphData(refIt->key, 0));
-                    refIt++;
-                }
-            }
-
-            pGraph->setData(pMap);
+            /* Data is loaded on next window update */
+            pGraph->setSampleStore(_pGraphDataModel->sampleStore(), graphIdx);
 
             _pGraphMarkers->addTracer(pGraph);
             _pGraphIndicators->add(graphIdx, pGraph);
         }
     }
 
+    applyPreviewData();
+    requestWindowUpdate();
+
     updateSecondaryAxisVisibility();
 
-    _pPlot->replot();
+    _pPlot->scheduleReplot();
 
     emit afterGraphUpdate();
 }
@@ -261,7 +246,7 @@ void GraphView::changeGraphColor(const quint32 graphIdx)
 
         setGraphColor(_pPlot->graph(activeIdx), _pGraphDataModel->color(graphIdx));
 
-        _pPlot->replot();
+        _pPlot->scheduleReplot();
     }
 }
 
@@ -274,7 +259,7 @@ void GraphView::changeGraphAxis(const quint32 graphIdx)
 
         updateSecondaryAxisVisibility();
 
-        _pPlot->replot();
+        _pPlot->scheduleReplot();
     }
 }
 
@@ -284,23 +269,61 @@ void GraphView::bringToFront()
     {
         _pPlot->graph(_pGuiModel->frontGraph())->setLayer("topMain");
         _pGraphIndicators->setFrontGraph(_pGuiModel->frontGraph());
-        _pPlot->replot();
+        _pPlot->scheduleReplot();
     }
 }
 
+/*!
+ * Show data set that was set in the sample store
+ */
 void GraphView::addData(QList<double> timeData, QList<QList<double> > data)
 {
-    quint64 totalPoints = 0;
-    const QVector<double> timeDataVector = timeData.toVector();
+    optimizeForDataSize(static_cast<quint64>(timeData.size()) * static_cast<quint64>(data.size()));
 
-    for (qint32 i = 0; i < data.size(); i++)
-    {
-        QVector<double> graphData = data.at(i).toVector();
-        _pPlot->graph(i)->setData(timeDataVector, graphData, true);
+    requestWindowUpdate();
+
+    _pPlot->rescaleAxes(true);
+    _pPlot->scheduleReplot();
+}
+
+/*!
+ * Show batch of loaded samples that was appended to the sample store
+ * Axes are not rescaled, the preview already covers the complete data set
+ */
+void GraphView::appendData(QList<double> timeData, QList<QList<double> > data)
+{
+    Q_UNUSED(timeData);
+
+    const quint64 sampleCount = static_cast<quint64>(_pGraphDataModel->sampleStore()->size());
+    optimizeForDataSize(sampleCount * static_cast<quint64>(data.size()));
 
-        totalPoints += graphData.size();
+    requestWindowUpdate();
+}
+
+/*!
+ * Show decimated preview of a data set that is being loaded
+ * Empty data removes the preview.
+ */
+void GraphView::showPreviewData(QList<double> timeData, QList<QList<double> > data)
+{
+    _previewTimeData = timeData;
+    _previewData = data;
+
+    applyPreviewData();
+
+    if (data.isEmpty())
+    {
+        rescalePlot();
+    }
+    else
+    {
+        _pPlot->rescaleAxes(true);
+        _pPlot->scheduleReplot();
     }
+}
 
+void GraphView::optimizeForDataSize(quint64 totalPoints)
+{
     // Check if optimizations are needed
     if (totalPoints > _cOptimizeThreshold)
     {
@@ -313,9 +336,6 @@ void GraphView::addData(QList<double> timeData, QList<QList<double> > data)
 
         _pPlot->setNotAntialiasedElements(QCP::aeAll);
     }
-
-    _pPlot->rescaleAxes(true);
-    _pPlot->replot();
 }
 
 void GraphView::handleGraphVisibilityChange(quint32 graphIdx)
@@ -333,59 +353,124 @@ void GraphView::handleGraphVisibilityChange(quint32 graphIdx)
     }
 }
 
+/*!
+ * Request rescale of plot
+ * Rescale is deferred to the next frame, so all requests in between are merged.
+ */
 void GraphView::rescalePlot()
 {
-    _pGraphScale->rescale();
+    _bRescalePending = true;
 
-    _pPlot->replot();
+    _pPlot->scheduleReplot();
 }
 
-void GraphView::plotResults(ResultDoubleList resultList)
+/*!
+ * Add batch of samples to plot
+ * Plot is only rescaled once for the complete batch. Results without value (NO_VALUE) are absent
+ * for that graph, e.g. the sample comes from another connection. Consecutive samples with the same
+ * timestamp and values for different graphs (independently polled connections) are merged.
+ * \param timestampList    Timestamp (ms since epoch) of each sample
+ * \param resultLists      Results of each sample, correspond with activeGraphList
+ */
+void GraphView::plotResults(QList<double> timestampList, QList<ResultDoubleList> resultLists)
 {
-    /* QList correspond with activeGraphList */
-
-    quint64 timeData;
-    if (_pSettingsModel->absoluteTimes())
-    {
-        // Epoch is in UTC time
-        timeData = QDateTime::currentMSecsSinceEpoch();
-    }
-    else
-    {
-        timeData = QDateTime::currentMSecsSinceEpoch() - _pGuiModel->communicationStartTime();
-    }
-
+    GraphSampleStore* pSampleStore = _pGraphDataModel->sampleStore();
+    QList<double> storeValues;
+    QList<bool> storeValidList;
     QList<double> dataList;
+    QList<bool> presentList;
+    bool bRowPending = false;
 
-    uint32_t i = 0;
-    for (const auto &result: resultList)
+    double rowTime = 0;
+    double timeData = 0;
+    for (qint32 sampleIdx = 0; sampleIdx < resultLists.size(); sampleIdx++)
     {
-        if (result.isValid())
+        if (_pSettingsModel->absoluteTimes())
         {
-            // No error, add points
-            _pPlot->graph(i)->addData(timeData, result.value());
-            dataList.append(result.value());
+            // Epoch is in UTC time
+            timeData = timestampList[sampleIdx];
         }
         else
         {
-            _pPlot->graph(i)->addData(timeData, 0);
-            dataList.append(0);
+            timeData = timestampList[sampleIdx] - static_cast<double>(_pGuiModel->communicationStartTime());
+        }
+
+        const ResultDoubleList& resultList = resultLists[sampleIdx];
+
+        bool bMerge = bRowPending && (timeData == rowTime) && (presentList.size() == resultList.size());
+        for (qint32 i = 0; bMerge && (i < resultList.size()); i++)
+        {
+            bMerge = !presentList[i] || (resultList[i].state() == ResultState::State::NO_VALUE);
+        }
+
+        if (!bMerge)
+        {
+            if (bRowPending)
+            {
+                pSampleStore->append(rowTime, storeValues, storeValidList);
+                emit dataAddedToPlot(rowTime, dataList);
+            }
+
+            /* Inactive graphs don't have a value */
+            storeValues.fill(0, pSampleStore->graphCount());
+            storeValidList.fill(false, pSampleStore->graphCount());
+
+            /* Graphs without result are absent until a merged sample has a value */
+            dataList.fill(qQNaN(), resultList.size());
+            presentList.fill(false, resultList.size());
+
+            for (qint32 i = 0; i < resultList.size(); i++)
+            {
+                storeValues[_pGraphDataModel->convertToGraphIndex(static_cast<quint32>(i))] = qQNaN();
+            }
+
+            rowTime = timeData;
+            bRowPending = true;
+        }
+
+        for (qint32 i = 0; i < resultList.size(); i++)
+        {
+            const ResultDouble &result = resultList[i];
+            const qint32 graphIdx = _pGraphDataModel->convertToGraphIndex(static_cast<quint32>(i));
+
+            if (result.state() == ResultState::State::NO_VALUE)
+            {
+                /* Graph has no sample at this time */
+            }
+            else if (result.isValid())
+            {
+                // No error, add points
+                storeValues[graphIdx] = result.value();
+                storeValidList[graphIdx] = true;
+                dataList[i] = result.value();
+                presentList[i] = true;
+            }
+            else
+            {
+                storeValues[graphIdx] = 0;
+                dataList[i] = 0;
+                presentList[i] = true;
+            }
         }
-        i++;
     }
 
-    emit dataAddedToPlot(timeData, dataList);
+    if (bRowPending)
+    {
+        pSampleStore->append(rowTime, storeValues, storeValidList);
+        emit dataAddedToPlot(rowTime, dataList);
+
+        applyRetention(timeData);
+        requestWindowUpdate();
+    }
 
    rescalePlot();
 }
 
 void GraphView::clearResults()
 {
-    for (qint32 i = 0; i < _pPlot->graphCount(); i++)
-    {
-        _pPlot->graph(i)->data()->clear();
-    }
+    _pGraphDataModel->sampleStore()->clear();
 
+    requestWindowUpdate();
     rescalePlot();
 }
 
@@ -398,6 +483,128 @@ void GraphView::showMarkers()
     _pGuiModel->setEndMarkerPos(getClosestPoint(endPos));
 }
 
+void GraphView::handleFrameStarted()
+{
+    if (_bRescalePending)
+    {
+        _bRescalePending = false;
+        _pGraphScale->rescale();
+    }
+
+    /* After rescale, so the window matches the new key range */
+    if (_bWindowUpdatePending)
+    {
+        _bWindowUpdatePending = false;
+        updateWindow();
+    }
+}
+
+void GraphView::handleKeyRangeChange()
+{
+    _bWindowUpdatePending = true;
+    _pPlot->scheduleReplot();
+}
+
+void GraphView::handleLazyDataSourceChange()
+{
+    requestWindowUpdate();
+}
+
+void GraphView::updateMaxFrameRate()
+{
+    _pPlot->setMaxFrameRate(_pSettingsModel->maxFrameRate());
+}
+
+void GraphView::requestWindowUpdate()
+{
+    _windowRange = QCPRange();
+
+    handleKeyRangeChange();
+}
+
+/*!
+ * Load samples around the visible key range in the graphs
+ * The window is three times the visible range, so panning doesn't require a reload on
+ * every frame. The window is reloaded when the visible range leaves it, when zoomed in
+ * far enough to need more detail or when the samples changed.
+ *
+ * When a data file is browsed lazily, the window of the data file is loaded in the sample
+ * store first.
+ */
+void GraphView::updateWindow()
+{
+    const QCPRange visibleRange = _pPlot->xAxis->range();
+
+    if (
+        (_windowRange.size() > 0)
+        && _windowRange.contains(visibleRange.lower)
+        && _windowRange.contains(visibleRange.upper)
+        && (visibleRange.size() * _cWindowZoomFactor > _windowVisibleSize)
+    )
+    {
+        /* Window is still valid */
+        return;
+    }
+
+    const QCPRange windowRange(visibleRange.lower - visibleRange.size(), visibleRange.upper + visibleRange.size());
+    const qint32 bucketCount = 3 * qMax(1, _pPlot->axisRect()->width());
+
+    QSharedPointer<LazyDataSource> pDataSource = _pGraphDataModel->lazyDataSource();
+    if (
+        !pDataSource.isNull()
+        && (pDataSource->graphCount() == _pGraphDataModel->size())
+    )
+    {
+        QList<double> timeData;
+        QList<QList<double> > data;
+        pDataSource->window(windowRange, bucketCount, timeData, data);
+
+        _pGraphDataModel->sampleStore()->setAll(timeData, data);
+    }
+
+    for (qint32 i = 0; i < _pPlot->graphCount(); i++)
+    {
+        ScopeGraph* pGraph = qobject_cast<ScopeGraph*>(_pPlot->graph(i));
+        if (pGraph != nullptr)
+        {
+            pGraph->loadWindow(windowRange, bucketCount);
+        }
+    }
+
+    _windowRange = windowRange;
+    _windowVisibleSize = visibleRange.size();
+
+    _pPlot->scheduleReplot();
+}
+
+/*!
+ * Set preview of data set on the graphs
+ * Preview rows correspond with all graphs, graphs of the plot only with active graphs.
+ */
+void GraphView::applyPreviewData()
+{
+    for (qint32 i = 0; i < _pPlot->graphCount(); i++)
+    {
+        ScopeGraph* pGraph = qobject_cast<ScopeGraph*>(_pPlot->graph(i));
+        const qint32 graphIdx = _pGraphDataModel->convertToGraphIndex(static_cast<quint32>(i));
+
+        if (pGraph != nullptr)
+        {
+            if (
+                (graphIdx >= 0)
+                && (graphIdx < _previewData.size())
+            )
+            {
+                pGraph->setPreviewData(_previewTimeData, _previewData.at(graphIdx));
+            }
+            else
+            {
+                pGraph->clearPreviewData();
+            }
+        }
+    }
+}
+
 void GraphView::mousePress(QMouseEvent *event)
 {
     if (_pGraphViewZoom->handleMousePress(event))
@@ -510,7 +717,7 @@ void GraphView::paintTimeStampToolTip(QPoint pos)
         double tooltipPos = getClosestPoint(xPos);
 
         bool bValid;
-        const QCPRange keyRange = _pPlot->graph(0)->data()->keyRange(bValid);
+        const QCPRange keyRange = dataKeyRange(bValid);
 
         if (bValid && keyRange.contains(xPos))
         {
@@ -549,19 +756,21 @@ void GraphView::handleSamplePoints()
         if (_pPlot->graphCount() > 0 && (graphDataSize() > 0))
         {
             QCPRange axisRange = _pPlot->xAxis->range();
+            GraphSampleStore* pSampleStore = _pGraphDataModel->sampleStore();
 
-            auto lowerBoundIt = _pPlot->graph(0)->data()->findBegin(axisRange.lower, false);
-            auto upperBoundIt = _pPlot->graph(0)->data()->findBegin(axisRange.upper);
+            /* First sample in range and last sample before end of range */
+            const qint32 lowerIdx = qMin(pSampleStore->findBegin(axisRange.lower), pSampleStore->size() - 1);
+            const qint32 upperIdx = qMax(pSampleStore->findBegin(axisRange.upper) - 1, 0);
 
-            const int pointCount = upperBoundIt - lowerBoundIt;
+            const int pointCount = upperIdx - lowerIdx;
 
             /* Get size in pixels */
-            const double sizePx = _pPlot->xAxis->coordToPixel(upperBoundIt->key) - _pPlot->xAxis->coordToPixel(lowerBoundIt->key);
+            const double sizePx = _pPlot->xAxis->coordToPixel(pSampleStore->key(upperIdx)) - _pPlot->xAxis->coordToPixel(pSampleStore->key(lowerIdx));
 
             /* Calculate number of pixels per point */
             double nrOfPixelsPerPoint;
 
-            if (lowerBoundIt != upperBoundIt)
+            if (lowerIdx != upperIdx)
             {
                 nrOfPixelsPerPoint = sizePx / qAbs(pointCount);
             }
@@ -623,31 +832,9 @@ double GraphView::getClosestPoint(double coordinate)
 {
     if ((_pPlot->graphCount() > 0) && (graphDataSize() != 0))
     {
-        QCPGraphDataContainer::const_iterator closestIt;
-        QCPGraphDataContainer::const_iterator leftIt = _pPlot->graph(0)->data()->findBegin(coordinate);
-
-        auto rightIt = leftIt + 1;
-        if (rightIt !=  _pPlot->graph(0)->data()->constEnd())
-        {
+        GraphSampleStore* pSampleStore = _pGraphDataModel->sampleStore();
 
-            const double diffReference = rightIt->key - leftIt->key;
-            const double diffPos = coordinate - leftIt->key;
-
-            if (diffPos > (diffReference / 2))
-            {
-                closestIt = rightIt;
-            }
-            else
-            {
-                closestIt = leftIt;
-            }
-        }
-        else
-        {
-            closestIt = leftIt;
-        }
-
-        return closestIt->key;
+        return pSampleStore->key(pSampleStore->closestSample(coordinate));
     }
     else
     {
@@ -672,3 +859,19 @@ void GraphView::updateSecondaryAxisVisibility()
 
     rescalePlot();
 }
+
+/*!
+ * Remove data older than the retention window from all graphs
+ * Removing from the front of the sample store is amortized constant time, so memory
+ * stays bounded during long running logs.
+ * \param lastTime     Time of most recent sample (ms)
+ */
+void GraphView::applyRetention(double lastTime)
+{
+    const quint32 retention = _pSettingsModel->plotRetention();
+    if (retention > 0)
+    {
+        const double cutoff = lastTime - static_cast<double>(retention) * 1000;
+        _pGraphDataModel->sampleStore()->removeBefore(cutoff);
+    }
+}
@@ -27,6 +27,7 @@ public:
     virtual ~GraphView();
 
     qint32 graphDataSize();
+    QCPRange dataKeyRange(bool &foundRange);
     bool valuesUnderCursor(QList<double> &valueList);
 
     QPointF pixelToPointF(const QPoint &pixel) const;
@@ -45,9 +46,11 @@ public slots:
     void bringToFront();
 
     void addData(QList<double> timeData, QList<QList<double> > data);
+    void appendData(QList<double> timeData, QList<QList<double> > data);
+    void showPreviewData(QList<double> timeData, QList<QList<double> > data);
     void handleGraphVisibilityChange(quint32 graphIdx);
     void rescalePlot();
-    void plotResults(ResultDoubleList resultList);
+    void plotResults(QList<double> timestampList, QList<ResultDoubleList> resultLists);
     void clearResults();
 
 signals:
@@ -62,6 +65,10 @@ private slots:
     void mouseMove(QMouseEvent *event);
 
     void handleSamplePoints();
+    void handleFrameStarted();
+    void handleKeyRangeChange();
+    void handleLazyDataSourceChange();
+    void updateMaxFrameRate();
 
 private:
     void paintTimeStampToolTip(QPoint pos);
@@ -70,6 +77,11 @@ private:
     void setGraphAxis(QCPGraph* _pGraph, const GraphData::valueAxis_t &axis);
     double getClosestPoint(double coordinate);
     void updateSecondaryAxisVisibility();
+    void applyRetention(double lastTime);
+    void optimizeForDataSize(quint64 totalPoints);
+    void applyPreviewData();
+    void requestWindowUpdate();
+    void updateWindow();
 
     QVector<QString> _tickLabels;
 
@@ -78,6 +90,16 @@ private:
     GraphDataModel * _pGraphDataModel;
     ScopePlot * _pPlot;
     bool _bEnableSampleHighlight;
+    bool _bRescalePending;
+
+    /* Preview of data set that is loading, or overview of lazily loaded data file */
+    QList<double> _previewTimeData;
+    QList<QList<double> > _previewData;
+
+    /* Window of samples that is loaded in the graphs */
+    bool _bWindowUpdatePending;
+    QCPRange _windowRange;
+    double _windowVisibleSize;
 
     GraphScale* _pGraphScale;
     GraphViewZoom* _pGraphViewZoom;
@@ -89,6 +111,7 @@ private:
 
     static const qint32 _cPixelPerPointThreshold = 5; /* in pixels */
     static const quint64 _cOptimizeThreshold = 1000000uL;
+    static const qint32 _cWindowZoomFactor = 2;
 
 };
 
@@ -74,13 +74,13 @@ bool NoteHandling::handleMouseMove(QMouseEvent *event)
 void NoteHandling::handleNotePositionChanged(const quint32 idx)
 {
     _notesItems[idx]->setNotePosition(_pNoteModel->notePosition(idx)); // place position at left/top of axis rect
-    _pPlot->replot();
+    _pPlot->scheduleReplot();
 }
 
 void NoteHandling::handleNoteTextChanged(const quint32 idx)
 {
     _notesItems[idx]->setText(_pNoteModel->textData(idx));
-    _pPlot->replot();
+    _pPlot->scheduleReplot();
 }
 
 void NoteHandling::handleNoteAdded(const quint32 idx)
@@ -91,11 +91,11 @@ void NoteHandling::handleNoteAdded(const quint32 idx)
 
     _notesItems.append(newNote);
 
-    _pPlot->replot();
+    _pPlot->scheduleReplot();
 }
 
 void NoteHandling::handleNoteRemoved(const quint32 idx)
 {
     _notesItems.removeAt(idx);
-    _pPlot->replot();
+    _pPlot->scheduleReplot();
 }
@@ -0,0 +1,253 @@
+#include <algorithm> // std::lower_bound, std::upper_bound
+
+#include "graphsamplestore.h"
+#include "scopegraph.h"
+
+ScopeGraph::ScopeGraph(QCPAxis *keyAxis, QCPAxis *valueAxis) :
+    QCPGraph(keyAxis, valueAxis),
+    _pSampleStore(nullptr),
+    _graphIdx(-1)
+{
+
+}
+
+/*!
+ * Set column of sample store that is drawn by this graph
+ * \param pSampleStore  Samples of all graphs
+ * \param graphIdx      Index of graph in sample store
+ */
+void ScopeGraph::setSampleStore(GraphSampleStore* pSampleStore, qint32 graphIdx)
+{
+    _pSampleStore = pSampleStore;
+    _graphIdx = graphIdx;
+}
+
+/*!
+ * Load window of samples in the data container of the graph
+ * \param keyRange      Key range of window
+ * \param maxBuckets    Number of buckets (e.g. pixels) of window
+ */
+void ScopeGraph::loadWindow(const QCPRange &keyRange, qint32 maxBuckets)
+{
+    /* Release the window that is shared with the data container, so the buffer is refilled in place */
+    mDataContainer->set(QVector<QCPGraphData>(), true);
+
+    if (_pSampleStore != nullptr)
+    {
+        _pSampleStore->window(_graphIdx, keyRange, maxBuckets, _windowData);
+    }
+    else
+    {
+        _windowData.clear();
+    }
+
+    /* Container shares the buffer, the samples aren't copied */
+    mDataContainer->set(_windowData, true);
+}
+
+/*!
+ * Set decimated preview of the data that is still being loaded
+ * \param keys     Keys of preview samples (increasing)
+ * \param values   Values of preview samples
+ */
+void ScopeGraph::setPreviewData(const QList<double>& keys, const QList<double>& values)
+{
+    const qint32 count = qMin(keys.size(), values.size());
+
+    _previewData.clear();
+    _previewData.reserve(count);
+    for (qint32 idx = 0; idx < count; idx++)
+    {
+        _previewData.append(QCPGraphData(keys[idx], values[idx]));
+    }
+}
+
+void ScopeGraph::clearPreviewData()
+{
+    _previewData.clear();
+    _previewData.squeeze();
+}
+
+bool ScopeGraph::hasPreviewData() const
+{
+    return !_previewData.isEmpty();
+}
+
+/*!
+ * Key range of all samples (not only the window), includes the preview so the complete
+ * file is visible while loading
+ */
+QCPRange ScopeGraph::getKeyRange(bool &foundRange, QCP::SignDomain inSignDomain) const
+{
+    QCPRange range;
+
+    if (
+        (inSignDomain == QCP::sdBoth)
+        && hasStoreSamples()
+        )
+    {
+        range = _pSampleStore->keyRange(foundRange);
+    }
+    else
+    {
+        range = QCPGraph::getKeyRange(foundRange, inSignDomain);
+    }
+
+    if (
+        (inSignDomain == QCP::sdBoth)
+        && !_previewData.isEmpty()
+        )
+    {
+        const QCPRange previewRange(_previewData.first().key, _previewData.last().key);
+
+        range = foundRange ? QCPRange(qMin(range.lower, previewRange.lower), qMax(range.upper, previewRange.upper)) : previewRange;
+        foundRange = true;
+    }
+
+    return range;
+}
+
+/*!
+ * Get value range from index of sample store, so auto scaling doesn't visit every sample
+ */
+QCPRange ScopeGraph::getValueRange(bool &foundRange, QCP::SignDomain inSignDomain, const QCPRange &inKeyRange) const
+{
+    QCPRange range;
+
+    if (
+        (inSignDomain == QCP::sdBoth)
+        && hasStoreSamples()
+        )
+    {
+        range = _pSampleStore->valueRange(_graphIdx, foundRange, inKeyRange);
+    }
+    else
+    {
+        range = QCPGraph::getValueRange(foundRange, inSignDomain, inKeyRange);
+    }
+
+    if (
+        (inSignDomain == QCP::sdBoth)
+        && !_previewData.isEmpty()
+        )
+    {
+        bool bFoundPreview = false;
+        const QCPRange previewRange = previewValueRange(bFoundPreview, inKeyRange);
+
+        if (bFoundPreview)
+        {
+            range = foundRange ? QCPRange(qMin(range.lower, previewRange.lower), qMax(range.upper, previewRange.upper)) : previewRange;
+            foundRange = true;
+        }
+    }
+
+    return range;
+}
+
+void ScopeGraph::draw(QCPPainter *painter)
+{
+    QCPGraph::draw(painter);
+
+    if (
+        !_previewData.isEmpty()
+        && (mLineStyle != lsNone)
+        && (keyAxis() != nullptr)
+        && (valueAxis() != nullptr)
+        )
+    {
+        drawPreview(painter);
+    }
+}
+
+/*!
+ * Draw preview samples outside of the loaded samples with a faded pen
+ */
+void ScopeGraph::drawPreview(QCPPainter *painter) const
+{
+    QVector<QCPGraphData> beforeData;
+    QVector<QCPGraphData> afterData;
+
+    if (!hasStoreSamples())
+    {
+        afterData = _previewData;
+    }
+    else
+    {
+        const qint32 lastIdx = _pSampleStore->size() - 1;
+        const QCPGraphData firstLoaded(_pSampleStore->key(0), _pSampleStore->value(_graphIdx, 0));
+        const QCPGraphData lastLoaded(_pSampleStore->key(lastIdx), _pSampleStore->value(_graphIdx, lastIdx));
+
+        /* Connect preview to loaded data */
+        auto beforeEnd = std::lower_bound(_previewData.constBegin(), _previewData.constEnd(), firstLoaded.key,
+                                          [](const QCPGraphData &data, double key) { return data.key < key; });
+        for (auto it = _previewData.constBegin(); it != beforeEnd; ++it)
+        {
+            beforeData.append(*it);
+        }
+        beforeData.append(firstLoaded);
+
+        afterData.append(lastLoaded);
+        auto afterBegin = std::upper_bound(_previewData.constBegin(), _previewData.constEnd(), lastLoaded.key,
+                                           [](double key, const QCPGraphData &data) { return key < data.key; });
+        for (auto it = afterBegin; it != _previewData.constEnd(); ++it)
+        {
+            afterData.append(*it);
+        }
+    }
+
+    QPen previewPen = mPen;
+    QColor previewColor = previewPen.color();
+    previewColor.setAlpha(cPreviewAlpha);
+    previewPen.setColor(previewColor);
+
+    painter->setPen(previewPen);
+    painter->setBrush(Qt::NoBrush);
+
+    if (beforeData.size() > 1)
+    {
+        drawLinePlot(painter, dataToLines(beforeData));
+    }
+
+    if (afterData.size() > 1)
+    {
+        drawLinePlot(painter, dataToLines(afterData));
+    }
+}
+
+QCPRange ScopeGraph::previewValueRange(bool &foundRange, const QCPRange &inKeyRange) const
+{
+    const bool bRestrictKeys = inKeyRange != QCPRange();
+    QCPRange range;
+
+    foundRange = false;
+    for (const QCPGraphData &data : _previewData)
+    {
+        if (
+            (bRestrictKeys && !inKeyRange.contains(data.key))
+            || qIsNaN(data.value)
+            )
+        {
+            continue;
+        }
+
+        if (foundRange)
+        {
+            range.expand(data.value);
+        }
+        else
+        {
+            range = QCPRange(data.value, data.value);
+            foundRange = true;
+        }
+    }
+
+    return range;
+}
+
+bool ScopeGraph::hasStoreSamples() const
+{
+    return (_pSampleStore != nullptr)
+            && (_graphIdx >= 0)
+            && (_graphIdx < _pSampleStore->graphCount())
+            && !_pSampleStore->isEmpty();
+}
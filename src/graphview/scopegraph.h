@@ -0,0 +1,51 @@
+#ifndef SCOPEGRAPH_H
+#define SCOPEGRAPH_H
+
+#include "qcustomplot.h"
+
+/* Forward declaration */
+class GraphSampleStore;
+
+/*!
+ * Graph that draws a column of the sample store
+ * The data container of the graph only holds a window of the samples (see loadWindow()), reduced
+ * to about two points per pixel, so drawing doesn't depend on the number of samples. Key and
+ * value ranges come from the sample store, so they cover all samples.
+ *
+ * A decimated preview of the complete data set is drawn for the key range outside of
+ * the loaded samples (while a data file is loading, or when only a window is loaded).
+ */
+class ScopeGraph : public QCPGraph
+{
+    Q_OBJECT
+public:
+    explicit ScopeGraph(QCPAxis *keyAxis, QCPAxis *valueAxis);
+
+    void setSampleStore(GraphSampleStore* pSampleStore, qint32 graphIdx);
+    void loadWindow(const QCPRange &keyRange, qint32 maxBuckets);
+
+    void setPreviewData(const QList<double>& keys, const QList<double>& values);
+    void clearPreviewData();
+    bool hasPreviewData() const;
+
+    virtual QCPRange getKeyRange(bool &foundRange, QCP::SignDomain inSignDomain=QCP::sdBoth) const Q_DECL_OVERRIDE;
+    virtual QCPRange getValueRange(bool &foundRange, QCP::SignDomain inSignDomain=QCP::sdBoth, const QCPRange &inKeyRange=QCPRange()) const Q_DECL_OVERRIDE;
+
+protected:
+    virtual void draw(QCPPainter *painter) Q_DECL_OVERRIDE;
+
+private:
+    bool hasStoreSamples() const;
+    void drawPreview(QCPPainter *painter) const;
+    QCPRange previewValueRange(bool &foundRange, const QCPRange &inKeyRange) const;
+
+    GraphSampleStore* _pSampleStore;
+    qint32 _graphIdx;
+    QVector<QCPGraphData> _windowData;
+    QVector<QCPGraphData> _previewData;
+
+    static const int cPreviewAlpha = 96;
+
+};
+
+#endif // SCOPEGRAPH_H
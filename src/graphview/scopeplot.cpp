@@ -3,9 +3,12 @@
 #include "scopeplot.h"
 
 ScopePlot::ScopePlot(QWidget *parent):
-    QCustomPlot(parent)
+    QCustomPlot(parent), _frameTimer(this)
 {
+    _frameTimer.setSingleShot(true);
+    connect(&_frameTimer, &QTimer::timeout, this, &ScopePlot::renderFrame);
 
+    setMaxFrameRate(cDefaultMaxFrameRate);
 }
 
 ScopePlot::~ScopePlot()
@@ -29,3 +32,66 @@ void ScopePlot::enterEvent(QEnterEvent *event)
 
     QCustomPlot::enterEvent(event);
 }
+
+/*!
+ * Add graph on primary axes
+ * \return Pointer to graph, owned by plot
+ */
+ScopeGraph* ScopePlot::addScopeGraph()
+{
+    ScopeGraph* pGraph = new ScopeGraph(xAxis, yAxis);
+    pGraph->setName(QString("Graph %1").arg(graphCount()));
+
+    return pGraph;
+}
+
+/*!
+ * Mark plot as dirty
+ * All changes requested before the next frame are merged into a single replot.
+ * Frames are never rendered faster than the maximum frame rate.
+ */
+void ScopePlot::scheduleReplot()
+{
+    if (!_frameTimer.isActive())
+    {
+        qint64 delay = 0;
+        if (_lastFrame.isValid())
+        {
+            delay = qMax(static_cast<qint64>(0), static_cast<qint64>(_frameInterval) - _lastFrame.elapsed());
+        }
+
+        _frameTimer.start(static_cast<int>(delay));
+    }
+}
+
+quint32 ScopePlot::maxFrameRate() const
+{
+    return 1000 / _frameInterval;
+}
+
+/*!
+ * Set maximum number of frames per second
+ * \param frameRate     Frame rate (fps), clipped between 1 and 1000
+ */
+void ScopePlot::setMaxFrameRate(quint32 frameRate)
+{
+    const quint32 clippedRate = qBound(1u, frameRate, 1000u);
+
+    _frameInterval = 1000 / clippedRate;
+}
+
+/*!
+ * Render pending changes
+ * \ref frameStarted is emitted first, so receivers can apply deferred work (e.g. rescale) in this frame.
+ * Changes scheduled during that signal are included in this frame.
+ */
+void ScopePlot::renderFrame()
+{
+    emit frameStarted();
+
+    _frameTimer.stop();
+    _lastFrame.start();
+
+    /* Paint on next widget update, so it is synchronized with the window system */
+    replot(QCustomPlot::rpQueuedRefresh);
+}
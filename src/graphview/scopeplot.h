@@ -2,16 +2,40 @@
 #define SCOPEPLOT_H
 
 #include <QObject>
+#include <QTimer>
+#include <QElapsedTimer>
 #include "qcustomplot.h"
+#include "scopegraph.h"
 
 class ScopePlot : public QCustomPlot
 {
+    Q_OBJECT
 public:
     explicit ScopePlot(QWidget *parent);
     ~ScopePlot();
 
     virtual void enterEvent(QEnterEvent * event);
 
+    ScopeGraph* addScopeGraph();
+
+    void scheduleReplot();
+
+    quint32 maxFrameRate() const;
+    void setMaxFrameRate(quint32 frameRate);
+
+    static const quint32 cDefaultMaxFrameRate = 30;
+
+signals:
+    void frameStarted();
+
+private slots:
+    void renderFrame();
+
+private:
+    QTimer _frameTimer;
+    QElapsedTimer _lastFrame;
+    quint32 _frameInterval; /* in ms */
+
 };
 
 #endif // SCOPEPLOT_H
@@ -0,0 +1,65 @@
+#ifndef BINARYDATAFILE_H
+#define BINARYDATAFILE_H
+
+#include <QColor>
+#include <QStringList>
+
+#include "note.h"
+
+/*!
+ * Definition of the ModbusScope binary capture file
+ *
+ * All fields are stored little-endian.
+ *
+ * File header:
+ *      char[8]     magic ("MBSCDATA")
+ *      quint32     format version
+ *      quint32     metadata size in bytes
+ *      ...         metadata (UTF-8 encoded JSON)
+ *
+ * The header is followed by any number of chunks:
+ *      quint32     chunk magic ("CHNK")
+ *      quint32     sample count
+ *      quint32     column count (including time column)
+ *      quint32     flags
+ *      quint32     payload size in bytes
+ *      ...         payload: time column followed by one column per graph (doubles),
+ *                  compressed with qCompress when cChunkCompressed is set
+ */
+namespace BinaryDataFile
+{
+    const char cMagic[] = "MBSCDATA";
+    const quint32 cMagicSize = 8;
+    const quint32 cFormatVersion = 1;
+    const quint32 cFileHeaderSize = cMagicSize + 2 * sizeof(quint32);
+
+    const quint32 cChunkMagic = 0x4B4E4843; /* "CHNK" */
+    const quint32 cChunkHeaderSize = 5 * sizeof(quint32);
+    const quint32 cChunkCompressed = 0x1;
+
+    const char cFileSuffix[] = "mbsd";
+
+    typedef struct
+    {
+        QString label;
+        QColor color;
+        QString expression;
+        quint32 axis;
+    } Graph;
+
+    typedef struct
+    {
+        QString version;
+        qint64 startTime;
+        qint64 endTime;
+        quint32 pollTime;
+        bool bAbsoluteTimes;
+        bool bDuringLog;
+
+        QList<Graph> graphs;
+        QList<Note> notes;
+    } Metadata;
+
+}
+
+#endif // BINARYDATAFILE_H
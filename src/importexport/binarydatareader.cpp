@@ -0,0 +1,382 @@
+#include <cstring>
+
+#include <QtEndian>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include "binarydatareader.h"
+
+BinaryDataReader::BinaryDataReader()
+{
+    _pData = nullptr;
+    _size = 0;
+    _sampleCount = 0;
+}
+
+BinaryDataReader::~BinaryDataReader()
+{
+    close();
+}
+
+bool BinaryDataReader::isBinaryDataFile(QString filePath)
+{
+    QFile file(filePath);
+    if (file.open(QIODevice::ReadOnly))
+    {
+        const QByteArray magic = file.read(BinaryDataFile::cMagicSize);
+        return magic == QByteArray(BinaryDataFile::cMagic, BinaryDataFile::cMagicSize);
+    }
+
+    return false;
+}
+
+/*!
+ * Map file and index its chunks
+ * \return false when file can't be mapped or isn't a valid capture file, see errorString()
+ */
+bool BinaryDataReader::open(QString filePath)
+{
+    close();
+
+    _file.setFileName(filePath);
+    if (!_file.open(QIODevice::ReadOnly))
+    {
+        _errorString = QString("Couldn't open data file: %1").arg(filePath);
+        return false;
+    }
+
+    _size = _file.size();
+    _pData = _file.map(0, _size);
+    if (_pData == nullptr)
+    {
+        _errorString = QString("Couldn't map data file: %1").arg(filePath);
+        close();
+        return false;
+    }
+
+    if (!parseFile())
+    {
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+void BinaryDataReader::close()
+{
+    if (_pData != nullptr)
+    {
+        _file.unmap(const_cast<uchar*>(_pData));
+        _pData = nullptr;
+    }
+
+    if (_file.isOpen())
+    {
+        _file.close();
+    }
+
+    _size = 0;
+    _sampleCount = 0;
+    _chunks.clear();
+}
+
+QString BinaryDataReader::errorString() const
+{
+    return _errorString;
+}
+
+const BinaryDataFile::Metadata& BinaryDataReader::metadata() const
+{
+    return _metadata;
+}
+
+qint32 BinaryDataReader::chunkCount() const
+{
+    return _chunks.size();
+}
+
+qint64 BinaryDataReader::sampleCount() const
+{
+    return _sampleCount;
+}
+
+/*!
+ * Append samples of a chunk to the rows
+ * \param chunkIdx      index of chunk
+ * \param timeRow       time column
+ * \param dataRows      one row per graph, resized to the graph count when needed
+ */
+bool BinaryDataReader::readChunk(qint32 chunkIdx, QList<double>& timeRow, QList<QList<double> >& dataRows) const
+{
+    if ((chunkIdx < 0) || (chunkIdx >= _chunks.size()))
+    {
+        return false;
+    }
+
+    const Chunk& chunk = _chunks[chunkIdx];
+    const qint32 graphCount = _metadata.graphs.size();
+    const qint64 columnSize = static_cast<qint64>(chunk.sampleCount) * sizeof(double);
+
+    QByteArray uncompressed;
+    const uchar* pPayload = _pData + chunk.offset;
+    if (chunk.flags & BinaryDataFile::cChunkCompressed)
+    {
+        uncompressed = qUncompress(pPayload, static_cast<qsizetype>(chunk.payloadSize));
+        if (uncompressed.size() != columnSize * (graphCount + 1))
+        {
+            return false;
+        }
+
+        pPayload = reinterpret_cast<const uchar*>(uncompressed.constData());
+    }
+
+    while (dataRows.size() < graphCount)
+    {
+        dataRows.append(QList<double>());
+    }
+
+    timeRow.reserve(timeRow.size() + chunk.sampleCount);
+    for (quint32 idx = 0; idx < chunk.sampleCount; idx++)
+    {
+        timeRow.append(qFromLittleEndian<double>(pPayload + idx * sizeof(double)));
+    }
+
+    for (qint32 column = 0; column < graphCount; column++)
+    {
+        const uchar* pColumn = pPayload + (column + 1) * columnSize;
+        QList<double>& row = dataRows[column];
+
+        row.reserve(row.size() + chunk.sampleCount);
+        for (quint32 idx = 0; idx < chunk.sampleCount; idx++)
+        {
+            row.append(qFromLittleEndian<double>(pColumn + idx * sizeof(double)));
+        }
+    }
+
+    return true;
+}
+
+/*!
+ * Read evenly spaced samples of the file as quick preview of the complete data set
+ * Only a limited number of chunks (always including the first and last chunk) is decoded.
+ * \param sampleCount     maximum number of samples
+ * \param timeRow         time of samples
+ * \param dataRows        data of samples, one row per graph
+ */
+bool BinaryDataReader::readPreview(qint32 sampleCount, QList<double>& timeRow, QList<QList<double> >& dataRows) const
+{
+    timeRow.clear();
+    dataRows.clear();
+
+    if (_chunks.isEmpty() || (sampleCount <= 0))
+    {
+        return true;
+    }
+
+    QList<double> chunkTimeRow;
+    QList<QList<double> > chunkDataRows;
+    const qint32 previewChunks = (_chunks.size() < cPreviewChunkCount) ? static_cast<qint32>(_chunks.size()) : cPreviewChunkCount;
+    for (qint32 idx = 0; idx < previewChunks; idx++)
+    {
+        const qint32 chunkIdx = (previewChunks > 1) ? (idx * (_chunks.size() - 1)) / (previewChunks - 1) : 0;
+        if (!readChunk(chunkIdx, chunkTimeRow, chunkDataRows))
+        {
+            return false;
+        }
+    }
+
+    /* Subsample decoded chunks, keep last sample */
+    const qint32 decodedCount = chunkTimeRow.size();
+    const qint32 step = qMax(1, decodedCount / sampleCount);
+
+    for (qint32 column = 0; column < chunkDataRows.size(); column++)
+    {
+        dataRows.append(QList<double>());
+    }
+
+    for (qint32 idx = 0; idx < decodedCount; idx += step)
+    {
+        const qint32 sampleIdx = (idx + step >= decodedCount) ? decodedCount - 1 : idx;
+
+        timeRow.append(chunkTimeRow[sampleIdx]);
+        for (qint32 column = 0; column < chunkDataRows.size(); column++)
+        {
+            dataRows[column].append(chunkDataRows[column][sampleIdx]);
+        }
+    }
+
+    return true;
+}
+
+/*!
+ * Read complete file in the same structure as the csv parser
+ */
+bool BinaryDataReader::readData(DataFileParser::FileData* pData) const
+{
+    metadataToFileData(_metadata, pData);
+
+    for (QList<double>& dataRow : pData->dataRows)
+    {
+        dataRow.reserve(_sampleCount);
+    }
+
+    pData->timeRow.reserve(_sampleCount);
+    for (qint32 chunkIdx = 0; chunkIdx < _chunks.size(); chunkIdx++)
+    {
+        if (!readChunk(chunkIdx, pData->timeRow, pData->dataRows))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*!
+ * Fill file data with the header information of the metadata, with an empty row per graph
+ */
+void BinaryDataReader::metadataToFileData(const BinaryDataFile::Metadata& metadata, DataFileParser::FileData* pData)
+{
+    pData->axisLabel = metadata.bAbsoluteTimes ? QStringLiteral("Time") : QStringLiteral("Time (ms)");
+    pData->bAbsoluteTimes = metadata.bAbsoluteTimes;
+    pData->timeRow.clear();
+    pData->dataLabel.clear();
+    pData->dataRows.clear();
+    pData->colors.clear();
+    pData->axis.clear();
+    pData->notes = metadata.notes;
+
+    for (const BinaryDataFile::Graph& graph : metadata.graphs)
+    {
+        pData->dataLabel.append(graph.label);
+        pData->colors.append(graph.color);
+        pData->axis.append(graph.axis);
+        pData->dataRows.append(QList<double>());
+    }
+}
+
+bool BinaryDataReader::parseMetadata(const QByteArray& metadataBytes, BinaryDataFile::Metadata& metadata)
+{
+    QJsonParseError parseError;
+    const QJsonDocument document = QJsonDocument::fromJson(metadataBytes, &parseError);
+    if ((parseError.error != QJsonParseError::NoError) || !document.isObject())
+    {
+        return false;
+    }
+
+    const QJsonObject root = document.object();
+
+    metadata.version = root["version"].toString();
+    metadata.startTime = root["starttime"].toInteger();
+    metadata.endTime = root["endtime"].toInteger();
+    metadata.pollTime = static_cast<quint32>(root["polltime"].toInt());
+    metadata.bAbsoluteTimes = root["absolutetimes"].toBool();
+    metadata.bDuringLog = root["duringlog"].toBool();
+
+    metadata.graphs.clear();
+    const QJsonArray graphs = root["graphs"].toArray();
+    for (const QJsonValue& graphValue : graphs)
+    {
+        const QJsonObject graphObject = graphValue.toObject();
+
+        BinaryDataFile::Graph graph;
+        graph.label = graphObject["label"].toString();
+        graph.color = QColor(graphObject["color"].toString());
+        graph.expression = graphObject["expression"].toString();
+        graph.axis = static_cast<quint32>(graphObject["axis"].toInt());
+
+        metadata.graphs.append(graph);
+    }
+
+    metadata.notes.clear();
+    const QJsonArray notes = root["notes"].toArray();
+    for (const QJsonValue& noteValue : notes)
+    {
+        const QJsonObject noteObject = noteValue.toObject();
+
+        metadata.notes.append(Note(noteObject["text"].toString(),
+                                   QPointF(noteObject["key"].toDouble(), noteObject["value"].toDouble())));
+    }
+
+    return true;
+}
+
+bool BinaryDataReader::parseFile()
+{
+    if (
+        (_size < BinaryDataFile::cFileHeaderSize)
+        || (memcmp(_pData, BinaryDataFile::cMagic, BinaryDataFile::cMagicSize) != 0)
+    )
+    {
+        _errorString = QString("Not a ModbusScope binary data file");
+        return false;
+    }
+
+    const quint32 version = qFromLittleEndian<quint32>(_pData + BinaryDataFile::cMagicSize);
+    if (version > BinaryDataFile::cFormatVersion)
+    {
+        _errorString = QString("Unsupported binary data file version (%1)").arg(version);
+        return false;
+    }
+
+    const quint32 metadataSize = qFromLittleEndian<quint32>(_pData + BinaryDataFile::cMagicSize + sizeof(quint32));
+    if (_size < BinaryDataFile::cFileHeaderSize + static_cast<qint64>(metadataSize))
+    {
+        _errorString = QString("Binary data file header is incomplete");
+        return false;
+    }
+
+    const QByteArray metadataBytes = QByteArray::fromRawData(reinterpret_cast<const char*>(_pData + BinaryDataFile::cFileHeaderSize), metadataSize);
+    if (!parseMetadata(metadataBytes, _metadata))
+    {
+        _errorString = QString("Binary data file header is invalid");
+        return false;
+    }
+
+    const quint32 expectedColumns = static_cast<quint32>(_metadata.graphs.size()) + 1;
+
+    qint64 offset = BinaryDataFile::cFileHeaderSize + metadataSize;
+    while (offset + BinaryDataFile::cChunkHeaderSize <= _size)
+    {
+        const uchar* pHeader = _pData + offset;
+
+        Chunk chunk;
+        const quint32 magic = qFromLittleEndian<quint32>(pHeader);
+        chunk.sampleCount = qFromLittleEndian<quint32>(pHeader + 4);
+        const quint32 columnCount = qFromLittleEndian<quint32>(pHeader + 8);
+        chunk.flags = qFromLittleEndian<quint32>(pHeader + 12);
+        chunk.payloadSize = qFromLittleEndian<quint32>(pHeader + 16);
+        chunk.offset = offset + BinaryDataFile::cChunkHeaderSize;
+
+        if ((magic != BinaryDataFile::cChunkMagic) || (columnCount != expectedColumns))
+        {
+            _errorString = QString("Binary data file is corrupt at offset %1").arg(offset);
+            return false;
+        }
+
+        if (chunk.offset + chunk.payloadSize > _size)
+        {
+            /* Incomplete chunk at end of file */
+            break;
+        }
+        else if (
+            !(chunk.flags & BinaryDataFile::cChunkCompressed)
+            && (chunk.payloadSize != static_cast<qint64>(chunk.sampleCount) * columnCount * sizeof(double))
+        )
+        {
+            _errorString = QString("Binary data file is corrupt at offset %1").arg(offset);
+            return false;
+        }
+        else
+        {
+            _chunks.append(chunk);
+            _sampleCount += chunk.sampleCount;
+        }
+
+        offset = chunk.offset + chunk.payloadSize;
+    }
+
+    return true;
+}
@@ -0,0 +1,61 @@
+#ifndef BINARYDATAREADER_H
+#define BINARYDATAREADER_H
+
+#include <QFile>
+
+#include "binarydatafile.h"
+#include "datafileparser.h"
+
+/*!
+ * Reads a binary capture file through a memory mapping of the file
+ * A trailing chunk that is incomplete (for example after a crash during logging) is ignored.
+ */
+class BinaryDataReader
+{
+public:
+    BinaryDataReader();
+    ~BinaryDataReader();
+
+    static bool isBinaryDataFile(QString filePath);
+
+    bool open(QString filePath);
+    void close();
+
+    QString errorString() const;
+    const BinaryDataFile::Metadata& metadata() const;
+
+    qint32 chunkCount() const;
+    qint64 sampleCount() const;
+
+    bool readChunk(qint32 chunkIdx, QList<double>& timeRow, QList<QList<double> >& dataRows) const;
+    bool readPreview(qint32 sampleCount, QList<double>& timeRow, QList<QList<double> >& dataRows) const;
+    bool readData(DataFileParser::FileData* pData) const;
+
+    static void metadataToFileData(const BinaryDataFile::Metadata& metadata, DataFileParser::FileData* pData);
+    static bool parseMetadata(const QByteArray& metadataBytes, BinaryDataFile::Metadata& metadata);
+
+private:
+
+    typedef struct
+    {
+        qint64 offset; /* Offset of payload */
+        quint32 sampleCount;
+        quint32 flags;
+        quint32 payloadSize;
+    } Chunk;
+
+    bool parseFile();
+
+    static const qint32 cPreviewChunkCount = 32;
+
+    QFile _file;
+    const uchar* _pData;
+    qint64 _size;
+
+    QString _errorString;
+    BinaryDataFile::Metadata _metadata;
+    QList<Chunk> _chunks;
+    qint64 _sampleCount;
+};
+
+#endif // BINARYDATAREADER_H
@@ -0,0 +1,331 @@
+#include <cstring>
+
+#include <QtEndian>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include "binarydatawriter.h"
+
+BinaryDataWriter::BinaryDataWriter(bool bCompress)
+{
+    _bCompress = bCompress;
+    _metadataRegionSize = 0;
+}
+
+BinaryDataWriter::~BinaryDataWriter()
+{
+    close();
+}
+
+/*!
+ * Create (or truncate) file and write file header
+ * \param filePath          path of capture file
+ * \param metadata          metadata to embed in the header
+ * \param metadataReserve   extra space after metadata (in bytes), so the metadata can grow with updateMetadata()
+ * \return true when file is ready to receive samples
+ */
+bool BinaryDataWriter::open(QString filePath, const BinaryDataFile::Metadata& metadata, quint32 metadataReserve)
+{
+    close();
+
+    _timeColumn.clear();
+    _columns = QVector<QVector<double> >(metadata.graphs.size());
+
+    _file.setFileName(filePath);
+    if (!_file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        return false;
+    }
+
+    const QByteArray header = fileHeader(metadata, metadataReserve);
+    _metadataRegionSize = static_cast<quint32>(header.size()) - BinaryDataFile::cFileHeaderSize;
+
+    if (_file.write(header) != header.size())
+    {
+        _file.close();
+        return false;
+    }
+
+    return true;
+}
+
+/*!
+ * Open existing file to append samples
+ * The file must have the same layout as the metadata.
+ * \return true when file is ready to receive samples
+ */
+bool BinaryDataWriter::openAppend(QString filePath, const BinaryDataFile::Metadata& metadata)
+{
+    close();
+
+    _timeColumn.clear();
+    _columns = QVector<QVector<double> >(metadata.graphs.size());
+
+    /* Not in append mode, because the metadata is updated in place */
+    _file.setFileName(filePath);
+    if (!_file.open(QIODevice::ReadWrite))
+    {
+        return false;
+    }
+
+    const QByteArray header = _file.read(BinaryDataFile::cFileHeaderSize);
+    if (
+        (header.size() != static_cast<qsizetype>(BinaryDataFile::cFileHeaderSize))
+        || (memcmp(header.constData(), BinaryDataFile::cMagic, BinaryDataFile::cMagicSize) != 0)
+    )
+    {
+        _file.close();
+        return false;
+    }
+
+    _metadataRegionSize = qFromLittleEndian<quint32>(header.constData() + BinaryDataFile::cMagicSize + sizeof(quint32));
+
+    if (
+        (_file.size() < dataOffset())
+        || !_file.seek(_file.size())
+    )
+    {
+        _file.close();
+        return false;
+    }
+
+    return true;
+}
+
+void BinaryDataWriter::close()
+{
+    if (_file.isOpen())
+    {
+        flush();
+        _file.close();
+    }
+}
+
+bool BinaryDataWriter::isOpen() const
+{
+    return _file.isOpen();
+}
+
+/*!
+ * Add sample row to the current chunk
+ * \param timeData      time of sample
+ * \param dataValues    value per graph, count should match the graphs in the metadata
+ * \return false when the row doesn't match the file layout or the write failed
+ */
+bool BinaryDataWriter::append(double timeData, const QList<double>& dataValues)
+{
+    if (!_file.isOpen() || (dataValues.size() != _columns.size()))
+    {
+        return false;
+    }
+
+    _timeColumn.append(timeData);
+    for (qint32 idx = 0; idx < dataValues.size(); idx++)
+    {
+        _columns[idx].append(dataValues[idx]);
+    }
+
+    if (static_cast<quint32>(_timeColumn.size()) >= cChunkSampleCount)
+    {
+        return writeChunk();
+    }
+
+    return true;
+}
+
+/*!
+ * Write buffered samples as a (partial) chunk
+ */
+bool BinaryDataWriter::flush()
+{
+    if (!_file.isOpen())
+    {
+        return false;
+    }
+
+    bool bRet = true;
+    if (!_timeColumn.isEmpty())
+    {
+        bRet = writeChunk();
+    }
+
+    return bRet && _file.flush();
+}
+
+/*!
+ * Hand written chunks to the operating system, buffered samples stay in the current chunk
+ */
+bool BinaryDataWriter::flushFile()
+{
+    return _file.isOpen() && _file.flush();
+}
+
+/*!
+ * Replace metadata in the header, without rewriting the samples
+ * \return false when the metadata doesn't fit in the reserved space or the write failed
+ */
+bool BinaryDataWriter::updateMetadata(const BinaryDataFile::Metadata& metadata)
+{
+    QByteArray metadataBytes = serializeMetadata(metadata);
+
+    if (
+        !_file.isOpen()
+        || (static_cast<quint32>(metadataBytes.size()) > _metadataRegionSize)
+    )
+    {
+        return false;
+    }
+
+    /* Trailing whitespace is allowed after the JSON document */
+    metadataBytes.append(QByteArray(static_cast<qsizetype>(_metadataRegionSize) - metadataBytes.size(), ' '));
+
+    const qint64 endPos = _file.pos();
+
+    bool bRet = _file.seek(BinaryDataFile::cFileHeaderSize);
+    bRet = bRet && (_file.write(metadataBytes) == metadataBytes.size());
+
+    /* Always return to end of file */
+    bRet = _file.seek(endPos) && bRet;
+
+    return bRet;
+}
+
+/*!
+ * Offset of first chunk in the file
+ */
+qint64 BinaryDataWriter::dataOffset() const
+{
+    return static_cast<qint64>(BinaryDataFile::cFileHeaderSize) + _metadataRegionSize;
+}
+
+/*!
+ * Native file handle, for example to synchronize the file to disk
+ */
+int BinaryDataWriter::handle() const
+{
+    return _file.handle();
+}
+
+quint32 BinaryDataWriter::bufferedSamples() const
+{
+    return static_cast<quint32>(_timeColumn.size());
+}
+
+QByteArray BinaryDataWriter::serializeMetadata(const BinaryDataFile::Metadata& metadata)
+{
+    QJsonObject root;
+
+    root["version"] = metadata.version;
+    root["starttime"] = metadata.startTime;
+    root["endtime"] = metadata.endTime;
+    root["polltime"] = static_cast<qint64>(metadata.pollTime);
+    root["absolutetimes"] = metadata.bAbsoluteTimes;
+    root["duringlog"] = metadata.bDuringLog;
+
+    QJsonArray graphs;
+    for (const BinaryDataFile::Graph& graph : metadata.graphs)
+    {
+        QJsonObject graphObject;
+        graphObject["label"] = graph.label;
+        graphObject["color"] = graph.color.name();
+        graphObject["expression"] = graph.expression;
+        graphObject["axis"] = static_cast<qint64>(graph.axis);
+
+        graphs.append(graphObject);
+    }
+    root["graphs"] = graphs;
+
+    QJsonArray notes;
+    for (const Note& note : metadata.notes)
+    {
+        QJsonObject noteObject;
+        noteObject["key"] = note.notePosition().x();
+        noteObject["value"] = note.notePosition().y();
+        noteObject["text"] = note.text();
+
+        notes.append(noteObject);
+    }
+    root["notes"] = notes;
+
+    return QJsonDocument(root).toJson(QJsonDocument::Compact);
+}
+
+/*!
+ * Create file header with metadata, followed by reserved space (spaces)
+ */
+QByteArray BinaryDataWriter::fileHeader(const BinaryDataFile::Metadata& metadata, quint32 metadataReserve)
+{
+    QByteArray metadataBytes = serializeMetadata(metadata);
+    metadataBytes.append(QByteArray(static_cast<qsizetype>(metadataReserve), ' '));
+
+    QByteArray header(BinaryDataFile::cFileHeaderSize, '\0');
+    memcpy(header.data(), BinaryDataFile::cMagic, BinaryDataFile::cMagicSize);
+    qToLittleEndian<quint32>(BinaryDataFile::cFormatVersion, header.data() + BinaryDataFile::cMagicSize);
+    qToLittleEndian<quint32>(static_cast<quint32>(metadataBytes.size()), header.data() + BinaryDataFile::cMagicSize + sizeof(quint32));
+
+    header.append(metadataBytes);
+
+    return header;
+}
+
+bool BinaryDataWriter::writeChunk()
+{
+    const quint32 sampleCount = static_cast<quint32>(_timeColumn.size());
+    const quint32 columnCount = static_cast<quint32>(_columns.size()) + 1;
+    const qint64 columnSize = static_cast<qint64>(sampleCount) * sizeof(double);
+
+    _payload.resize(columnSize * columnCount);
+
+    char* pDest = _payload.data();
+    for (quint32 idx = 0; idx < sampleCount; idx++)
+    {
+        qToLittleEndian<double>(_timeColumn[idx], pDest + idx * sizeof(double));
+    }
+
+    for (qint32 column = 0; column < _columns.size(); column++)
+    {
+        pDest = _payload.data() + (column + 1) * columnSize;
+
+        const QVector<double>& values = _columns[column];
+        for (quint32 idx = 0; idx < sampleCount; idx++)
+        {
+            qToLittleEndian<double>(values[idx], pDest + idx * sizeof(double));
+        }
+    }
+
+    quint32 flags = 0;
+    QByteArray compressed;
+    if (_bCompress)
+    {
+        compressed = qCompress(_payload, cCompressionLevel);
+
+        /* Only keep compressed payload when it actually saves space */
+        if (compressed.size() < _payload.size())
+        {
+            flags |= BinaryDataFile::cChunkCompressed;
+        }
+    }
+
+    const QByteArray& payload = (flags & BinaryDataFile::cChunkCompressed) ? compressed : _payload;
+
+    char chunkHeader[BinaryDataFile::cChunkHeaderSize];
+    qToLittleEndian<quint32>(BinaryDataFile::cChunkMagic, chunkHeader);
+    qToLittleEndian<quint32>(sampleCount, chunkHeader + 4);
+    qToLittleEndian<quint32>(columnCount, chunkHeader + 8);
+    qToLittleEndian<quint32>(flags, chunkHeader + 12);
+    qToLittleEndian<quint32>(static_cast<quint32>(payload.size()), chunkHeader + 16);
+
+    _timeColumn.clear();
+    for (qint32 column = 0; column < _columns.size(); column++)
+    {
+        _columns[column].clear();
+    }
+
+    if (_file.write(chunkHeader, sizeof(chunkHeader)) != static_cast<qint64>(sizeof(chunkHeader)))
+    {
+        return false;
+    }
+
+    return _file.write(payload) == payload.size();
+}
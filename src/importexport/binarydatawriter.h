@@ -0,0 +1,55 @@
+#ifndef BINARYDATAWRITER_H
+#define BINARYDATAWRITER_H
+
+#include <QFile>
+#include <QVector>
+
+#include "binarydatafile.h"
+
+/*!
+ * Writes samples to a binary capture file
+ * Samples are buffered column-wise and written as a chunk when the chunk is full or on flush.
+ * Space can be reserved after the metadata, so the metadata can be updated in place while samples are appended.
+ */
+class BinaryDataWriter
+{
+public:
+    explicit BinaryDataWriter(bool bCompress = true);
+    ~BinaryDataWriter();
+
+    bool open(QString filePath, const BinaryDataFile::Metadata& metadata, quint32 metadataReserve = 0);
+    bool openAppend(QString filePath, const BinaryDataFile::Metadata& metadata);
+    void close();
+    bool isOpen() const;
+
+    bool updateMetadata(const BinaryDataFile::Metadata& metadata);
+    qint64 dataOffset() const;
+    int handle() const;
+
+    bool append(double timeData, const QList<double>& dataValues);
+    bool flush();
+    bool flushFile();
+
+    quint32 bufferedSamples() const;
+
+    static QByteArray serializeMetadata(const BinaryDataFile::Metadata& metadata);
+    static QByteArray fileHeader(const BinaryDataFile::Metadata& metadata, quint32 metadataReserve);
+
+    static const quint32 cChunkSampleCount = 4096;
+    static const int cCompressionLevel = 1;
+
+private:
+    bool writeChunk();
+
+    QFile _file;
+    bool _bCompress;
+
+    /* Size of metadata, including reserved space */
+    quint32 _metadataRegionSize;
+
+    QVector<double> _timeColumn;
+    QVector<QVector<double> > _columns;
+    QByteArray _payload;
+};
+
+#endif // BINARYDATAWRITER_H
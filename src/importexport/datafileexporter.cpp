@@ -1,6 +1,4 @@
-
 #include "util.h"
-#include "formatdatetime.h"
 
 #include "qcustomplot.h"
 #include "guimodel.h"
@@ -8,6 +6,8 @@
 #include "graphdatamodel.h"
 
 #include "datafileexporter.h"
+#include "binarydatawriter.h"
+#include "lazydatasource.h"
 #include "notemodel.h"
 
 DataFileExporter::DataFileExporter(GuiModel *pGuiModel, SettingsModel * pSettingsModel, GraphDataModel * pGraphDataModel, NoteModel *pNoteModel, QObject *parent) :
@@ -18,28 +18,44 @@ DataFileExporter::DataFileExporter(GuiModel *pGuiModel, SettingsModel * pSetting
     _pGraphDataModel = pGraphDataModel;
     _pNoteModel = pNoteModel;
 
-    lastLogTime = QDateTime::currentMSecsSinceEpoch();
+    _pLogWriter = new DataLogWriter();
+    _pLogWriter->moveToThread(&_logThread);
+    connect(_pLogWriter, &DataLogWriter::writeErrorOccurred, this, &DataFileExporter::handleLogWriteError);
+
+    _logThread.start();
 }
 
 DataFileExporter::~DataFileExporter()
 {
+    disableExporterDuringLog();
+
+    _logThread.quit();
+    _logThread.wait();
 
+    delete _pLogWriter;
 }
 
 void DataFileExporter::enableExporterDuringLog()
 {
-    _dataExportBuffer.clear();
-    lastLogTime = QDateTime::currentMSecsSinceEpoch();
+    const DataLogWriter::Settings logSettings = constructLogSettings();
 
-    // Clean file
-    clearFile(_pSettingsModel->writeDuringLogFile());
+    bool bRet = false;
+    QMetaObject::invokeMethod(_pLogWriter, [this, &bRet, &logSettings]() {
+        bRet = _pLogWriter->open(logSettings);
+    }, Qt::BlockingQueuedConnection);
 
-    exportDataHeader();
+    if (!bRet)
+    {
+        reportWriteError(logSettings.filePath);
+    }
 }
 
 void DataFileExporter::disableExporterDuringLog()
 {
-    flushExportBuffer();
+    /* Waits until all queued samples are written */
+    QMetaObject::invokeMethod(_pLogWriter, [this]() {
+        _pLogWriter->close();
+    }, Qt::BlockingQueuedConnection);
 }
 
 void DataFileExporter::exportDataLine(double timeData, QList <double> dataValues)
@@ -48,27 +64,60 @@ void DataFileExporter::exportDataLine(double timeData, QList <double> dataValues
 
     if (_pSettingsModel->writeDuringLog())
     {
-        // Use buffering
-        _dataExportBuffer.append(formatData(timeData, dataValues));
-
-        if ((QDateTime::currentMSecsSinceEpoch() - lastLogTime) > _cLogBufferTimeout)
-        {
-            flushExportBuffer();
-        }
+        /* Formatting and writing is done on log thread */
+        _pLogWriter->push(timeData, dataValues);
     }
 }
 
 void DataFileExporter::rewriteDataFile(void)
 {
-    _dataExportBuffer.clear();
-    lastLogTime = QDateTime::currentMSecsSinceEpoch();
+    if (_pLogWriter->isOpen())
+    {
+        /* Restart log with current data (normally none, after data is cleared) */
+        enableExporterDuringLog();
+
+        forEachDataRow([this](double key, const QList<double>& dataRowValues) {
+            return _pLogWriter->push(key, dataRowValues);
+        });
+    }
+    else
+    {
+        exportDataFile(_pSettingsModel->writeDuringLogFile());
+    }
+}
+
+/*!
+ * Update header of log file (for example after a color change)
+ * During a log, only the header is updated on the log thread, the samples aren't rewritten.
+ */
+void DataFileExporter::updateDataFileHeader(void)
+{
+    if (_pLogWriter->isOpen())
+    {
+        const DataLogWriter::Settings logSettings = constructLogSettings();
 
-    exportDataFile(_pSettingsModel->writeDuringLogFile());
+        QMetaObject::invokeMethod(_pLogWriter, [this, logSettings]() {
+            _pLogWriter->updateHeader(logSettings);
+        }, Qt::QueuedConnection);
+    }
+    else
+    {
+        rewriteDataFile();
+    }
+}
+
+void DataFileExporter::handleLogWriteError(QString filePath)
+{
+    reportWriteError(filePath);
 }
 
 void DataFileExporter::exportDataFile(QString dataFile)
 {
-    if (_pGraphDataModel->activeCount() != 0)
+    if (isBinaryDataFile(dataFile))
+    {
+        exportBinaryDataFile(dataFile);
+    }
+    else if (_pGraphDataModel->activeCount() != 0)
     {
         QStringList logData;
 
@@ -88,44 +137,21 @@ void DataFileExporter::exportDataFile(QString dataFile)
 
         if (bRet)
         {
-            QList<quint16> activeGraphIndexes;
-            _pGraphDataModel->activeGraphIndexList(&activeGraphIndexes);
-            QList<QCPGraphDataContainer::const_iterator> dataListIterators;
-
-            for(qint32 idx = 0; idx < activeGraphIndexes.size(); idx++)
-            {
-                // Save iterators to data lists
-                dataListIterators.append(_pGraphDataModel->dataMap(activeGraphIndexes[idx])->constBegin());
-            }
-
             // Add data lines
-            const qint32 dataCount = _pGraphDataModel->dataMap(activeGraphIndexes[0])->size();
-            for(qint32 i = 0; i < dataCount; i++)
-            {
-                QList<double> dataRowValues;
-                double key = dataListIterators[0]->key;
-                for(qint32 d = 0; d < dataListIterators.size(); d++)
-                {
-                    dataRowValues.append(dataListIterators[d]->value);
-
-                    dataListIterators[d]++;
-                }
-
+            qint64 lineIdx = 0;
+            forEachDataRow([&](double key, const QList<double>& dataRowValues) {
                 logData.append(formatData(key, dataRowValues));
 
-
-                if ( i % _cLogChunkLineCount == 0)
+                if (lineIdx % _cLogChunkLineCount == 0)
                 {
                     bRet = writeToFile(dataFile, logData);
 
                     logData.clear();
-
-                    if (!bRet)
-                    {
-                        break;
-                    }
                 }
-            }
+                lineIdx++;
+
+                return bRet;
+            });
 
             if (bRet && (logData.size() > 0))
             {
@@ -137,6 +163,20 @@ void DataFileExporter::exportDataFile(QString dataFile)
 
 bool DataFileExporter::updateNoteLines(QString dataFile)
 {
+    if (isBinaryDataFile(dataFile))
+    {
+        /* Notes are part of the embedded header, so rewrite the complete file */
+        if (exportBinaryDataFile(dataFile))
+        {
+            _pNoteModel->setNotesDataUpdated(false);
+            return true;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
     bool bSuccess = true;
 
     QFileInfo fileInfo(dataFile);
@@ -246,27 +286,117 @@ bool DataFileExporter::updateNoteLines(QString dataFile)
     }
 }
 
-void DataFileExporter::flushExportBuffer()
+bool DataFileExporter::isBinaryDataFile(QString filePath)
 {
-    // Write to file
-    writeToFile(_pSettingsModel->writeDuringLogFile(), _dataExportBuffer);
+    return QFileInfo(filePath).suffix().toLower() == QString(BinaryDataFile::cFileSuffix);
+}
+
+/*!
+ * Write all graph data to a binary capture file
+ */
+bool DataFileExporter::exportBinaryDataFile(QString dataFile)
+{
+    BinaryDataWriter writer;
+    BinaryDataWriter* pWriter = &writer;
+
+    /* Data file that is browsed lazily is memory mapped, so it can't be rewritten */
+    QSharedPointer<LazyDataSource> pSource = _pGraphDataModel->lazyDataSource();
+    if (
+        !pSource.isNull()
+        && (QFileInfo(pSource->filePath()).canonicalFilePath() == QFileInfo(dataFile).canonicalFilePath())
+    )
+    {
+        Util::showError(tr("Data file (%1) is opened, save to another file").arg(dataFile));
+        return false;
+    }
+
+    bool bRet = pWriter->open(dataFile, constructMetadata(false));
+    if (bRet)
+    {
+        bRet = forEachDataRow([pWriter](double key, const QList<double>& dataRowValues) {
+            return pWriter->append(key, dataRowValues);
+        });
+
+        if (bRet)
+        {
+            bRet = pWriter->flush();
+        }
+    }
 
-    _dataExportBuffer.clear();
-    lastLogTime = QDateTime::currentMSecsSinceEpoch();
+    if (!bRet)
+    {
+        pWriter->close();
+        reportWriteError(dataFile);
+    }
+
+    return bRet;
 }
 
-void DataFileExporter::exportDataHeader()
+/*!
+ * Call function for every sample of the active graphs, until the function returns false
+ * When a data file is browsed lazily, the samples are read from the data file block by block,
+ * so the complete data set is exported and not only the loaded window.
+ * \return false when a row is rejected or the data file can't be read
+ */
+bool DataFileExporter::forEachDataRow(const std::function<bool(double, const QList<double>&)>& rowFunction)
 {
-    QStringList logData;
+    QList<quint16> activeGraphIndexes;
+    _pGraphDataModel->activeGraphIndexList(&activeGraphIndexes);
+
+    if (activeGraphIndexes.isEmpty())
+    {
+        return true;
+    }
+
+    QList<double> dataRowValues;
+    QSharedPointer<LazyDataSource> pSource = _pGraphDataModel->lazyDataSource();
+    if (!pSource.isNull())
+    {
+        QList<double> timeRow;
+        QList<QList<double> > dataRows;
+        for (qint32 blockIdx = 0; blockIdx < pSource->blockCount(); blockIdx++)
+        {
+            if (!pSource->readBlock(blockIdx, timeRow, dataRows))
+            {
+                return false;
+            }
 
-    // create header
-    logData.append(constructDataHeader(true));
+            for (qint32 i = 0; i < timeRow.size(); i++)
+            {
+                dataRowValues.clear();
+                for (quint16 graphIdx : qAsConst(activeGraphIndexes))
+                {
+                    dataRowValues.append(dataRows[graphIdx][i]);
+                }
 
-    // Create label row
-    logData.append(createPropertyRow(E_LABEL));
+                if (!rowFunction(timeRow[i], dataRowValues))
+                {
+                    return false;
+                }
+            }
+        }
+    }
+    else
+    {
+        /* Rows are read straight from the columns of the sample store */
+        const GraphSampleStore* pSampleStore = _pGraphDataModel->sampleStore();
+        for(qint32 i = 0; i < pSampleStore->size(); i++)
+        {
+            dataRowValues.clear();
+            for (quint16 graphIdx : qAsConst(activeGraphIndexes))
+            {
+                /* Invalid samples are exported as NaN, so they aren't mistaken for a value */
+                dataRowValues.append(pSampleStore->validValue(graphIdx, i));
+            }
+
+            if (!rowFunction(pSampleStore->key(i), dataRowValues))
+            {
+                return false;
+            }
+        }
+    }
 
-    // Write to file
-    writeToFile(_pSettingsModel->writeDuringLogFile(), logData);
+    return true;
 }
 
 QStringList DataFileExporter::constructDataHeader(bool bDuringLog)
@@ -336,6 +466,83 @@ QStringList DataFileExporter::constructDataHeader(bool bDuringLog)
     return header;
 }
 
+BinaryDataFile::Metadata DataFileExporter::constructMetadata(bool bDuringLog)
+{
+    BinaryDataFile::Metadata metadata;
+
+    metadata.version = Util::currentVersion();
+    metadata.startTime = _pGuiModel->communicationStartTime();
+    metadata.endTime = bDuringLog ? 0 : _pGuiModel->communicationEndTime();
+    metadata.pollTime = _pSettingsModel->pollTime();
+    metadata.bAbsoluteTimes = _pSettingsModel->absoluteTimes();
+    metadata.bDuringLog = bDuringLog;
+
+    for(qint32 i = 0; i < _pGraphDataModel->activeCount(); i++)
+    {
+        const qint32 graphIdx = _pGraphDataModel->convertToGraphIndex(i);
+
+        BinaryDataFile::Graph graph;
+        graph.label = _pGraphDataModel->label(graphIdx);
+        graph.color = _pGraphDataModel->color(graphIdx);
+        graph.expression = _pGraphDataModel->simplifiedExpression(graphIdx);
+        graph.axis = _pGraphDataModel->valueAxis(graphIdx) == GraphData::VALUE_AXIS_PRIMARY ? 0 : 1;
+
+        metadata.graphs.append(graph);
+    }
+
+    for (qint32 idx = 0; idx < _pNoteModel->size(); idx++)
+    {
+        metadata.notes.append(Note(_pNoteModel->textData(idx), _pNoteModel->notePosition(idx)));
+    }
+
+    return metadata;
+}
+
+/*!
+ * Synchronization to disk of log file during communication, as selected in settings
+ */
+DataLogWriter::SyncPolicy DataFileExporter::logSyncPolicy()
+{
+    switch (_pSettingsModel->logSyncPolicy())
+    {
+    case SettingsModel::LOG_SYNC_NONE:
+        return DataLogWriter::SYNC_NONE;
+
+    case SettingsModel::LOG_SYNC_EVERY_BATCH:
+        return DataLogWriter::SYNC_EVERY_BATCH;
+
+    case SettingsModel::LOG_SYNC_PERIODIC:
+    default:
+        return DataLogWriter::SYNC_PERIODIC;
+    }
+}
+
+/*!
+ * Settings of log file during communication, including the header of the file
+ */
+DataLogWriter::Settings DataFileExporter::constructLogSettings()
+{
+    DataLogWriter::Settings logSettings;
+
+    logSettings.filePath = _pSettingsModel->writeDuringLogFile();
+    logSettings.bBinary = isBinaryDataFile(logSettings.filePath);
+    logSettings.columnCount = _pGraphDataModel->activeCount();
+    logSettings.syncPolicy = logSyncPolicy();
+    logSettings.bAbsoluteTimes = _pSettingsModel->absoluteTimes();
+
+    if (logSettings.bBinary)
+    {
+        logSettings.metadata = constructMetadata(true);
+    }
+    else
+    {
+        logSettings.headerLines = constructDataHeader(true);
+        logSettings.headerLines.append(createPropertyRow(E_LABEL));
+    }
+
+    return logSettings;
+}
+
 QString DataFileExporter::constructConnSettings(quint8 connectionId)
 {
     QString strSettings;
@@ -463,28 +670,7 @@ QString DataFileExporter::createPropertyRow(registerProperty prop)
 
 QString DataFileExporter::formatData(double timeData, QList<double> dataValues)
 {
-    QString line;
-
-    if (_pSettingsModel->absoluteTimes())
-    {
-        QDateTime dateTime;
-        dateTime.setMSecsSinceEpoch(timeData);
-        line.append(FormatDateTime::formatDateTime(dateTime));
-    }
-    else
-    {
-        // Format time (no decimals)
-        const quint64 t = static_cast<quint64>(timeData);
-        line.append(QString::number(t, 'f', 0));
-    }
-
-    // Add formatted data (maximum 3 decimals, no trailing zeros)
-    for(qint32 d = 0; d < dataValues.size(); d++)
-    {
-        line.append(Util::separatorCharacter() + Util::formatDoubleForExport(dataValues[d]));
-    }
-
-    return line;
+    return DataLogWriter::formatDataLine(timeData, dataValues, _pSettingsModel->absoluteTimes());
 }
 
 bool DataFileExporter::writeToFile(QString filePath, QStringList logData)
@@ -504,21 +690,26 @@ bool DataFileExporter::writeToFile(QString filePath, QStringList logData)
     }
     else
     {
-        if (
-                (_pSettingsModel->writeDuringLogFile() == filePath)
-                && (_pSettingsModel->writeDuringLog())
-            )
-        {
-            // Disable logging to file on write error
-            _pSettingsModel->setWriteDuringLog(false);
-        }
-
-        Util::showError(tr("Save to data file (%1) failed").arg(filePath));
+        reportWriteError(filePath);
     }
 
     return bRet;
 }
 
+void DataFileExporter::reportWriteError(QString filePath)
+{
+    if (
+            (_pSettingsModel->writeDuringLogFile() == filePath)
+            && (_pSettingsModel->writeDuringLog())
+        )
+    {
+        // Disable logging to file on write error
+        _pSettingsModel->setWriteDuringLog(false);
+    }
+
+    Util::showError(tr("Save to data file (%1) failed").arg(filePath));
+}
+
 void DataFileExporter::clearFile(QString filePath)
 {
     QFile file(filePath);
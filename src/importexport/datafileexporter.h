@@ -3,6 +3,11 @@
 
 #include <QObject>
 #include <QStringList>
+#include <QThread>
+#include <functional>
+
+#include "binarydatafile.h"
+#include "datalogwriter.h"
 
 /* Forward declaration */
 class SettingsModel;
@@ -23,11 +28,17 @@ public:
     void exportDataFile(QString dataFile);
     bool updateNoteLines(QString dataFile);
 
+    static bool isBinaryDataFile(QString filePath);
+
 signals:
 
 public slots:
     void exportDataLine(double timeData, QList <double> dataValues);
     void rewriteDataFile(void);
+    void updateDataFileHeader(void);
+
+private slots:
+    void handleLogWriteError(QString filePath);
 
 private:
 
@@ -41,14 +52,18 @@ private:
 
     } registerProperty;
 
-    void flushExportBuffer();
-    void exportDataHeader();
+    bool exportBinaryDataFile(QString dataFile);
+    bool forEachDataRow(const std::function<bool(double, const QList<double>&)>& rowFunction);
     QStringList constructDataHeader(bool bDuringLog);
+    BinaryDataFile::Metadata constructMetadata(bool bDuringLog);
+    DataLogWriter::Settings constructLogSettings();
+    DataLogWriter::SyncPolicy logSyncPolicy();
     QString constructConnSettings(quint8 connectionId);
     void createNoteRows(QStringList& noteRows);
     QString createPropertyRow(registerProperty prop);
     QString formatData(double timeData, QList<double> dataValues);
     bool writeToFile(QString filePath, QStringList logData);
+    void reportWriteError(QString filePath);
     void clearFile(QString filePath);
 
     GuiModel * _pGuiModel;
@@ -56,10 +71,10 @@ private:
     GraphDataModel * _pGraphDataModel;
     NoteModel * _pNoteModel;
 
-    QStringList _dataExportBuffer;
-    quint64 lastLogTime;
+    /* Log during communication is written on a separate thread */
+    QThread _logThread;
+    DataLogWriter * _pLogWriter;
 
-    static const quint64 _cLogBufferTimeout = 1000; /* in milliseconds */
     static const quint32 _cLogChunkLineCount = 1000;
 
 };
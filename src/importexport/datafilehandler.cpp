@@ -1,4 +1,6 @@
 #include "datafileparser.h"
+#include "binarydatareader.h"
+#include "lazydatasource.h"
 #include "settingsauto.h"
 #include "util.h"
 
@@ -7,7 +9,9 @@
 #include "fileselectionhelper.h"
 
 #include <QWidget>
+#include <QFileInfo>
 #include <QProgressDialog>
+#include <QThread>
 
 DataFileHandler::DataFileHandler(GuiModel* pGuiModel, GraphDataModel* pGraphDataModel, NoteModel* pNoteModel, SettingsModel * pSettingsModel, DataParserModel * pDataParserModel, QWidget *parent) : QObject(parent)
 {
@@ -20,20 +24,52 @@ DataFileHandler::DataFileHandler(GuiModel* pGuiModel, GraphDataModel* pGraphData
     _pDataFileStream = nullptr;
     _pDataFile = nullptr;
 
+    _pDataParser = nullptr;
+    _pBinaryReader = nullptr;
+    _nextChunkIdx = 0;
+    _bDataLoadActive = false;
+
     _pDataFileExporter = new DataFileExporter(_pGuiModel, _pSettingsModel, _pGraphDataModel, _pNoteModel);
 
+    /* Single shot, so a batch is never started from a (modal) event loop of a previous batch */
+    _loadTimer.setSingleShot(true);
+    _loadTimer.setInterval(0);
+    connect(&_loadTimer, &QTimer::timeout, this, &DataFileHandler::loadNextDataBatch);
+
     connect(this, &DataFileHandler::startDataParsing, this, &DataFileHandler::parseDataFile);
+    connect(_pGuiModel, &GuiModel::guiStateChanged, this, &DataFileHandler::handleGuiStateChange);
 }
 
 DataFileHandler::~DataFileHandler()
 {
     delete _pDataFileExporter;
 
+    stopDataLoad();
     cleanUpFileHandler();
 }
 
 void DataFileHandler::openDataFile(QString dataFilePath)
 {
+    /* Cancel load of previous file */
+    stopDataLoad();
+    cleanUpFileHandler();
+
+    if (BinaryDataReader::isBinaryDataFile(dataFilePath))
+    {
+        _pDataParserModel->setDataFilePath(dataFilePath);
+
+        if (QFileInfo(dataFilePath).size() > _cLazyLoadThreshold)
+        {
+            openLazyDataFile(dataFilePath);
+        }
+        else
+        {
+            parseBinaryDataFile(dataFilePath);
+        }
+
+        return;
+    }
+
     _pDataFile = new QFile(dataFilePath);
 
     bool bModbusScopeDataFile = false;
@@ -127,7 +163,7 @@ void DataFileHandler::selectDataImportFile()
     dialog.setDefaultSuffix("csv");
     dialog.setWindowTitle(tr("Select data file"));
 
-    QStringList extensionFilter = QStringList() << tr("csv file (*.csv)") << tr("any file (*)");
+    QStringList extensionFilter = QStringList() << tr("csv file (*.csv)") << tr("binary data file (*.mbsd)") << tr("any file (*)");
     dialog.setNameFilters(extensionFilter);
 
     QString selectedFile = FileSelectionHelper::showDialog(&dialog);
@@ -142,7 +178,7 @@ void DataFileHandler::selectDataExportFile()
     QFileDialog dialog;
     FileSelectionHelper::configureFileDialog(&dialog,
                                              FileSelectionHelper::DIALOG_TYPE_SAVE,
-                                             FileSelectionHelper::FILE_TYPE_CSV);
+                                             FileSelectionHelper::FILE_TYPE_DATA);
 
     QString selectedFile = FileSelectionHelper::showDialog(&dialog);
     if (!selectedFile.isEmpty())
@@ -161,73 +197,296 @@ void DataFileHandler::rewriteDataFile(void)
     _pDataFileExporter->rewriteDataFile();
 }
 
+void DataFileHandler::updateDataFileHeader(void)
+{
+    _pDataFileExporter->updateDataFileHeader();
+}
+
 void DataFileHandler::parseDataFile()
 {
     if (_pDataFileStream != nullptr)
     {
-        DataFileParser dataParser(_pDataParserModel);
         DataFileParser::FileData data;
-        QProgressDialog progressDialog("Loading file...", QString(), 0, 100, dynamic_cast<QWidget *>(parent()));
 
-        progressDialog.setWindowModality(Qt::WindowModal);
-        progressDialog.setMinimumDuration(0);
+        _pDataParser = new DataFileParser(_pDataParserModel);
+        connect(_pDataParser, &DataFileParser::parseErrorOccurred, this, &DataFileHandler::handleError);
 
-        connect(&dataParser, &DataFileParser::parseErrorOccurred, this, &DataFileHandler::handleError);
-        connect(&dataParser, &DataFileParser::updateProgress, &progressDialog, &QProgressDialog::setValue);
+        if (!_pDataParser->processDataFileHeader(_pDataFileStream, &data))
+        {
+            stopDataLoad();
+            cleanUpFileHandler();
+        }
+        else if (_pDataParser->startMappedData(_pDataFileStream))
+        {
+            /* File is kept open (and mapped) until the last batch is loaded */
+            QList<double> previewTimeRow;
+            QList<QList<double> > previewDataRows;
+            _pDataParser->previewMappedData(_cPreviewSampleCount, previewTimeRow, previewDataRows);
 
-        if (dataParser.processDataFile(_pDataFileStream, &data))
+            startDataLoad(data, previewTimeRow, previewDataRows);
+        }
+        else
         {
-            progressDialog.setValue(progressDialog.maximum());
+            QProgressDialog progressDialog("Loading file...", QString(), 0, 100, dynamic_cast<QWidget *>(parent()));
 
-            _pGraphDataModel->clear();
-            _pGuiModel->setFrontGraph(-1);
+            progressDialog.setWindowModality(Qt::WindowModal);
+            progressDialog.setMinimumDuration(0);
 
-            _pGraphDataModel->add(data.dataLabel);
+            connect(_pDataParser, &DataFileParser::updateProgress, &progressDialog, &QProgressDialog::setValue);
 
-            if (!data.colors.isEmpty() && data.colors.count() == data.dataLabel.size())
+            if (_pDataParser->processDataLines(_pDataFileStream, &data))
             {
-                for (int idx = 0; idx < data.dataLabel.size(); idx++)
-                {
-                    _pGraphDataModel->setColor(static_cast<quint32>(idx), data.colors[idx]);
-                }
-            }
+                progressDialog.setValue(progressDialog.maximum());
 
-            if (!data.axis.isEmpty() && data.axis.count() == data.dataLabel.size())
+                loadFileData(data);
+            }
+            else
             {
-                for (int idx = 0; idx < data.dataLabel.size(); idx++)
-                {
-                    auto valueAxis = data.axis[idx] == 1 ? GraphData::VALUE_AXIS_SECONDARY : GraphData::VALUE_AXIS_PRIMARY;
-                    _pGraphDataModel->setValueAxis(static_cast<quint32>(idx), valueAxis);
-                }
+                progressDialog.cancel();
             }
 
-            _pGraphDataModel->setAllData(data.timeRow, data.dataRows);
+            stopDataLoad();
+            cleanUpFileHandler();
+        }
+    }
+}
 
-            _pNoteModel->clear();
-            if (!data.notes.isEmpty())
-            {
-                foreach(Note note, data.notes)
-                {
-                    _pNoteModel->add(note);
-                }
-            }
-            _pNoteModel->setNotesDataUpdated(false);
+void DataFileHandler::parseBinaryDataFile(QString dataFilePath)
+{
+    _pBinaryReader = new BinaryDataReader();
 
-            _pGuiModel->setFrontGraph(0);
-            _pGuiModel->setProjectFilePath("");
-            _pGuiModel->clearMarkersState();
-            _pGuiModel->setGuiState(GuiModel::DATA_LOADED);
+    if (_pBinaryReader->open(dataFilePath))
+    {
+        DataFileParser::FileData data;
+        QList<double> previewTimeRow;
+        QList<QList<double> > previewDataRows;
+
+        BinaryDataReader::metadataToFileData(_pBinaryReader->metadata(), &data);
+
+        /* Export of loaded data uses time format of file */
+        _pSettingsModel->setAbsoluteTimes(data.bAbsoluteTimes);
+
+        if (_pBinaryReader->readPreview(_cPreviewSampleCount, previewTimeRow, previewDataRows))
+        {
+            _nextChunkIdx = 0;
+            startDataLoad(data, previewTimeRow, previewDataRows);
 
+            return;
         }
-        else
+    }
+
+    Util::showError(_pBinaryReader->errorString().isEmpty() ? tr("Couldn't read data file: %1").arg(dataFilePath) : _pBinaryReader->errorString());
+
+    stopDataLoad();
+}
+
+/*!
+ * Browse binary data file without loading all samples
+ * Only an overview of the complete file and a window around the visible range are loaded.
+ * The first time a file is opened, it is indexed once; the index is cached next to the file.
+ */
+void DataFileHandler::openLazyDataFile(QString dataFilePath)
+{
+    QSharedPointer<LazyDataSource> pSource(new LazyDataSource());
+
+    QProgressDialog progressDialog(tr("Indexing file..."), QString(), 0, 100, dynamic_cast<QWidget *>(parent()));
+    progressDialog.setWindowModality(Qt::WindowModal);
+    progressDialog.setMinimumDuration(0);
+
+    const bool bRet = pSource->open(dataFilePath, [&progressDialog](int percentage) {
+        progressDialog.setValue(percentage);
+    });
+
+    progressDialog.setValue(progressDialog.maximum());
+
+    if (!bRet)
+    {
+        Util::showError(pSource->errorString());
+        return;
+    }
+
+    DataFileParser::FileData data;
+    BinaryDataReader::metadataToFileData(pSource->metadata(), &data);
+
+    /* Export of loaded data uses time format of file */
+    _pSettingsModel->setAbsoluteTimes(data.bAbsoluteTimes);
+
+    loadFileData(data);
+
+    QList<double> overviewTimeRow;
+    QList<QList<double> > overviewDataRows;
+    bool bFoundRange = false;
+    const QCPRange fileRange = pSource->keyRange(bFoundRange);
+    if (bFoundRange)
+    {
+        pSource->window(fileRange, _cPreviewSampleCount, overviewTimeRow, overviewDataRows);
+    }
+
+    _pGraphDataModel->setLazyDataSource(pSource);
+    _pGraphDataModel->setPreviewData(overviewTimeRow, overviewDataRows);
+}
+
+/*!
+ * Show graphs with preview of data and start loading the data in batches
+ */
+void DataFileHandler::startDataLoad(DataFileParser::FileData& data, QList<double>& previewTimeRow, QList<QList<double> >& previewDataRows)
+{
+    /* Create graphs without data */
+    data.timeRow.clear();
+    data.dataRows.clear();
+    for (qint32 idx = 0; idx < data.dataLabel.size(); idx++)
+    {
+        data.dataRows.append(QList<double>());
+    }
+
+    loadFileData(data);
+
+    _pGraphDataModel->setPreviewData(previewTimeRow, previewDataRows);
+
+    _bDataLoadActive = true;
+    _loadTimer.start();
+}
+
+/*!
+ * Append next batch of data to the graphs
+ */
+void DataFileHandler::loadNextDataBatch()
+{
+    QList<double> timeRow;
+    QList<QList<double> > dataRows;
+    bool bRet = true;
+    bool bDone = false;
+
+    if (_pDataParser != nullptr)
+    {
+        const qint64 batchSize = _cBatchSizePerThread * QThread::idealThreadCount();
+
+        bRet = _pDataParser->parseNextMappedData(batchSize, timeRow, dataRows);
+
+        /* Load can be cancelled from the event loop of the error dialog */
+        bDone = (_pDataParser == nullptr) || _pDataParser->mappedDataAtEnd();
+    }
+    else if (_pBinaryReader != nullptr)
+    {
+        const qint32 lastChunkIdx = qMin(_nextChunkIdx + _cBinaryBatchChunks, _pBinaryReader->chunkCount());
+        while (bRet && (_nextChunkIdx < lastChunkIdx))
         {
-            progressDialog.cancel();
+            bRet = _pBinaryReader->readChunk(_nextChunkIdx, timeRow, dataRows);
+            _nextChunkIdx++;
         }
 
+        bDone = _nextChunkIdx >= _pBinaryReader->chunkCount();
+
+        if (!bRet)
+        {
+            Util::showError(tr("Binary data file is corrupt (chunk %1)").arg(_nextChunkIdx - 1));
+        }
+    }
+    else
+    {
+        bDone = true;
+    }
+
+    if (bRet && !timeRow.isEmpty())
+    {
+        _pGraphDataModel->appendAllData(timeRow, dataRows);
+    }
+
+    /* On error, the data that is already loaded is kept */
+    if (!bRet || bDone)
+    {
+        stopDataLoad();
+        cleanUpFileHandler();
+    }
+    else if (_bDataLoadActive)
+    {
+        _loadTimer.start();
+    }
+    else
+    {
+        /* Load is cancelled while processing batch */
+    }
+}
+
+/*!
+ * Stop progressive load, a load is cancelled when the application leaves the data loaded state
+ */
+void DataFileHandler::handleGuiStateChange()
+{
+    if (_bDataLoadActive && (_pGuiModel->guiState() != GuiModel::DATA_LOADED))
+    {
+        stopDataLoad();
         cleanUpFileHandler();
     }
 }
 
+void DataFileHandler::stopDataLoad()
+{
+    _loadTimer.stop();
+
+    if (_bDataLoadActive)
+    {
+        _bDataLoadActive = false;
+
+        _pGraphDataModel->clearPreviewData();
+    }
+
+    if (_pDataParser != nullptr)
+    {
+        /* Parser can still be on the call stack when the load is cancelled while reporting an error */
+        _pDataParser->stopMappedData();
+        _pDataParser->deleteLater();
+        _pDataParser = nullptr;
+    }
+
+    if (_pBinaryReader != nullptr)
+    {
+        delete _pBinaryReader;
+        _pBinaryReader = nullptr;
+    }
+}
+
+void DataFileHandler::loadFileData(DataFileParser::FileData& data)
+{
+    _pGraphDataModel->clear();
+    _pGuiModel->setFrontGraph(-1);
+
+    _pGraphDataModel->add(data.dataLabel);
+
+    if (!data.colors.isEmpty() && data.colors.count() == data.dataLabel.size())
+    {
+        for (int idx = 0; idx < data.dataLabel.size(); idx++)
+        {
+            _pGraphDataModel->setColor(static_cast<quint32>(idx), data.colors[idx]);
+        }
+    }
+
+    if (!data.axis.isEmpty() && data.axis.count() == data.dataLabel.size())
+    {
+        for (int idx = 0; idx < data.dataLabel.size(); idx++)
+        {
+            auto valueAxis = data.axis[idx] == 1 ? GraphData::VALUE_AXIS_SECONDARY : GraphData::VALUE_AXIS_PRIMARY;
+            _pGraphDataModel->setValueAxis(static_cast<quint32>(idx), valueAxis);
+        }
+    }
+
+    _pGraphDataModel->setAllData(data.timeRow, data.dataRows);
+
+    _pNoteModel->clear();
+    if (!data.notes.isEmpty())
+    {
+        foreach(Note note, data.notes)
+        {
+            _pNoteModel->add(note);
+        }
+    }
+    _pNoteModel->setNotesDataUpdated(false);
+
+    _pGuiModel->setFrontGraph(0);
+    _pGuiModel->setProjectFilePath("");
+    _pGuiModel->clearMarkersState();
+    _pGuiModel->setGuiState(GuiModel::DATA_LOADED);
+}
 
 void DataFileHandler::handleError(QString msg)
 {
@@ -2,6 +2,7 @@
 #define DATAFILEHANDLER_H
 
 #include <QObject>
+#include <QTimer>
 
 #include "guimodel.h"
 #include "graphdatamodel.h"
@@ -9,8 +10,19 @@
 #include "settingsmodel.h"
 
 #include "datafileexporter.h"
+#include "datafileparser.h"
 #include "dataparsermodel.h"
 
+/* Forward declaration */
+class BinaryDataReader;
+
+/*!
+ * Opens, parses and exports data files
+ * Large data files are loaded progressively: a decimated preview of the complete file is
+ * shown first, after which the data is appended to the graphs in batches from a timer,
+ * so the GUI stays responsive during the load. Binary data files that are too large to load
+ * completely are browsed through a LazyDataSource instead.
+ */
 class DataFileHandler : public QObject
 {
     Q_OBJECT
@@ -35,14 +47,22 @@ public slots:
 
     void exportDataLine(double timeData, QList <double> dataValues);
     void rewriteDataFile(void);
+    void updateDataFileHeader(void);
 
     void parseDataFile();
 
 private slots:
     void handleError(QString msg);
     void cleanUpFileHandler();
+    void loadNextDataBatch();
+    void handleGuiStateChange();
 
 private:
+    void parseBinaryDataFile(QString dataFilePath);
+    void openLazyDataFile(QString dataFilePath);
+    void loadFileData(DataFileParser::FileData& data);
+    void startDataLoad(DataFileParser::FileData& data, QList<double>& previewTimeRow, QList<QList<double> >& previewDataRows);
+    void stopDataLoad();
 
     GuiModel* _pGuiModel;
     GraphDataModel* _pGraphDataModel;
@@ -55,7 +75,18 @@ private:
     QTextStream* _pDataFileStream;
     QFile* _pDataFile;
 
+    /* Progressive load */
+    QTimer _loadTimer;
+    DataFileParser* _pDataParser;
+    BinaryDataReader* _pBinaryReader;
+    qint32 _nextChunkIdx;
+    bool _bDataLoadActive;
+
     static const qint32 _cSampleLineLength = 50;
+    static const qint32 _cPreviewSampleCount = 4096;
+    static const qint64 _cBatchSizePerThread = 8 * 1024 * 1024;
+    static const qint32 _cBinaryBatchChunks = 64;
+    static const qint64 _cLazyLoadThreshold = 256 * 1024 * 1024;
 };
 
 #endif // DATAFILEHANDLER_H
@@ -0,0 +1,358 @@
+#include <algorithm> // std::lower_bound
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QtNumeric>
+
+#include "binarydatareader.h"
+#include "datafileindex.h"
+
+const char DataFileIndex::cMagic[] = "MBSCIDX0";
+
+DataFileIndex::DataFileIndex()
+{
+    _graphCount = 0;
+}
+
+void DataFileIndex::clear()
+{
+    _blocks.clear();
+    _graphCount = 0;
+}
+
+/*!
+ * Build index by decoding every chunk of the data file once
+ * Only a single chunk is decoded at a time, so memory usage doesn't depend on the size of the file.
+ * \param reader            opened data file
+ * \param progressCallback  called with percentage of indexed chunks
+ * \return false when a chunk can't be decoded
+ */
+bool DataFileIndex::build(const BinaryDataReader& reader, const std::function<void(int)>& progressCallback)
+{
+    clear();
+
+    _graphCount = reader.metadata().graphs.size();
+
+    QList<double> timeRow;
+    QList<QList<double> > dataRows;
+    QList<double> lastValues;
+    qint64 firstSample = 0;
+    qint32 lastPercentage = -1;
+
+    for (qint32 chunkIdx = 0; chunkIdx < reader.chunkCount(); chunkIdx++)
+    {
+        timeRow.clear();
+        dataRows.clear();
+        if (!reader.readChunk(chunkIdx, timeRow, dataRows) || timeRow.isEmpty())
+        {
+            clear();
+            return false;
+        }
+
+        /* Segment between last sample of previous block and first sample of this block */
+        if (!_blocks.isEmpty())
+        {
+            Block& previous = _blocks.last();
+            for (qint32 graphIdx = 0; graphIdx < _graphCount; graphIdx++)
+            {
+                double area = 0;
+                if (
+                    !qIsNaN(lastValues[graphIdx])
+                    && !qIsNaN(dataRows[graphIdx].first())
+                )
+                {
+                    area = (timeRow.first() - previous.lastKey) * (lastValues[graphIdx] + dataRows[graphIdx].first()) / 2;
+                }
+
+                previous.tailAreas[graphIdx] = area;
+                previous.summaries[graphIdx].area += area;
+            }
+        }
+
+        Block block;
+        block.firstSample = firstSample;
+        block.sampleCount = static_cast<quint32>(timeRow.size());
+        block.firstKey = timeRow.first();
+        block.lastKey = timeRow.last();
+
+        for (qint32 graphIdx = 0; graphIdx < _graphCount; graphIdx++)
+        {
+            const QList<double>& values = dataRows[graphIdx];
+
+            EnvelopePyramid::Summary summary;
+            EnvelopePyramid::initSummary(summary);
+
+            for (qint32 idx = 0; idx < timeRow.size(); idx++)
+            {
+                /* Graph has no sample at this time (NaN) */
+                if (qIsNaN(values[idx]))
+                {
+                    continue;
+                }
+
+                double area = 0;
+                if (
+                    (idx + 1 < timeRow.size())
+                    && !qIsNaN(values[idx + 1])
+                )
+                {
+                    area = (timeRow[idx + 1] - timeRow[idx]) * (values[idx] + values[idx + 1]) / 2;
+                }
+
+                EnvelopePyramid::addSample(summary, firstSample + idx, values[idx], area);
+            }
+
+            block.summaries.append(summary);
+            block.tailAreas.append(0);
+        }
+
+        appendEnvelope(timeRow, dataRows, block.envelope);
+
+        _blocks.append(block);
+        firstSample += timeRow.size();
+
+        lastValues.clear();
+        for (qint32 graphIdx = 0; graphIdx < _graphCount; graphIdx++)
+        {
+            lastValues.append(dataRows[graphIdx].last());
+        }
+
+        const qint32 percentage = static_cast<qint32>((static_cast<qint64>(chunkIdx + 1) * 100) / reader.chunkCount());
+        if (percentage != lastPercentage)
+        {
+            lastPercentage = percentage;
+            progressCallback(percentage);
+        }
+    }
+
+    return true;
+}
+
+/*!
+ * Load cached index of data file
+ * \return false when there is no cache, or when it doesn't match the data file
+ */
+bool DataFileIndex::load(QString dataFilePath, const BinaryDataReader& reader)
+{
+    clear();
+
+    QFile file(indexFilePath(dataFilePath));
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        return false;
+    }
+
+    const QFileInfo dataFileInfo(dataFilePath);
+
+    QDataStream stream(&file);
+    stream.setByteOrder(QDataStream::LittleEndian);
+    stream.setFloatingPointPrecision(QDataStream::DoublePrecision);
+
+    QByteArray magic(cMagicSize, '\0');
+    quint32 version = 0;
+    qint64 dataFileSize = 0;
+    qint64 dataFileModified = 0;
+    qint32 graphCount = 0;
+    qint32 blockCount = 0;
+
+    stream.readRawData(magic.data(), cMagicSize);
+    stream >> version >> dataFileSize >> dataFileModified >> graphCount >> blockCount;
+
+    if (
+        (stream.status() != QDataStream::Ok)
+        || (magic != QByteArray(cMagic, cMagicSize))
+        || (version != cFormatVersion)
+        || (dataFileSize != dataFileInfo.size())
+        || (dataFileModified != dataFileInfo.lastModified().toMSecsSinceEpoch())
+        || (graphCount != reader.metadata().graphs.size())
+        || (blockCount != reader.chunkCount())
+    )
+    {
+        return false;
+    }
+
+    _graphCount = graphCount;
+    _blocks.reserve(blockCount);
+    for (qint32 blockIdx = 0; blockIdx < blockCount; blockIdx++)
+    {
+        Block block;
+        stream >> block.firstSample >> block.sampleCount >> block.firstKey >> block.lastKey;
+
+        for (qint32 graphIdx = 0; graphIdx < graphCount; graphIdx++)
+        {
+            EnvelopePyramid::Summary summary;
+            EnvelopePyramid::initSummary(summary);
+            double tailArea = 0;
+
+            stream >> summary.minIdx >> summary.maxIdx >> summary.min >> summary.max;
+            stream >> summary.count >> summary.mean >> summary.m2 >> summary.area >> tailArea;
+
+            block.summaries.append(summary);
+            block.tailAreas.append(tailArea);
+        }
+
+        stream >> block.envelope;
+
+        _blocks.append(block);
+    }
+
+    if (stream.status() != QDataStream::Ok)
+    {
+        clear();
+        return false;
+    }
+
+    return true;
+}
+
+/*!
+ * Cache index next to the data file
+ * \return false when the cache can't be written (for example a read-only location)
+ */
+bool DataFileIndex::save(QString dataFilePath) const
+{
+    QSaveFile file(indexFilePath(dataFilePath));
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        return false;
+    }
+
+    const QFileInfo dataFileInfo(dataFilePath);
+
+    QDataStream stream(&file);
+    stream.setByteOrder(QDataStream::LittleEndian);
+    stream.setFloatingPointPrecision(QDataStream::DoublePrecision);
+
+    stream.writeRawData(cMagic, cMagicSize);
+    stream << cFormatVersion << static_cast<qint64>(dataFileInfo.size()) << dataFileInfo.lastModified().toMSecsSinceEpoch();
+    stream << _graphCount << static_cast<qint32>(_blocks.size());
+
+    for (const Block& block : _blocks)
+    {
+        stream << block.firstSample << block.sampleCount << block.firstKey << block.lastKey;
+
+        for (qint32 graphIdx = 0; graphIdx < _graphCount; graphIdx++)
+        {
+            const EnvelopePyramid::Summary& summary = block.summaries[graphIdx];
+
+            stream << summary.minIdx << summary.maxIdx << summary.min << summary.max;
+            stream << summary.count << summary.mean << summary.m2 << summary.area << block.tailAreas[graphIdx];
+        }
+
+        stream << block.envelope;
+    }
+
+    return (stream.status() == QDataStream::Ok) && file.commit();
+}
+
+/*!
+ * Number of values per envelope bucket of a block
+ */
+qint32 DataFileIndex::envelopeStride() const
+{
+    return 2 + 2 * _graphCount;
+}
+
+qint32 DataFileIndex::graphCount() const
+{
+    return _graphCount;
+}
+
+qint32 DataFileIndex::blockCount() const
+{
+    return _blocks.size();
+}
+
+qint64 DataFileIndex::sampleCount() const
+{
+    if (_blocks.isEmpty())
+    {
+        return 0;
+    }
+
+    return _blocks.last().firstSample + _blocks.last().sampleCount;
+}
+
+const DataFileIndex::Block& DataFileIndex::block(qint32 blockIdx) const
+{
+    return _blocks[blockIdx];
+}
+
+/*!
+ * Find first block that ends at or after key
+ * \return Block index, blockCount() when all blocks end before key
+ */
+qint32 DataFileIndex::findBlock(double key) const
+{
+    auto it = std::lower_bound(_blocks.constBegin(), _blocks.constEnd(), key,
+                               [](const Block &block, double key) { return block.lastKey < key; });
+
+    return static_cast<qint32>(it - _blocks.constBegin());
+}
+
+void DataFileIndex::appendEnvelope(const QList<double>& timeRow, const QList<QList<double> >& dataRows, QList<double>& envelope) const
+{
+    for (qint32 begin = 0; begin < timeRow.size(); begin += cEnvelopeBucketSize)
+    {
+        const qint32 end = qMin(begin + cEnvelopeBucketSize, static_cast<qint32>(timeRow.size()));
+
+        envelope.append(timeRow[begin]);
+        envelope.append(timeRow[end - 1]);
+
+        for (qint32 graphIdx = 0; graphIdx < _graphCount; graphIdx++)
+        {
+            appendExtremes(dataRows[graphIdx], begin, end, envelope);
+        }
+    }
+}
+
+/*!
+ * Append minimum and maximum of values in [begin, end), in order of occurrence
+ * Samples without value (NaN) are skipped, both extremes are NaN when no sample has a value.
+ */
+void DataFileIndex::appendExtremes(const QList<double>& values, qint32 begin, qint32 end, QList<double>& extremes)
+{
+    qint32 minIdx = -1;
+    qint32 maxIdx = -1;
+    for (qint32 idx = begin; idx < end; idx++)
+    {
+        if (qIsNaN(values[idx]))
+        {
+            continue;
+        }
+
+        if ((minIdx < 0) || (values[idx] < values[minIdx]))
+        {
+            minIdx = idx;
+        }
+
+        if ((maxIdx < 0) || (values[idx] > values[maxIdx]))
+        {
+            maxIdx = idx;
+        }
+    }
+
+    if (minIdx < 0)
+    {
+        extremes.append(qQNaN());
+        extremes.append(qQNaN());
+    }
+    else if (minIdx <= maxIdx)
+    {
+        extremes.append(values[minIdx]);
+        extremes.append(values[maxIdx]);
+    }
+    else
+    {
+        extremes.append(values[maxIdx]);
+        extremes.append(values[minIdx]);
+    }
+}
+
+QString DataFileIndex::indexFilePath(QString dataFilePath)
+{
+    return dataFilePath + QStringLiteral(".idx");
+}
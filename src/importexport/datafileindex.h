@@ -0,0 +1,77 @@
+#ifndef DATAFILEINDEX_H
+#define DATAFILEINDEX_H
+
+#include <QList>
+#include <QString>
+#include <functional>
+
+#include "envelopepyramid.h"
+
+/* Forward declaration */
+class BinaryDataReader;
+
+/*!
+ * Sparse time index of a binary data file
+ * There is one block per chunk of the file with its key range and a summary of every graph,
+ * so the data file can be browsed without loading all samples. The index is cached next to the
+ * data file and is only reused when the data file didn't change.
+ */
+class DataFileIndex
+{
+public:
+
+    typedef struct
+    {
+        qint64 firstSample;
+        quint32 sampleCount;
+        double firstKey;
+        double lastKey;
+
+        /* Per graph, area includes segment towards first sample of next block */
+        QList<EnvelopePyramid::Summary> summaries;
+
+        /* Per graph, area of segment between last sample and first sample of next block */
+        QList<double> tailAreas;
+
+        /*
+         * Min/max envelope per bucket of cEnvelopeBucketSize samples, envelopeStride() values per bucket:
+         * first key, last key and per graph the extremes in order of occurrence
+         */
+        QList<double> envelope;
+    } Block;
+
+    DataFileIndex();
+
+    void clear();
+
+    bool build(const BinaryDataReader& reader, const std::function<void(int)>& progressCallback);
+    bool load(QString dataFilePath, const BinaryDataReader& reader);
+    bool save(QString dataFilePath) const;
+
+    qint32 graphCount() const;
+    qint32 blockCount() const;
+    qint64 sampleCount() const;
+    const Block& block(qint32 blockIdx) const;
+
+    qint32 findBlock(double key) const;
+
+    qint32 envelopeStride() const;
+
+    static QString indexFilePath(QString dataFilePath);
+    static void appendExtremes(const QList<double>& values, qint32 begin, qint32 end, QList<double>& extremes);
+
+    static const qint32 cEnvelopeBucketSize = 256;
+
+private:
+
+    void appendEnvelope(const QList<double>& timeRow, const QList<QList<double> >& dataRows, QList<double>& envelope) const;
+
+    static const char cMagic[];
+    static const qint32 cMagicSize = 8;
+    static const quint32 cFormatVersion = 2;
+
+    QList<Block> _blocks;
+    qint32 _graphCount;
+};
+
+#endif // DATAFILEINDEX_H
@@ -1,7 +1,10 @@
+#include <cstring>
+
 #include <QColor>
 #include <QIODevice>
 #include <QDateTime>
 #include "datafileparser.h"
+#include "mappeddataparser.h"
 
 const QString DataFileParser::_cDatePattern = QString(R"(\s*(\d{1,2})[\-\/\s](\d{1,2})[\-\/\s](\d{4})\s*([0-2][0-9]):([0-5][0-9]):([0-5][0-9])[.,]?(\d{0,3}))");
 const QString DataFileParser::_cTrimStrimPattern = QString(R"(\"?(.[^\"]*)\"?)");
@@ -11,7 +14,12 @@ DataFileParser::DataFileParser(DataParserModel *pDataParserModel)
      _totalCharSize(0),
      _charCount(0),
      _lastPercentageUpdate(0),
-     _expectedFields(1)
+     _expectedFields(1),
+     _pMappedFile(nullptr),
+     _pMappedData(nullptr),
+     _mappedSize(0),
+     _mappedOffset(0),
+     _pMappedParser(nullptr)
 {
     _pDataParserModel = pDataParserModel;
 
@@ -24,11 +32,20 @@ DataFileParser::DataFileParser(DataParserModel *pDataParserModel)
 
 DataFileParser::~DataFileParser()
 {
-
+    stopMappedData();
 }
 
 // Return false on error
 bool DataFileParser::processDataFile(QTextStream * pDataStream, FileData * pData)
+{
+    return processDataFileHeader(pDataStream, pData) && processDataLines(pDataStream, pData);
+}
+
+/*!
+ * Parse properties and labels, the stream is positioned at the first data line afterwards
+ * \return false on error
+ */
+bool DataFileParser::processDataFileHeader(QTextStream * pDataStream, FileData * pData)
 {
     bool bRet = true;
     QString line;
@@ -210,6 +227,17 @@ bool DataFileParser::processDataFile(QTextStream * pDataStream, FileData * pData
         }
     }
 
+    return bRet;
+}
+
+/*!
+ * Parse all data lines, the header should already be processed
+ * \return false on error
+ */
+bool DataFileParser::processDataLines(QTextStream * pDataStream, FileData * pData)
+{
+    bool bRet = true;
+
     // read data
     if (bRet)
     {
@@ -237,6 +265,19 @@ bool DataFileParser::processDataFile(QTextStream * pDataStream, FileData * pData
 
 bool DataFileParser::parseDataLines(QTextStream* pDataStream, QList<QList<double> > &dataRows)
 {
+    /* Parse directly from memory mapped file when possible */
+    QFile* pFile = qobject_cast<QFile*>(pDataStream->device());
+    if (pFile != nullptr)
+    {
+        bool bMapped = false;
+        const bool bMappedResult = parseMappedDataLines(pFile, pDataStream->pos(), dataRows, &bMapped);
+
+        if (bMapped)
+        {
+            return bMappedResult;
+        }
+    }
+
     QString line;
     bool bRet = true;
     bool bResult = true;
@@ -347,6 +388,228 @@ bool DataFileParser::parseDataLines(QTextStream* pDataStream, QList<QList<double
     return bRet;
 }
 
+/*!
+ * Parse data lines straight from the memory mapped file
+ * \param pFile       opened data file
+ * \param offset      byte offset of first data line
+ * \param dataRows    parsed data, one list per column (time column first)
+ * \param pbMapped    set to false when the mapped parser can't be used with the current settings
+ * \return false on error
+ */
+bool DataFileParser::parseMappedDataLines(QFile *pFile, qint64 offset, QList<QList<double> > &dataRows, bool *pbMapped)
+{
+    MappedDataParser::Settings settings;
+    const qint64 size = pFile->size() - offset;
+
+    *pbMapped = false;
+
+    if (
+        (offset < 0)
+        || (size <= 0)
+        || !MappedDataParser::settingsFromModel(_pDataParserModel, _expectedFields, settings)
+    )
+    {
+        return false;
+    }
+
+    uchar* pMap = pFile->map(offset, size);
+    if (pMap == nullptr)
+    {
+        return false;
+    }
+
+    *pbMapped = true;
+
+    MappedDataParser mappedParser(settings);
+    qint64 lastProgress = 0;
+    const bool bRet = mappedParser.parse(reinterpret_cast<const char*>(pMap), size, dataRows, [this, &lastProgress](qint64 bytesParsed) {
+        checkProgressUpdate(static_cast<quint64>(bytesParsed - lastProgress));
+        lastProgress = bytesParsed;
+    });
+
+    pFile->unmap(pMap);
+
+    if (!bRet)
+    {
+        reportMappedError(mappedParser.error());
+    }
+
+    return bRet;
+}
+
+/*!
+ * Map the data lines of the file for parsing in batches
+ * The stream should be positioned at the first data line (see processDataFileHeader).
+ * \return false when the data can't be parsed from a mapped file, use processDataLines instead
+ */
+bool DataFileParser::startMappedData(QTextStream *pDataStream)
+{
+    MappedDataParser::Settings settings;
+    QFile* pFile = qobject_cast<QFile*>(pDataStream->device());
+
+    stopMappedData();
+
+    /* STM studio correction needs the complete data set */
+    if (
+        (pFile == nullptr)
+        || _pDataParserModel->stmStudioCorrection()
+        || !MappedDataParser::settingsFromModel(_pDataParserModel, _expectedFields, settings)
+    )
+    {
+        return false;
+    }
+
+    const qint64 offset = pDataStream->pos();
+    const qint64 size = pFile->size() - offset;
+    if ((offset < 0) || (size <= 0))
+    {
+        return false;
+    }
+
+    _pMappedData = pFile->map(offset, size);
+    if (_pMappedData == nullptr)
+    {
+        return false;
+    }
+
+    _pMappedFile = pFile;
+    _mappedSize = size;
+    _mappedOffset = 0;
+    _pMappedParser = new MappedDataParser(settings);
+
+    return true;
+}
+
+/*!
+ * Parse evenly spaced samples of the mapped data lines
+ * \param sampleCount     maximum number of samples
+ * \param timeRow         time of samples
+ * \param dataRows        data of samples, one list per graph
+ */
+void DataFileParser::previewMappedData(qint32 sampleCount, QList<double> &timeRow, QList<QList<double> > &dataRows)
+{
+    timeRow.clear();
+    dataRows.clear();
+
+    if (_pMappedParser != nullptr)
+    {
+        _pMappedParser->preview(reinterpret_cast<const char*>(_pMappedData), _mappedSize, sampleCount, dataRows);
+
+        if (!dataRows.isEmpty())
+        {
+            timeRow = dataRows.takeFirst();
+        }
+    }
+}
+
+/*!
+ * Parse next batch of mapped data lines
+ * \param maxBytes        approximate size of batch, the batch always ends at a line end
+ * \param timeRow         time of parsed samples
+ * \param dataRows        data of parsed samples, one list per graph
+ * \return false on error
+ */
+bool DataFileParser::parseNextMappedData(qint64 maxBytes, QList<double> &timeRow, QList<QList<double> > &dataRows)
+{
+    timeRow.clear();
+    dataRows.clear();
+
+    if (mappedDataAtEnd())
+    {
+        return false;
+    }
+
+    const char* pData = reinterpret_cast<const char*>(_pMappedData);
+    const char* pBegin = pData + _mappedOffset;
+    const char* pDataEnd = pData + _mappedSize;
+    const char* pEnd = pBegin + qMin(maxBytes, _mappedSize - _mappedOffset);
+
+    if (pEnd < pDataEnd)
+    {
+        const char* pNewLine = static_cast<const char*>(memchr(pEnd, '\n', pDataEnd - pEnd));
+        pEnd = (pNewLine == nullptr) ? pDataEnd : pNewLine + 1;
+    }
+
+    qint64 lastProgress = 0;
+    const bool bRet = _pMappedParser->parse(pBegin, pEnd - pBegin, dataRows, [this, &lastProgress](qint64 bytesParsed) {
+        checkProgressUpdate(static_cast<quint64>(bytesParsed - lastProgress));
+        lastProgress = bytesParsed;
+    });
+
+    if (bRet)
+    {
+        _lineNumber += static_cast<quint32>(_pMappedParser->lineCount());
+        _mappedOffset = pEnd - pData;
+
+        timeRow = dataRows.takeFirst();
+    }
+    else
+    {
+        reportMappedError(_pMappedParser->error());
+        dataRows.clear();
+    }
+
+    return bRet;
+}
+
+bool DataFileParser::mappedDataAtEnd() const
+{
+    return (_pMappedParser == nullptr) || (_mappedOffset >= _mappedSize);
+}
+
+void DataFileParser::stopMappedData()
+{
+    if (_pMappedData != nullptr)
+    {
+        _pMappedFile->unmap(_pMappedData);
+        _pMappedData = nullptr;
+    }
+
+    if (_pMappedParser != nullptr)
+    {
+        delete _pMappedParser;
+        _pMappedParser = nullptr;
+    }
+
+    _pMappedFile = nullptr;
+    _mappedSize = 0;
+    _mappedOffset = 0;
+}
+
+void DataFileParser::reportMappedError(const MappedDataParser::Error &error)
+{
+    const qint64 lineNumber = _lineNumber + error.lineNumber;
+
+    QString errorMsg;
+    if (error.type == MappedDataParser::ERROR_FIELD_COUNT)
+    {
+        errorMsg = QString(tr("The number of label columns doesn't match number of data columns!\n\n"
+                                "Line number: %1\n"
+                                ).arg(lineNumber));
+    }
+    else if (error.type == MappedDataParser::ERROR_DATE)
+    {
+        errorMsg = QString(tr("Invalid absolute date (while processing data)\n"
+                                   "Line number: %1\n"
+                                   "Line: \"%2\"\n"
+                                   "\n\nExpected date format: \'%3\'"
+                                   ).arg(lineNumber).arg(error.line, "dd-MM-yyyy hh:mm:ss.zzz"));
+    }
+    else
+    {
+        errorMsg = QString(tr("Invalid data (while processing data)\n"
+                                   "Line number: %1\n"
+                                   "Line: \"%2\"\n"
+                                   "\n\nExpected decimal separator character: \'%3\'"
+                                   ).arg(lineNumber).arg(error.line, _pDataParserModel->decimalSeparator()));
+    }
+
+    emit parseErrorOccurred(errorMsg);
+}
+
+return bRet;
+}
+
 // Return false on error
 bool DataFileParser::readLineFromFile(QTextStream* pDataStream, QString *pLine)
 {
@@ -504,7 +767,7 @@ bool DataFileParser::isCommentLine(QString line)
 }
 
 
-void DataFileParser::checkProgressUpdate(quint32 charRead)
+void DataFileParser::checkProgressUpdate(quint64 charRead)
 {
     quint32 percentage = 0;
 
@@ -1,11 +1,13 @@
 #ifndef DATAFILEPARSER_H
 #define DATAFILEPARSER_H
 
+#include <QFile>
 #include <QTextStream>
 #include <QRegularExpression>
 
 #include "note.h"
 #include "dataparsermodel.h"
+#include "mappeddataparser.h"
 
 class DataFileParser : public QObject
 {
@@ -24,12 +26,23 @@ public:
         QList<quint32> axis;
         QList<Note> notes;
 
+        /* Time row holds absolute times (ms since epoch), only known for binary data files */
+        bool bAbsoluteTimes = false;
+
     } FileData;
 
     explicit DataFileParser(DataParserModel * pDataParserModel);
     ~DataFileParser();
 
     bool processDataFile(QTextStream * pDataStream, FileData * pData);
+    bool processDataFileHeader(QTextStream * pDataStream, FileData * pData);
+    bool processDataLines(QTextStream * pDataStream, FileData * pData);
+
+    bool startMappedData(QTextStream * pDataStream);
+    void previewMappedData(qint32 sampleCount, QList<double> &timeRow, QList<QList<double> > &dataRows);
+    bool parseNextMappedData(qint64 maxBytes, QList<double> &timeRow, QList<QList<double> > &dataRows);
+    bool mappedDataAtEnd() const;
+    void stopMappedData();
 
 signals:
     void parseErrorOccurred(QString msg);
@@ -37,12 +50,14 @@ signals:
 
 private:
     bool parseDataLines(QTextStream *pDataStream, QList<QList<double> > &dataRows);
+    bool parseMappedDataLines(QFile *pFile, qint64 offset, QList<QList<double> > &dataRows, bool *pbMapped);
+    void reportMappedError(const MappedDataParser::Error &error);
     bool readLineFromFile(QTextStream *pDataStream, QString *pLine);
     qint64 parseDateTime(QString rawData, bool *bOk);
     bool parseNoteField(QStringList noteFieldList, Note * pNote);
     double parseDouble(QString strNumber, bool* bOk);
     bool isCommentLine(QString line);
-    void checkProgressUpdate(quint32 charRead);
+    void checkProgressUpdate(quint64 charRead);
 
     void correctStmStudioData(QList<QList<double> > &dataLists);
     bool isNibbleCorrupt(quint16 ref, quint16 compare);
@@ -57,6 +72,12 @@ private:
 
     quint32 _expectedFields;
 
+    QFile* _pMappedFile;
+    uchar* _pMappedData;
+    qint64 _mappedSize;
+    qint64 _mappedOffset;
+    MappedDataParser* _pMappedParser;
+
     QRegularExpression _trimStringRegex;
     QRegularExpression _dateParseRegex;
 
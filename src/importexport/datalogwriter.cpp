@@ -0,0 +1,491 @@
+#include <cmath>
+
+#include <QtGlobal>
+#include <QDateTime>
+#include <QSaveFile>
+#include <QThread>
+#include <QTimer>
+
+#ifdef Q_OS_WIN
+#include <io.h> // _commit
+#else
+#include <unistd.h> // fsync
+#endif
+
+#include "util.h"
+#include "formatdatetime.h"
+#include "scopelogging.h"
+#include "datalogwriter.h"
+
+#ifdef Q_OS_WIN
+static const char cNewLine[] = "\r\n";
+#else
+static const char cNewLine[] = "\n";
+#endif
+
+DataLogWriter::DataLogWriter(QObject *parent) :
+    QObject(parent),
+    _bOpen(false),
+    _bProcessPending(false),
+    _droppedCount(0),
+    _reportedDropCount(0),
+    _headerSize(0)
+{
+    _settings.bBinary = false;
+    _settings.columnCount = 0;
+    _settings.syncPolicy = SYNC_NONE;
+    _settings.bAbsoluteTimes = false;
+
+    /* Child, so the timer moves along to the writer thread */
+    _pFlushTimer = new QTimer(this);
+    _pFlushTimer->setInterval(cFlushInterval);
+    connect(_pFlushTimer, &QTimer::timeout, this, &DataLogWriter::processQueue);
+}
+
+DataLogWriter::~DataLogWriter()
+{
+    close();
+}
+
+/*!
+ * Create (or truncate) log file and write header
+ * Records that are still queued from a previous log are discarded.
+ * \return false when the file can't be written
+ */
+bool DataLogWriter::open(const Settings& settings)
+{
+    close();
+
+    _settings = settings;
+    _queue.reset(settings.columnCount);
+
+    bool bRet;
+    if (_settings.bBinary)
+    {
+        bRet = _binaryWriter.open(_settings.filePath, _settings.metadata, cHeaderReserve);
+    }
+    else
+    {
+        const QByteArray header = csvHeader(_settings.headerLines, static_cast<qint32>(cHeaderReserve));
+        _headerSize = static_cast<qint32>(header.size());
+
+        _file.setFileName(_settings.filePath);
+        bRet = _file.open(QIODevice::WriteOnly | QIODevice::Truncate);
+        bRet = bRet && (_file.write(header) == header.size());
+
+        if (!bRet)
+        {
+            _file.close();
+        }
+    }
+
+    if (bRet)
+    {
+        _syncTimer.start();
+        _pFlushTimer->start();
+        _bOpen.store(true);
+    }
+
+    return bRet;
+}
+
+/*!
+ * Write all queued records and close log file
+ */
+void DataLogWriter::close()
+{
+    if (!_bOpen.load())
+    {
+        return;
+    }
+
+    processQueue();
+
+    /* File is already closed when last batch failed */
+    if (_bOpen.load())
+    {
+        /* Write partial chunk before it is synchronized */
+        bool bRet = _settings.bBinary ? _binaryWriter.flush() : true;
+        if (
+            bRet
+            && (_settings.syncPolicy != SYNC_NONE)
+        )
+        {
+            const int handle = _settings.bBinary ? _binaryWriter.handle() : _file.handle();
+            bRet = syncToDisk(handle);
+        }
+
+        _bOpen.store(false);
+        _pFlushTimer->stop();
+
+        _file.close();
+        _binaryWriter.close();
+
+        if (!bRet)
+        {
+            emit writeErrorOccurred(_settings.filePath);
+        }
+    }
+}
+
+/*!
+ * Whether log file is open, can be called from any thread
+ */
+bool DataLogWriter::isOpen() const
+{
+    return _bOpen.load();
+}
+
+/*!
+ * Add record to log
+ * Must only be called from a single producer thread. The producer never waits for the writer:
+ * when the writer can't keep up and the queue is full, the record is dropped and counted. The
+ * writer thread reports the dropped records.
+ * \param timestamp     Time of record
+ * \param values        Value per column
+ * \return false when log isn't open, values don't match the columns or record is dropped
+ */
+bool DataLogWriter::push(double timestamp, const QList<double>& values)
+{
+    if (
+        !_bOpen.load()
+        || (values.size() != _queue.columnCount())
+    )
+    {
+        return false;
+    }
+
+    bool bQueued = _queue.push(timestamp, values);
+
+    if (!bQueued && (QThread::currentThread() == thread()))
+    {
+        /* Producer is writer thread, so make room directly */
+        processQueue();
+        bQueued = _queue.push(timestamp, values);
+    }
+
+    if (!bQueued)
+    {
+        _droppedCount.fetch_add(1);
+    }
+
+    /* Write early when queue fills up faster than the flush interval */
+    if (
+        (_queue.size() >= _queue.capacity() / 2)
+        && !_bProcessPending.exchange(true)
+    )
+    {
+        QMetaObject::invokeMethod(this, &DataLogWriter::processQueue, Qt::QueuedConnection);
+    }
+
+    return bQueued;
+}
+
+/*!
+ * Return number of records dropped because the writer couldn't keep up, can be called from any thread
+ */
+quint64 DataLogWriter::droppedCount() const
+{
+    return _droppedCount.load();
+}
+
+/*!
+ * Update header of log file
+ * The header is overwritten in place when it fits in the reserved space. Otherwise the samples
+ * are copied once to a file with a larger header.
+ * \param settings  settings with new header lines (csv) or metadata (binary)
+ * \return false when the file can't be written
+ */
+bool DataLogWriter::updateHeader(const Settings& settings)
+{
+    if (!_bOpen.load())
+    {
+        return false;
+    }
+
+    _settings.headerLines = settings.headerLines;
+    _settings.metadata = settings.metadata;
+
+    bool bRet = true;
+    if (_settings.bBinary)
+    {
+        if (!_binaryWriter.updateMetadata(_settings.metadata))
+        {
+            const qint64 dataOffset = _binaryWriter.dataOffset();
+            _binaryWriter.close();
+
+            /* Original file is kept when the copy fails */
+            bRet = replaceHeader(BinaryDataWriter::fileHeader(_settings.metadata, cHeaderReserve), dataOffset);
+            bRet = _binaryWriter.openAppend(_settings.filePath, _settings.metadata) && bRet;
+        }
+    }
+    else
+    {
+        const QByteArray header = csvHeader(_settings.headerLines, 0);
+        const qint32 paddingSize = _headerSize - static_cast<qint32>(header.size());
+
+        if (
+            (paddingSize == 0)
+            || ((paddingSize > 0) && (_settings.headerLines.size() >= 2))
+        )
+        {
+            const qint64 endPos = _file.pos();
+
+            bRet = _file.seek(0);
+            bRet = bRet && (_file.write(csvHeader(_settings.headerLines, paddingSize)) == _headerSize);
+            bRet = _file.seek(endPos) && bRet;
+        }
+        else
+        {
+            const QByteArray newHeader = csvHeader(_settings.headerLines, static_cast<qint32>(cHeaderReserve));
+
+            _file.close();
+
+            if (replaceHeader(newHeader, _headerSize))
+            {
+                _headerSize = static_cast<qint32>(newHeader.size());
+            }
+            else
+            {
+                bRet = false;
+            }
+
+            /* Not in append mode, because the header is updated in place */
+            bRet = _file.open(QIODevice::ReadWrite) && _file.seek(_file.size()) && bRet;
+        }
+    }
+
+    if (!bRet)
+    {
+        reportError();
+    }
+
+    return bRet;
+}
+
+/*!
+ * Write queued records to the log file
+ * Called periodically and when the queue fills up.
+ */
+void DataLogWriter::processQueue()
+{
+    /* Re-arm notification before taking, so a record added meanwhile is never missed */
+    _bProcessPending.store(false);
+
+    if (!_bOpen.load())
+    {
+        return;
+    }
+
+    bool bRet = true;
+    while (bRet && (_queue.size() > 0))
+    {
+        bRet = writeBatch();
+    }
+
+    bRet = bRet && finishBatch();
+
+    if (!bRet)
+    {
+        reportError();
+    }
+
+    const quint64 droppedCount = _droppedCount.load();
+    if (droppedCount != _reportedDropCount)
+    {
+        qCWarning(scopeGeneralInfo) << QString("Data log can't keep up, %1 samples are missing in %2 (total: %3)")
+                                       .arg(droppedCount - _reportedDropCount)
+                                       .arg(_settings.filePath)
+                                       .arg(droppedCount);
+
+        _reportedDropCount = droppedCount;
+    }
+}
+
+QString DataLogWriter::formatDataLine(double timeData, const QList<double>& dataValues, bool bAbsoluteTimes)
+{
+    QString line;
+
+    if (bAbsoluteTimes)
+    {
+        QDateTime dateTime;
+        dateTime.setMSecsSinceEpoch(timeData);
+        line.append(FormatDateTime::formatDateTime(dateTime));
+    }
+    else
+    {
+        // Format time (µs resolution, no trailing zeros)
+        const double t = std::round(timeData * 1000) / 1000;
+        line.append(Util::formatDoubleForExport(t));
+    }
+
+    // Add formatted data (maximum 3 decimals, no trailing zeros)
+    for(qint32 d = 0; d < dataValues.size(); d++)
+    {
+        line.append(Util::separatorCharacter() + Util::formatDoubleForExport(dataValues[d]));
+    }
+
+    return line;
+}
+
+/*!
+ * Make sure data of file is written to disk, not only to the cache of the operating system
+ * \param handle    native file handle
+ */
+bool DataLogWriter::syncToDisk(int handle)
+{
+    if (handle < 0)
+    {
+        return false;
+    }
+
+#ifdef Q_OS_WIN
+    return _commit(handle) == 0;
+#else
+    return ::fsync(handle) == 0;
+#endif
+}
+
+bool DataLogWriter::writeBatch()
+{
+    _timestamps.clear();
+    _values.clear();
+
+    const qint32 count = _queue.pop(cBatchSize, _timestamps, _values);
+    const qint32 columnCount = _queue.columnCount();
+
+    _lineBuffer.clear();
+    for (qint32 row = 0; row < count; row++)
+    {
+        _rowValues.clear();
+        for (qint32 col = 0; col < columnCount; col++)
+        {
+            _rowValues.append(_values[row * columnCount + col]);
+        }
+
+        if (_settings.bBinary)
+        {
+            if (!_binaryWriter.append(_timestamps[row], _rowValues))
+            {
+                return false;
+            }
+        }
+        else
+        {
+            _lineBuffer.append(formatDataLine(_timestamps[row], _rowValues, _settings.bAbsoluteTimes).toUtf8());
+            _lineBuffer.append(cNewLine);
+        }
+    }
+
+    if (!_settings.bBinary)
+    {
+        return _file.write(_lineBuffer) == _lineBuffer.size();
+    }
+
+    return true;
+}
+
+/*!
+ * Hand written batch to the operating system and synchronize to disk according to policy
+ * Binary samples are only written as complete chunks, the partial chunk is written on close.
+ */
+bool DataLogWriter::finishBatch()
+{
+    bool bRet = _settings.bBinary ? _binaryWriter.flushFile() : _file.flush();
+
+    bool bSync = false;
+    if (_settings.syncPolicy == SYNC_EVERY_BATCH)
+    {
+        bSync = true;
+    }
+    else if (_settings.syncPolicy == SYNC_PERIODIC)
+    {
+        bSync = _syncTimer.hasExpired(cSyncInterval);
+    }
+    else
+    {
+        bSync = false;
+    }
+
+    if (bRet && bSync)
+    {
+        bRet = syncToDisk(_settings.bBinary ? _binaryWriter.handle() : _file.handle());
+        _syncTimer.restart();
+    }
+
+    return bRet;
+}
+
+/*!
+ * Replace header of log file, the data after the old header is copied once
+ * The original file is only replaced when the copy is complete.
+ * \param header        new header
+ * \param dataOffset    size of old header
+ */
+bool DataLogWriter::replaceHeader(const QByteArray& header, qint64 dataOffset)
+{
+    QFile oldFile(_settings.filePath);
+    QSaveFile newFile(_settings.filePath);
+
+    if (
+        !oldFile.open(QIODevice::ReadOnly)
+        || !oldFile.seek(dataOffset)
+        || !newFile.open(QIODevice::WriteOnly)
+        || (newFile.write(header) != header.size())
+    )
+    {
+        return false;
+    }
+
+    while (!oldFile.atEnd())
+    {
+        const QByteArray block = oldFile.read(cCopyBlockSize);
+        if (
+            block.isEmpty()
+            || (newFile.write(block) != block.size())
+        )
+        {
+            return false;
+        }
+    }
+
+    oldFile.close();
+
+    return newFile.commit();
+}
+
+/*!
+ * Stop log after a write error
+ */
+void DataLogWriter::reportError()
+{
+    _bOpen.store(false);
+    _pFlushTimer->stop();
+
+    _file.close();
+    _binaryWriter.close();
+
+    emit writeErrorOccurred(_settings.filePath);
+}
+
+/*!
+ * Create csv header, reserved space (spaces) is added to the last comment line in front of the label row
+ */
+QByteArray DataLogWriter::csvHeader(const QStringList& headerLines, qint32 paddingSize) const
+{
+    QByteArray header;
+
+    for (qint32 idx = 0; idx < headerLines.size(); idx++)
+    {
+        header.append(headerLines[idx].toUtf8());
+
+        if (idx == headerLines.size() - 2)
+        {
+            header.append(QByteArray(paddingSize, ' '));
+        }
+
+        header.append(cNewLine);
+    }
+
+    return header;
+}
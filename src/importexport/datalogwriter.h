@@ -0,0 +1,117 @@
+#ifndef DATALOGWRITER_H
+#define DATALOGWRITER_H
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QObject>
+#include <QStringList>
+#include <atomic>
+
+#include "binarydatafile.h"
+#include "binarydatawriter.h"
+#include "logrecordqueue.h"
+
+/* Forward declaration */
+class QTimer;
+
+/*!
+ * Writes samples to the log file on a dedicated thread
+ * The producer (gui thread) only copies the samples into a bounded lock-free queue, it never
+ * waits for the writer. The writer thread takes the samples in batches, formats them and writes
+ * them to the file. The header of the file has reserved space, so it can be updated in place
+ * without rewriting the samples.
+ *
+ * Except for push() and droppedCount(), all functions must be called from the thread of the writer object.
+ */
+class DataLogWriter : public QObject
+{
+    Q_OBJECT
+public:
+
+    typedef enum
+    {
+        SYNC_NONE = 0,      /* Leave writing to disk to the operating system */
+        SYNC_PERIODIC,      /* Synchronize to disk every cSyncInterval */
+        SYNC_EVERY_BATCH,   /* Synchronize to disk after every batch */
+    } SyncPolicy;
+
+    typedef struct
+    {
+        QString filePath;
+        bool bBinary;
+        qint32 columnCount;
+        SyncPolicy syncPolicy;
+
+        /* Csv: comment lines followed by the label row, reserved space is added to the last comment line */
+        QStringList headerLines;
+        bool bAbsoluteTimes;
+
+        /* Binary */
+        BinaryDataFile::Metadata metadata;
+    } Settings;
+
+    explicit DataLogWriter(QObject *parent = nullptr);
+    ~DataLogWriter();
+
+    bool open(const Settings& settings);
+    void close();
+    bool isOpen() const;
+
+    bool push(double timestamp, const QList<double>& values);
+    quint64 droppedCount() const;
+
+    bool updateHeader(const Settings& settings);
+
+    static QString formatDataLine(double timeData, const QList<double>& dataValues, bool bAbsoluteTimes);
+    static bool syncToDisk(int handle);
+
+    static const qint32 cFlushInterval = 1000; /* in milliseconds */
+    static const qint32 cSyncInterval = 10000; /* in milliseconds */
+    static const qint32 cBatchSize = 4096;
+    static const quint32 cHeaderReserve = 4096;
+
+signals:
+    void writeErrorOccurred(QString filePath);
+
+public slots:
+    void processQueue();
+
+private:
+
+    bool writeBatch();
+    bool finishBatch();
+    bool replaceHeader(const QByteArray& header, qint64 dataOffset);
+    void reportError();
+
+    QByteArray csvHeader(const QStringList& headerLines, qint32 paddingSize) const;
+
+    static const qint64 cCopyBlockSize = 1024 * 1024;
+
+    Settings _settings;
+
+    LogRecordQueue _queue;
+    std::atomic<bool> _bOpen;
+    std::atomic<bool> _bProcessPending;
+
+    /* Written by producer, reported by writer thread */
+    std::atomic<quint64> _droppedCount;
+    quint64 _reportedDropCount;
+
+    QTimer* _pFlushTimer;
+    QElapsedTimer _syncTimer;
+
+    /* Csv */
+    QFile _file;
+    qint32 _headerSize;
+
+    /* Binary */
+    BinaryDataWriter _binaryWriter;
+
+    /* Batch buffers, reused to avoid allocations */
+    QVector<double> _timestamps;
+    QVector<double> _values;
+    QList<double> _rowValues;
+    QByteArray _lineBuffer;
+};
+
+#endif // DATALOGWRITER_H
@@ -9,6 +9,12 @@ DiagnosticExporter::DiagnosticExporter(DiagnosticModel * pDiagModel, QObject *pa
 
 void DiagnosticExporter::exportDiagnosticsFile(QTextStream& diagStream)
 {
+    /* Include logs that aren't inserted yet */
+    _pDiagModel->flush();
+
+    /* Oldest logs that were removed from the model */
+    _pDiagModel->exportSpilled(diagStream);
+
     for (qint32 idx = 0; idx < _pDiagModel->size(); idx++)
     {
         diagStream << _pDiagModel->toExportString(idx) << "\n";
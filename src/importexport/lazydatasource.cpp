@@ -0,0 +1,444 @@
+#include <algorithm> // std::lower_bound
+
+#include <QtNumeric>
+
+#include "lazydatasource.h"
+
+LazyDataSource::LazyDataSource()
+    : _bIndexCached(false),
+      _blockCache(cCacheValueCount)
+{
+
+}
+
+LazyDataSource::~LazyDataSource()
+{
+    close();
+}
+
+/*!
+ * Open data file and load its index
+ * The index is built (and cached next to the data file) when there is no valid cache.
+ * \param filePath          path of binary data file
+ * \param progressCallback  called with percentage while the index is built
+ * \return false on error, see errorString()
+ */
+bool LazyDataSource::open(QString filePath, const std::function<void(int)>& progressCallback)
+{
+    close();
+
+    if (!_reader.open(filePath))
+    {
+        return false;
+    }
+
+    _bIndexCached = _index.load(filePath, _reader);
+    if (!_bIndexCached)
+    {
+        if (!_index.build(_reader, progressCallback))
+        {
+            _reader.close();
+            return false;
+        }
+
+        /* Browsing still works without cache (e.g. read-only location) */
+        _index.save(filePath);
+    }
+
+    _filePath = filePath;
+
+    return true;
+}
+
+void LazyDataSource::close()
+{
+    _blockCache.clear();
+    _index.clear();
+    _reader.close();
+    _bIndexCached = false;
+    _filePath.clear();
+}
+
+QString LazyDataSource::filePath() const
+{
+    return _filePath;
+}
+
+QString LazyDataSource::errorString() const
+{
+    if (_reader.errorString().isEmpty())
+    {
+        return QString("Binary data file is corrupt");
+    }
+
+    return _reader.errorString();
+}
+
+const BinaryDataFile::Metadata& LazyDataSource::metadata() const
+{
+    return _reader.metadata();
+}
+
+/*!
+ * Whether index was loaded from cache on open
+ */
+bool LazyDataSource::isIndexCached() const
+{
+    return _bIndexCached;
+}
+
+qint32 LazyDataSource::graphCount() const
+{
+    return _index.graphCount();
+}
+
+qint64 LazyDataSource::sampleCount() const
+{
+    return _index.sampleCount();
+}
+
+QCPRange LazyDataSource::keyRange(bool &foundRange) const
+{
+    foundRange = _index.blockCount() > 0;
+    if (!foundRange)
+    {
+        return QCPRange();
+    }
+
+    return QCPRange(_index.block(0).firstKey, _index.block(_index.blockCount() - 1).lastKey);
+}
+
+/*!
+ * Get samples of key range, reduced to about two samples per bucket
+ * Keys are shared by all graphs. When there are more samples than buckets, each bucket
+ * contains the minimum and maximum of every graph, in order of occurrence.
+ * \param keyRange      key range, the blocks around the range are included so lines continue outside of it
+ * \param maxBuckets    number of buckets (e.g. pixels)
+ * \param timeRow       keys of samples
+ * \param dataRows      values of samples, one list per graph
+ */
+void LazyDataSource::window(const QCPRange &keyRange, qint32 maxBuckets, QList<double> &timeRow, QList<QList<double> > &dataRows)
+{
+    timeRow.clear();
+    dataRows.clear();
+    for (qint32 graphIdx = 0; graphIdx < graphCount(); graphIdx++)
+    {
+        dataRows.append(QList<double>());
+    }
+
+    if (
+        (_index.blockCount() == 0)
+        || (maxBuckets <= 0)
+    )
+    {
+        return;
+    }
+
+    const qint32 firstBlock = qMax(0, _index.findBlock(keyRange.lower) - 1);
+    const qint32 lastBlock = qMin(_index.blockCount() - 1, _index.findBlock(keyRange.upper) + 1);
+
+    qint64 rangeSampleCount = 0;
+    for (qint32 blockIdx = firstBlock; blockIdx <= lastBlock; blockIdx++)
+    {
+        rangeSampleCount += _index.block(blockIdx).sampleCount;
+    }
+
+    const qint32 rangeBlockCount = lastBlock - firstBlock + 1;
+    const qint64 envelopeBucketCount = rangeSampleCount / DataFileIndex::cEnvelopeBucketSize;
+
+    if (rangeBlockCount <= cMaxDecodedBlocks)
+    {
+        /* Zoomed in: decode samples */
+        const qint32 bucketSize = static_cast<qint32>((rangeSampleCount + maxBuckets - 1) / maxBuckets);
+
+        for (qint32 blockIdx = firstBlock; blockIdx <= lastBlock; blockIdx++)
+        {
+            const DecodedBlock* pDecoded = decodedBlock(blockIdx);
+            if (pDecoded == nullptr)
+            {
+                break;
+            }
+
+            appendSamples(*pDecoded, bucketSize, timeRow, dataRows);
+        }
+    }
+    else if (envelopeBucketCount <= 2 * static_cast<qint64>(maxBuckets))
+    {
+        /* Envelope of index has enough detail */
+        for (qint32 blockIdx = firstBlock; blockIdx <= lastBlock; blockIdx++)
+        {
+            appendBlockEnvelope(_index.block(blockIdx), timeRow, dataRows);
+        }
+    }
+    else
+    {
+        /* Zoomed out: block is smaller than a bucket, merge summaries of blocks per bucket */
+        const qint32 blocksPerBucket = (rangeBlockCount + maxBuckets - 1) / maxBuckets;
+
+        for (qint32 blockIdx = firstBlock; blockIdx <= lastBlock; blockIdx += blocksPerBucket)
+        {
+            appendBlockSummary(blockIdx, qMin(blockIdx + blocksPerBucket - 1, lastBlock), timeRow, dataRows);
+        }
+    }
+}
+
+/*!
+ * Calculate statistics of samples in key range
+ * Blocks that are completely in range use the summaries of the index, only the blocks
+ * at the edges of the range are decoded. Samples without value (NaN) are skipped and
+ * segments towards them have no area.
+ * \param graphIdx      index of graph
+ * \param startKey      key of first sample
+ * \param endKey        key of last sample
+ * \return Statistics of range, same result as GraphDataIndex::statistics
+ */
+GraphDataIndex::Statistics LazyDataSource::statistics(qint32 graphIdx, double startKey, double endKey)
+{
+    EnvelopePyramid::Summary summary;
+    EnvelopePyramid::initSummary(summary);
+    double lastArea = 0;
+
+    if (
+        (graphIdx < 0)
+        || (graphIdx >= graphCount())
+    )
+    {
+        return GraphDataIndex::summaryStatistics(summary, lastArea);
+    }
+
+    for (qint32 blockIdx = _index.findBlock(startKey); blockIdx < _index.blockCount(); blockIdx++)
+    {
+        const DataFileIndex::Block& block = _index.block(blockIdx);
+
+        if (block.firstKey > endKey)
+        {
+            break;
+        }
+        else if (
+            (block.firstKey >= startKey)
+            && (block.lastKey <= endKey)
+        )
+        {
+            EnvelopePyramid::merge(summary, block.summaries[graphIdx]);
+            if (block.summaries[graphIdx].count > 0)
+            {
+                lastArea = block.tailAreas[graphIdx];
+            }
+        }
+        else
+        {
+            const DecodedBlock* pDecoded = decodedBlock(blockIdx);
+            if (pDecoded == nullptr)
+            {
+                break;
+            }
+
+            const QList<double>& keys = pDecoded->timeRow;
+            const QList<double>& values = pDecoded->dataRows[graphIdx];
+            for (qint32 idx = 0; idx < keys.size(); idx++)
+            {
+                if (keys[idx] < startKey)
+                {
+                    continue;
+                }
+                else if (keys[idx] > endKey)
+                {
+                    break;
+                }
+                else if (qIsNaN(values[idx]))
+                {
+                    /* Graph has no sample at this time */
+                    continue;
+                }
+                else
+                {
+                    /* Same areas as the block summaries of the index */
+                    double area = block.tailAreas[graphIdx];
+                    if (idx + 1 < keys.size())
+                    {
+                        area = 0;
+                        if (!qIsNaN(values[idx + 1]))
+                        {
+                            area = (keys[idx + 1] - keys[idx]) * (values[idx] + values[idx + 1]) / 2;
+                        }
+                    }
+
+                    EnvelopePyramid::addSample(summary, block.firstSample + idx, values[idx], area);
+                    lastArea = area;
+                }
+            }
+        }
+    }
+
+    return GraphDataIndex::summaryStatistics(summary, lastArea);
+}
+
+/*!
+ * Get value of first sample at or after key, last sample when key is after the data
+ */
+double LazyDataSource::valueAt(qint32 graphIdx, double key)
+{
+    if (
+        (graphIdx < 0)
+        || (graphIdx >= graphCount())
+        || (_index.blockCount() == 0)
+    )
+    {
+        return 0;
+    }
+
+    const qint32 blockIdx = qMin(_index.findBlock(key), _index.blockCount() - 1);
+    const DecodedBlock* pDecoded = decodedBlock(blockIdx);
+    if (pDecoded == nullptr)
+    {
+        return 0;
+    }
+
+    const QList<double>& keys = pDecoded->timeRow;
+    const qint32 idx = static_cast<qint32>(std::lower_bound(keys.constBegin(), keys.constEnd(), key) - keys.constBegin());
+
+    return pDecoded->dataRows[graphIdx][qMin(idx, static_cast<qint32>(keys.size()) - 1)];
+}
+
+qint32 LazyDataSource::blockCount() const
+{
+    return _index.blockCount();
+}
+
+/*!
+ * Read all samples of block, without using the cache (e.g. to export the complete file)
+ */
+bool LazyDataSource::readBlock(qint32 blockIdx, QList<double> &timeRow, QList<QList<double> > &dataRows) const
+{
+    timeRow.clear();
+    dataRows.clear();
+
+    return _reader.readChunk(blockIdx, timeRow, dataRows);
+}
+
+/*!
+ * Get decoded block from cache, decode it when needed
+ * \return Decoded block, only valid until the next call. nullptr on error
+ */
+const LazyDataSource::DecodedBlock* LazyDataSource::decodedBlock(qint32 blockIdx)
+{
+    DecodedBlock* pDecoded = _blockCache.object(blockIdx);
+    if (pDecoded == nullptr)
+    {
+        pDecoded = new DecodedBlock();
+        if (!_reader.readChunk(blockIdx, pDecoded->timeRow, pDecoded->dataRows))
+        {
+            delete pDecoded;
+            return nullptr;
+        }
+
+        const qsizetype cost = pDecoded->timeRow.size() * (pDecoded->dataRows.size() + 1);
+
+        /* Cache takes ownership, block that is too large for the cache is deleted immediately */
+        _blockCache.insert(blockIdx, pDecoded, cost);
+        pDecoded = _blockCache.object(blockIdx);
+    }
+
+    return pDecoded;
+}
+
+/*!
+ * Append samples of block, reduced to the minimum and maximum of each bucket of bucketSize samples
+ * Samples without value (NaN) are skipped in the buckets.
+ */
+void LazyDataSource::appendSamples(const DecodedBlock &decoded, qint32 bucketSize, QList<double> &timeRow, QList<QList<double> > &dataRows) const
+{
+    const qint32 count = static_cast<qint32>(decoded.timeRow.size());
+
+    if (bucketSize <= 1)
+    {
+        timeRow.append(decoded.timeRow);
+        for (qint32 graphIdx = 0; graphIdx < dataRows.size(); graphIdx++)
+        {
+            dataRows[graphIdx].append(decoded.dataRows[graphIdx]);
+        }
+
+        return;
+    }
+
+    for (qint32 begin = 0; begin < count; begin += bucketSize)
+    {
+        const qint32 end = qMin(begin + bucketSize, count);
+
+        timeRow.append(decoded.timeRow[begin]);
+        if (end - begin > 1)
+        {
+            timeRow.append(decoded.timeRow[end - 1]);
+        }
+
+        for (qint32 graphIdx = 0; graphIdx < dataRows.size(); graphIdx++)
+        {
+            if (end - begin <= 1)
+            {
+                dataRows[graphIdx].append(decoded.dataRows[graphIdx][begin]);
+            }
+            else
+            {
+                DataFileIndex::appendExtremes(decoded.dataRows[graphIdx], begin, end, dataRows[graphIdx]);
+            }
+        }
+    }
+}
+
+/*!
+ * Append envelope of block from the index
+ */
+void LazyDataSource::appendBlockEnvelope(const DataFileIndex::Block &block, QList<double> &timeRow, QList<QList<double> > &dataRows) const
+{
+    const qint32 stride = _index.envelopeStride();
+
+    for (qint32 pos = 0; pos + stride <= block.envelope.size(); pos += stride)
+    {
+        timeRow.append(block.envelope[pos]);
+        timeRow.append(block.envelope[pos + 1]);
+
+        for (qint32 graphIdx = 0; graphIdx < dataRows.size(); graphIdx++)
+        {
+            dataRows[graphIdx].append(block.envelope[pos + 2 + 2 * graphIdx]);
+            dataRows[graphIdx].append(block.envelope[pos + 3 + 2 * graphIdx]);
+        }
+    }
+}
+
+/*!
+ * Append minimum and maximum of consecutive blocks, in order of occurrence
+ * A graph without samples in the blocks gets NaN, so it has a gap instead of a false zero.
+ * \param firstBlock    index of first block
+ * \param lastBlock     index of last block
+ */
+void LazyDataSource::appendBlockSummary(qint32 firstBlock, qint32 lastBlock, QList<double> &timeRow, QList<QList<double> > &dataRows) const
+{
+    timeRow.append(_index.block(firstBlock).firstKey);
+    timeRow.append(_index.block(lastBlock).lastKey);
+
+    for (qint32 graphIdx = 0; graphIdx < dataRows.size(); graphIdx++)
+    {
+        EnvelopePyramid::Summary summary;
+        EnvelopePyramid::initSummary(summary);
+        for (qint32 blockIdx = firstBlock; blockIdx <= lastBlock; blockIdx++)
+        {
+            EnvelopePyramid::merge(summary, _index.block(blockIdx).summaries[graphIdx]);
+        }
+
+        if (summary.count == 0)
+        {
+            dataRows[graphIdx].append(qQNaN());
+            dataRows[graphIdx].append(qQNaN());
+        }
+        else if (summary.minIdx <= summary.maxIdx)
+        {
+            dataRows[graphIdx].append(summary.min);
+            dataRows[graphIdx].append(summary.max);
+        }
+        else
+        {
+            dataRows[graphIdx].append(summary.max);
+            dataRows[graphIdx].append(summary.min);
+        }
+    }
+}
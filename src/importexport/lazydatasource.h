@@ -0,0 +1,69 @@
+#ifndef LAZYDATASOURCE_H
+#define LAZYDATASOURCE_H
+
+#include <QCache>
+#include <functional>
+
+#include "binarydatareader.h"
+#include "datafileindex.h"
+#include "graphdataindex.h"
+
+/*!
+ * Data source that reads samples of a binary data file on demand
+ * Only the samples of the requested key range are decoded, at the resolution that is needed
+ * to draw them. Decoded chunks are kept in a cache of limited size, so files that are larger
+ * than the available memory can be browsed.
+ */
+class LazyDataSource
+{
+public:
+    LazyDataSource();
+    ~LazyDataSource();
+
+    bool open(QString filePath, const std::function<void(int)>& progressCallback);
+    void close();
+
+    QString filePath() const;
+    QString errorString() const;
+    const BinaryDataFile::Metadata& metadata() const;
+    bool isIndexCached() const;
+
+    qint32 graphCount() const;
+    qint64 sampleCount() const;
+    QCPRange keyRange(bool &foundRange) const;
+
+    void window(const QCPRange &keyRange, qint32 maxBuckets, QList<double> &timeRow, QList<QList<double> > &dataRows);
+    GraphDataIndex::Statistics statistics(qint32 graphIdx, double startKey, double endKey);
+    double valueAt(qint32 graphIdx, double key);
+
+    qint32 blockCount() const;
+    bool readBlock(qint32 blockIdx, QList<double> &timeRow, QList<QList<double> > &dataRows) const;
+
+    static const qint32 cMaxDecodedBlocks = 32;
+
+private:
+
+    typedef struct
+    {
+        QList<double> timeRow;
+        QList<QList<double> > dataRows;
+    } DecodedBlock;
+
+    const DecodedBlock* decodedBlock(qint32 blockIdx);
+
+    void appendSamples(const DecodedBlock &decoded, qint32 bucketSize, QList<double> &timeRow, QList<QList<double> > &dataRows) const;
+    void appendBlockEnvelope(const DataFileIndex::Block &block, QList<double> &timeRow, QList<QList<double> > &dataRows) const;
+    void appendBlockSummary(qint32 firstBlock, qint32 lastBlock, QList<double> &timeRow, QList<QList<double> > &dataRows) const;
+
+    QString _filePath;
+    BinaryDataReader _reader;
+    DataFileIndex _index;
+    bool _bIndexCached;
+
+    /* Cost of a decoded block is its number of values */
+    QCache<qint32, DecodedBlock> _blockCache;
+
+    static const qint32 cCacheValueCount = 4 * 1024 * 1024;
+};
+
+#endif // LAZYDATASOURCE_H
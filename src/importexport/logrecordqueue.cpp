@@ -0,0 +1,109 @@
+
+#include "logrecordqueue.h"
+
+LogRecordQueue::LogRecordQueue() :
+    _ring(0, 1)
+{
+
+}
+
+/*!
+ * Discard all records and prepare queue for records with columnCount values
+ * The capacity is chosen so the memory of the queue doesn't depend on the number of columns.
+ * Must only be called while neither the producer nor the consumer accesses the queue.
+ */
+void LogRecordQueue::reset(qint32 columnCount)
+{
+    const quint32 rowValueCount = static_cast<quint32>(qMax(columnCount, 0)) + 1;
+    const quint32 minCapacity = cMinCapacity;
+    const quint32 capacity = qMax(cValueCapacity / rowValueCount, minCapacity);
+
+    _ring.reset(capacity, static_cast<qint32>(rowValueCount));
+}
+
+/*!
+ * Add record to queue
+ * Must only be called from the producer thread. The producer never waits on the consumer,
+ * the record is rejected when the queue is full.
+ * \param timestamp     Time of record
+ * \param values        Value per column
+ * \return true when record is added, false when queue is full or record doesn't match the columns
+ */
+bool LogRecordQueue::push(double timestamp, const QList<double>& values)
+{
+    if (values.size() != columnCount())
+    {
+        return false;
+    }
+
+    double* pRecord = _ring.pushSlot();
+    if (pRecord == nullptr)
+    {
+        return false;
+    }
+
+    pRecord[0] = timestamp;
+    for (qsizetype col = 0; col < values.size(); col++)
+    {
+        pRecord[col + 1] = values[col];
+    }
+
+    _ring.commitPush();
+
+    return true;
+}
+
+/*!
+ * Take records from queue
+ * Must only be called from the consumer thread
+ * \param maxCount      Maximum number of records to take
+ * \param timestamps    Timestamps of records are appended to this list
+ * \param values        Values of records are appended to this list, columnCount() values per record
+ * \return Number of records taken
+ */
+qint32 LogRecordQueue::pop(qint32 maxCount, QVector<double>& timestamps, QVector<double>& values)
+{
+    const quint32 count = qMin(_ring.size(), static_cast<quint32>(qMax(maxCount, 0)));
+
+    if (count > 0)
+    {
+        const qint32 colCount = columnCount();
+
+        timestamps.reserve(timestamps.size() + count);
+        values.reserve(values.size() + static_cast<qsizetype>(count) * colCount);
+
+        for (quint32 idx = 0; idx < count; idx++)
+        {
+            const double* pRecord = _ring.peek(idx);
+
+            timestamps.append(pRecord[0]);
+            for (qint32 col = 0; col < colCount; col++)
+            {
+                values.append(pRecord[col + 1]);
+            }
+        }
+
+        _ring.commitPop(count);
+    }
+
+    return static_cast<qint32>(count);
+}
+
+qint32 LogRecordQueue::columnCount() const
+{
+    return _ring.stride() - 1;
+}
+
+/*!
+ * Return number of queued records
+ * Can be called from any thread, the result is only a snapshot.
+ */
+quint32 LogRecordQueue::size() const
+{
+    return _ring.size();
+}
+
+quint32 LogRecordQueue::capacity() const
+{
+    return _ring.capacity();
+}
@@ -0,0 +1,39 @@
+#ifndef LOGRECORDQUEUE_H
+#define LOGRECORDQUEUE_H
+
+#include <QList>
+#include <QVector>
+
+#include "spscring.h"
+
+/*!
+ * Fixed capacity queue of sample records for the data log writer
+ * A record is stored in binary form (time and one value per column), formatting is left to
+ * the consumer. One producer and one consumer thread can access the queue at the same time
+ * without locking.
+ */
+class LogRecordQueue
+{
+public:
+    LogRecordQueue();
+
+    void reset(qint32 columnCount);
+
+    bool push(double timestamp, const QList<double>& values);
+    qint32 pop(qint32 maxCount, QVector<double>& timestamps, QVector<double>& values);
+
+    qint32 columnCount() const;
+    quint32 size() const;
+    quint32 capacity() const;
+
+    static const quint32 cValueCapacity = 1024 * 1024;
+    static const quint32 cMinCapacity = 1024;
+
+private:
+    Q_DISABLE_COPY(LogRecordQueue)
+
+    /* A record holds the time in its first value, followed by one value per column */
+    SpscRing<double> _ring;
+};
+
+#endif // LOGRECORDQUEUE_H
@@ -0,0 +1,609 @@
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+
+#include <QDateTime>
+#include <QDeadlineTimer>
+#include <QThread>
+
+#include "dataparsermodel.h"
+#include "mappeddataparser.h"
+
+/* Maximum length of a single number field */
+static const qint32 cMaxNumberLength = 64;
+
+/* Interval of progress updates while waiting for the worker threads (ms) */
+static const qint32 cProgressInterval = 50;
+
+/* Parsed byte count between updates of the shared progress counter */
+static const qint64 cProgressGranularity = 256 * 1024;
+
+/* Number of lines that are tried per preview sample to find a data line */
+static const qint32 cPreviewLineAttempts = 8;
+
+static inline bool isSpace(char c)
+{
+    return (c == ' ') || (c == '\t') || (c == '\r') || (c == '\n') || (c == '\v') || (c == '\f');
+}
+
+static inline bool isDigit(char c)
+{
+    return (c >= '0') && (c <= '9');
+}
+
+static void trim(const char*& pBegin, const char*& pEnd)
+{
+    while ((pBegin < pEnd) && isSpace(*pBegin))
+    {
+        pBegin++;
+    }
+
+    while ((pEnd > pBegin) && isSpace(*(pEnd - 1)))
+    {
+        pEnd--;
+    }
+}
+
+/* Parse between minDigits and maxDigits digits, return false when less than minDigits are available */
+static bool parseDigits(const char*& p, const char* pEnd, qint32 minDigits, qint32 maxDigits, qint32& value)
+{
+    qint32 digits = 0;
+
+    value = 0;
+    while ((p < pEnd) && (digits < maxDigits) && isDigit(*p))
+    {
+        value = value * 10 + (*p - '0');
+        p++;
+        digits++;
+    }
+
+    return digits >= minDigits;
+}
+
+MappedDataParser::MappedDataParser(const Settings& settings)
+    : _settings(settings),
+      _lineCount(0),
+      _bytesParsed(0)
+{
+    _error.type = ERROR_NONE;
+    _error.lineNumber = 0;
+}
+
+/*!
+ * Convert parser settings to their single byte representation
+ * \return false when a separator can't be handled on raw bytes
+ */
+bool MappedDataParser::settingsFromModel(DataParserModel* pDataParserModel, quint32 expectedFields, Settings& settings)
+{
+    const QString fieldSeparator = pDataParserModel->fieldSeparator();
+    const QString groupSeparator = pDataParserModel->groupSeparator();
+    const QString decimalSeparator = pDataParserModel->decimalSeparator();
+    const QString commentSequence = pDataParserModel->commentSequence();
+
+    if (
+        (fieldSeparator.size() != 1)
+        || (fieldSeparator.at(0).unicode() >= 0x80)
+        || (decimalSeparator.size() != 1)
+        || (decimalSeparator.at(0).unicode() >= 0x80)
+        || (groupSeparator.size() > 1)
+        || (!groupSeparator.isEmpty() && (groupSeparator.at(0).unicode() >= 0x80))
+    )
+    {
+        return false;
+    }
+
+    settings.fieldSeparator = fieldSeparator.at(0).toLatin1();
+    settings.groupSeparator = groupSeparator.isEmpty() ? '\0' : groupSeparator.at(0).toLatin1();
+    settings.decimalSeparator = decimalSeparator.at(0).toLatin1();
+    settings.commentSequence = commentSequence.toUtf8();
+    settings.column = pDataParserModel->column();
+    settings.expectedFields = expectedFields;
+    settings.bTimeInMilliSeconds = pDataParserModel->timeInMilliSeconds();
+
+    return true;
+}
+
+/*!
+ * Parse data lines
+ * \param pData             start of data lines
+ * \param size              size of data in bytes
+ * \param dataRows          parsed data, one list per column (time column first)
+ * \param progressCallback  called periodically with the number of parsed bytes
+ * \return false on error, see error()
+ */
+bool MappedDataParser::parse(const char* pData, qint64 size, QList<QList<double> >& dataRows, const std::function<void(qint64)>& progressCallback)
+{
+    _bytesParsed = 0;
+    _lineCount = 0;
+    _error.type = ERROR_NONE;
+
+    const qint64 chunkCount = qBound(static_cast<qint64>(1), size / cMinChunkSize, static_cast<qint64>(QThread::idealThreadCount()));
+
+    /* Split data in line aligned chunks */
+    QList<Chunk> chunks;
+    const char* pChunkBegin = pData;
+    const char* pDataEnd = pData + size;
+    for (qint64 idx = 0; idx < chunkCount; idx++)
+    {
+        const char* pChunkEnd = pDataEnd;
+        if (idx < chunkCount - 1)
+        {
+            pChunkEnd = pData + (size * (idx + 1)) / chunkCount;
+            pChunkEnd = std::max(pChunkEnd, pChunkBegin);
+
+            const char* pNewLine = static_cast<const char*>(memchr(pChunkEnd, '\n', pDataEnd - pChunkEnd));
+            pChunkEnd = (pNewLine == nullptr) ? pDataEnd : pNewLine + 1;
+        }
+
+        Chunk chunk;
+        chunk.pBegin = pChunkBegin;
+        chunk.pEnd = pChunkEnd;
+        chunk.lineCount = 0;
+        chunk.rowOffset = 0;
+        chunk.rowCount = 0;
+        chunk.error.type = ERROR_NONE;
+        chunk.error.lineNumber = 0;
+        chunks.append(chunk);
+
+        pChunkBegin = pChunkEnd;
+    }
+
+    auto reportProgress = [this, &progressCallback]() { progressCallback(_bytesParsed); };
+
+    /* Count lines per chunk to determine the row slots of each chunk */
+    runParallel(chunks, [](Chunk& chunk) {
+        chunk.lineCount = std::count(chunk.pBegin, chunk.pEnd, '\n');
+        if ((chunk.pEnd > chunk.pBegin) && (*(chunk.pEnd - 1) != '\n'))
+        {
+            chunk.lineCount++;
+        }
+    }, [](){});
+
+    qint64 totalLines = 0;
+    for (Chunk& chunk : chunks)
+    {
+        chunk.rowOffset = totalLines;
+        totalLines += chunk.lineCount;
+    }
+
+    /* Preallocate columns */
+    dataRows.clear();
+    QList<double*> columns;
+    for (quint32 idx = 0; idx < _settings.expectedFields; idx++)
+    {
+        dataRows.append(QList<double>(totalLines));
+        columns.append(dataRows.last().data());
+    }
+
+    runParallel(chunks, [this, &columns](Chunk& chunk) { parseChunk(chunk, columns); }, reportProgress);
+
+    /* Report first error in file order */
+    qint64 lineOffset = 0;
+    for (const Chunk& chunk : qAsConst(chunks))
+    {
+        if (chunk.error.type != ERROR_NONE)
+        {
+            _error = chunk.error;
+            _error.lineNumber += lineOffset;
+
+            for (QList<double>& row : dataRows)
+            {
+                row.clear();
+            }
+
+            return false;
+        }
+
+        lineOffset += chunk.lineCount;
+    }
+
+    /* Remove unused slots of skipped (empty or comment) lines */
+    qint64 rowCount = 0;
+    for (const Chunk& chunk : qAsConst(chunks))
+    {
+        if ((chunk.rowOffset != rowCount) && (chunk.rowCount > 0))
+        {
+            for (double* pColumn : qAsConst(columns))
+            {
+                memmove(pColumn + rowCount, pColumn + chunk.rowOffset, static_cast<size_t>(chunk.rowCount) * sizeof(double));
+            }
+        }
+
+        rowCount += chunk.rowCount;
+    }
+
+    for (QList<double>& row : dataRows)
+    {
+        row.resize(rowCount);
+        row.squeeze();
+    }
+
+    _lineCount = totalLines;
+
+    progressCallback(size);
+
+    return true;
+}
+
+/*!
+ * Parse evenly spaced lines of the data as quick preview of the complete data set
+ * Lines with invalid data and lines that aren't in increasing time order are skipped.
+ * \param sampleCount     maximum number of lines
+ * \param dataRows        parsed data, one list per column (time column first)
+ */
+void MappedDataParser::preview(const char* pData, qint64 size, qint32 sampleCount, QList<QList<double> >& dataRows) const
+{
+    const char* pDataEnd = pData + size;
+
+    dataRows.clear();
+    QList<double*> columns;
+    for (quint32 idx = 0; idx < _settings.expectedFields; idx++)
+    {
+        dataRows.append(QList<double>(sampleCount + 1));
+        columns.append(dataRows.last().data());
+    }
+
+    qint64 rowCount = 0;
+    for (qint32 sampleIdx = 0; (sampleIdx < sampleCount) && (size > 0); sampleIdx++)
+    {
+        /* Start at first line after sample offset */
+        const char* pLine = pData + (size * sampleIdx) / sampleCount;
+        if (pLine > pData)
+        {
+            const char* pNewLine = static_cast<const char*>(memchr(pLine - 1, '\n', pDataEnd - pLine + 1));
+            pLine = (pNewLine == nullptr) ? pDataEnd : pNewLine + 1;
+        }
+
+        /* Use first valid data line */
+        for (qint32 attempt = 0; (attempt < cPreviewLineAttempts) && (pLine < pDataEnd); attempt++)
+        {
+            const char* pNewLine = static_cast<const char*>(memchr(pLine, '\n', pDataEnd - pLine));
+            const char* pBegin = pLine;
+            const char* pEnd = (pNewLine == nullptr) ? pDataEnd : pNewLine;
+
+            pLine = (pNewLine == nullptr) ? pDataEnd : pNewLine + 1;
+
+            if (
+                isDataLine(pBegin, pEnd)
+                && (parseLine(pBegin, pEnd, columns, rowCount) == ERROR_NONE)
+            )
+            {
+                if ((rowCount == 0) || (columns[0][rowCount] > columns[0][rowCount - 1]))
+                {
+                    rowCount++;
+                }
+                break;
+            }
+        }
+    }
+
+    /* Always include the last line, so the preview covers the complete time range */
+    const char* pEnd = pDataEnd;
+    while (pEnd > pData)
+    {
+        const char* pBegin = pEnd;
+        while ((pBegin > pData) && (*(pBegin - 1) != '\n'))
+        {
+            pBegin--;
+        }
+
+        const char* pLineBegin = pBegin;
+        const char* pLineEnd = pEnd;
+        if (
+            isDataLine(pLineBegin, pLineEnd)
+            && (parseLine(pLineBegin, pLineEnd, columns, rowCount) == ERROR_NONE)
+        )
+        {
+            if ((rowCount == 0) || (columns[0][rowCount] > columns[0][rowCount - 1]))
+            {
+                rowCount++;
+            }
+            break;
+        }
+
+        pEnd = (pBegin > pData) ? pBegin - 1 : pData;
+    }
+
+    for (QList<double>& row : dataRows)
+    {
+        row.resize(rowCount);
+    }
+}
+
+/*!
+ * Number of lines (including empty and comment lines) in the data of the last parse
+ */
+qint64 MappedDataParser::lineCount() const
+{
+    return _lineCount;
+}
+
+const MappedDataParser::Error& MappedDataParser::error() const
+{
+    return _error;
+}
+
+/*!
+ * Parse a number field with the configured group and decimal separator
+ * Surrounding whitespace is ignored.
+ */
+bool MappedDataParser::parseNumber(const char* pBegin, const char* pEnd, const Settings& settings, double& result)
+{
+    char buffer[cMaxNumberLength];
+    qint32 length = 0;
+
+    trim(pBegin, pEnd);
+
+    for (const char* p = pBegin; p < pEnd; p++)
+    {
+        char c = *p;
+
+        if ((settings.groupSeparator != '\0') && (c == settings.groupSeparator))
+        {
+            continue;
+        }
+        else if (c == settings.decimalSeparator)
+        {
+            c = '.';
+        }
+        else
+        {
+            /* Use character as is */
+        }
+
+        if (length >= cMaxNumberLength)
+        {
+            return false;
+        }
+
+        buffer[length] = c;
+        length++;
+    }
+
+    const char* pStart = buffer;
+    const char* pStop = buffer + length;
+
+    if ((pStart < pStop) && (*pStart == '+'))
+    {
+        pStart++;
+    }
+
+    if (pStart == pStop)
+    {
+        return false;
+    }
+
+    const std::from_chars_result res = std::from_chars(pStart, pStop, result);
+
+    return (res.ec == std::errc()) && (res.ptr == pStop);
+}
+
+/*!
+ * Parse absolute date and time (dd-MM-yyyy HH:mm:ss.zzz)
+ * \param result    milliseconds since epoch (local time)
+ */
+bool MappedDataParser::parseDateTime(const char* pBegin, const char* pEnd, double& result)
+{
+    const char* p = pBegin;
+    qint32 day = 0;
+    qint32 month = 0;
+    qint32 year = 0;
+    qint32 hours = 0;
+    qint32 minutes = 0;
+    qint32 seconds = 0;
+    qint32 milliseconds = 0;
+
+    auto isDateSeparator = [&p, pEnd]() {
+        return (p < pEnd) && ((*p == '-') || (*p == '/') || isSpace(*p));
+    };
+
+    while ((p < pEnd) && isSpace(*p))
+    {
+        p++;
+    }
+
+    if (!parseDigits(p, pEnd, 1, 2, day) || !isDateSeparator())
+    {
+        return false;
+    }
+    p++;
+
+    if (!parseDigits(p, pEnd, 1, 2, month) || !isDateSeparator())
+    {
+        return false;
+    }
+    p++;
+
+    if (!parseDigits(p, pEnd, 4, 4, year))
+    {
+        return false;
+    }
+
+    while ((p < pEnd) && isSpace(*p))
+    {
+        p++;
+    }
+
+    if (
+        !parseDigits(p, pEnd, 2, 2, hours)
+        || (p >= pEnd) || (*p++ != ':')
+        || !parseDigits(p, pEnd, 2, 2, minutes)
+        || (p >= pEnd) || (*p++ != ':')
+        || !parseDigits(p, pEnd, 2, 2, seconds)
+    )
+    {
+        return false;
+    }
+
+    if ((p < pEnd) && ((*p == '.') || (*p == ',')))
+    {
+        p++;
+    }
+
+    parseDigits(p, pEnd, 0, 3, milliseconds);
+
+    const QDateTime dateTime(QDate(year, month, day), QTime(hours, minutes, seconds, milliseconds));
+    if (!dateTime.isValid())
+    {
+        return false;
+    }
+
+    result = static_cast<double>(dateTime.toMSecsSinceEpoch());
+
+    return true;
+}
+
+void MappedDataParser::parseChunk(Chunk& chunk, const QList<double*>& columns)
+{
+    const char* pLine = chunk.pBegin;
+    const char* pLastReport = chunk.pBegin;
+    qint64 lineIdx = 0;
+
+    while (pLine < chunk.pEnd)
+    {
+        const char* pNewLine = static_cast<const char*>(memchr(pLine, '\n', chunk.pEnd - pLine));
+        const char* pBegin = pLine;
+        const char* pEnd = (pNewLine == nullptr) ? chunk.pEnd : pNewLine;
+        const char* pNext = (pNewLine == nullptr) ? chunk.pEnd : pNewLine + 1;
+
+        lineIdx++;
+
+        if (isDataLine(pBegin, pEnd))
+        {
+            const ErrorType error = parseLine(pBegin, pEnd, columns, chunk.rowOffset + chunk.rowCount);
+            if (error != ERROR_NONE)
+            {
+                chunk.error.type = error;
+                chunk.error.lineNumber = lineIdx;
+                chunk.error.line = QString::fromUtf8(pBegin, pEnd - pBegin);
+                break;
+            }
+
+            chunk.rowCount++;
+        }
+
+        if (pNext - pLastReport >= cProgressGranularity)
+        {
+            _bytesParsed += pNext - pLastReport;
+            pLastReport = pNext;
+        }
+
+        pLine = pNext;
+    }
+
+    _bytesParsed += pLine - pLastReport;
+}
+
+/*!
+ * Trim line and check whether it contains data
+ * \return false for empty and comment lines
+ */
+bool MappedDataParser::isDataLine(const char*& pBegin, const char*& pEnd) const
+{
+    trim(pBegin, pEnd);
+
+    const bool bComment = !_settings.commentSequence.isEmpty()
+                            && (pEnd - pBegin >= _settings.commentSequence.size())
+                            && (memcmp(pBegin, _settings.commentSequence.constData(), static_cast<size_t>(_settings.commentSequence.size())) == 0);
+
+    return (pBegin < pEnd) && !bComment;
+}
+
+/*!
+ * Parse fields of a (trimmed) data line into row of the columns
+ */
+MappedDataParser::ErrorType MappedDataParser::parseLine(const char* pBegin, const char* pEnd, const QList<double*>& columns, qint64 row) const
+{
+    const quint32 totalFields = _settings.column + _settings.expectedFields;
+    const quint32 fieldCount = static_cast<quint32>(std::count(pBegin, pEnd, _settings.fieldSeparator)) + 1;
+
+    if (fieldCount != totalFields)
+    {
+        return ERROR_FIELD_COUNT;
+    }
+
+    const char* pField = pBegin;
+    for (quint32 fieldIdx = 0; fieldIdx < fieldCount; fieldIdx++)
+    {
+        const char* pFieldEnd = static_cast<const char*>(memchr(pField, _settings.fieldSeparator, pEnd - pField));
+        if (pFieldEnd == nullptr)
+        {
+            pFieldEnd = pEnd;
+        }
+
+        if (fieldIdx >= _settings.column)
+        {
+            const bool bTimeField = fieldIdx == _settings.column;
+
+            const char* pTrimBegin = pField;
+            const char* pTrimEnd = pFieldEnd;
+            trim(pTrimBegin, pTrimEnd);
+
+            double number = 0;
+            if (pTrimBegin == pTrimEnd)
+            {
+                number = 0;
+            }
+            else if (parseNumber(pTrimBegin, pTrimEnd, _settings, number))
+            {
+                /* Valid number */
+            }
+            else if (bTimeField)
+            {
+                if (!parseDateTime(pTrimBegin, pTrimEnd, number))
+                {
+                    return ERROR_DATE;
+                }
+            }
+            else
+            {
+                return ERROR_DATA;
+            }
+
+            /* Only multiply for first column (time data) */
+            if (bTimeField && !_settings.bTimeInMilliSeconds)
+            {
+                number *= 1000;
+            }
+
+            columns[fieldIdx - _settings.column][row] = number;
+        }
+
+        pField = pFieldEnd + 1;
+    }
+
+    return ERROR_NONE;
+}
+
+void MappedDataParser::runParallel(QList<Chunk>& chunks, const std::function<void(Chunk&)>& func, const std::function<void()>& progressCallback)
+{
+    if (chunks.size() == 1)
+    {
+        func(chunks[0]);
+        progressCallback();
+    }
+    else
+    {
+        QList<QThread*> threads;
+        for (Chunk& chunk : chunks)
+        {
+            Chunk* pChunk = &chunk;
+            QThread* pThread = QThread::create([&func, pChunk]() { func(*pChunk); });
+            pThread->start();
+
+            threads.append(pThread);
+        }
+
+        for (QThread* pThread : qAsConst(threads))
+        {
+            while (!pThread->wait(QDeadlineTimer(cProgressInterval)))
+            {
+                progressCallback();
+            }
+
+            delete pThread;
+        }
+
+        progressCallback();
+    }
+}
@@ -0,0 +1,86 @@
+#ifndef MAPPEDDATAPARSER_H
+#define MAPPEDDATAPARSER_H
+
+#include <QList>
+#include <QString>
+#include <atomic>
+#include <functional>
+
+/* Forward declaration */
+class DataParserModel;
+
+/*!
+ * Parses the data lines of a memory mapped data file
+ * The data is split in line aligned chunks that are parsed in parallel, straight from the raw bytes,
+ * into preallocated column arrays.
+ */
+class MappedDataParser
+{
+public:
+
+    typedef struct
+    {
+        char fieldSeparator;
+        char groupSeparator; /* '\0' when not used */
+        char decimalSeparator;
+        QByteArray commentSequence;
+        quint32 column;
+        quint32 expectedFields;
+        bool bTimeInMilliSeconds;
+    } Settings;
+
+    typedef enum
+    {
+        ERROR_NONE = 0,
+        ERROR_FIELD_COUNT,
+        ERROR_DATE,
+        ERROR_DATA,
+    } ErrorType;
+
+    typedef struct
+    {
+        ErrorType type;
+        qint64 lineNumber; /* Relative to start of data */
+        QString line;
+    } Error;
+
+    explicit MappedDataParser(const Settings& settings);
+
+    static bool settingsFromModel(DataParserModel* pDataParserModel, quint32 expectedFields, Settings& settings);
+
+    bool parse(const char* pData, qint64 size, QList<QList<double> >& dataRows, const std::function<void(qint64)>& progressCallback);
+    void preview(const char* pData, qint64 size, qint32 sampleCount, QList<QList<double> >& dataRows) const;
+
+    qint64 lineCount() const;
+    const Error& error() const;
+
+    static bool parseNumber(const char* pBegin, const char* pEnd, const Settings& settings, double& result);
+    static bool parseDateTime(const char* pBegin, const char* pEnd, double& result);
+
+    static const qint64 cMinChunkSize = 1024 * 1024;
+
+private:
+
+    typedef struct
+    {
+        const char* pBegin;
+        const char* pEnd;
+        qint64 lineCount;
+        qint64 rowOffset;
+        qint64 rowCount;
+        Error error;
+    } Chunk;
+
+    void parseChunk(Chunk& chunk, const QList<double*>& columns);
+    bool isDataLine(const char*& pBegin, const char*& pEnd) const;
+    ErrorType parseLine(const char* pBegin, const char* pEnd, const QList<double*>& columns, qint64 row) const;
+    void runParallel(QList<Chunk>& chunks, const std::function<void(Chunk&)>& func, const std::function<void()>& progressCallback);
+
+    Settings _settings;
+    Error _error;
+    qint64 _lineCount;
+
+    std::atomic<qint64> _bytesParsed;
+};
+
+#endif // MAPPEDDATAPARSER_H
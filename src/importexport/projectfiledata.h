@@ -4,6 +4,8 @@
 #include <QColor>
 #include <QList>
 
+#include "readcapability.h"
+
 namespace ProjectFileData
 {
     typedef struct _RegisterSettings
@@ -19,6 +21,8 @@ namespace ProjectFileData
 
         quint32 valueAxis = 0;
 
+        quint32 pollInterval = 0;
+
     } RegisterSettings;
 
     typedef struct
@@ -51,6 +55,14 @@ namespace ProjectFileData
 
         bool bAbsoluteTimes = false;
 
+        bool bIndependentPolling = false;
+
+        bool bPlotRetention = false;
+        quint32 plotRetention;
+
+        bool bMaxFrameRate = false;
+        quint32 maxFrameRate;
+
         bool bLogToFile = true;
         bool bLogToFileFile = false;
         QString logFile;
@@ -97,10 +109,18 @@ namespace ProjectFileData
         bool bConsecutiveMax = false;
         quint8 consecutiveMax;
 
+        bool bMaxGap = false;
+        quint8 maxGap;
+
+        bool bPipelineDepth = false;
+        quint8 pipelineDepth;
+
         bool bInt32LittleEndian = true;
 
         bool bPersistentConnection = true;
 
+        ReadCapability readCapability;
+
     } ConnectionSettings;
 
     typedef struct _GeneralSettings
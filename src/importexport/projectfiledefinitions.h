@@ -26,10 +26,18 @@ namespace ProjectFileDefinitions
     const char cStopBitsTag[] = "stopbits";
     const char cTimeoutTag[] = "timeout";
     const char cConsecutiveMaxTag[] = "consecutivemax";
+    const char cMaxGapTag[] = "maxgap";
+    const char cPipelineDepthTag[] = "pipelinedepth";
     const char cInt32LittleEndianTag[] = "int32littleendian";
     const char cPersistentConnectionTag[] = "persistentconnection";
+    const char cReadCapabilityTag[] = "readcapability";
+    const char cMaxReadSizeTag[] = "maxreadsize";
+    const char cReadBoundaryTag[] = "readboundary";
     const char cPollTimeTag[] = "polltime";
     const char cAbsoluteTimesTag[] = "absolutetimes";
+    const char cIndependentPollingTag[] = "independentpolling";
+    const char cPlotRetentionTag[] = "plotretention";
+    const char cMaxFrameRateTag[] = "maxframerate";
     const char cLogToFileTag[] = "logtofile";
     const char cFilenameTag[] = "filename";
     const char cRegisterTag[] = "register";
@@ -37,6 +45,7 @@ namespace ProjectFileDefinitions
     const char cExpressionTag[] = "expression";
     const char cColorTag[] = "color";
     const char cValueAxisTag[] = "valueaxis";
+    const char cPollIntervalTag[] = "pollinterval";
 
     const char cScaleTag[] = "scale";
     const char cXaxisTag[] = "xaxis";
@@ -50,6 +59,7 @@ namespace ProjectFileDefinitions
     const char cEnabledAttribute[] = "enabled";
     const char cActiveAttribute[] = "active";
     const char cModeAttribute[] = "mode";
+    const char cObjectTypeAttribute[] = "objecttype";
 
     /* Value strings */
     const char cSlidingValue[] = "sliding";
@@ -96,19 +96,51 @@ void ProjectFileExporter::createConnectionTags(QDomElement * pParentElement)
         addTextNode(ProjectFileDefinitions::cSlaveIdTag, QString("%1").arg(_pSettingsModel->slaveId(i)), &connectionElement);
         addTextNode(ProjectFileDefinitions::cTimeoutTag, QString("%1").arg(_pSettingsModel->timeout(i)), &connectionElement);
         addTextNode(ProjectFileDefinitions::cConsecutiveMaxTag, QString("%1").arg(_pSettingsModel->consecutiveMax(i)), &connectionElement);
+        addTextNode(ProjectFileDefinitions::cMaxGapTag, QString("%1").arg(_pSettingsModel->maxGap(i)), &connectionElement);
+        addTextNode(ProjectFileDefinitions::cPipelineDepthTag, QString("%1").arg(_pSettingsModel->pipelineDepth(i)), &connectionElement);
         addTextNode(ProjectFileDefinitions::cInt32LittleEndianTag, convertBoolToText(_pSettingsModel->int32LittleEndian(i)), &connectionElement);
         addTextNode(ProjectFileDefinitions::cPersistentConnectionTag, convertBoolToText(_pSettingsModel->persistentConnection(i)), &connectionElement);
 
+        createReadCapabilityTag(&connectionElement, i);
+
         pParentElement->appendChild(connectionElement);
     }
 }
 
+void ProjectFileExporter::createReadCapabilityTag(QDomElement * pParentElement, quint8 connectionId)
+{
+    const ReadCapability capability = _pSettingsModel->readCapability(connectionId);
+
+    /* Nothing learned yet */
+    if (capability.isEmpty())
+    {
+        return;
+    }
+
+    QDomElement capabilityElement = _domDocument.createElement(ProjectFileDefinitions::cReadCapabilityTag);
+
+    if (capability.maxBlockSize() > 0)
+    {
+        addTextNode(ProjectFileDefinitions::cMaxReadSizeTag, QString("%1").arg(capability.maxBlockSize()), &capabilityElement);
+    }
+
+    for (const ModbusAddress &address : capability.boundaryList())
+    {
+        addAddressNode(ProjectFileDefinitions::cReadBoundaryTag, address, &capabilityElement);
+    }
+
+    pParentElement->appendChild(capabilityElement);
+}
+
 void ProjectFileExporter::createLogTag(QDomElement * pParentElement)
 {
     QDomElement logElement = _domDocument.createElement(ProjectFileDefinitions::cLogTag);
 
     addTextNode(ProjectFileDefinitions::cPollTimeTag, QString("%1").arg(_pSettingsModel->pollTime()), &logElement);
     addTextNode(ProjectFileDefinitions::cAbsoluteTimesTag, convertBoolToText(_pSettingsModel->absoluteTimes()), &logElement);
+    addTextNode(ProjectFileDefinitions::cIndependentPollingTag, convertBoolToText(_pSettingsModel->independentPolling()), &logElement);
+    addTextNode(ProjectFileDefinitions::cPlotRetentionTag, QString("%1").arg(_pSettingsModel->plotRetention()), &logElement);
+    addTextNode(ProjectFileDefinitions::cMaxFrameRateTag, QString("%1").arg(_pSettingsModel->maxFrameRate()), &logElement);
 
     /* Create logtofile tag */
     QDomElement logToFileElement = _domDocument.createElement(ProjectFileDefinitions::cLogToFileTag);
@@ -148,6 +180,7 @@ void ProjectFileExporter::createRegisterTag(QDomElement * pParentElement, qint32
     addCDataNode(ProjectFileDefinitions::cExpressionTag, _pGraphDataModel->expression(idx), &registerElement);
     addTextNode(ProjectFileDefinitions::cColorTag, _pGraphDataModel->color(idx).name(), &registerElement);
     addTextNode(ProjectFileDefinitions::cValueAxisTag, QString("%1").arg(_pGraphDataModel->valueAxis(idx)), &registerElement);
+    addTextNode(ProjectFileDefinitions::cPollIntervalTag, QString("%1").arg(_pGraphDataModel->pollInterval(idx)), &registerElement);
 
     pParentElement->appendChild(registerElement);
 }
@@ -213,6 +246,17 @@ void ProjectFileExporter::addTextNode(QString tagName, QString tagValue, QDomEle
     pParentElement->appendChild(tag);
 }
 
+void ProjectFileExporter::addAddressNode(QString tagName, ModbusAddress address, QDomElement * pParentElement)
+{
+    QDomElement tag = _domDocument.createElement(tagName);
+    tag.setAttribute(ProjectFileDefinitions::cObjectTypeAttribute, QString("%1").arg(static_cast<int>(address.objectType())));
+
+    QDomText valueNode = _domDocument.createTextNode(QString("%1").arg(address.address(ModbusAddress::Offset::WITHOUT_OFFSET)));
+    tag.appendChild(valueNode);
+
+    pParentElement->appendChild(tag);
+}
+
 void ProjectFileExporter::addCDataNode(QString tagName, QString tagValue, QDomElement * pParentElement)
 {
     QDomElement tag = _domDocument.createElement(tagName);
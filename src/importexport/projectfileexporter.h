@@ -26,6 +26,7 @@ private:
     void createModbusTag(QDomElement * pParentElement);
 
     void createConnectionTags(QDomElement * pParentElement);
+    void createReadCapabilityTag(QDomElement * pParentElement, quint8 connectionId);
     void createLogTag(QDomElement * pParentElement);
 
     void createScopeTag(QDomElement * pParentElement);
@@ -36,6 +37,7 @@ private:
     QString convertBoolToText(bool bValue);
     void addTextNode(QString tagName, QString tagValue, QDomElement * pParentElement);
     void addCDataNode(QString tagName, QString tagValue, QDomElement * pParentElement);
+    void addAddressNode(QString tagName, ModbusAddress address, QDomElement * pParentElement);
 
     GuiModel * _pGuiModel;
     SettingsModel * _pSettingsModel;
@@ -213,9 +213,22 @@ void ProjectFileHandler::updateProjectSetting(ProjectFileData::ProjectSettings *
                 _pSettingsModel->setConsecutiveMax(connectionId, pProjectSettings->general.connectionSettings[idx].consecutiveMax);
             }
 
+            if (pProjectSettings->general.connectionSettings[idx].bMaxGap)
+            {
+                _pSettingsModel->setMaxGap(connectionId, pProjectSettings->general.connectionSettings[idx].maxGap);
+            }
+
+            if (pProjectSettings->general.connectionSettings[idx].bPipelineDepth)
+            {
+                _pSettingsModel->setPipelineDepth(connectionId, pProjectSettings->general.connectionSettings[idx].pipelineDepth);
+            }
+
             _pSettingsModel->setInt32LittleEndian(connectionId, pProjectSettings->general.connectionSettings[idx].bInt32LittleEndian);
 
             _pSettingsModel->setPersistentConnection(connectionId, pProjectSettings->general.connectionSettings[idx].bPersistentConnection);
+
+            /* After device settings, changing the device clears the read capability */
+            _pSettingsModel->setReadCapability(connectionId, pProjectSettings->general.connectionSettings[idx].readCapability);
         }
     }
 
@@ -226,6 +239,18 @@ void ProjectFileHandler::updateProjectSetting(ProjectFileData::ProjectSettings *
 
     _pSettingsModel->setAbsoluteTimes(pProjectSettings->general.logSettings.bAbsoluteTimes);
 
+    _pSettingsModel->setIndependentPolling(pProjectSettings->general.logSettings.bIndependentPolling);
+
+    if (pProjectSettings->general.logSettings.bPlotRetention)
+    {
+        _pSettingsModel->setPlotRetention(pProjectSettings->general.logSettings.plotRetention);
+    }
+
+    if (pProjectSettings->general.logSettings.bMaxFrameRate)
+    {
+        _pSettingsModel->setMaxFrameRate(pProjectSettings->general.logSettings.maxFrameRate);
+    }
+
     _pSettingsModel->setWriteDuringLog(pProjectSettings->general.logSettings.bLogToFile);
     if (pProjectSettings->general.logSettings.bLogToFileFile)
     {
@@ -272,6 +297,7 @@ void ProjectFileHandler::updateProjectSetting(ProjectFileData::ProjectSettings *
         rowData.setColor(pSettingData->color);
         rowData.setValueAxis(pSettingData->valueAxis == 1 ? GraphData::VALUE_AXIS_SECONDARY : GraphData::VALUE_AXIS_PRIMARY);
         rowData.setExpression(pSettingData->expression);
+        rowData.setPollInterval(pSettingData->pollInterval);
 
         _pGraphDataModel->add(rowData);
     }
@@ -1,6 +1,7 @@
 
 #include <QFileInfo>
 #include <QDir>
+#include <limits>
 #include "projectfileparser.h"
 #include "projectfiledefinitions.h"
 
@@ -273,6 +274,26 @@ GeneralError ProjectFileParser::parseConnectionTag(const QDomElement &element, C
                 break;
             }
         }
+        else if (child.tagName() == ProjectFileDefinitions::cMaxGapTag)
+        {
+            pConnectionSettings->bMaxGap = true;
+            pConnectionSettings->maxGap = static_cast<quint8>(child.text().toUInt(&bRet));
+            if (!bRet)
+            {
+                parseErr.reportError(QString("Maximum register gap ( %1 ) is not a valid number").arg(child.text()));
+                break;
+            }
+        }
+        else if (child.tagName() == ProjectFileDefinitions::cPipelineDepthTag)
+        {
+            pConnectionSettings->bPipelineDepth = true;
+            pConnectionSettings->pipelineDepth = static_cast<quint8>(child.text().toUInt(&bRet));
+            if (!bRet)
+            {
+                parseErr.reportError(QString("Pipeline depth ( %1 ) is not a valid number").arg(child.text()));
+                break;
+            }
+        }
         else if (child.tagName() == ProjectFileDefinitions::cInt32LittleEndianTag)
         {
             if (!child.text().toLower().compare(ProjectFileDefinitions::cTrueValue))
@@ -295,6 +316,60 @@ GeneralError ProjectFileParser::parseConnectionTag(const QDomElement &element, C
                 pConnectionSettings->bPersistentConnection = false;
             }
         }
+        else if (child.tagName() == ProjectFileDefinitions::cReadCapabilityTag)
+        {
+            parseErr = parseReadCapabilityTag(child, pConnectionSettings);
+            if (!parseErr.result())
+            {
+                break;
+            }
+        }
+        else
+        {
+            // unknown tag: ignore
+        }
+        child = child.nextSiblingElement();
+    }
+
+    return parseErr;
+}
+
+GeneralError ProjectFileParser::parseReadCapabilityTag(const QDomElement &element, ConnectionSettings * pConnectionSettings)
+{
+    GeneralError parseErr;
+    QDomElement child = element.firstChildElement();
+    while (!child.isNull())
+    {
+        bool bRet;
+        if (child.tagName() == ProjectFileDefinitions::cMaxReadSizeTag)
+        {
+            const quint32 maxReadSize = child.text().toUInt(&bRet);
+            if (!bRet || (maxReadSize > std::numeric_limits<quint16>::max()))
+            {
+                parseErr.reportError(QString("Maximum read size ( %1 ) is not a valid number").arg(child.text()));
+                break;
+            }
+
+            pConnectionSettings->readCapability.limitBlockSize(static_cast<quint16>(maxReadSize));
+        }
+        else if (child.tagName() == ProjectFileDefinitions::cReadBoundaryTag)
+        {
+            const quint32 objectType = child.attribute(ProjectFileDefinitions::cObjectTypeAttribute).toUInt(&bRet);
+            if (!bRet || (objectType >= static_cast<quint32>(ModbusAddress::ObjectType::UNKNOWN)))
+            {
+                parseErr.reportError(QString("Object type ( %1 ) is not valid").arg(child.attribute(ProjectFileDefinitions::cObjectTypeAttribute)));
+                break;
+            }
+
+            const quint32 address = child.text().toUInt(&bRet);
+            if (!bRet || (address > std::numeric_limits<quint16>::max()))
+            {
+                parseErr.reportError(QString("Address ( %1 ) is not a valid number").arg(child.text()));
+                break;
+            }
+
+            pConnectionSettings->readCapability.addBoundary(ModbusAddress(address, static_cast<ModbusAddress::ObjectType>(objectType)));
+        }
         else
         {
             // unknown tag: ignore
@@ -333,6 +408,39 @@ GeneralError ProjectFileParser::parseLogTag(const QDomElement &element, LogSetti
                 pLogSettings->bAbsoluteTimes = false;
             }
         }
+        else if (child.tagName() == ProjectFileDefinitions::cIndependentPollingTag)
+        {
+            if (!child.text().toLower().compare(ProjectFileDefinitions::cTrueValue))
+            {
+                pLogSettings->bIndependentPolling = true;
+            }
+            else
+            {
+                pLogSettings->bIndependentPolling = false;
+            }
+        }
+        else if (child.tagName() == ProjectFileDefinitions::cPlotRetentionTag)
+        {
+            bool bRet;
+            pLogSettings->bPlotRetention = true;
+            pLogSettings->plotRetention = child.text().toUInt(&bRet);
+            if (!bRet)
+            {
+                parseErr.reportError(QString("Plot retention ( %1 ) is not a valid number").arg(child.text()));
+                break;
+            }
+        }
+        else if (child.tagName() == ProjectFileDefinitions::cMaxFrameRateTag)
+        {
+            bool bRet;
+            pLogSettings->bMaxFrameRate = true;
+            pLogSettings->maxFrameRate = child.text().toUInt(&bRet);
+            if (!bRet)
+            {
+                parseErr.reportError(QString("Maximum frame rate ( %1 ) is not a valid number").arg(child.text()));
+                break;
+            }
+        }
         else if (child.tagName() == ProjectFileDefinitions::cLogToFileTag)
         {
             parseErr = parseLogToFile(child, pLogSettings);
@@ -497,6 +605,15 @@ GeneralError ProjectFileParser::parseRegisterTag(const QDomElement &element, Reg
                 pRegisterSettings->valueAxis = axis;
             }
         }
+        else if (child.tagName() == ProjectFileDefinitions::cPollIntervalTag)
+        {
+            pRegisterSettings->pollInterval = child.text().toUInt(&bRet);
+            if (!bRet)
+            {
+                parseErr.reportError(QString("Poll interval ( %1 ) is not a valid number").arg(child.text()));
+                break;
+            }
+        }
         else if (child.tagName() == ProjectFileDefinitions::cConnectionIdTag)
         {
             const qint32 newConnectionId = child.text().toInt(&bRet);
@@ -22,6 +22,7 @@ MainApp::MainApp(QStringList cmdArguments, QObject *parent) : QObject(parent)
     _pGraphDataModel = new GraphDataModel();
     _pNoteModel = new NoteModel();
     _pDiagnosticModel = new DiagnosticModel();
+    _pDiagnosticModel->setSpillEnabled(true);
     _pDataParserModel = new DataParserModel();
 
     ScopeLogging::Logger().initLogging(_pDiagnosticModel);
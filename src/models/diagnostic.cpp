@@ -15,6 +15,18 @@ Diagnostic::Diagnostic(QString category, LogSeverity severity, qint32 timeOffset
     _message = message;
 }
 
+/*!
+ * \brief Creates log of diagnostic event, the message is formatted on request
+ * \param event Diagnostic event
+ */
+Diagnostic::Diagnostic(const DiagnosticEvent &event)
+{
+    _category = DiagnosticEvent::category();
+    _severity = eventSeverity(event.type());
+    _timeOffset = event.timeOffset();
+    _event = event;
+}
+
 QString Diagnostic::category() const
 {
     return _category;
@@ -49,7 +61,14 @@ void Diagnostic::setSeverity(const LogSeverity &severity)
  */
 QString Diagnostic::message() const
 {
-    return _message;
+    if (_event.type() != DiagnosticEvent::TYPE_NONE)
+    {
+        return _event.message();
+    }
+    else
+    {
+        return _message;
+    }
 }
 
 /*!
@@ -59,6 +78,7 @@ QString Diagnostic::message() const
 void Diagnostic::setMessage(const QString &message)
 {
     _message = message;
+    _event = DiagnosticEvent();
 }
 
 /*!
@@ -105,6 +125,32 @@ QString Diagnostic::severityString() const
     }
 }
 
+/*!
+ * \brief Diagnostic::eventSeverity
+ * \param type Type of diagnostic event
+ * \return Severity of event type
+ */
+Diagnostic::LogSeverity Diagnostic::eventSeverity(DiagnosticEvent::Type type)
+{
+    switch (type)
+    {
+        case DiagnosticEvent::TYPE_CONNECTION_DISABLED:
+        case DiagnosticEvent::TYPE_READ_EXCEPTION:
+            return LOG_WARNING;
+
+        case DiagnosticEvent::TYPE_READ_CAPABILITY:
+            return LOG_INFO;
+
+        case DiagnosticEvent::TYPE_READ_LIST:
+        case DiagnosticEvent::TYPE_READ_PARTIAL:
+        case DiagnosticEvent::TYPE_READ_SUCCESS:
+        case DiagnosticEvent::TYPE_READ_RESULTS:
+        case DiagnosticEvent::TYPE_NONE:
+        default:
+            return LOG_DEBUG;
+    }
+}
+
 /*!
  * \brief Diagnostic::toString
  * \return Printable summary of log
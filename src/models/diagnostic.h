@@ -4,6 +4,8 @@
 #include <QString>
 #include <QDebug>
 
+#include "diagnosticevent.h"
+
 class Diagnostic
 {
 
@@ -17,6 +19,7 @@ public:
     } LogSeverity;
 
     explicit Diagnostic(QString category, LogSeverity severity, qint32 timeOffset, QString message);
+    explicit Diagnostic(const DiagnosticEvent &event);
 
     QString category() const;
     void setCategory(const QString &category);
@@ -35,12 +38,17 @@ public:
     QString toString() const;
     QString toExportString() const;
 
+    static LogSeverity eventSeverity(DiagnosticEvent::Type type);
+
 private:
 
     QString _category;
     LogSeverity _severity;
     qint32 _timeOffset;
     QString _message;
+
+    /* Message of event is only formatted when requested */
+    DiagnosticEvent _event;
 };
 
 QDebug operator<<(QDebug debug, const Diagnostic &log);
@@ -0,0 +1,118 @@
+#include "diagnosticevent.h"
+
+DiagnosticEvent::DiagnosticEvent() :
+    DiagnosticEvent(TYPE_NONE, 0)
+{
+
+}
+
+/*!
+ * \brief Creates new diagnostic event
+ * \param type          Type of event
+ * \param connectionId  Connection of event
+ * \param address       Start address of read
+ * \param count         Number of registers
+ * \param code          Exception code, number of invalid results or number of unreadable registers, depends on type
+ */
+DiagnosticEvent::DiagnosticEvent(Type type, quint8 connectionId, ModbusAddress address, quint16 count, quint16 code) :
+    _timeOffset(0),
+    _address(static_cast<quint16>(address.address(ModbusAddress::Offset::WITHOUT_OFFSET))),
+    _count(count),
+    _code(code),
+    _type(static_cast<quint8>(type)),
+    _objectType(static_cast<quint8>(address.objectType())),
+    _connectionId(connectionId)
+{
+
+}
+
+DiagnosticEvent::Type DiagnosticEvent::type() const
+{
+    return static_cast<Type>(_type);
+}
+
+quint8 DiagnosticEvent::connectionId() const
+{
+    return _connectionId;
+}
+
+ModbusAddress DiagnosticEvent::address() const
+{
+    return ModbusAddress(_address, static_cast<ModbusAddress::ObjectType>(_objectType));
+}
+
+quint16 DiagnosticEvent::count() const
+{
+    return _count;
+}
+
+quint16 DiagnosticEvent::code() const
+{
+    return _code;
+}
+
+qint32 DiagnosticEvent::timeOffset() const
+{
+    return _timeOffset;
+}
+
+void DiagnosticEvent::setTimeOffset(qint32 timeOffset)
+{
+    _timeOffset = timeOffset;
+}
+
+/*!
+ * \brief Format message of event
+ * \return Message, same format as the messages of the connection
+ */
+QString DiagnosticEvent::message() const
+{
+    QString msg;
+
+    switch (type())
+    {
+        case TYPE_CONNECTION_DISABLED:
+            msg = QStringLiteral("Read failed because connection is disabled");
+            break;
+
+        case TYPE_READ_LIST:
+            msg = QString("Register list read: %1 registers, first (%2)").arg(count()).arg(address().toString());
+            break;
+
+        case TYPE_READ_PARTIAL:
+            msg = QString("Partial list read: Start address (%1) and count (%2)").arg(address().toString()).arg(count());
+            break;
+
+        case TYPE_READ_SUCCESS:
+            msg = QString("Read success: Start address (%1) and count (%2)").arg(address().toString()).arg(count());
+            break;
+
+        case TYPE_READ_EXCEPTION:
+            msg = QString("Modbus Exception: %1 at start address (%2)").arg(code()).arg(address().toString());
+            break;
+
+        case TYPE_READ_RESULTS:
+            msg = QString("Result map: %1 registers, %2 invalid").arg(count()).arg(code());
+            break;
+
+        case TYPE_READ_CAPABILITY:
+            msg = QString("Read capability learned: maximum read size (%1), %2 unreadable registers")
+                      .arg(count() == 0 ? QStringLiteral("unlimited") : QString::number(count()))
+                      .arg(code());
+            break;
+
+        case TYPE_NONE:
+        default:
+            break;
+    }
+
+    return QString("[Conn %1] %2").arg(connectionId() + 1).arg(msg);
+}
+
+/*!
+ * \brief Logging category of events
+ */
+QString DiagnosticEvent::category()
+{
+    return QStringLiteral("scope.comm.connection");
+}
@@ -0,0 +1,56 @@
+#ifndef DIAGNOSTICEVENT_H
+#define DIAGNOSTICEVENT_H
+
+#include <QString>
+#include "modbusaddress.h"
+
+/*!
+ * Fixed size record of a communication diagnostic
+ * Events are recorded without any formatting, so they are cheap enough to record on every poll.
+ * The message is only formatted when the diagnostic is displayed or exported.
+ */
+class DiagnosticEvent
+{
+
+public:
+
+    typedef enum
+    {
+        TYPE_NONE = 0,
+        TYPE_CONNECTION_DISABLED,
+        TYPE_READ_LIST,
+        TYPE_READ_PARTIAL,
+        TYPE_READ_SUCCESS,
+        TYPE_READ_EXCEPTION,
+        TYPE_READ_RESULTS,
+        TYPE_READ_CAPABILITY,
+    } Type;
+
+    DiagnosticEvent();
+    explicit DiagnosticEvent(Type type, quint8 connectionId, ModbusAddress address = ModbusAddress(), quint16 count = 0, quint16 code = 0);
+
+    Type type() const;
+    quint8 connectionId() const;
+    ModbusAddress address() const;
+    quint16 count() const;
+    quint16 code() const;
+
+    qint32 timeOffset() const;
+    void setTimeOffset(qint32 timeOffset);
+
+    QString message() const;
+
+    static QString category();
+
+private:
+
+    qint32 _timeOffset;
+    quint16 _address; /* Without offset */
+    quint16 _count;
+    quint16 _code; /* Exception code, number of invalid results or number of unreadable registers */
+    quint8 _type;
+    quint8 _objectType;
+    quint8 _connectionId;
+};
+
+#endif // DIAGNOSTICEVENT_H
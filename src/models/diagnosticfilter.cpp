@@ -9,7 +9,8 @@ DiagnosticFilter::DiagnosticFilter(QObject* parent) : QSortFilterProxyModel(pare
 bool DiagnosticFilter::filterAcceptsRow(int source_row, const QModelIndex &source_parent) const
 {
     Q_UNUSED(source_parent);
-    Diagnostic::LogSeverity severity = reinterpret_cast<DiagnosticModel *>(sourceModel())->dataSeverity(static_cast<quint32>(source_row));
+    /* Severity is stored per row, no need to look at the log text */
+    Diagnostic::LogSeverity severity = static_cast<DiagnosticModel *>(sourceModel())->dataSeverity(static_cast<quint32>(source_row));
 
     if (_filterBitmask & (1 << severity))
     {
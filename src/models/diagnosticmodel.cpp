@@ -1,3 +1,6 @@
+#include <QStringDecoder>
+#include <QTemporaryFile>
+
 #include "diagnosticmodel.h"
 #include "QModelIndex"
 #include "QAbstractItemModel"
@@ -6,9 +9,36 @@
  * \brief Constructor for DiagnosticModel
  * \param parent    parent object
  */
-DiagnosticModel::DiagnosticModel(QObject *parent) : QAbstractListModel(parent)
+DiagnosticModel::DiagnosticModel(QObject *parent) :
+    DiagnosticModel(cDefaultCapacity, parent)
+{
+
+}
+
+/*!
+ * \brief Constructor for DiagnosticModel
+ * \param capacity  Maximum number of logs in model
+ * \param parent    parent object
+ */
+DiagnosticModel::DiagnosticModel(qint32 capacity, QObject *parent) :
+    QAbstractListModel(parent),
+    _capacity(qMax(capacity, 1)),
+    _first(0),
+    _count(0),
+    _bSpill(false),
+    _pSpillFile(nullptr),
+    _spilledCount(0)
 {
     _minSeverityLevel = Diagnostic::LOG_INFO;
+
+    _flushTimer.setSingleShot(true);
+    _flushTimer.setInterval(cFlushInterval);
+    connect(&_flushTimer, &QTimer::timeout, this, &DiagnosticModel::flush);
+}
+
+DiagnosticModel::~DiagnosticModel()
+{
+    delete _pSpillFile;
 }
 
 /*!
@@ -39,7 +69,7 @@ QVariant DiagnosticModel::data(const QModelIndex &index, int role) const
 {
     if (index.isValid() && (role == Qt::DisplayRole))
     {
-        return _logList[index.row()].toString();
+        return log(static_cast<quint32>(index.row())).toString();
     }
 
     return QVariant();
@@ -54,7 +84,7 @@ Diagnostic::LogSeverity DiagnosticModel::dataSeverity(quint32 index) const
 {
     if (index < static_cast<quint32>(size()))
     {
-        return _logList[index].severity();
+        return log(index).severity();
     }
 
     return static_cast<Diagnostic::LogSeverity>(-1);
@@ -99,29 +129,52 @@ Qt::ItemFlags DiagnosticModel::flags(const QModelIndex & index) const
  */
 qint32 DiagnosticModel::size() const
 {
-    return _logList.size();
+    return _count;
 }
 
 /*!
- * \brief Clear the model data
+ * \brief Return maximum number of rows in model
+ */
+qint32 DiagnosticModel::capacity() const
+{
+    return _capacity;
+}
+
+/*!
+ * \brief Clear the model data, including logs that aren't inserted yet and spilled logs
  */
 void DiagnosticModel::clear()
 {
-    beginRemoveRows(QModelIndex(), 0, size() - 1);
+    _pendingList.clear();
+    _flushTimer.stop();
 
-    _logList.clear();
+    if (size() > 0)
+    {
+        beginRemoveRows(QModelIndex(), 0, size() - 1);
 
-    endRemoveRows();
+        _logRing.clear();
+        _first = 0;
+        _count = 0;
+
+        endRemoveRows();
+    }
+
+    if (_pSpillFile != nullptr)
+    {
+        _pSpillFile->resize(0);
+        _pSpillFile->seek(0);
+    }
+    _spilledCount = 0;
 }
 
 QString DiagnosticModel::toString(quint32 idx) const
 {
-    return _logList[idx].toString();
+    return log(idx).toString();
 }
 
 QString DiagnosticModel::toExportString(quint32 idx) const
 {
-    return _logList[idx].toExportString();
+    return log(idx).toExportString();
 }
 
 void DiagnosticModel::setMinimumSeverityLevel(Diagnostic::LogSeverity minSeverity)
@@ -131,24 +184,209 @@ void DiagnosticModel::setMinimumSeverityLevel(Diagnostic::LogSeverity minSeverit
 
 /*!
  * \brief Add item to model
+ * The item is inserted with the next batch (see flush())
  * \param log
  */
 void DiagnosticModel::addLog(QString category, Diagnostic::LogSeverity severity, qint32 timeOffset, QString message)
 {
     if (severity <= _minSeverityLevel)
     {
-        /* Call function to prepare view */
-        beginInsertRows(QModelIndex(), size(), size());
+        addPending(Diagnostic(internCategory(category), severity, timeOffset, message));
+    }
+}
+
+/*!
+ * \brief Add batch of diagnostic events to model
+ * The messages of the events are only formatted when they are requested.
+ * \param eventList   Events, oldest first
+ */
+void DiagnosticModel::addEvents(const QList<DiagnosticEvent> &eventList)
+{
+    for (const DiagnosticEvent &event : eventList)
+    {
+        if (Diagnostic::eventSeverity(event.type()) <= _minSeverityLevel)
+        {
+            Diagnostic log(event);
+            log.setCategory(internCategory(log.category()));
+
+            addPending(log);
+        }
+    }
+}
+
+/*!
+ * \brief Write logs that were removed from the model to a temporary file
+ * \param bSpill  Enable spilling, disabling it discards the spilled logs
+ */
+void DiagnosticModel::setSpillEnabled(bool bSpill)
+{
+    _bSpill = bSpill;
+
+    if (!_bSpill)
+    {
+        delete _pSpillFile;
+        _pSpillFile = nullptr;
+        _spilledCount = 0;
+    }
+}
+
+/*!
+ * \brief Return number of logs that were removed from the model and spilled to disk
+ */
+qint64 DiagnosticModel::spilledCount() const
+{
+    return _spilledCount;
+}
+
+/*!
+ * \brief Write spilled logs to stream, in export format
+ * \param stream   Stream to write to
+ */
+void DiagnosticModel::exportSpilled(QTextStream &stream)
+{
+    if (
+        (_pSpillFile == nullptr)
+        || (_spilledCount == 0)
+    )
+    {
+        return;
+    }
+
+    _pSpillFile->flush();
+    _pSpillFile->seek(0);
+
+    /* Decoder keeps state, so a character split over two blocks is decoded correctly */
+    QStringDecoder decoder(QStringDecoder::Utf8);
+    while (!_pSpillFile->atEnd())
+    {
+        stream << QString(decoder.decode(_pSpillFile->read(cSpillReadSize)));
+    }
 
-        Diagnostic log(category, severity, timeOffset, message);
+    /* Continue spilling at end */
+    _pSpillFile->seek(_pSpillFile->size());
+}
 
-        _logList.append(log);
+/*!
+ * \brief Insert all added logs in the model as a single batch
+ * When the capacity is reached, the oldest logs are removed first.
+ */
+void DiagnosticModel::flush()
+{
+    _flushTimer.stop();
 
-        /* Call functions to trigger view update */
-        endInsertRows();
+    if (_pendingList.isEmpty())
+    {
+        return;
+    }
 
-        QModelIndex nIndex = index(size() - 1, 0);
+    /* More logs than fit in the model, oldest pending logs are only spilled */
+    const qint32 skipCount = qMax(static_cast<qint32>(_pendingList.size()) - _capacity, 0);
+    for (qint32 idx = 0; idx < skipCount; idx++)
+    {
+        spill(_pendingList[idx]);
+    }
 
-        emit dataChanged(nIndex, nIndex);
+    const qint32 insertCount = static_cast<qint32>(_pendingList.size()) - skipCount;
+
+    const qint32 overflow = size() + insertCount - _capacity;
+    if (overflow > 0)
+    {
+        removeOldest(overflow);
     }
+
+    beginInsertRows(QModelIndex(), size(), size() + insertCount - 1);
+
+    for (qint32 idx = skipCount; idx < _pendingList.size(); idx++)
+    {
+        if (_logRing.size() < _capacity)
+        {
+            _logRing.append(_pendingList[idx]);
+        }
+        else
+        {
+            _logRing[(_first + _count) % _capacity] = _pendingList[idx];
+        }
+        _count++;
+    }
+
+    endInsertRows();
+
+    _pendingList.clear();
+
+    emit dataChanged(index(size() - insertCount, 0), index(size() - 1, 0));
+}
+
+void DiagnosticModel::addPending(const Diagnostic &log)
+{
+    _pendingList.append(log);
+
+    if (!_flushTimer.isActive())
+    {
+        _flushTimer.start();
+    }
+}
+
+/*!
+ * \brief Get shared copy of category string
+ * There are only a few categories, so each log doesn't need its own copy of the string.
+ */
+QString DiagnosticModel::internCategory(const QString &category)
+{
+    const qsizetype categoryIdx = _categoryList.indexOf(category);
+    if (categoryIdx >= 0)
+    {
+        return _categoryList[categoryIdx];
+    }
+    else
+    {
+        _categoryList.append(category);
+        return category;
+    }
+}
+
+const Diagnostic& DiagnosticModel::log(quint32 idx) const
+{
+    return _logRing[(_first + static_cast<qint32>(idx)) % _capacity];
+}
+
+/*!
+ * \brief Remove oldest logs from model, they are spilled when enabled
+ */
+void DiagnosticModel::removeOldest(qint32 count)
+{
+    beginRemoveRows(QModelIndex(), 0, count - 1);
+
+    for (qint32 idx = 0; idx < count; idx++)
+    {
+        spill(log(static_cast<quint32>(idx)));
+    }
+
+    _first = (_first + count) % _capacity;
+    _count -= count;
+
+    endRemoveRows();
+}
+
+void DiagnosticModel::spill(const Diagnostic &log)
+{
+    if (!_bSpill)
+    {
+        return;
+    }
+
+    if (_pSpillFile == nullptr)
+    {
+        _pSpillFile = new QTemporaryFile();
+        if (!_pSpillFile->open())
+        {
+            delete _pSpillFile;
+            _pSpillFile = nullptr;
+            _bSpill = false;
+            return;
+        }
+    }
+
+    _pSpillFile->write(log.toExportString().toUtf8());
+    _pSpillFile->write("\n");
+    _spilledCount++;
 }
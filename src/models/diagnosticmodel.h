@@ -2,15 +2,30 @@
 #define DIAGNOSTICLOGMODEL_H
 
 #include <QObject>
+#include <QTimer>
+#include <QTextStream>
 #include "QAbstractListModel"
 #include "diagnostic.h"
 
+/* Forward declaration */
+class QTemporaryFile;
 
+/*!
+ * Model of the diagnostic logs
+ * Logs are kept in a ring of limited capacity, the oldest logs are removed when it is full.
+ * When spilling is enabled, removed logs are written to a temporary file so the complete
+ * history can still be exported.
+ *
+ * Added logs are collected and inserted in the model as a single batch on a timer, so a
+ * view isn't updated for every log.
+ */
 class DiagnosticModel : public QAbstractListModel
 {
     Q_OBJECT
 public:
     explicit DiagnosticModel(QObject *parent = nullptr);
+    explicit DiagnosticModel(qint32 capacity, QObject *parent = nullptr);
+    ~DiagnosticModel();
 
     int rowCount(const QModelIndex &parent = QModelIndex()) const ;
     int columnCount(const QModelIndex & parent = QModelIndex()) const;
@@ -22,6 +37,7 @@ public:
     Qt::ItemFlags flags(const QModelIndex & index) const;
 
     qint32 size() const;
+    qint32 capacity() const;
 
     void clear();
 
@@ -30,11 +46,45 @@ public:
 
     void setMinimumSeverityLevel(Diagnostic::LogSeverity maxSeverity);
     void addLog(QString category, Diagnostic::LogSeverity severity, qint32 timeOffset, QString message);
+    void addEvents(const QList<DiagnosticEvent> &eventList);
+
+    void setSpillEnabled(bool bSpill);
+    qint64 spilledCount() const;
+    void exportSpilled(QTextStream &stream);
+
+    static const qint32 cDefaultCapacity = 100000;
+
+public slots:
+    void flush();
 
 private:
+    void addPending(const Diagnostic &log);
+    QString internCategory(const QString &category);
+    const Diagnostic& log(quint32 idx) const;
+    void removeOldest(qint32 count);
+    void spill(const Diagnostic &log);
 
     Diagnostic::LogSeverity _minSeverityLevel;
-    QList<Diagnostic> _logList;
+
+    /* Ring of logs, row 0 is at _first */
+    const qint32 _capacity;
+    QList<Diagnostic> _logRing;
+    qint32 _first;
+    qint32 _count;
+
+    /* Logs that aren't inserted in the model yet */
+    QList<Diagnostic> _pendingList;
+    QTimer _flushTimer;
+
+    /* Every log refers to the same string of its category */
+    QStringList _categoryList;
+
+    bool _bSpill;
+    QTemporaryFile* _pSpillFile;
+    qint64 _spilledCount;
+
+    static const qint32 cFlushInterval = 100; /* ms */
+    static const qint64 cSpillReadSize = 64 * 1024;
 };
 
 #endif // DIAGNOSTICLOGMODEL_H
@@ -10,13 +10,12 @@ GraphData::GraphData()
     _color = "-1"; // Invalid color
     _bActive = true;
     _expression = QStringLiteral("0");
-
-    _pDataMap = QSharedPointer<QCPGraphDataContainer>(new QCPGraphDataContainer);
+    _pollInterval = 0;
 }
 
 GraphData::~GraphData()
 {
-    _pDataMap.clear();
+
 }
 
 GraphData::valueAxis_t GraphData::valueAxis() const
@@ -85,7 +84,12 @@ void GraphData::setExpression(QString expression)
     _expression = expression;
 }
 
-QSharedPointer<QCPGraphDataContainer> GraphData::dataMap()
+quint32 GraphData::pollInterval() const
+{
+    return _pollInterval;
+}
+
+void GraphData::setPollInterval(quint32 pollInterval)
 {
-    return _pDataMap;
+    _pollInterval = pollInterval;
 }
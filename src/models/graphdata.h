@@ -3,7 +3,7 @@
 
 #include <QtGlobal>
 #include <QColor>
-#include "qcustomplot.h"
+#include <QString>
 
 class GraphData
 {
@@ -37,7 +37,8 @@ public:
     QString expression() const;
     void setExpression(QString expression);
 
-    QSharedPointer<QCPGraphDataContainer> dataMap();
+    quint32 pollInterval() const;
+    void setPollInterval(quint32 pollInterval);
 
 private:
 
@@ -49,7 +50,8 @@ private:
     bool _bActive;
     QString _expression;
 
-    QSharedPointer<QCPGraphDataContainer> _pDataMap;
+    /* Poll interval in ms, 0 is poll time of settings */
+    quint32 _pollInterval;
 
 };
 
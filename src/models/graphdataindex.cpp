@@ -0,0 +1,266 @@
+
+#include <QtNumeric>
+#include <cmath>
+
+#include "graphdataindex.h"
+
+GraphDataIndex::GraphDataIndex() :
+    _bValid(false),
+    _lastPresentIdx(-1)
+{
+
+}
+
+/*!
+ * Force rebuild of index before next query
+ * Required when existing samples are modified in place, appended samples are detected automatically.
+ */
+void GraphDataIndex::invalidate()
+{
+    _bValid = false;
+}
+
+/*!
+ * Remove oldest samples from index (retention)
+ * \param count     Number of samples removed from the front of the samples
+ */
+void GraphDataIndex::removeFront(qint64 count)
+{
+    const qint64 knownCount = _pyramid.endIndex() - _pyramid.firstIndex();
+
+    if (count > knownCount)
+    {
+        /* Also removes samples that weren't indexed yet */
+        _bValid = false;
+    }
+    else
+    {
+        _pyramid.removeFront(count);
+    }
+}
+
+/*!
+ * Get min/max envelope of range of samples
+ * \param samples       Samples of graph
+ * \param begin         Index of first sample of range
+ * \param end           Index after last sample of range
+ * \param maxBuckets    Number of envelope buckets (e.g. pixels), each bucket results in at most two samples
+ * \param indexes       Receives indexes of samples of envelope, in increasing order
+ */
+void GraphDataIndex::envelope(const Samples &samples, qint64 begin, qint64 end, qint64 maxBuckets, QVector<qint64> &indexes)
+{
+    sync(samples);
+
+    const qint64 offset = _pyramid.firstIndex();
+
+    indexes.clear();
+    _pyramid.envelope(offset + begin, offset + end, _pyramid.levelFor(end - begin, maxBuckets), indexes);
+
+    for (qint64 &idx : indexes)
+    {
+        idx -= offset;
+    }
+}
+
+/*!
+ * Calculate statistics of range of samples in O(log n)
+ * \param samples   Samples of graph
+ * \param begin     Index of first sample of range
+ * \param end       Index after last sample of range
+ * \return Statistics of range, integral uses trapezoids between the samples
+ */
+GraphDataIndex::Statistics GraphDataIndex::statistics(const Samples &samples, qint64 begin, qint64 end)
+{
+    Statistics stats = {0, 0, 0, 0, 0, 0, 0};
+
+    if (end - begin <= 0)
+    {
+        return stats;
+    }
+
+    sync(samples);
+
+    const qint64 offset = _pyramid.firstIndex();
+
+    EnvelopePyramid::Summary summary;
+    QVector<qint64> rawIndexes;
+    _pyramid.summary(offset + begin, offset + end, summary, rawIndexes);
+
+    for (const qint64 idx : qAsConst(rawIndexes))
+    {
+        if (
+            isValid(samples, idx - offset)
+            && !isAbsent(samples, idx - offset)
+        )
+        {
+            EnvelopePyramid::addSample(summary, idx, samples.pValues[idx - offset], segmentArea(samples, idx - offset));
+        }
+    }
+
+    /* Area of a sample is the segment towards the next sample, last segment is outside of range */
+    qint64 lastIdx = end - 1;
+    while (
+        (lastIdx > begin)
+        && isAbsent(samples, lastIdx)
+    )
+    {
+        lastIdx--;
+    }
+
+    return summaryStatistics(summary, segmentArea(samples, lastIdx));
+}
+
+/*!
+ * Convert summary of range of samples to statistics
+ * \param summary     Summary of samples, area of each sample is the segment towards the next sample
+ * \param lastArea    Area of last sample in range, this segment is outside of range
+ * \return Statistics of range
+ */
+GraphDataIndex::Statistics GraphDataIndex::summaryStatistics(const EnvelopePyramid::Summary &summary, double lastArea)
+{
+    Statistics stats = {0, 0, 0, 0, 0, 0, 0};
+
+    if (summary.count <= 0)
+    {
+        return stats;
+    }
+
+    const double count = static_cast<double>(summary.count);
+
+    stats.count = summary.count;
+    stats.minimum = summary.min;
+    stats.maximum = summary.max;
+    stats.average = summary.mean;
+    stats.standardDeviation = std::sqrt(summary.m2 / count);
+    stats.rms = std::sqrt((summary.m2 + summary.mean * summary.mean * count) / count);
+    stats.integral = (summary.area - lastArea) / 1000;
+
+    return stats;
+}
+
+/*!
+ * Check whether sample has a valid value
+ * Invalid samples aren't part of the statistics and show as a gap in the envelope.
+ */
+bool GraphDataIndex::isValid(const Samples &samples, qint64 idx)
+{
+    if (samples.pValidity == nullptr)
+    {
+        return true;
+    }
+
+    const qint64 bitPos = samples.validityOffset + idx;
+
+    return (samples.pValidity[bitPos / 64] >> (bitPos % 64)) & 1u;
+}
+
+/*!
+ * Check whether graph has no sample at index (NaN value)
+ * Absent samples aren't part of the statistics or the envelope, a line continues over them.
+ */
+bool GraphDataIndex::isAbsent(const Samples &samples, qint64 idx)
+{
+    return qIsNaN(samples.pValues[idx]);
+}
+
+/*!
+ * Add samples that were appended since the last query to the index
+ * Sample idx of the samples is index (firstIndex() + idx) of the pyramid.
+ */
+void GraphDataIndex::sync(const Samples &samples)
+{
+    qint64 knownCount = _pyramid.endIndex() - _pyramid.firstIndex();
+
+    if (
+        _bValid
+        && (samples.count < knownCount)
+    )
+    {
+        /* Samples were removed without notification */
+        _bValid = false;
+    }
+
+    if (!_bValid)
+    {
+        _pyramid.clear();
+        _lastPresentIdx = -1;
+        knownCount = 0;
+
+        _bValid = true;
+    }
+
+    const qint64 offset = _pyramid.firstIndex();
+
+    for (qint64 idx = knownCount; idx < samples.count; idx++)
+    {
+        if (isAbsent(samples, idx))
+        {
+            _pyramid.appendAbsent();
+        }
+        else
+        {
+            /* Segment of previous sample ends at this sample */
+            if (_lastPresentIdx >= offset)
+            {
+                _pyramid.addArea(_lastPresentIdx, segmentArea(samples, _lastPresentIdx - offset));
+            }
+
+            _lastPresentIdx = _pyramid.endIndex();
+
+            if (isValid(samples, idx))
+            {
+                _pyramid.append(samples.pValues[idx]);
+            }
+            else
+            {
+                _pyramid.appendGap();
+            }
+        }
+    }
+}
+
+/*!
+ * Area of trapezoid between sample and next sample, absent samples are skipped
+ * \return Area, 0 when there is no next sample or one of both samples is invalid
+ */
+double GraphDataIndex::segmentArea(const Samples &samples, qint64 idx) const
+{
+    if (
+        (idx < 0)
+        || (idx >= samples.count)
+        || isAbsent(samples, idx)
+        || !isValid(samples, idx)
+        )
+    {
+        return 0;
+    }
+
+    const qint64 nextIdx = nextPresent(samples, idx);
+    if (
+        (nextIdx >= samples.count)
+        || !isValid(samples, nextIdx)
+        )
+    {
+        return 0;
+    }
+
+    return (samples.pKeys[nextIdx] - samples.pKeys[idx]) * (samples.pValues[idx] + samples.pValues[nextIdx]) / 2;
+}
+
+/*!
+ * Index of first sample after idx that isn't absent
+ * \return Sample index, samples.count when there is none
+ */
+qint64 GraphDataIndex::nextPresent(const Samples &samples, qint64 idx) const
+{
+    qint64 nextIdx = idx + 1;
+    while (
+        (nextIdx < samples.count)
+        && isAbsent(samples, nextIdx)
+    )
+    {
+        nextIdx++;
+    }
+
+    return nextIdx;
+}
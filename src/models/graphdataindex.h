@@ -0,0 +1,64 @@
+#ifndef GRAPHDATAINDEX_H
+#define GRAPHDATAINDEX_H
+
+#include <QVector>
+#include "envelopepyramid.h"
+
+/*!
+ * Summary index of the values of a single graph
+ * The index follows the samples lazily: appended samples are picked up automatically
+ * before every query. Samples removed from the front are reported with removeFront().
+ */
+class GraphDataIndex
+{
+public:
+
+    typedef struct
+    {
+        qint64 count;
+        double minimum;
+        double maximum;
+        double average;
+        double standardDeviation;
+        double rms;
+        double integral; /* value * s */
+    } Statistics;
+
+    /* Samples of a graph, keys are increasing */
+    typedef struct
+    {
+        const double* pKeys;
+        const double* pValues;
+        qint64 count;
+
+        /* Bit (validityOffset + idx) is set when sample idx is valid, all samples are valid when nullptr.
+         * A NaN value means the graph has no sample at that key (absent), see isAbsent(). */
+        const quint64* pValidity;
+        qint64 validityOffset;
+    } Samples;
+
+    GraphDataIndex();
+
+    void invalidate();
+    void removeFront(qint64 count);
+
+    void envelope(const Samples &samples, qint64 begin, qint64 end, qint64 maxBuckets, QVector<qint64> &indexes);
+    Statistics statistics(const Samples &samples, qint64 begin, qint64 end);
+
+    static Statistics summaryStatistics(const EnvelopePyramid::Summary &summary, double lastArea);
+    static bool isValid(const Samples &samples, qint64 idx);
+    static bool isAbsent(const Samples &samples, qint64 idx);
+
+private:
+    void sync(const Samples &samples);
+    double segmentArea(const Samples &samples, qint64 idx) const;
+    qint64 nextPresent(const Samples &samples, qint64 idx) const;
+
+    EnvelopePyramid _pyramid;
+    bool _bValid;
+
+    /* Pyramid index of last sample that isn't absent, -1 when there is none */
+    qint64 _lastPresentIdx;
+};
+
+#endif // GRAPHDATAINDEX_H
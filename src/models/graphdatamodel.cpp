@@ -3,6 +3,7 @@
 #include "util.h"
 
 #include "graphdatamodel.h"
+#include "lazydatasource.h"
 
 GraphDataModel::GraphDataModel(QObject *parent) : QAbstractTableModel(parent)
 {
@@ -13,6 +14,7 @@ GraphDataModel::GraphDataModel(QObject *parent) : QAbstractTableModel(parent)
     connect(this, &GraphDataModel::colorChanged, this, &GraphDataModel::modelDataChanged);
     connect(this, &GraphDataModel::activeChanged, this, &GraphDataModel::modelDataChanged);
     connect(this, &GraphDataModel::expressionChanged, this, &GraphDataModel::modelDataChanged);
+    connect(this, &GraphDataModel::pollIntervalChanged, this, &GraphDataModel::modelDataChanged);
 
     /* When adding or removing graphs, the complete view should be refreshed to make sure all indexes are updated */
     connect(this, &GraphDataModel::added, this, &GraphDataModel::modelCompleteDataChanged);
@@ -71,6 +73,23 @@ QVariant GraphDataModel::data(const QModelIndex &index, int role) const
             return axis;
         }
         break;
+    case column::POLL_INTERVAL:
+        if (role == Qt::DisplayRole)
+        {
+            if (pollInterval(index.row()) == 0)
+            {
+                return QString("Default");
+            }
+            else
+            {
+                return QString("%1 ms").arg(pollInterval(index.row()));
+            }
+        }
+        else if (role == Qt::EditRole)
+        {
+            return pollInterval(index.row());
+        }
+        break;
     default:
         return QVariant();
         break;
@@ -98,6 +117,8 @@ QVariant GraphDataModel::headerData(int section, Qt::Orientation orientation, in
                 return QString("Expression");
             case column::VALUE_AXIS:
                 return QString("Y-Axis");
+            case column::POLL_INTERVAL:
+                return QString("Poll interval");
             default:
                 return QVariant();
             }
@@ -178,6 +199,24 @@ bool GraphDataModel::setData(const QModelIndex & index, const QVariant & value,
             }
         }
         break;
+    case column::POLL_INTERVAL:
+        if (role == Qt::EditRole)
+        {
+            bool bSuccess = false;
+            const quint32 newPollInterval = value.toUInt(&bSuccess);
+
+            if (bSuccess)
+            {
+                setPollInterval(index.row(), newPollInterval);
+            }
+            else
+            {
+                bRet = false;
+                Util::showError(tr("Poll interval is not valid"));
+                break;
+            }
+        }
+        break;
     default:
         break;
 
@@ -334,9 +373,18 @@ QString GraphDataModel::simplifiedExpression(quint32 index) const
     return _graphData[index].expression().simplified();
 }
 
-QSharedPointer<QCPGraphDataContainer> GraphDataModel::dataMap(quint32 index)
+quint32 GraphDataModel::pollInterval(quint32 index) const
+{
+    return _graphData[index].pollInterval();
+}
+
+/*!
+ * Samples of all graphs
+ * When a data file is browsed lazily, the store only contains the loaded window of the file.
+ */
+GraphSampleStore* GraphDataModel::sampleStore()
 {
-    return _graphData[index].dataMap();
+    return &_sampleStore;
 }
 
 void GraphDataModel::setValueAxis(quint32 index, GraphData::valueAxis_t axis)
@@ -387,7 +435,7 @@ void GraphDataModel::setActive(quint32 index, bool bActive)
         // When deactivated, clear data
         if (!bActive)
         {
-            _graphData[index].dataMap()->clear();
+            _sampleStore.clearValues(index);
         }
         else
         {
@@ -408,6 +456,15 @@ void GraphDataModel::setExpression(quint32 index, QString expression)
     }
 }
 
+void GraphDataModel::setPollInterval(quint32 index, quint32 pollInterval)
+{
+    if (_graphData[index].pollInterval() != pollInterval)
+    {
+         _graphData[index].setPollInterval(pollInterval);
+         emit pollIntervalChanged(index);
+    }
+}
+
 void GraphDataModel::add(GraphData rowData)
 {
     addToModel(rowData);
@@ -445,10 +502,66 @@ void GraphDataModel::setAllData(QList<double> timeData, QList<QList<double> > da
 {
     if (data.size() == size())
     {
+        _sampleStore.setAll(timeData, data);
+
         emit graphsAddData(timeData, data);
     }
 }
 
+/*!
+ * Append samples after the existing data of all graphs (progressive loading)
+ */
+void GraphDataModel::appendAllData(QList<double> timeData, QList<QList<double> > data)
+{
+    if (data.size() == size())
+    {
+        _sampleStore.appendAll(timeData, data);
+
+        emit graphsAppendData(timeData, data);
+    }
+}
+
+/*!
+ * Set decimated preview of the complete data set that is being loaded
+ */
+void GraphDataModel::setPreviewData(QList<double> timeData, QList<QList<double> > data)
+{
+    if (data.size() == size())
+    {
+        emit graphsPreviewData(timeData, data);
+    }
+}
+
+void GraphDataModel::clearPreviewData()
+{
+    emit graphsPreviewData(QList<double>(), QList<QList<double> >());
+}
+
+/*!
+ * Set source of data file that is browsed lazily
+ * The data of the graphs is then only a window of the data file, which is updated by the graph view.
+ * A null pointer ends lazy mode, which also removes the overview of the data file.
+ */
+void GraphDataModel::setLazyDataSource(QSharedPointer<LazyDataSource> pDataSource)
+{
+    if (_pLazyDataSource != pDataSource)
+    {
+        if (!_pLazyDataSource.isNull())
+        {
+            clearPreviewData();
+        }
+
+        _pLazyDataSource = pDataSource;
+
+        emit lazyDataSourceChanged();
+    }
+}
+
+QSharedPointer<LazyDataSource> GraphDataModel::lazyDataSource() const
+{
+    return _pLazyDataSource;
+}
+
 void GraphDataModel::removeRegister(qint32 idx)
 {
     if (idx < _graphData.size())
@@ -459,12 +572,19 @@ void GraphDataModel::removeRegister(qint32 idx)
 
 void GraphDataModel::clear()
 {
+    setLazyDataSource(QSharedPointer<LazyDataSource>());
+
     if (_graphData.size() > 0)
     {
         beginRemoveRows(QModelIndex(), 0, _graphData.size() - 1);
 
         _graphData.clear();
 
+        while (_sampleStore.graphCount() > 0)
+        {
+            _sampleStore.removeGraph(_sampleStore.graphCount() - 1);
+        }
+
         updateActiveGraphList();
 
         endRemoveRows();
@@ -544,6 +664,7 @@ void GraphDataModel::addToModel(GraphData graphData)
     }
 
     _graphData.append(graphData);
+    _sampleStore.insertGraph(_graphData.size() - 1);
 
     updateActiveGraphList();
 
@@ -558,6 +679,7 @@ void GraphDataModel::removeFromModel(qint32 row)
     beginRemoveRows(QModelIndex(), row, row);
 
     _graphData.removeAt(row);
+    _sampleStore.removeGraph(row);
 
     updateActiveGraphList();
 
@@ -581,6 +703,7 @@ void GraphDataModel::moveRow(int sourceRow, int destRow)
     if (sourceRow != newRow)
     {
         _graphData.move(sourceRow, newRow);
+        _sampleStore.moveGraph(sourceRow, newRow);
     }
 
     modelCompleteDataChanged();
@@ -6,7 +6,10 @@
 #include <QList>
 
 #include "graphdata.h"
+#include "graphsamplestore.h"
 
+/* Forward declaration */
+class LazyDataSource;
 
 class GraphDataModel : public QAbstractTableModel
 {
@@ -19,6 +22,7 @@ public:
         TEXT,
         EXPRESSION,
         VALUE_AXIS,
+        POLL_INTERVAL,
 
         COUNT
     };
@@ -51,7 +55,8 @@ public:
     bool isActive(quint32 index) const;
     QString expression(quint32 index) const;
     QString simplifiedExpression(quint32 index) const;
-    QSharedPointer<QCPGraphDataContainer> dataMap(quint32 index);
+    quint32 pollInterval(quint32 index) const;
+    GraphSampleStore* sampleStore();
 
     void setValueAxis(quint32 index, GraphData::valueAxis_t axis);
     void setVisible(quint32 index, bool bVisible);
@@ -59,12 +64,19 @@ public:
     void setColor(quint32 index, const QColor &color);
     void setActive(quint32 index, bool bActive);
     void setExpression(quint32 index, QString expression);
+    void setPollInterval(quint32 index, quint32 pollInterval);
 
     void add(GraphData rowData);
     void add(QList<GraphData> graphDataList);
     void add();
     void add(QList<QString> labelList);
     void setAllData(QList<double> timeData, QList<QList<double> > data);
+    void appendAllData(QList<double> timeData, QList<QList<double> > data);
+    void setPreviewData(QList<double> timeData, QList<QList<double> > data);
+    void clearPreviewData();
+
+    void setLazyDataSource(QSharedPointer<LazyDataSource> pDataSource);
+    QSharedPointer<LazyDataSource> lazyDataSource() const;
 
     void removeRegister(qint32 idx);
     void clear();
@@ -82,7 +94,11 @@ signals:
     void colorChanged(const quint32 graphIdx);
     void activeChanged(const quint32 graphIdx);
     void expressionChanged(const quint32 graphIdx);
+    void pollIntervalChanged(const quint32 graphIdx);
     void graphsAddData(QList<double>, QList<QList<double> > data);
+    void graphsAppendData(QList<double>, QList<QList<double> > data);
+    void graphsPreviewData(QList<double>, QList<QList<double> > data);
+    void lazyDataSourceChanged();
 
     void moved();
     void added(const quint32 idx);
@@ -101,6 +117,12 @@ private:
 
     QList<GraphData> _graphData;
     QList<quint32> _activeGraphList;
+
+    /* Samples of all graphs, columns follow the rows of the model */
+    GraphSampleStore _sampleStore;
+
+    /* Set when the graph data only contains the visible window of a data file */
+    QSharedPointer<LazyDataSource> _pLazyDataSource;
 };
 
 #endif // GRAPHDATAMODEL_H
@@ -0,0 +1,535 @@
+
+#include <QtNumeric>
+#include <algorithm> // std::lower_bound, std::upper_bound
+
+#include "graphsamplestore.h"
+
+GraphSampleStore::GraphSampleStore() :
+    _first(0)
+{
+
+}
+
+qint32 GraphSampleStore::graphCount() const
+{
+    return static_cast<qint32>(_columns.size());
+}
+
+/*!
+ * Add graph, the graph has no valid values for the existing samples
+ */
+void GraphSampleStore::insertGraph(qint32 graphIdx)
+{
+    Column column;
+    column.values = QVector<double>(_keys.size(), 0);
+    column.validity = QVector<quint64>((_keys.size() + 63) / 64, 0);
+
+    _columns.insert(qBound(0, graphIdx, graphCount()), column);
+}
+
+/*!
+ * Remove graph, the samples are removed together with the last graph
+ */
+void GraphSampleStore::removeGraph(qint32 graphIdx)
+{
+    if (
+        (graphIdx >= 0)
+        && (graphIdx < graphCount())
+    )
+    {
+        _columns.removeAt(graphIdx);
+    }
+
+    if (_columns.isEmpty())
+    {
+        clear();
+    }
+}
+
+void GraphSampleStore::moveGraph(qint32 from, qint32 to)
+{
+    if (
+        (from >= 0) && (from < graphCount())
+        && (to >= 0) && (to < graphCount())
+    )
+    {
+        _columns.move(from, to);
+    }
+}
+
+qint32 GraphSampleStore::size() const
+{
+    return static_cast<qint32>(_keys.size()) - _first;
+}
+
+bool GraphSampleStore::isEmpty() const
+{
+    return size() == 0;
+}
+
+/*!
+ * Remove all samples, graphs are kept
+ */
+void GraphSampleStore::clear()
+{
+    _first = 0;
+    _keys.clear();
+
+    for (Column &column : _columns)
+    {
+        column.values.clear();
+        column.validity.clear();
+        column.index.invalidate();
+    }
+}
+
+/*!
+ * Clear values of a single graph, the keys are kept for the other graphs
+ */
+void GraphSampleStore::clearValues(qint32 graphIdx)
+{
+    if (
+        (graphIdx >= 0)
+        && (graphIdx < graphCount())
+    )
+    {
+        Column &column = _columns[graphIdx];
+
+        column.values.fill(0);
+        column.validity.fill(0);
+        column.index.invalidate();
+    }
+}
+
+/*!
+ * Replace all samples
+ * \param keys      Key of each sample (increasing)
+ * \param values    Values of each sample, one list per graph
+ */
+void GraphSampleStore::setAll(const QList<double> &keys, const QList<QList<double> > &values)
+{
+    clear();
+    appendAll(keys, values);
+}
+
+/*!
+ * Append samples after the existing samples, all values are valid
+ * \param keys      Key of each sample (increasing)
+ * \param values    Values of each sample, one list per graph
+ */
+void GraphSampleStore::appendAll(const QList<double> &keys, const QList<QList<double> > &values)
+{
+    if (values.size() != graphCount())
+    {
+        return;
+    }
+
+    for (const QList<double> &graphValues : values)
+    {
+        if (graphValues.size() != keys.size())
+        {
+            return;
+        }
+    }
+
+    const qint32 begin = static_cast<qint32>(_keys.size());
+    _keys.append(keys);
+
+    for (qint32 graphIdx = 0; graphIdx < graphCount(); graphIdx++)
+    {
+        Column &column = _columns[graphIdx];
+
+        column.values.append(values[graphIdx]);
+        setValidRange(column, begin, static_cast<qint32>(_keys.size()), true);
+    }
+}
+
+/*!
+ * Append single sample
+ * \param key           Key of sample, at or after the last key
+ * \param values        Value per graph, NaN when graph has no sample at this key
+ * \param validList     Validity of value per graph, invalid values are kept (e.g. 0)
+ */
+void GraphSampleStore::append(double key, const QList<double> &values, const QList<bool> &validList)
+{
+    if (
+        (values.size() != graphCount())
+        || (validList.size() != graphCount())
+    )
+    {
+        return;
+    }
+
+    const qint32 pos = static_cast<qint32>(_keys.size());
+    _keys.append(key);
+
+    for (qint32 graphIdx = 0; graphIdx < graphCount(); graphIdx++)
+    {
+        Column &column = _columns[graphIdx];
+
+        column.values.append(values[graphIdx]);
+        setValidRange(column, pos, pos + 1, validList[graphIdx]);
+    }
+}
+
+/*!
+ * Remove samples with a key before the given key (retention)
+ * Samples are removed in amortized constant time, the arrays are only compacted when
+ * at least half of them is removed.
+ */
+void GraphSampleStore::removeBefore(double key)
+{
+    const qint32 count = findBegin(key);
+    if (count <= 0)
+    {
+        return;
+    }
+
+    _first += count;
+
+    for (Column &column : _columns)
+    {
+        column.index.removeFront(count);
+    }
+
+    if (
+        (_first >= cCompactThreshold)
+        && (_first * 2 >= _keys.size())
+    )
+    {
+        compact();
+    }
+}
+
+double GraphSampleStore::key(qint32 idx) const
+{
+    return _keys[_first + idx];
+}
+
+double GraphSampleStore::value(qint32 graphIdx, qint32 idx) const
+{
+    return _columns[graphIdx].values[_first + idx];
+}
+
+bool GraphSampleStore::isValid(qint32 graphIdx, qint32 idx) const
+{
+    return GraphDataIndex::isValid(samples(graphIdx), idx);
+}
+
+/*!
+ * Check whether graph has no sample at this key (e.g. graph is polled by another connection)
+ */
+bool GraphSampleStore::isAbsent(qint32 graphIdx, qint32 idx) const
+{
+    return qIsNaN(value(graphIdx, idx));
+}
+
+/*!
+ * Value of sample, NaN when the sample isn't valid or absent
+ * Plots show a gap for NaN values.
+ */
+double GraphSampleStore::validValue(qint32 graphIdx, qint32 idx) const
+{
+    return isValid(graphIdx, idx) ? value(graphIdx, idx) : qQNaN();
+}
+
+/*!
+ * Keys of all samples (size() entries)
+ */
+const double* GraphSampleStore::keyData() const
+{
+    return _keys.constData() + _first;
+}
+
+/*!
+ * Values of all samples of a graph (size() entries)
+ */
+const double* GraphSampleStore::valueData(qint32 graphIdx) const
+{
+    return _columns[graphIdx].values.constData() + _first;
+}
+
+/*!
+ * Index of first sample with key at or after key
+ * \return Sample index, size() when all samples are before key
+ */
+qint32 GraphSampleStore::findBegin(double key) const
+{
+    return static_cast<qint32>(std::lower_bound(keyData(), keyData() + size(), key) - keyData());
+}
+
+/*!
+ * Index of first sample with key after key
+ * \return Sample index, size() when no sample is after key
+ */
+qint32 GraphSampleStore::findEnd(double key) const
+{
+    return static_cast<qint32>(std::upper_bound(keyData(), keyData() + size(), key) - keyData());
+}
+
+/*!
+ * Index of sample that is closest to key, the earlier sample wins when both are as close
+ * \return Sample index, -1 when there are no samples
+ */
+qint32 GraphSampleStore::closestSample(double key) const
+{
+    if (isEmpty())
+    {
+        return -1;
+    }
+
+    const qint32 idx = qMin(findBegin(key), size() - 1);
+
+    if (
+        (idx > 0)
+        && (key - this->key(idx - 1) <= this->key(idx) - key)
+    )
+    {
+        return idx - 1;
+    }
+
+    return idx;
+}
+
+QCPRange GraphSampleStore::keyRange(bool &foundRange) const
+{
+    foundRange = !isEmpty();
+    if (!foundRange)
+    {
+        return QCPRange();
+    }
+
+    return QCPRange(key(0), key(size() - 1));
+}
+
+/*!
+ * Get value of first sample at or after key, last sample when key is after the data
+ * Absent samples are skipped, the previous sample of the graph is used when there is none after key.
+ */
+double GraphSampleStore::valueAt(qint32 graphIdx, double key) const
+{
+    if (
+        (graphIdx < 0)
+        || (graphIdx >= graphCount())
+        || isEmpty()
+    )
+    {
+        return 0;
+    }
+
+    const qint32 startIdx = qMin(findBegin(key), size() - 1);
+
+    for (qint32 idx = startIdx; idx < size(); idx++)
+    {
+        if (!isAbsent(graphIdx, idx))
+        {
+            return value(graphIdx, idx);
+        }
+    }
+
+    for (qint32 idx = startIdx - 1; idx >= 0; idx--)
+    {
+        if (!isAbsent(graphIdx, idx))
+        {
+            return value(graphIdx, idx);
+        }
+    }
+
+    return 0;
+}
+
+/*!
+ * Calculate statistics of valid samples in key range in O(log n)
+ * \param graphIdx      index of graph
+ * \param startKey      key of first sample
+ * \param endKey        key of last sample
+ * \return Statistics of range
+ */
+GraphDataIndex::Statistics GraphSampleStore::statistics(qint32 graphIdx, double startKey, double endKey)
+{
+    if (
+        (graphIdx < 0)
+        || (graphIdx >= graphCount())
+    )
+    {
+        EnvelopePyramid::Summary summary;
+        EnvelopePyramid::initSummary(summary);
+
+        return GraphDataIndex::summaryStatistics(summary, 0);
+    }
+
+    return _columns[graphIdx].index.statistics(samples(graphIdx), findBegin(startKey), findEnd(endKey));
+}
+
+/*!
+ * Get value range of valid samples in O(log n)
+ * Same result as QCPDataContainer::valueRange for both sign domains, without visiting every sample.
+ * \param graphIdx     index of graph
+ * \param foundRange   Set to true when there are samples in range
+ * \param inKeyRange   Only samples with key in this range are used, empty range to use all samples
+ * \return Value range
+ */
+QCPRange GraphSampleStore::valueRange(qint32 graphIdx, bool &foundRange, const QCPRange &inKeyRange)
+{
+    foundRange = false;
+
+    if (
+        (graphIdx < 0)
+        || (graphIdx >= graphCount())
+    )
+    {
+        return QCPRange();
+    }
+
+    qint32 begin = 0;
+    qint32 end = size();
+
+    if (inKeyRange != QCPRange())
+    {
+        begin = findBegin(inKeyRange.lower);
+        end = findEnd(inKeyRange.upper);
+    }
+
+    const GraphDataIndex::Statistics stats = _columns[graphIdx].index.statistics(samples(graphIdx), begin, end);
+
+    foundRange = stats.count > 0;
+
+    return QCPRange(stats.minimum, stats.maximum);
+}
+
+/*!
+ * Get samples of a graph in key range, reduced to what can be drawn
+ * When there are more samples than buckets can show, only the min/max envelope
+ * of the samples is returned. Invalid samples have a NaN value, so the line shows a gap.
+ * Absent samples are left out, so the line continues.
+ * \param graphIdx      index of graph
+ * \param keyRange      key range, one sample on both sides is included so lines continue outside of it
+ * \param maxBuckets    number of buckets (e.g. pixels)
+ * \param lineData      receives samples
+ */
+void GraphSampleStore::window(qint32 graphIdx, const QCPRange &keyRange, qint32 maxBuckets, QVector<QCPGraphData> &lineData)
+{
+    lineData.clear();
+
+    if (
+        (graphIdx < 0)
+        || (graphIdx >= graphCount())
+        || isEmpty()
+        || (maxBuckets <= 0)
+    )
+    {
+        return;
+    }
+
+    const qint32 begin = qMax(findBegin(keyRange.lower) - 1, 0);
+    const qint32 end = qMin(findEnd(keyRange.upper) + 1, size());
+
+    const double* pKeys = keyData();
+
+    if (end - begin <= EnvelopePyramid::bucketSize(0) * maxBuckets)
+    {
+        lineData.reserve(end - begin);
+        for (qint32 idx = begin; idx < end; idx++)
+        {
+            if (!isAbsent(graphIdx, idx))
+            {
+                lineData.append(QCPGraphData(pKeys[idx], validValue(graphIdx, idx)));
+            }
+        }
+    }
+    else
+    {
+        QVector<qint64> indexes;
+        _columns[graphIdx].index.envelope(samples(graphIdx), begin, end, maxBuckets, indexes);
+
+        lineData.reserve(indexes.size());
+        for (const qint64 idx : qAsConst(indexes))
+        {
+            if (!isAbsent(graphIdx, static_cast<qint32>(idx)))
+            {
+                lineData.append(QCPGraphData(pKeys[idx], validValue(graphIdx, static_cast<qint32>(idx))));
+            }
+        }
+    }
+}
+
+GraphDataIndex::Samples GraphSampleStore::samples(qint32 graphIdx) const
+{
+    GraphDataIndex::Samples graphSamples;
+
+    graphSamples.pKeys = keyData();
+    graphSamples.pValues = valueData(graphIdx);
+    graphSamples.count = size();
+    graphSamples.pValidity = _columns[graphIdx].validity.constData();
+    graphSamples.validityOffset = _first;
+
+    return graphSamples;
+}
+
+/*!
+ * Set validity of samples at array positions [begin, end)
+ */
+void GraphSampleStore::setValidRange(Column &column, qint32 begin, qint32 end, bool bValid)
+{
+    const qint32 wordCount = (end + 63) / 64;
+    if (column.validity.size() < wordCount)
+    {
+        column.validity.resize(wordCount);
+    }
+
+    for (qint32 pos = begin; pos < end; pos++)
+    {
+        const quint64 mask = static_cast<quint64>(1) << (pos % 64);
+
+        if (bValid)
+        {
+            column.validity[pos / 64] |= mask;
+        }
+        else
+        {
+            column.validity[pos / 64] &= ~mask;
+        }
+    }
+}
+
+/*!
+ * Free samples that were removed from the front of the arrays
+ */
+void GraphSampleStore::compact()
+{
+    const qint32 remaining = size();
+
+    _keys.remove(0, _first);
+
+    for (Column &column : _columns)
+    {
+        column.values.remove(0, _first);
+
+        QVector<quint64> validity((remaining + 63) / 64, 0);
+        for (qint32 word = 0; word < validity.size(); word++)
+        {
+            validity[word] = validityWord(column.validity, _first + word * 64);
+        }
+
+        column.validity = validity;
+    }
+
+    _first = 0;
+}
+
+/*!
+ * Get 64 validity bits starting at any bit position
+ */
+quint64 GraphSampleStore::validityWord(const QVector<quint64> &validity, qint32 bitPos)
+{
+    const qint32 word = bitPos / 64;
+    const qint32 shift = bitPos % 64;
+
+    quint64 result = validity.value(word) >> shift;
+    if (shift != 0)
+    {
+        result |= validity.value(word + 1) << (64 - shift);
+    }
+
+    return result;
+}
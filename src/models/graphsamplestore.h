@@ -0,0 +1,87 @@
+#ifndef GRAPHSAMPLESTORE_H
+#define GRAPHSAMPLESTORE_H
+
+#include <QList>
+#include <QVector>
+#include "qcustomplot.h"
+#include "graphdataindex.h"
+
+/*!
+ * Samples of all graphs, stored as struct of arrays
+ * All graphs share a single time column, every graph has a value column and a validity bitmap.
+ * Columns are contiguous, so export and statistics run over plain arrays. The plot graphs
+ * only get a window of the samples (see window()), reduced to what can be drawn.
+ *
+ * Graphs without a value for a sample (inactive, added later or invalid result) have
+ * value 0 and aren't valid for that sample. Invalid samples are left out of the statistics
+ * and value range, the window and export show them as NaN (a gap in the line).
+ *
+ * A NaN value means the graph has no sample at that key (absent), e.g. when connections are
+ * polled independently and the sample comes from another connection. Absent samples are
+ * left out of the statistics and the window, so the line continues over them.
+ */
+class GraphSampleStore
+{
+public:
+    GraphSampleStore();
+
+    qint32 graphCount() const;
+    void insertGraph(qint32 graphIdx);
+    void removeGraph(qint32 graphIdx);
+    void moveGraph(qint32 from, qint32 to);
+
+    qint32 size() const;
+    bool isEmpty() const;
+
+    void clear();
+    void clearValues(qint32 graphIdx);
+
+    void setAll(const QList<double> &keys, const QList<QList<double> > &values);
+    void appendAll(const QList<double> &keys, const QList<QList<double> > &values);
+    void append(double key, const QList<double> &values, const QList<bool> &validList);
+    void removeBefore(double key);
+
+    double key(qint32 idx) const;
+    double value(qint32 graphIdx, qint32 idx) const;
+    bool isValid(qint32 graphIdx, qint32 idx) const;
+    bool isAbsent(qint32 graphIdx, qint32 idx) const;
+    double validValue(qint32 graphIdx, qint32 idx) const;
+
+    const double* keyData() const;
+    const double* valueData(qint32 graphIdx) const;
+
+    qint32 findBegin(double key) const;
+    qint32 findEnd(double key) const;
+    qint32 closestSample(double key) const;
+    QCPRange keyRange(bool &foundRange) const;
+
+    double valueAt(qint32 graphIdx, double key) const;
+    GraphDataIndex::Statistics statistics(qint32 graphIdx, double startKey, double endKey);
+    QCPRange valueRange(qint32 graphIdx, bool &foundRange, const QCPRange &inKeyRange = QCPRange());
+    void window(qint32 graphIdx, const QCPRange &keyRange, qint32 maxBuckets, QVector<QCPGraphData> &lineData);
+
+private:
+
+    typedef struct
+    {
+        QVector<double> values;
+        QVector<quint64> validity; /* One bit per sample, same positions as values */
+        GraphDataIndex index;
+    } Column;
+
+    GraphDataIndex::Samples samples(qint32 graphIdx) const;
+    void setValidRange(Column &column, qint32 begin, qint32 end, bool bValid);
+    void compact();
+
+    static quint64 validityWord(const QVector<quint64> &validity, qint32 bitPos);
+
+    /* Samples before this position were removed (retention), they are compacted lazily */
+    qint32 _first;
+
+    QVector<double> _keys;
+    QList<Column> _columns;
+
+    static const qint32 cCompactThreshold = 4096;
+};
+
+#endif // GRAPHSAMPLESTORE_H
@@ -13,13 +13,19 @@ const quint32 GuiModel::cSlopeMask         = 1 << 1;
 const quint32 GuiModel::cAverageMask       = 1 << 2;
 const quint32 GuiModel::cMinimumMask       = 1 << 3;
 const quint32 GuiModel::cMaximumMask       = 1 << 4;
+const quint32 GuiModel::cStdDevMask        = 1 << 5;
+const quint32 GuiModel::cRmsMask           = 1 << 6;
+const quint32 GuiModel::cIntegralMask      = 1 << 7;
 
 const QStringList GuiModel::cMarkerExpressionStrings = QStringList()
                                                         <<  "Diff: %0\n"
                                                         <<  "Slope: %0\n"
                                                         <<  "Avg: %0\n"
                                                         <<  "Min: %0\n"
-                                                        <<  "Max: %0\n";
+                                                        <<  "Max: %0\n"
+                                                        <<  "StdDev: %0\n"
+                                                        <<  "RMS: %0\n"
+                                                        <<  "Integral: %0\n";
 
 const QList<quint32> GuiModel::cMarkerExpressionBits = QList<quint32>()
                         << GuiModel::cDifferenceMask
@@ -27,6 +33,9 @@ const QList<quint32> GuiModel::cMarkerExpressionBits = QList<quint32>()
                         << GuiModel::cAverageMask
                         << GuiModel::cMinimumMask
                         << GuiModel::cMaximumMask
+                        << GuiModel::cStdDevMask
+                        << GuiModel::cRmsMask
+                        << GuiModel::cIntegralMask
                         ;
 const QString GuiModel::cMarkerExpressionStart = QString("y1: %0\n");
 const QString GuiModel::cMarkerExpressionEnd = QString("y2: %0\n");
@@ -28,6 +28,9 @@ public:
     static const quint32 cAverageMask;
     static const quint32 cMinimumMask;
     static const quint32 cMaximumMask;
+    static const quint32 cStdDevMask;
+    static const quint32 cRmsMask;
+    static const quint32 cIntegralMask;
 
     static const QStringList cMarkerExpressionStrings;
     static const QList<quint32> cMarkerExpressionBits;
@@ -0,0 +1,127 @@
+
+#include <algorithm> // std::lower_bound, std::upper_bound, std::binary_search
+
+#include "readcapability.h"
+
+ReadCapability::ReadCapability() :
+    _maxBlockSize(0)
+{
+
+}
+
+bool ReadCapability::isEmpty() const
+{
+    return (_maxBlockSize == 0)
+           && _unreadableList.isEmpty()
+           && _boundaryList.isEmpty();
+}
+
+void ReadCapability::clear()
+{
+    _maxBlockSize = 0;
+    _unreadableList.clear();
+    _boundaryList.clear();
+}
+
+/*!
+ * Maximum number of registers in a single read
+ * \return Maximum number of registers, 0 when not limited
+ */
+quint16 ReadCapability::maxBlockSize() const
+{
+    return _maxBlockSize;
+}
+
+/*!
+ * Limit number of registers in a single read, a larger limit is ignored
+ * \param count     Number of registers that is known to succeed
+ */
+void ReadCapability::limitBlockSize(quint16 count)
+{
+    if (
+        (count > 0)
+        && ((_maxBlockSize == 0) || (count < _maxBlockSize))
+    )
+    {
+        _maxBlockSize = count;
+    }
+}
+
+const QList<ModbusAddress>& ReadCapability::unreadableList() const
+{
+    return _unreadableList;
+}
+
+bool ReadCapability::isUnreadable(ModbusAddress address) const
+{
+    return std::binary_search(_unreadableList.constBegin(), _unreadableList.constEnd(), address);
+}
+
+void ReadCapability::addUnreadable(ModbusAddress address)
+{
+    insertSorted(_unreadableList, address);
+}
+
+const QList<ModbusAddress>& ReadCapability::boundaryList() const
+{
+    return _boundaryList;
+}
+
+/*!
+ * Add boundary, a single read can't contain both the address and the address before it
+ */
+void ReadCapability::addBoundary(ModbusAddress address)
+{
+    insertSorted(_boundaryList, address);
+}
+
+/*!
+ * Check whether two addresses need to be in separate reads
+ * \param lowAddress   Last address of read
+ * \param highAddress  Address that would be added to read, addresses in between are read as well
+ * \return true when a single read of both addresses would be refused
+ */
+bool ReadCapability::isSplit(ModbusAddress lowAddress, ModbusAddress highAddress) const
+{
+    /* Boundary can be the high address itself */
+    if (containsBetween(_boundaryList, lowAddress, highAddress.next()))
+    {
+        return true;
+    }
+
+    return containsBetween(_unreadableList, lowAddress, highAddress);
+}
+
+bool operator== (const ReadCapability& capability1, const ReadCapability& capability2)
+{
+    return (capability1._maxBlockSize == capability2._maxBlockSize)
+           && (capability1._unreadableList == capability2._unreadableList)
+           && (capability1._boundaryList == capability2._boundaryList);
+}
+
+bool operator!= (const ReadCapability& capability1, const ReadCapability& capability2)
+{
+    return !(capability1 == capability2);
+}
+
+void ReadCapability::insertSorted(QList<ModbusAddress>& list, ModbusAddress address)
+{
+    auto it = std::lower_bound(list.begin(), list.end(), address);
+    if (
+        (it == list.end())
+        || !(*it == address)
+    )
+    {
+        list.insert(it, address);
+    }
+}
+
+/*!
+ * Check whether sorted list contains an address after lowAddress and before highAddress
+ */
+bool ReadCapability::containsBetween(const QList<ModbusAddress>& list, ModbusAddress lowAddress, ModbusAddress highAddress)
+{
+    auto it = std::upper_bound(list.constBegin(), list.constEnd(), lowAddress);
+
+    return (it != list.constEnd()) && (*it < highAddress);
+}
@@ -0,0 +1,55 @@
+#ifndef READCAPABILITY_H
+#define READCAPABILITY_H
+
+#include <QList>
+#include <QMetaType>
+#include "modbusaddress.h"
+
+/*!
+ * Read capabilities of a device, learned from the reads that the device refused
+ * The read planner uses them so steady-state polls only issue requests that succeed:
+ *  - maximum number of registers in a single read
+ *  - addresses that can't be read
+ *  - boundaries that a single read can't cross
+ * Only the maximum read size and the boundaries are stored in the project file.
+ */
+class ReadCapability
+{
+public:
+    ReadCapability();
+
+    bool isEmpty() const;
+    void clear();
+
+    quint16 maxBlockSize() const;
+    void limitBlockSize(quint16 count);
+
+    const QList<ModbusAddress>& unreadableList() const;
+    bool isUnreadable(ModbusAddress address) const;
+    void addUnreadable(ModbusAddress address);
+
+    const QList<ModbusAddress>& boundaryList() const;
+    void addBoundary(ModbusAddress address);
+
+    bool isSplit(ModbusAddress lowAddress, ModbusAddress highAddress) const;
+
+    friend bool operator== (const ReadCapability& capability1, const ReadCapability& capability2);
+    friend bool operator!= (const ReadCapability& capability1, const ReadCapability& capability2);
+
+private:
+    static void insertSorted(QList<ModbusAddress>& list, ModbusAddress address);
+    static bool containsBetween(const QList<ModbusAddress>& list, ModbusAddress lowAddress, ModbusAddress highAddress);
+
+    /* 0 when not limited */
+    quint16 _maxBlockSize;
+
+    /* Sorted */
+    QList<ModbusAddress> _unreadableList;
+
+    /* Sorted, a read can't contain both a boundary and the address before it */
+    QList<ModbusAddress> _boundaryList;
+};
+
+Q_DECLARE_METATYPE(ReadCapability)
+
+#endif // READCAPABILITY_H
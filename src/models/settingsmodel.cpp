@@ -23,6 +23,8 @@ SettingsModel::SettingsModel(QObject *parent) :
         connectionSettings.slaveId = 1;
         connectionSettings.timeout = 1000;
         connectionSettings.consecutiveMax = 125;
+        connectionSettings.maxGap = 0;
+        connectionSettings.pipelineDepth = 1;
         connectionSettings.bConnectionState = false;
         connectionSettings.bInt32LittleEndian = true;
         connectionSettings.bPersistentConnection = true;
@@ -35,8 +37,12 @@ SettingsModel::SettingsModel(QObject *parent) :
 
     _pollTime = 250;
     _bAbsoluteTimes = false;
+    _bIndependentPolling = false;
+    _plotRetention = 0;
+    _maxFrameRate = 30;
     _bWriteDuringLog = true;
     _writeDuringLogFile = SettingsModel::defaultLogPath();
+    _logSyncPolicy = LOG_SYNC_PERIODIC;
 }
 
 SettingsModel::~SettingsModel()
@@ -49,7 +55,11 @@ void SettingsModel::triggerUpdate(void)
     emit pollTimeChanged();
     emit writeDuringLogChanged();
     emit writeDuringLogFileChanged();
+    emit logSyncPolicyChanged();
     emit absoluteTimesChanged();
+    emit independentPollingChanged();
+    emit plotRetentionChanged();
+    emit maxFrameRateChanged();
 
     for(quint8 i = 0; i < Connection::ID_CNT; i++)
     {
@@ -67,9 +77,12 @@ void SettingsModel::triggerUpdate(void)
         emit slaveIdChanged(i);
         emit timeoutChanged(i);
         emit consecutiveMaxChanged(i);
+        emit maxGapChanged(i);
+        emit pipelineDepthChanged(i);
         emit connectionStateChanged(i);
         emit int32LittleEndianChanged(i);
         emit persistentConnectionChanged(i);
+        emit readCapabilityChanged(i);
     }
 }
 
@@ -101,6 +114,48 @@ bool SettingsModel::absoluteTimes()
     return _bAbsoluteTimes;
 }
 
+void SettingsModel::setIndependentPolling(bool bIndependent)
+{
+    if (_bIndependentPolling != bIndependent)
+    {
+        _bIndependentPolling = bIndependent;
+        emit independentPollingChanged();
+    }
+}
+
+bool SettingsModel::independentPolling()
+{
+    return _bIndependentPolling;
+}
+
+void SettingsModel::setPlotRetention(quint32 retention)
+{
+    if (_plotRetention != retention)
+    {
+        _plotRetention = retention;
+        emit plotRetentionChanged();
+    }
+}
+
+quint32 SettingsModel::plotRetention()
+{
+    return _plotRetention;
+}
+
+void SettingsModel::setMaxFrameRate(quint32 frameRate)
+{
+    if (_maxFrameRate != frameRate)
+    {
+        _maxFrameRate = frameRate;
+        emit maxFrameRateChanged();
+    }
+}
+
+quint32 SettingsModel::maxFrameRate()
+{
+    return _maxFrameRate;
+}
+
 void SettingsModel::setConsecutiveMax(quint8 connectionId, quint8 max)
 {
     clipConnectionId(connectionId);
@@ -119,6 +174,42 @@ quint8 SettingsModel::consecutiveMax(quint8 connectionId)
     return _connectionSettings[connectionId].consecutiveMax;
 }
 
+void SettingsModel::setMaxGap(quint8 connectionId, quint8 maxGap)
+{
+    clipConnectionId(connectionId);
+
+    if (_connectionSettings[connectionId].maxGap != maxGap)
+    {
+        _connectionSettings[connectionId].maxGap = maxGap;
+        emit maxGapChanged(connectionId);
+    }
+}
+
+quint8 SettingsModel::maxGap(quint8 connectionId)
+{
+    clipConnectionId(connectionId);
+
+    return _connectionSettings[connectionId].maxGap;
+}
+
+void SettingsModel::setPipelineDepth(quint8 connectionId, quint8 pipelineDepth)
+{
+    clipConnectionId(connectionId);
+
+    if (_connectionSettings[connectionId].pipelineDepth != pipelineDepth)
+    {
+        _connectionSettings[connectionId].pipelineDepth = pipelineDepth;
+        emit pipelineDepthChanged(connectionId);
+    }
+}
+
+quint8 SettingsModel::pipelineDepth(quint8 connectionId)
+{
+    clipConnectionId(connectionId);
+
+    return _connectionSettings[connectionId].pipelineDepth;
+}
+
 void SettingsModel::setConnectionState(quint8 connectionId, bool bState)
 {
     clipConnectionId(connectionId);
@@ -180,6 +271,24 @@ bool SettingsModel::persistentConnection(quint8 connectionId)
     return _connectionSettings[connectionId].bPersistentConnection;
 }
 
+void SettingsModel::setReadCapability(quint8 connectionId, const ReadCapability& capability)
+{
+    clipConnectionId(connectionId);
+
+    if (_connectionSettings[connectionId].readCapability != capability)
+    {
+        _connectionSettings[connectionId].readCapability = capability;
+        emit readCapabilityChanged(connectionId);
+    }
+}
+
+ReadCapability SettingsModel::readCapability(quint8 connectionId)
+{
+    clipConnectionId(connectionId);
+
+    return _connectionSettings[connectionId].readCapability;
+}
+
 void SettingsModel::setWriteDuringLog(bool bState)
 {
     if (_bWriteDuringLog != bState)
@@ -213,6 +322,20 @@ QString SettingsModel::writeDuringLogFile()
     return _writeDuringLogFile;
 }
 
+void SettingsModel::setLogSyncPolicy(LogSyncPolicy policy)
+{
+    if (_logSyncPolicy != policy)
+    {
+        _logSyncPolicy = policy;
+        emit logSyncPolicyChanged();
+    }
+}
+
+SettingsModel::LogSyncPolicy SettingsModel::logSyncPolicy()
+{
+    return _logSyncPolicy;
+}
+
 void SettingsModel::setConnectionType(quint8 connectionId, Connection::type_t connectionType)
 {
     clipConnectionId(connectionId);
@@ -221,6 +344,9 @@ void SettingsModel::setConnectionType(quint8 connectionId, Connection::type_t co
     {
         _connectionSettings[connectionId].connectionType = connectionType;
         emit connectionTypeChanged(connectionId);
+
+        /* Other device */
+        clearReadCapability(connectionId);
     }
 }
 
@@ -239,6 +365,9 @@ void SettingsModel::setPortName(quint8 connectionId, QString portName)
     {
         _connectionSettings[connectionId].portName = portName;
         emit portNameChanged(connectionId);
+
+        /* Other device */
+        clearReadCapability(connectionId);
     }
 }
 
@@ -329,6 +458,9 @@ void SettingsModel::setIpAddress(quint8 connectionId, QString ip)
     {
         _connectionSettings[connectionId].ipAddress = ip;
         emit ipChanged(connectionId);
+
+        /* Other device */
+        clearReadCapability(connectionId);
     }
 }
 
@@ -347,6 +479,9 @@ void SettingsModel::setPort(quint8 connectionId, quint16 port)
     {
         _connectionSettings[connectionId].port = port;
         emit portChanged(connectionId);
+
+        /* Other device */
+        clearReadCapability(connectionId);
     }
 }
 
@@ -372,6 +507,9 @@ void SettingsModel::setSlaveId(quint8 connectionId, quint8 id)
     {
         _connectionSettings[connectionId].slaveId = id;
         emit slaveIdChanged(connectionId);
+
+        /* Other device */
+        clearReadCapability(connectionId);
     }
 }
 
@@ -429,3 +567,11 @@ quint8 SettingsModel::clipConnectionId(quint8 connectionId)
     /* Default to first connection on id is not supported */
     return connectionId < static_cast<quint8>(Connection::ID_CNT) ? connectionId : static_cast<quint8>(Connection::ID_1);
 }
+
+/*!
+ * Forget learned read capability, it doesn't apply to another device
+ */
+void SettingsModel::clearReadCapability(quint8 connectionId)
+{
+    setReadCapability(connectionId, ReadCapability());
+}
@@ -6,12 +6,20 @@
 #include <QSerialPort>
 
 #include "connectiontypes.h"
+#include "readcapability.h"
 
 class SettingsModel : public QObject
 {
     Q_OBJECT
 public:
 
+    typedef enum
+    {
+        LOG_SYNC_NONE = 0,      /* Leave writing to disk to the operating system */
+        LOG_SYNC_PERIODIC,      /* Synchronize to disk periodically */
+        LOG_SYNC_EVERY_BATCH,   /* Synchronize to disk after every write */
+    } LogSyncPolicy;
+
     explicit SettingsModel(QObject *parent = nullptr);
     ~SettingsModel();
 
@@ -20,6 +28,7 @@ public:
     void setPollTime(quint32 pollTime);
     void setWriteDuringLogFile(QString filename);
     void setWriteDuringLogFileToDefault(void);
+    void setLogSyncPolicy(LogSyncPolicy policy);
 
     void setConnectionType(quint8 connectionId, Connection::type_t connectionType);
 
@@ -35,12 +44,16 @@ public:
     void setSlaveId(quint8 connectionId, quint8 id);
     void setTimeout(quint8 connectionId, quint32 timeout);
     void setConsecutiveMax(quint8 connectionId, quint8 max);
+    void setMaxGap(quint8 connectionId, quint8 maxGap);
+    void setPipelineDepth(quint8 connectionId, quint8 pipelineDepth);
     void setConnectionState(quint8 connectionId, bool bState);
     void setInt32LittleEndian(quint8 connectionId, bool int32LittleEndian);
     void setPersistentConnection(quint8 connectionId, bool persistentConnection);
+    void setReadCapability(quint8 connectionId, const ReadCapability& capability);
 
     QString writeDuringLogFile();
     bool writeDuringLog();
+    LogSyncPolicy logSyncPolicy();
     Connection::type_t connectionType(quint8 connectionId);
 
     QString portName(quint8 connectionId);
@@ -54,12 +67,18 @@ public:
     quint8 slaveId(quint8 connectionId);
     quint32 timeout(quint8 connectionId);
     quint8 consecutiveMax(quint8 connectionId);
+    quint8 maxGap(quint8 connectionId);
+    quint8 pipelineDepth(quint8 connectionId);
     bool connectionState(quint8 connectionId);
     bool int32LittleEndian(quint8 connectionId);
     bool persistentConnection(quint8 connectionId);
+    ReadCapability readCapability(quint8 connectionId);
 
     quint32 pollTime();
     bool absoluteTimes();
+    bool independentPolling();
+    quint32 plotRetention();
+    quint32 maxFrameRate();
 
     void serialConnectionStrings(quint8 connectionId, QString &strParity, QString &strDataBits, QString &strStopBits);
 
@@ -79,12 +98,19 @@ public:
 public slots:
     void setWriteDuringLog(bool bState);
     void setAbsoluteTimes(bool bAbsolute);
+    void setIndependentPolling(bool bIndependent);
+    void setPlotRetention(quint32 retention);
+    void setMaxFrameRate(quint32 frameRate);
 
 signals:
     void pollTimeChanged();
     void writeDuringLogChanged();
     void writeDuringLogFileChanged();
+    void logSyncPolicyChanged();
     void absoluteTimesChanged();
+    void independentPollingChanged();
+    void plotRetentionChanged();
+    void maxFrameRateChanged();
 
     void connectionTypeChanged(quint8 connectionId);
 
@@ -100,13 +126,17 @@ signals:
     void slaveIdChanged(quint8 connectionId);
     void timeoutChanged(quint8 connectionId);
     void consecutiveMaxChanged(quint8 connectionId);
+    void maxGapChanged(quint8 connectionId);
+    void pipelineDepthChanged(quint8 connectionId);
     void connectionStateChanged(quint8 connectionId);
     void int32LittleEndianChanged(quint8 connectionId);
     void persistentConnectionChanged(quint8 connectionId);
+    void readCapabilityChanged(quint8 connectionId);
 
 private:
 
     quint8 clipConnectionId(quint8 connectionId);
+    void clearReadCapability(quint8 connectionId);
 
     typedef struct
     {
@@ -124,19 +154,32 @@ private:
         quint8 slaveId;
         quint32 timeout;
         quint8 consecutiveMax;
+        quint8 maxGap;
+        quint8 pipelineDepth;
         bool bConnectionState;
         bool bInt32LittleEndian;
         bool bPersistentConnection;
 
+        /* Learned while polling, only valid for the current device */
+        ReadCapability readCapability;
+
     } ConnectionSettings;
 
     QList<ConnectionSettings> _connectionSettings;
 
     quint32 _pollTime;
     bool _bAbsoluteTimes;
+    bool _bIndependentPolling;
+
+    /* Time (s) of data kept in plot, 0 is unlimited */
+    quint32 _plotRetention;
+
+    /* Maximum number of plot updates per second */
+    quint32 _maxFrameRate;
 
     bool _bWriteDuringLog;
     QString _writeDuringLogFile;
+    LogSyncPolicy _logSyncPolicy;
 
 };
 
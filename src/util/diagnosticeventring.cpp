@@ -0,0 +1,83 @@
+
+#include "diagnosticeventring.h"
+
+/*!
+ * Constructor
+ * \param capacity      Maximum number of queued events, rounded up to a power of two
+ */
+DiagnosticEventRing::DiagnosticEventRing(quint32 capacity) :
+    _ring(qMax(capacity, 2u), 1),
+    _droppedCount(0)
+{
+
+}
+
+/*!
+ * Add event to buffer
+ * Must only be called from the producer thread. The event is dropped when the buffer is full,
+ * the producer never waits on the consumer.
+ * \param event     Diagnostic event
+ * \return true when event is added, false when buffer is full
+ */
+bool DiagnosticEventRing::push(const DiagnosticEvent &event)
+{
+    DiagnosticEvent* pSlot = _ring.pushSlot();
+    if (pSlot == nullptr)
+    {
+        _droppedCount.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    *pSlot = event;
+
+    _ring.commitPush();
+
+    return true;
+}
+
+/*!
+ * Take all events from buffer
+ * Must only be called from the consumer thread
+ * \param eventList     Events are appended to this list, oldest first
+ * \return Number of events taken
+ */
+qint32 DiagnosticEventRing::pop(QList<DiagnosticEvent> &eventList)
+{
+    const quint32 count = _ring.size();
+
+    if (count > 0)
+    {
+        eventList.reserve(eventList.size() + count);
+
+        for (quint32 idx = 0; idx < count; idx++)
+        {
+            eventList.append(*_ring.peek(idx));
+        }
+
+        _ring.commitPop(count);
+    }
+
+    return static_cast<qint32>(count);
+}
+
+/*!
+ * Return number of queued events
+ * Can be called from any thread, the result is only a snapshot.
+ */
+quint32 DiagnosticEventRing::size() const
+{
+    return _ring.size();
+}
+
+quint32 DiagnosticEventRing::capacity() const
+{
+    return _ring.capacity();
+}
+
+/*!
+ * Return number of events that were dropped because the buffer was full
+ */
+quint64 DiagnosticEventRing::droppedCount() const
+{
+    return _droppedCount.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,37 @@
+#ifndef DIAGNOSTICEVENTRING_H
+#define DIAGNOSTICEVENTRING_H
+
+#include <QList>
+#include <atomic>
+
+#include "diagnosticevent.h"
+#include "spscring.h"
+
+/*!
+ * Fixed capacity ring buffer of diagnostic events
+ * The storage is allocated once, recording an event never allocates. One producer and one
+ * consumer thread can access the buffer at the same time without locking.
+ */
+class DiagnosticEventRing
+{
+public:
+    explicit DiagnosticEventRing(quint32 capacity = cDefaultCapacity);
+
+    bool push(const DiagnosticEvent &event);
+    qint32 pop(QList<DiagnosticEvent> &eventList);
+
+    quint32 size() const;
+    quint32 capacity() const;
+    quint64 droppedCount() const;
+
+    static const quint32 cDefaultCapacity = 4096;
+
+private:
+    Q_DISABLE_COPY(DiagnosticEventRing)
+
+    SpscRing<DiagnosticEvent> _ring;
+
+    std::atomic<quint64> _droppedCount;
+};
+
+#endif // DIAGNOSTICEVENTRING_H
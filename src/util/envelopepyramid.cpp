@@ -0,0 +1,383 @@
+
+#include <QtNumeric>
+#include <algorithm> // std::sort
+
+#include "envelopepyramid.h"
+
+EnvelopePyramid::EnvelopePyramid()
+    : _levels(cLevelCount)
+{
+    clear();
+}
+
+void EnvelopePyramid::clear()
+{
+    for (Level &level : _levels)
+    {
+        level.firstBucket = 0;
+        level.buckets.clear();
+    }
+
+    _firstIdx = 0;
+    _endIdx = 0;
+}
+
+/*!
+ * Append sample to all levels
+ * \param value     Value of sample
+ */
+void EnvelopePyramid::append(double value)
+{
+    Summary sample;
+    initSummary(sample);
+    addSample(sample, _endIdx, value, 0);
+
+    appendSummary(sample);
+}
+
+/*!
+ * Append sample without value (e.g. invalid result)
+ * The sample isn't part of the statistics, the envelope includes it so a line shows a gap.
+ */
+void EnvelopePyramid::appendGap()
+{
+    Summary sample;
+    initSummary(sample);
+    sample.gapIdx = _endIdx;
+
+    appendSummary(sample);
+}
+
+/*!
+ * Append sample that isn't part of the series (e.g. graph has no value at this key)
+ * The sample is left out of the statistics and the envelope, a line continues over it.
+ */
+void EnvelopePyramid::appendAbsent()
+{
+    Summary sample;
+    initSummary(sample);
+
+    appendSummary(sample);
+}
+
+/*!
+ * Add area (e.g. of segment towards next sample) to an existing sample
+ * \param idx       Index of sample
+ * \param area      Area to add
+ */
+void EnvelopePyramid::addArea(qint64 idx, double area)
+{
+    if (
+        (idx >= _firstIdx)
+        && (idx < _endIdx)
+        )
+    {
+        for (qint32 levelIdx = 0; levelIdx < cLevelCount; levelIdx++)
+        {
+            Level &level = _levels[levelIdx];
+            level.buckets[static_cast<std::size_t>((idx >> (cBaseShift + levelIdx)) - level.firstBucket)].area += area;
+        }
+    }
+}
+
+/*!
+ * Remove oldest samples
+ * Buckets that only contain removed samples are freed, sample indexes aren't renumbered.
+ * \param count     Number of samples to remove
+ */
+void EnvelopePyramid::removeFront(qint64 count)
+{
+    _firstIdx = qMin(_firstIdx + qMax(count, static_cast<qint64>(0)), _endIdx);
+
+    for (qint32 levelIdx = 0; levelIdx < cLevelCount; levelIdx++)
+    {
+        Level &level = _levels[levelIdx];
+        while (
+               (!level.buckets.empty())
+               && (((level.firstBucket + 1) << (cBaseShift + levelIdx)) <= _firstIdx)
+               )
+        {
+            level.buckets.pop_front();
+            level.firstBucket++;
+        }
+    }
+}
+
+qint64 EnvelopePyramid::firstIndex() const
+{
+    return _firstIdx;
+}
+
+qint64 EnvelopePyramid::endIndex() const
+{
+    return _endIdx;
+}
+
+/*!
+ * Return coarsest level needed to show samples with the requested number of buckets
+ * \param sampleCount   Number of samples to show
+ * \param maxBuckets    Maximum number of buckets (e.g. pixels)
+ * \return Level index
+ */
+qint32 EnvelopePyramid::levelFor(qint64 sampleCount, qint64 maxBuckets) const
+{
+    for (qint32 levelIdx = 0; levelIdx < cLevelCount; levelIdx++)
+    {
+        if (sampleCount <= bucketSize(levelIdx) * qMax(maxBuckets, static_cast<qint64>(1)))
+        {
+            return levelIdx;
+        }
+    }
+
+    return cLevelCount - 1;
+}
+
+/*!
+ * Collect indexes of samples that form the min/max envelope of a range
+ * The range is covered by buckets of at most the requested level. Edges that aren't aligned with
+ * a bucket are covered by smaller buckets, or by the samples themselves.
+ * \param begin     Index of first sample of range
+ * \param end       Index after last sample of range
+ * \param level     Coarsest level to use
+ * \param indexes   Sample indexes are appended in increasing order
+ */
+void EnvelopePyramid::envelope(qint64 begin, qint64 end, qint32 level, QVector<qint64> &indexes) const
+{
+    qint64 pos = qMax(begin, _firstIdx);
+    const qint64 endPos = qMin(end, _endIdx);
+    const qint32 maxLevel = qBound(0, level, cLevelCount - 1);
+
+    while (pos < endPos)
+    {
+        const qint32 levelIdx = coveringLevel(pos, endPos, maxLevel);
+
+        if (levelIdx >= 0)
+        {
+            appendBucketIndexes(bucket(levelIdx, pos), indexes);
+
+            pos += bucketSize(levelIdx);
+        }
+        else
+        {
+            /* Not aligned with smallest bucket, use sample itself */
+            indexes.append(pos);
+            pos++;
+        }
+    }
+}
+
+/*!
+ * Combine statistics of a range
+ * The range is covered by the largest buckets possible, so only O(log n) buckets are used.
+ * Samples at the edges that aren't covered by a bucket are returned, the caller adds those.
+ * \param begin         Index of first sample of range
+ * \param end           Index after last sample of range
+ * \param result        Summary of all buckets in range
+ * \param rawIndexes    Indexes of samples that aren't part of result
+ */
+void EnvelopePyramid::summary(qint64 begin, qint64 end, Summary &result, QVector<qint64> &rawIndexes) const
+{
+    qint64 pos = qMax(begin, _firstIdx);
+    const qint64 endPos = qMin(end, _endIdx);
+
+    initSummary(result);
+
+    while (pos < endPos)
+    {
+        const qint32 levelIdx = coveringLevel(pos, endPos, cLevelCount - 1);
+
+        if (levelIdx >= 0)
+        {
+            merge(result, bucket(levelIdx, pos));
+            pos += bucketSize(levelIdx);
+        }
+        else
+        {
+            rawIndexes.append(pos);
+            pos++;
+        }
+    }
+}
+
+/*!
+ * Append indexes of minimum, maximum and first gap of a bucket in increasing order
+ */
+void EnvelopePyramid::appendBucketIndexes(const Summary &summary, QVector<qint64> &indexes)
+{
+    qint64 bucketIndexes[3];
+    qint32 count = 0;
+
+    if (summary.count > 0)
+    {
+        bucketIndexes[count++] = summary.minIdx;
+        if (summary.maxIdx != summary.minIdx)
+        {
+            bucketIndexes[count++] = summary.maxIdx;
+        }
+    }
+
+    if (summary.gapIdx >= 0)
+    {
+        bucketIndexes[count++] = summary.gapIdx;
+    }
+
+    std::sort(bucketIndexes, bucketIndexes + count);
+
+    for (qint32 idx = 0; idx < count; idx++)
+    {
+        indexes.append(bucketIndexes[idx]);
+    }
+}
+
+qint64 EnvelopePyramid::bucketSize(qint32 level)
+{
+    return static_cast<qint64>(1) << (cBaseShift + level);
+}
+
+void EnvelopePyramid::initSummary(Summary &summary)
+{
+    summary.minIdx = -1;
+    summary.maxIdx = -1;
+    summary.min = 0;
+    summary.max = 0;
+    summary.count = 0;
+    summary.mean = 0;
+    summary.m2 = 0;
+    summary.area = 0;
+    summary.gapIdx = -1;
+}
+
+/*!
+ * Add single sample to summary
+ */
+void EnvelopePyramid::addSample(Summary &summary, qint64 idx, double value, double area)
+{
+    Summary sample;
+
+    sample.minIdx = idx;
+    sample.maxIdx = idx;
+    sample.min = value;
+    sample.max = value;
+    sample.count = 1;
+    sample.mean = value;
+    sample.m2 = 0;
+    sample.area = area;
+    sample.gapIdx = -1;
+
+    merge(summary, sample);
+}
+
+/*!
+ * Merge two summaries
+ * Variance is combined with the parallel algorithm of Chan et al., which stays accurate
+ * for large offsets.
+ */
+void EnvelopePyramid::merge(Summary &summary, const Summary &other)
+{
+    qint64 gapIdx = summary.gapIdx;
+    if (
+        (other.gapIdx >= 0)
+        && ((gapIdx < 0) || (other.gapIdx < gapIdx))
+        )
+    {
+        gapIdx = other.gapIdx;
+    }
+
+    if (other.count == 0)
+    {
+        /* Nothing to add */
+    }
+    else if (summary.count == 0)
+    {
+        summary = other;
+    }
+    else
+    {
+        /* NaN never wins over a real value */
+        if (
+            (other.min < summary.min)
+            || qIsNaN(summary.min)
+            )
+        {
+            summary.min = other.min;
+            summary.minIdx = other.minIdx;
+        }
+
+        if (
+            (other.max > summary.max)
+            || qIsNaN(summary.max)
+            )
+        {
+            summary.max = other.max;
+            summary.maxIdx = other.maxIdx;
+        }
+
+        const qint64 count = summary.count + other.count;
+        const double delta = other.mean - summary.mean;
+
+        summary.mean += delta * static_cast<double>(other.count) / static_cast<double>(count);
+        summary.m2 += other.m2 + delta * delta * static_cast<double>(summary.count) * static_cast<double>(other.count) / static_cast<double>(count);
+        summary.count = count;
+        summary.area += other.area;
+    }
+
+    summary.gapIdx = gapIdx;
+}
+
+/*!
+ * Add summary of single sample to all levels
+ */
+void EnvelopePyramid::appendSummary(const Summary &sample)
+{
+    const qint64 idx = _endIdx;
+    _endIdx++;
+
+    for (qint32 levelIdx = 0; levelIdx < cLevelCount; levelIdx++)
+    {
+        Level &level = _levels[levelIdx];
+        const qint64 bucketIdx = idx >> (cBaseShift + levelIdx);
+
+        if (level.buckets.empty())
+        {
+            level.firstBucket = bucketIdx;
+        }
+
+        if (bucketIdx != level.firstBucket + static_cast<qint64>(level.buckets.size()) - 1)
+        {
+            Summary newBucket;
+            initSummary(newBucket);
+            level.buckets.push_back(newBucket);
+        }
+
+        merge(level.buckets.back(), sample);
+    }
+}
+
+/*!
+ * Return largest level (up to maxLevel) with a bucket starting at pos that ends before end
+ * \return Level index, -1 when no bucket fits
+ */
+qint32 EnvelopePyramid::coveringLevel(qint64 pos, qint64 end, qint32 maxLevel) const
+{
+    qint32 levelIdx = maxLevel;
+    while (levelIdx >= 0)
+    {
+        const qint64 size = bucketSize(levelIdx);
+        if (
+            (pos % size == 0)
+            && (pos + size <= end)
+            )
+        {
+            break;
+        }
+        levelIdx--;
+    }
+
+    return levelIdx;
+}
+
+const EnvelopePyramid::Summary& EnvelopePyramid::bucket(qint32 levelIdx, qint64 pos) const
+{
+    const Level &level = _levels[levelIdx];
+    return level.buckets[static_cast<std::size_t>((pos >> (cBaseShift + levelIdx)) - level.firstBucket)];
+}
@@ -0,0 +1,81 @@
+#ifndef ENVELOPEPYRAMID_H
+#define ENVELOPEPYRAMID_H
+
+#include <QVector>
+#include <deque>
+#include <vector>
+
+/*!
+ * Multi-resolution summary of a growing series of samples
+ * Level n combines buckets of (16 << n) samples. The levels are updated incrementally
+ * when a sample is appended and old samples can be dropped from the front.
+ */
+class EnvelopePyramid
+{
+public:
+
+    typedef struct
+    {
+        qint64 minIdx;
+        qint64 maxIdx;
+        double min;
+        double max;
+
+        qint64 count;
+        double mean;
+        double m2; /* Sum of squared differences from mean */
+        double area;
+
+        qint64 gapIdx; /* First sample without value, -1 when there is none */
+    } Summary;
+
+    EnvelopePyramid();
+
+    void clear();
+    void append(double value);
+    void appendGap();
+    void appendAbsent();
+    void addArea(qint64 idx, double area);
+    void removeFront(qint64 count);
+
+    qint64 firstIndex() const;
+    qint64 endIndex() const;
+
+    qint32 levelFor(qint64 sampleCount, qint64 maxBuckets) const;
+    void envelope(qint64 begin, qint64 end, qint32 level, QVector<qint64> &indexes) const;
+    void summary(qint64 begin, qint64 end, Summary &result, QVector<qint64> &rawIndexes) const;
+
+    static qint64 bucketSize(qint32 level);
+
+    static void initSummary(Summary &summary);
+    static void addSample(Summary &summary, qint64 idx, double value, double area);
+    static void merge(Summary &summary, const Summary &other);
+
+    static const qint32 cLevelCount = 18;
+
+private:
+
+    typedef struct
+    {
+        /* Bucket number of first entry */
+        qint64 firstBucket;
+        std::deque<Summary> buckets;
+    } Level;
+
+    void appendSummary(const Summary &sample);
+    static void appendBucketIndexes(const Summary &summary, QVector<qint64> &indexes);
+    qint32 coveringLevel(qint64 pos, qint64 end, qint32 maxLevel) const;
+    const Summary& bucket(qint32 levelIdx, qint64 pos) const;
+
+    static const qint32 cBaseShift = 4;
+
+    std::vector<Level> _levels;
+
+    /* Index of oldest sample that wasn't removed */
+    qint64 _firstIdx;
+
+    /* Index of next sample */
+    qint64 _endIdx;
+};
+
+#endif // ENVELOPEPYRAMID_H
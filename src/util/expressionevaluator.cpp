@@ -0,0 +1,138 @@
+#include "expressionevaluator.h"
+
+ExpressionEvaluator::ExpressionEvaluator()
+{
+
+}
+
+/*!
+ * Parse and compile expressions
+ * Expressions are compiled once, evaluation loads the registers directly from a shared register array
+ * \param expressionList    Processed expressions (registers referenced with r(idx))
+ */
+void ExpressionEvaluator::setExpressions(QStringList expressionList)
+{
+    _parsers.clear();
+    _expressionRegisters.clear();
+    _invalidInputList.clear();
+
+    quint32 registerCount = 0;
+    for (const QString &expr: qAsConst(expressionList))
+    {
+        _parsers.append(QMuParser(expr));
+        _expressionRegisters.append(_parsers.last().registers());
+        _invalidInputList.append(false);
+
+        for (quint32 regIdx: qAsConst(_expressionRegisters.last()))
+        {
+            registerCount = qMax(registerCount, regIdx + 1);
+        }
+    }
+
+    /* Size is fixed after binding: parsers keep pointers in the array */
+    _registerValues.assign(registerCount, 0);
+    _registerValidMask.assign(registerCount, false);
+
+    for (qint32 exprIdx = 0; exprIdx < _parsers.size(); exprIdx++)
+    {
+        if (!_parsers[exprIdx].bindRegisterValues(_registerValues.data(), registerCount))
+        {
+            /* Evaluate once to get error message, expression will never be valid */
+            _parsers[exprIdx].evaluate();
+        }
+    }
+}
+
+qint32 ExpressionEvaluator::count() const
+{
+    return static_cast<qint32>(_parsers.size());
+}
+
+/*!
+ * Evaluate all expressions in a single pass
+ * Expressions with an invalid input register aren't evaluated, but return an error
+ * \param registerResults   Register values (index corresponds with r(idx))
+ * \param results           Receives the result of every expression
+ */
+void ExpressionEvaluator::evaluate(const ResultDoubleList &registerResults, ResultDoubleList &results)
+{
+    const quint32 copyCount = qMin(static_cast<quint32>(_registerValues.size()), static_cast<quint32>(registerResults.size()));
+
+    for (quint32 regIdx = 0; regIdx < copyCount; regIdx++)
+    {
+        _registerValues[regIdx] = registerResults[regIdx].value();
+        _registerValidMask[regIdx] = registerResults[regIdx].isValid();
+    }
+
+    for (quint32 regIdx = copyCount; regIdx < _registerValues.size(); regIdx++)
+    {
+        _registerValues[regIdx] = 0;
+        _registerValidMask[regIdx] = false;
+    }
+
+    results.clear();
+    results.reserve(_parsers.size());
+
+    for (qint32 exprIdx = 0; exprIdx < _parsers.size(); exprIdx++)
+    {
+        ResultDouble result;
+
+        _invalidInputList[exprIdx] = !inputValid(exprIdx);
+
+        if (
+            _parsers[exprIdx].isBound()
+            && !_invalidInputList[exprIdx]
+            && _parsers[exprIdx].evaluate()
+        )
+        {
+            result.setValue(_parsers[exprIdx].value());
+        }
+        else
+        {
+            result.setError();
+        }
+
+        results.append(result);
+    }
+}
+
+/*!
+ * Return message of last evaluation of expression
+ */
+QString ExpressionEvaluator::msg(qint32 exprIdx) const
+{
+    if (exprIdx >= _parsers.size())
+    {
+        return QString();
+    }
+
+    if (_parsers[exprIdx].isBound() && _invalidInputList[exprIdx])
+    {
+        return QStringLiteral("Invalid data error");
+    }
+
+    return _parsers[exprIdx].msg();
+}
+
+qint32 ExpressionEvaluator::errorPos(qint32 exprIdx) const
+{
+    if (exprIdx >= _parsers.size())
+    {
+        return -1;
+    }
+
+    return _parsers[exprIdx].errorPos();
+}
+
+bool ExpressionEvaluator::inputValid(qint32 exprIdx) const
+{
+    for (quint32 regIdx: _expressionRegisters[exprIdx])
+    {
+        if (!_registerValidMask[regIdx])
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
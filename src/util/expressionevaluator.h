@@ -0,0 +1,37 @@
+#ifndef EXPRESSIONEVALUATOR_H
+#define EXPRESSIONEVALUATOR_H
+
+#include <QStringList>
+#include <vector>
+
+#include "qmuparser.h"
+#include "result.h"
+
+class ExpressionEvaluator
+{
+public:
+    ExpressionEvaluator();
+
+    void setExpressions(QStringList expressionList);
+    qint32 count() const;
+
+    void evaluate(const ResultDoubleList &registerResults, ResultDoubleList &results);
+
+    QString msg(qint32 exprIdx) const;
+    qint32 errorPos(qint32 exprIdx) const;
+
+private:
+    Q_DISABLE_COPY(ExpressionEvaluator)
+
+    bool inputValid(qint32 exprIdx) const;
+
+    QList<QMuParser> _parsers;
+    QList<QList<quint32> > _expressionRegisters;
+    QList<bool> _invalidInputList;
+
+    /* Contiguous register array with validity mask, parsers load directly from this array */
+    std::vector<double> _registerValues;
+    std::vector<bool> _registerValidMask;
+};
+
+#endif // EXPRESSIONEVALUATOR_H
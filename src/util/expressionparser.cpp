@@ -26,13 +26,23 @@ void ExpressionParser::processedExpressions(QStringList& expressionList)
     expressionList = _processedExpressions;
 }
 
+/*!
+ * Return indexes (in modbus register list) of the registers used by each expression
+ */
+void ExpressionParser::expressionRegisters(QList<QList<quint32> >& registerIndexList)
+{
+    registerIndexList = _expressionRegisters;
+}
+
 void ExpressionParser::parseExpressions(QStringList& expressions)
 {
     _processedExpressions.clear();
     _modbusRegisters.clear();
+    _expressionRegisters.clear();
 
     for(QString expression: qAsConst(expressions))
     {
+        _expressionRegisters.append(QList<quint32>());
         _processedExpressions.append(processExpression(expression));
     }
 }
@@ -111,6 +121,11 @@ QString ExpressionParser::constructInternalRegisterFunction(ModbusRegister const
         idx = _modbusRegisters.size() - 1;
     }
 
+    if (!_expressionRegisters.last().contains(idx))
+    {
+        _expressionRegisters.last().append(idx);
+    }
+
     /* Add dummy whitespaces to make sure positions in internal representations match visible expressions */
     QString regIdx = QString("%1").arg(idx);
     const int spacesCount = size - 3 - regIdx.size(); /* ignore ${} and idx string length */
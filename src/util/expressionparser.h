@@ -13,6 +13,7 @@ public:
 
     void modbusRegisters(QList<ModbusRegister>& registerList);
     void processedExpressions(QStringList& expressionList);
+    void expressionRegisters(QList<QList<quint32> >& registerIndexList);
 
 private:
 
@@ -28,6 +29,7 @@ private:
 
     QStringList _processedExpressions;
     QList<ModbusRegister> _modbusRegisters;
+    QList<QList<quint32> > _expressionRegisters;
 
     QRegularExpression _findRegRegex;
     QRegularExpression _regParseRegex;
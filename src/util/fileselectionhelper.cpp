@@ -99,6 +99,17 @@ void FileSelectionHelper::configureFileType(QFileDialog* pDialog, FileType fileT
         pDialog->setNameFilter(tr("LOG files (*.log)"));
         break;
 
+    case FILE_TYPE_DATA:
+        pDialog->setDefaultSuffix("csv");
+        pDialog->setWindowTitle(tr("Select data file"));
+        pDialog->setNameFilters(QStringList() << tr("CSV files (*.csv)") << tr("Binary data files (*.mbsd)"));
+
+        /* Default suffix follows selected format */
+        connect(pDialog, &QFileDialog::filterSelected, pDialog, [pDialog](const QString &filter) {
+            pDialog->setDefaultSuffix(filter.contains("*.mbsd") ? "mbsd" : "csv");
+        });
+        break;
+
     case FILE_TYPE_NONE:
         break;
 
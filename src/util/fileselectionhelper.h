@@ -24,6 +24,7 @@ public:
         FILE_TYPE_MBC,
         FILE_TYPE_MBS,
         FILE_TYPE_LOG,
+        FILE_TYPE_DATA,
         FILE_TYPE_NONE,
     } FileType;
 
@@ -0,0 +1,236 @@
+
+#include <algorithm> // std::upper_bound
+
+#include "modbusresultmap.h"
+
+using State = ResultState::State;
+
+ModbusResultMap::ModbusResultMap()
+{
+
+}
+
+void ModbusResultMap::clear()
+{
+    _blocks.clear();
+    _values.clear();
+    _validity.clear();
+}
+
+/*!
+ * Reserve storage, so a complete read doesn't need to reallocate
+ * \param registerCount     Expected number of registers
+ */
+void ModbusResultMap::reserve(qint32 registerCount)
+{
+    _values.reserve(registerCount);
+    _validity.reserve((registerCount + 63) / 64);
+}
+
+/*!
+ * Add valid results of consecutive registers
+ * The registers shouldn't have a result yet.
+ * \param address       Address of first register
+ * \param pValues       Register values
+ * \param count         Number of registers
+ * \param timestamp     Arrival time of values (SampleClock)
+ */
+void ModbusResultMap::addValues(ModbusAddress address, const quint16* pValues, qint32 count, qint64 timestamp)
+{
+    const qint32 offset = addBlock(address, count, timestamp);
+
+    for (qint32 idx = 0; idx < count; idx++)
+    {
+        _values[offset + idx] = pValues[idx];
+        setValid(offset + idx, true);
+    }
+}
+
+/*!
+ * Add invalid results of consecutive registers
+ * The registers shouldn't have a result yet.
+ * \param address       Address of first register
+ * \param count         Number of registers
+ */
+void ModbusResultMap::addErrors(ModbusAddress address, qint32 count)
+{
+    /* New values are 0 and invalid */
+    addBlock(address, count, 0);
+}
+
+/*!
+ * Set result of single register, existing result is replaced
+ * The timestamp of an existing result is kept, it is shared with the other registers of the block.
+ */
+void ModbusResultMap::insert(ModbusAddress address, const Result<quint16>& result)
+{
+    qint32 pos;
+
+    const qint32 blockIdx = findBlock(address);
+    if (blockIdx != -1)
+    {
+        const Block& block = _blocks[blockIdx];
+        pos = block.offset + static_cast<qint32>(address.address(ModbusAddress::Offset::WITHOUT_OFFSET) - block.address.address(ModbusAddress::Offset::WITHOUT_OFFSET));
+    }
+    else
+    {
+        pos = addBlock(address, 1, result.timestamp());
+    }
+
+    _values[pos] = result.value();
+    setValid(pos, result.isValid());
+}
+
+/*!
+ * Number of registers with a result
+ */
+qsizetype ModbusResultMap::size() const
+{
+    return _values.size();
+}
+
+bool ModbusResultMap::isEmpty() const
+{
+    return _values.isEmpty();
+}
+
+bool ModbusResultMap::contains(ModbusAddress address) const
+{
+    return findBlock(address) != -1;
+}
+
+/*!
+ * Get result of register
+ * \return Result of register, result without value when register isn't in map
+ */
+Result<quint16> ModbusResultMap::value(ModbusAddress address) const
+{
+    const qint32 blockIdx = findBlock(address);
+    if (blockIdx == -1)
+    {
+        return Result<quint16>();
+    }
+
+    const Block& block = _blocks[blockIdx];
+    const qint32 idx = static_cast<qint32>(address.address(ModbusAddress::Offset::WITHOUT_OFFSET) - block.address.address(ModbusAddress::Offset::WITHOUT_OFFSET));
+
+    auto result = Result<quint16>(blockValue(block, idx), isBlockValueValid(block, idx) ? State::SUCCESS : State::INVALID);
+    result.setTimestamp(block.timestamp);
+
+    return result;
+}
+
+Result<quint16> ModbusResultMap::operator[](ModbusAddress address) const
+{
+    return value(address);
+}
+
+/*!
+ * Blocks of consecutive registers, sorted on address
+ */
+const QList<ModbusResultMap::Block>& ModbusResultMap::blocks() const
+{
+    return _blocks;
+}
+
+quint16 ModbusResultMap::blockValue(const Block& block, qint32 idx) const
+{
+    return _values[block.offset + idx];
+}
+
+bool ModbusResultMap::isBlockValueValid(const Block& block, qint32 idx) const
+{
+    return isValid(block.offset + idx);
+}
+
+/*!
+ * Find block that contains register
+ * \retval -1       Not found
+ * \retval != -1    Index of block
+ */
+qint32 ModbusResultMap::findBlock(ModbusAddress address) const
+{
+    auto it = std::upper_bound(_blocks.constBegin(), _blocks.constEnd(), address,
+                               [](const ModbusAddress& addr, const Block& block) { return addr < block.address; });
+
+    if (it == _blocks.constBegin())
+    {
+        return -1;
+    }
+
+    it--;
+
+    if (
+        (it->address.objectType() == address.objectType())
+        && (address.address(ModbusAddress::Offset::WITHOUT_OFFSET) - it->address.address(ModbusAddress::Offset::WITHOUT_OFFSET) < static_cast<quint32>(it->count))
+    )
+    {
+        return static_cast<qint32>(it - _blocks.constBegin());
+    }
+
+    return -1;
+}
+
+/*!
+ * Add storage for consecutive registers, values are 0 and invalid
+ * The registers are appended to the previous block when they follow it directly.
+ * \return Position of first register in value array
+ */
+qint32 ModbusResultMap::addBlock(ModbusAddress address, qint32 count, qint64 timestamp)
+{
+    const qint32 offset = static_cast<qint32>(_values.size());
+
+    _values.resize(offset + count);
+    _validity.resize((_values.size() + 63) / 64);
+    for (qint32 pos = offset; pos < offset + count; pos++)
+    {
+        setValid(pos, false);
+    }
+
+    auto it = std::upper_bound(_blocks.begin(), _blocks.end(), address,
+                               [](const ModbusAddress& addr, const Block& block) { return addr < block.address; });
+
+    if (it != _blocks.begin())
+    {
+        Block& previous = *(it - 1);
+
+        if (
+            (previous.address.next(previous.count) == address)
+            && (previous.offset + previous.count == offset)
+            && (previous.timestamp == timestamp)
+        )
+        {
+            previous.count += count;
+            return offset;
+        }
+    }
+
+    Block block;
+    block.address = address;
+    block.offset = offset;
+    block.count = count;
+    block.timestamp = timestamp;
+
+    _blocks.insert(it, block);
+
+    return offset;
+}
+
+void ModbusResultMap::setValid(qint32 pos, bool bValid)
+{
+    const quint64 mask = static_cast<quint64>(1) << (pos % 64);
+
+    if (bValid)
+    {
+        _validity[pos / 64] |= mask;
+    }
+    else
+    {
+        _validity[pos / 64] &= ~mask;
+    }
+}
+
+bool ModbusResultMap::isValid(qint32 pos) const
+{
+    return (_validity[pos / 64] >> (pos % 64)) & 1u;
+}
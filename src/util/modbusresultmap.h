@@ -3,8 +3,58 @@
 
 #include "result.h"
 #include "modbusaddress.h"
-#include <QMap>
+#include <QList>
+#include <QVector>
+#include <QMetaType>
 
-using ModbusResultMap = QMap<ModbusAddress, Result<quint16>>;
+/*!
+ * Register results of a read, stored as dense blocks
+ * Every block holds the results of consecutive registers (e.g. a single read request). The values of
+ * all blocks are in one contiguous array with a validity bitset, the blocks are sorted on address.
+ * All storage is implicitly shared, so passing the results through signals doesn't copy them.
+ */
+class ModbusResultMap
+{
+public:
+
+    typedef struct
+    {
+        ModbusAddress address; /* Address of first register */
+        qint32 offset;         /* Position of first value in value array */
+        qint32 count;
+        qint64 timestamp;
+    } Block;
+
+    ModbusResultMap();
+
+    void clear();
+    void reserve(qint32 registerCount);
+
+    void addValues(ModbusAddress address, const quint16* pValues, qint32 count, qint64 timestamp = 0);
+    void addErrors(ModbusAddress address, qint32 count);
+    void insert(ModbusAddress address, const Result<quint16>& result);
+
+    qsizetype size() const;
+    bool isEmpty() const;
+    bool contains(ModbusAddress address) const;
+    Result<quint16> value(ModbusAddress address) const;
+    Result<quint16> operator[](ModbusAddress address) const;
+
+    const QList<Block>& blocks() const;
+    quint16 blockValue(const Block& block, qint32 idx) const;
+    bool isBlockValueValid(const Block& block, qint32 idx) const;
+
+private:
+    qint32 findBlock(ModbusAddress address) const;
+    qint32 addBlock(ModbusAddress address, qint32 count, qint64 timestamp);
+    void setValid(qint32 pos, bool bValid);
+    bool isValid(qint32 pos) const;
+
+    QList<Block> _blocks;
+    QVector<quint16> _values;
+    QVector<quint64> _validity; /* One bit per value, same positions as values */
+};
+
+Q_DECLARE_METATYPE(ModbusResultMap)
 
 #endif // MODBUSRESULTMAP_H
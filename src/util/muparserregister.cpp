@@ -47,7 +47,6 @@ using namespace std;
 namespace mu
 {
 
-    ParserRegister::registerCb_t ParserRegister::_registerCb;
 
     value_type ParserRegister::Shr(value_type v1, value_type v2) { return ConvertToInteger(v1) >> ConvertToInteger(v2); }
     value_type ParserRegister::Shl(value_type v1, value_type v2) { return ConvertToInteger(v1) << ConvertToInteger(v2); }
@@ -55,16 +54,18 @@ namespace mu
     value_type ParserRegister::LogOr(value_type v1, value_type v2) { return ConvertToInteger(v1) | ConvertToInteger(v2); }
     value_type ParserRegister::Mod(value_type v1, value_type v2) { return ConvertToInteger(v1) % ConvertToInteger(v2); }
 
-    value_type ParserRegister::RegVal(value_type v1)
+    value_type ParserRegister::RegVal(void* pUserData, value_type v1)
     {
+        const ParserRegister* pParser = static_cast<const ParserRegister*>(pUserData);
+
         double intpart;
         if (modf(v1, &intpart) == 0.0)
         {
             double value = 0;
             bool success = false;
-            if (_registerCb)
+            if (pParser->_registerCb)
             {
-                (*_registerCb)(v1, &value, &success);
+                (*pParser->_registerCb)(pParser->_pRegisterContext, v1, &value, &success);
             }
 
             if (success)
@@ -168,7 +169,7 @@ namespace mu
 	  Call ParserBase class constructor and trigger Function, Operator and Constant initialization.
 	*/
     ParserRegister::ParserRegister()
-		:ParserBase()
+		:ParserBase(), _registerCb(nullptr), _pRegisterContext(nullptr)
 	{
         AddValIdent(IsVal);    // lowest priority
         AddValIdent(IsBinVal);
@@ -181,14 +182,16 @@ namespace mu
 	}
 
     ParserRegister::ParserRegister(const ParserRegister& a_Parser)
-        :ParserBase(a_Parser)
+        :ParserBase(a_Parser), _registerCb(a_Parser._registerCb), _pRegisterContext(a_Parser._pRegisterContext)
     {
-
+        /* Register function refers to parser instance, so rebind it to the copy */
+        InitFun();
     }
 
-    void ParserRegister::setRegisterCallback(registerCb_t registerCb)
+    void ParserRegister::setRegisterCallback(registerCb_t registerCb, void* pContext)
     {
         _registerCb = registerCb;
+        _pRegisterContext = pContext;
     }
 
 	//---------------------------------------------------------------------------
@@ -209,7 +212,7 @@ namespace mu
 	/** \brief Initialize the default functions. */
 	void ParserRegister::InitFun()
 	{
-        DefineFun(_T("r"), RegVal, false);
+        DefineFunUserData(_T("r"), RegVal, this, false);
 	}
 
 	//---------------------------------------------------------------------------
@@ -49,9 +49,9 @@ namespace mu
         ParserRegister();
         ParserRegister(const ParserRegister& a_Parser);
 
-        typedef void (*registerCb_t)(int, double*, bool*);
+        typedef void (*registerCb_t)(void*, int, double*, bool*);
 
-        static void setRegisterCallback(registerCb_t registerCb);
+        void setRegisterCallback(registerCb_t registerCb, void* pContext);
 
         virtual void InitCharSets();
         virtual void InitFun();
@@ -68,13 +68,15 @@ namespace mu
         static value_type LogOr(value_type v1, value_type v2);
         static value_type Not(value_type v1);
         static value_type Mod(value_type v1, value_type v2);
-        static value_type RegVal(value_type v1);
+        static value_type RegVal(void* pUserData, value_type v1);
 
         static int IsVal(const char_type* a_szExpr, int* a_iPos, value_type* a_fVal);
         static int IsHexVal(const char_type* a_szExpr, int* a_iPos, value_type* a_iVal);
         static int IsBinVal(const char_type* a_szExpr, int* a_iPos, value_type* a_fVal);
 
-        static registerCb_t _registerCb;
+        /* Register lookup is per parser instance, so parsers can be evaluated concurrently */
+        registerCb_t _registerCb;
+        void* _pRegisterContext;
 
 	};
 } // namespace mu
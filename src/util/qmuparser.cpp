@@ -1,30 +1,56 @@
 
+#include <QRegularExpression>
+
 #include "qmuparser.h"
 #include "muparserregister.h"
 
 #include "muParser.h"
 
-ResultDoubleList QMuParser::_registerValues;
-
 QMuParser::QMuParser(QString strExpression)
 {
-    mu::ParserRegister::setRegisterCallback(&QMuParser::registerValue);
     _pExprParser = new mu::ParserRegister();
+    _pExprParser->setRegisterCallback(&QMuParser::registerValue, this);
 
     _errorPos = -1;
+    _bBound = false;
 
     setExpression(strExpression);
 }
 
 QMuParser::QMuParser(const QMuParser &source)
-    : _pExprParser(new mu::ParserRegister(*source._pExprParser)),
+    : _registerValues(source._registerValues),
+    _pExprParser(new mu::ParserRegister(*source._pExprParser)),
+    _strExpression(source._strExpression),
     _bInvalidExpression(source._bInvalidExpression),
+    _bBound(source._bBound),
     _bSuccess(source._bSuccess),
     _value(source._value),
     _msg(source._msg),
     _errorPos(source._errorPos)
 {
+    /* Register callback context is this instance, not the source */
+    _pExprParser->setRegisterCallback(&QMuParser::registerValue, this);
+}
+
+QMuParser& QMuParser::operator= (const QMuParser &source)
+{
+    if (this != &source)
+    {
+        delete _pExprParser;
+        _pExprParser = new mu::ParserRegister(*source._pExprParser);
+        _pExprParser->setRegisterCallback(&QMuParser::registerValue, this);
+
+        _strExpression = source._strExpression;
+        _bInvalidExpression = source._bInvalidExpression;
+        _bBound = source._bBound;
+        _bSuccess = source._bSuccess;
+        _value = source._value;
+        _msg = source._msg;
+        _errorPos = source._errorPos;
+        _registerValues = source._registerValues;
+    }
 
+    return *this;
 }
 
 QMuParser::~QMuParser()
@@ -34,6 +60,9 @@ QMuParser::~QMuParser()
 
 void QMuParser::setExpression(QString expr)
 {
+    _strExpression = expr;
+    _bBound = false;
+
     /* Fixed by design */
     _pExprParser->SetArgSep(static_cast<mu::char_type>(';'));
 
@@ -77,11 +106,114 @@ void QMuParser::setExpression(QString expr)
     reset();
 }
 
-void QMuParser::setRegistersData(ResultDoubleList& regValues)
+void QMuParser::setRegistersData(const ResultDoubleList& regValues)
 {
     _registerValues = regValues;
 }
 
+/*!
+ * Compile register references to direct loads from a register array
+ * Every r(idx) in the expression is replaced by a variable that points to pRegisterValues[idx],
+ * so evaluation doesn't need the register callback. Validity of the registers isn't checked
+ * during evaluation, the caller has to check this before evaluating.
+ * \param pRegisterValues  Register array, must stay valid as long as the parser is used
+ * \param registerCount    Number of registers in array
+ * \retval true    Expression is compiled and bound to register array
+ * \retval false   Expression is invalid or refers to register outside of array
+ */
+bool QMuParser::bindRegisterValues(double* pRegisterValues, quint32 registerCount)
+{
+    _bBound = false;
+
+    if (_bInvalidExpression || (_errorPos != -1))
+    {
+        return false;
+    }
+
+    static const QRegularExpression registerRegex(R"(r\((\d+)\s*\))");
+
+    QString boundExpression = _strExpression;
+    QRegularExpressionMatchIterator matchIt = registerRegex.globalMatch(_strExpression);
+
+    _pExprParser->ClearVar();
+
+    while (matchIt.hasNext())
+    {
+        const QRegularExpressionMatch match = matchIt.next();
+        const quint32 regIdx = match.captured(1).toUInt();
+
+        if (regIdx >= registerCount)
+        {
+            _pExprParser->ClearVar();
+            _pExprParser->SetExpr(_strExpression.toStdWString());
+            return false;
+        }
+
+        /* Keep length equal, so error positions still match the expression */
+        const QString varName = QString("r_%1").arg(regIdx);
+        boundExpression.replace(match.capturedStart(), match.capturedLength(), varName.leftJustified(match.capturedLength(), ' '));
+
+        _pExprParser->DefineVar(varName.toStdWString(), &pRegisterValues[regIdx]);
+    }
+
+    try
+    {
+        _pExprParser->SetExpr(boundExpression.toStdWString());
+
+        /* Compile without evaluating, unknown identifiers are reported as used variables */
+        const mu::varmap_type& usedVars = _pExprParser->GetUsedVar();
+        const mu::varmap_type& definedVars = _pExprParser->GetVar();
+
+        _bBound = true;
+        for (const auto &usedVar: usedVars)
+        {
+            if (definedVars.find(usedVar.first) == definedVars.end())
+            {
+                _bBound = false;
+            }
+        }
+    }
+    catch (mu::Parser::exception_type &)
+    {
+        _bBound = false;
+    }
+
+    if (!_bBound)
+    {
+        /* Restore original expression, so evaluation reports the original error */
+        _pExprParser->ClearVar();
+        _pExprParser->SetExpr(_strExpression.toStdWString());
+    }
+
+    return _bBound;
+}
+
+bool QMuParser::isBound() const
+{
+    return _bBound;
+}
+
+/*!
+ * Return register indexes that are used in the expression (without duplicates)
+ */
+QList<quint32> QMuParser::registers() const
+{
+    static const QRegularExpression registerRegex(R"(r\((\d+)\s*\))");
+
+    QList<quint32> registerList;
+    QRegularExpressionMatchIterator matchIt = registerRegex.globalMatch(_strExpression);
+    while (matchIt.hasNext())
+    {
+        const quint32 regIdx = matchIt.next().captured(1).toUInt();
+        if (!registerList.contains(regIdx))
+        {
+            registerList.append(regIdx);
+        }
+    }
+
+    return registerList;
+}
+
 QString QMuParser::expression()
 {
     return QString::fromStdWString(_pExprParser->GetExpr()).trimmed();
@@ -169,12 +301,14 @@ void QMuParser::reset()
     _msg = QStringLiteral("No result yet");
 }
 
-void QMuParser::registerValue(int index, double* value, bool* success)
+void QMuParser::registerValue(void* pContext, int index, double* value, bool* success)
 {
-    if (index < _registerValues.size())
+    const QMuParser* pParser = static_cast<const QMuParser*>(pContext);
+
+    if ((index >= 0) && (index < pParser->_registerValues.size()))
     {
-        *value = _registerValues[index].value();
-        *success = _registerValues[index].isValid();
+        *value = pParser->_registerValues[index].value();
+        *success = pParser->_registerValues[index].isValid();
     }
     else
     {
@@ -13,10 +13,16 @@ public:
     QMuParser(const QMuParser &source);
     ~QMuParser();
 
+    QMuParser& operator= (const QMuParser &source);
+
     void setExpression(QString expr);
     QString expression();
 
-    static void setRegistersData(ResultDoubleList &regValues);
+    void setRegistersData(const ResultDoubleList &regValues);
+
+    bool bindRegisterValues(double* pRegisterValues, quint32 registerCount);
+    bool isBound() const;
+    QList<quint32> registers() const;
 
     bool evaluate();
 
@@ -29,13 +35,16 @@ private:
 
     void reset();
 
-    static void registerValue(int index, double *value, bool* success);
+    static void registerValue(void* pContext, int index, double *value, bool* success);
 
-    static ResultDoubleList _registerValues;
+    /* Evaluation context of r(idx) callback (not used when bound to register array) */
+    ResultDoubleList _registerValues;
 
     mu::ParserRegister* _pExprParser;
 
+    QString _strExpression;
     bool _bInvalidExpression;
+    bool _bBound;
 
     bool _bSuccess;
     double _value;
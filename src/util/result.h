@@ -33,6 +33,9 @@ public:
     ResultState::State state() const;
     void setState(ResultState::State state);
 
+    qint64 timestamp() const;
+    void setTimestamp(qint64 timestamp);
+
     Result<T>& operator= (Result<T> const & result);
 
     friend bool operator== (const Result<T>& res1, const Result<T>& res2)
@@ -54,6 +57,9 @@ private:
 
     T _value;
     ResultState::State _state;
+
+    /* Reply time (SampleClock), not used in comparison */
+    qint64 _timestamp;
 };
 
 /* Implementations need to be in header */
@@ -67,14 +73,14 @@ Result<T>::Result()
 
 template <class T>
 Result<T>::Result(T value, ResultState::State state)
-    : _value(value), _state(state)
+    : _value(value), _state(state), _timestamp(0)
 {
 
 }
 
 template<class T>
 Result<T>::Result(const Result<T>& copy)
-    : _value(copy._value), _state(copy._state)
+    : _value(copy._value), _state(copy._state), _timestamp(copy._timestamp)
 {
 
 }
@@ -117,6 +123,18 @@ void Result<T>::setState(ResultState::State state)
     _state = state;
 }
 
+template <class T>
+qint64 Result<T>::timestamp() const
+{
+    return _timestamp;
+}
+
+template <class T>
+void Result<T>::setTimestamp(qint64 timestamp)
+{
+    _timestamp = timestamp;
+}
+
 template <class T>
 Result<T>& Result<T>::operator= (Result<T> const & result)
 {
@@ -128,6 +146,7 @@ Result<T>& Result<T>::operator= (Result<T> const & result)
 
     _value = result._value;
     _state = result._state;
+    _timestamp = result._timestamp;
 
     // return the existing object so we can chain this operator
     return *this;
@@ -0,0 +1,58 @@
+#include <QDateTime>
+#include <QElapsedTimer>
+
+#include "sampleclock.h"
+
+namespace
+{
+    class ClockReference
+    {
+    public:
+        ClockReference()
+        {
+            _epochStartMsecs = QDateTime::currentMSecsSinceEpoch();
+            _timer.start();
+        }
+
+        qint64 elapsedNsecs() const
+        {
+            return _timer.nsecsElapsed();
+        }
+
+        qint64 epochStartMsecs() const
+        {
+            return _epochStartMsecs;
+        }
+
+    private:
+        QElapsedTimer _timer;
+        qint64 _epochStartMsecs;
+    };
+
+    const ClockReference& clockReference()
+    {
+        /* Thread-safe initialization on first use */
+        static const ClockReference reference;
+        return reference;
+    }
+}
+
+/*!
+ * Return current monotonic timestamp
+ * \return Timestamp in ns (always larger than 0)
+ */
+qint64 SampleClock::timestamp()
+{
+    return qMax<qint64>(1, clockReference().elapsedNsecs());
+}
+
+/*!
+ * Convert timestamp to wall clock time
+ * The wall clock time of the first timestamp is used as reference, so jumps of the system clock don't influence timestamps
+ * \param timestamp     Timestamp in ns
+ * \return Time in ms since epoch (with sub ms resolution)
+ */
+double SampleClock::toEpochMsecs(qint64 timestamp)
+{
+    return static_cast<double>(clockReference().epochStartMsecs()) + static_cast<double>(timestamp) / 1000000.0;
+}
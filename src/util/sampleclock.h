@@ -0,0 +1,17 @@
+#ifndef SAMPLECLOCK_H
+#define SAMPLECLOCK_H
+
+#include <QtGlobal>
+
+/*!
+ * Monotonic high resolution clock for time stamping of samples
+ * Timestamps are in ns and are only meaningful within the same process.
+ * A timestamp of 0 means that no timestamp is available.
+ */
+namespace SampleClock
+{
+    qint64 timestamp();
+    double toEpochMsecs(qint64 timestamp);
+}
+
+#endif // SAMPLECLOCK_H
@@ -1,5 +1,6 @@
 
 #include <QDateTime>
+#include <QThread>
 
 #include "diagnosticmodel.h"
 #include "scopelogging.h"
@@ -10,10 +11,13 @@ Q_LOGGING_CATEGORY(scopeGeneralInfo, "scope.general.info")
 Q_LOGGING_CATEGORY(scopePreset, "scope.preset")
 Q_LOGGING_CATEGORY(scopeUi, "scope.ui")
 
-ScopeLogging::ScopeLogging()
+ScopeLogging::ScopeLogging() :
+    _bEventNotifyPending(false),
+    _minSeverityLevel(Diagnostic::LOG_INFO)
 {
     _pDiagnosticModel = nullptr;
     _logStartTime = 0;
+    _reportedDropCount = 0;
 }
 
 void ScopeLogging::initLogging(DiagnosticModel* pDiagnosticModel)
@@ -42,9 +46,20 @@ void ScopeLogging::initLogging(DiagnosticModel* pDiagnosticModel)
  */
 void ScopeLogging::setMinimumSeverityLevel(Diagnostic::LogSeverity minSeverity)
 {
+    _minSeverityLevel.store(minSeverity, std::memory_order_relaxed);
     _pDiagnosticModel->setMinimumSeverityLevel(minSeverity);
 }
 
+/*!
+ * \brief Check whether logs of a severity are kept
+ * Can be called from any thread, so callers can skip collecting the details of a log.
+ */
+bool ScopeLogging::isEnabled(Diagnostic::LogSeverity severity) const
+{
+    return (_pDiagnosticModel != nullptr)
+            && (severity <= _minSeverityLevel.load(std::memory_order_relaxed));
+}
+
 void ScopeLogging::handleLog(QtMsgType type, const QMessageLogContext &context, const QString &msg)
 {
     Diagnostic::LogSeverity logSeverity;
@@ -68,7 +83,19 @@ void ScopeLogging::handleLog(QtMsgType type, const QMessageLogContext &context,
 
     if (_pDiagnosticModel != nullptr)
     {
-        _pDiagnosticModel->addLog(context.category, logSeverity, offset, msg);
+        if (QThread::currentThread() == _pDiagnosticModel->thread())
+        {
+            _pDiagnosticModel->addLog(context.category, logSeverity, offset, msg);
+        }
+        else
+        {
+            /* Logs from communication thread are added in thread of model */
+            const QString category(context.category);
+            DiagnosticModel* pDiagnosticModel = _pDiagnosticModel;
+            QMetaObject::invokeMethod(pDiagnosticModel, [pDiagnosticModel, category, logSeverity, offset, msg]() {
+                pDiagnosticModel->addLog(category, logSeverity, offset, msg);
+            }, Qt::QueuedConnection);
+        }
     }
 
 #if 0
@@ -78,6 +105,57 @@ void ScopeLogging::handleLog(QtMsgType type, const QMessageLogContext &context,
 #endif
 }
 
+/*!
+ * \brief Record diagnostic event
+ * Must only be called from a single thread (communication thread). The event is only copied
+ * in the event ring, it is added to the model in the thread of the model.
+ * \param event    Diagnostic event, time offset is set on recording
+ */
+void ScopeLogging::logEvent(DiagnosticEvent event)
+{
+    if (!isEnabled(Diagnostic::eventSeverity(event.type())))
+    {
+        return;
+    }
+
+    event.setTimeOffset(static_cast<qint32>(QDateTime::currentMSecsSinceEpoch() - _logStartTime));
+
+    /* A full ring drops the event, it is reported when the ring is emptied */
+    _eventRing.push(event);
+
+    if (!_bEventNotifyPending.exchange(true))
+    {
+        QMetaObject::invokeMethod(_pDiagnosticModel, [this]() {
+            processEvents();
+        }, Qt::QueuedConnection);
+    }
+}
+
+/*!
+ * \brief Move all recorded events to the model
+ * Called in the thread of the model
+ */
+void ScopeLogging::processEvents()
+{
+    /* Re-arm notification before taking, so an event added meanwhile is never missed */
+    _bEventNotifyPending.store(false);
+
+    QList<DiagnosticEvent> eventList;
+    _eventRing.pop(eventList);
+
+    _pDiagnosticModel->addEvents(eventList);
+
+    const quint64 dropCount = _eventRing.droppedCount();
+    if (dropCount != _reportedDropCount)
+    {
+        const qint32 offset = static_cast<qint32>(QDateTime::currentMSecsSinceEpoch() - _logStartTime);
+        _pDiagnosticModel->addLog(DiagnosticEvent::category(), Diagnostic::LOG_WARNING, offset,
+                                  QString("Diagnostic events dropped (total: %1)").arg(dropCount));
+
+        _reportedDropCount = dropCount;
+    }
+}
+
 namespace ModbusScopeLog
 {
     void messageHandler(QtMsgType type, const QMessageLogContext &context, const QString &msg)
@@ -2,7 +2,11 @@
 #define SCOPELOGGING_H
 
 #include <QLoggingCategory>
+#include <atomic>
+
 #include "diagnosticmodel.h"
+#include "diagnosticevent.h"
+#include "diagnosticeventring.h"
 
 Q_DECLARE_LOGGING_CATEGORY(scopeCommConnection)
 Q_DECLARE_LOGGING_CATEGORY(scopeComm)
@@ -19,13 +23,23 @@ public:
 
     void initLogging(DiagnosticModel* pDiagnosticModel);
     void setMinimumSeverityLevel(Diagnostic::LogSeverity minSeverity);
+    bool isEnabled(Diagnostic::LogSeverity severity) const;
 
     void handleLog(QtMsgType type, const QMessageLogContext &context, const QString &msg);
+    void logEvent(DiagnosticEvent event);
 
 private:
+    void processEvents();
+
     qint64 _logStartTime;
 
     DiagnosticModel* _pDiagnosticModel;
+
+    /* Events are added from the communication thread and taken in the thread of the model */
+    DiagnosticEventRing _eventRing;
+    std::atomic<bool> _bEventNotifyPending;
+    std::atomic<Diagnostic::LogSeverity> _minSeverityLevel;
+    quint64 _reportedDropCount;
 };
 
 inline ScopeLogging& ScopeLogging::Logger()
@@ -0,0 +1,201 @@
+#ifndef SPSCRING_H
+#define SPSCRING_H
+
+#include <QtGlobal>
+#include <QtMath>
+#include <atomic>
+#include <vector>
+
+/*!
+ * Fixed capacity ring of slots for one producer and one consumer thread
+ * A slot is a contiguous block of stride() elements, so variable width records are written
+ * and read in one go. The storage is only allocated by reset() and setStride(), pushing and
+ * popping never allocates and never waits on the other thread.
+ *
+ * Producer: pushSlot(), fill slot, commitPush()
+ * Consumer: size(), peek() for each queued slot, commitPop()
+ */
+template <typename T>
+class SpscRing
+{
+public:
+    explicit SpscRing(quint32 capacity = 0, qint32 stride = 1);
+
+    void reset(quint32 capacity, qint32 stride);
+    bool setStride(qint32 stride);
+
+    T* pushSlot();
+    void commitPush();
+
+    const T* peek(quint32 offset) const;
+    void commitPop(quint32 count);
+
+    quint32 size() const;
+    quint32 capacity() const;
+    qint32 stride() const;
+
+private:
+    Q_DISABLE_COPY(SpscRing)
+
+    std::size_t slotOffset(quint64 idx) const;
+
+    /* Only changed by reset, while neither thread accesses the ring */
+    quint32 _capacity;
+    quint32 _mask;
+
+    /* Only changed by producer while ring is empty */
+    qint32 _stride;
+    std::vector<T> _storage;
+
+    /* Free-running indexes, _writeIdx is owned by the producer and _readIdx by the consumer */
+    alignas(64) std::atomic<quint64> _writeIdx;
+    alignas(64) std::atomic<quint64> _readIdx;
+};
+
+/* Implementations need to be in header */
+
+/*!
+ * Constructor
+ * \param capacity      Maximum number of slots, rounded up to a power of two. Ring can't hold any slot when 0.
+ * \param stride        Number of elements per slot
+ */
+template <typename T>
+SpscRing<T>::SpscRing(quint32 capacity, qint32 stride) :
+    _capacity(0),
+    _mask(0),
+    _stride(0),
+    _writeIdx(0),
+    _readIdx(0)
+{
+    reset(capacity, stride);
+}
+
+/*!
+ * Discard all slots and reallocate the storage
+ * Must only be called while neither the producer nor the consumer accesses the ring.
+ * \param capacity      Maximum number of slots, rounded up to a power of two. Ring can't hold any slot when 0.
+ * \param stride        Number of elements per slot
+ */
+template <typename T>
+void SpscRing<T>::reset(quint32 capacity, qint32 stride)
+{
+    _capacity = capacity == 0 ? 0 : qNextPowerOfTwo(qMax(capacity, 2u) - 1);
+    _mask = _capacity == 0 ? 0 : _capacity - 1;
+    _stride = qMax(stride, 0);
+    _storage.assign(static_cast<std::size_t>(_capacity) * static_cast<std::size_t>(_stride), T());
+
+    _writeIdx.store(0);
+    _readIdx.store(0);
+}
+
+/*!
+ * Change number of elements per slot
+ * Must only be called from the producer thread. The consumer doesn't touch the storage of an
+ * empty ring, so the stride can only change when all slots are taken.
+ * \param stride        Number of elements per slot
+ * \return true when stride is changed (or unchanged), false when slots are queued
+ */
+template <typename T>
+bool SpscRing<T>::setStride(qint32 stride)
+{
+    stride = qMax(stride, 0);
+    if (stride == _stride)
+    {
+        return true;
+    }
+
+    if (_writeIdx.load(std::memory_order_relaxed) != _readIdx.load(std::memory_order_acquire))
+    {
+        return false;
+    }
+
+    _stride = stride;
+    _storage.assign(static_cast<std::size_t>(_capacity) * static_cast<std::size_t>(_stride), T());
+
+    return true;
+}
+
+/*!
+ * Return next free slot
+ * Must only be called from the producer thread. The slot is only visible to the consumer after commitPush().
+ * \return Pointer to stride() elements, nullptr when ring is full
+ */
+template <typename T>
+T* SpscRing<T>::pushSlot()
+{
+    const quint64 writeIdx = _writeIdx.load(std::memory_order_relaxed);
+    const quint64 readIdx = _readIdx.load(std::memory_order_acquire);
+
+    if (writeIdx - readIdx >= _capacity)
+    {
+        return nullptr;
+    }
+
+    return _storage.data() + slotOffset(writeIdx);
+}
+
+/*!
+ * Publish slot returned by pushSlot() to the consumer
+ */
+template <typename T>
+void SpscRing<T>::commitPush()
+{
+    _writeIdx.store(_writeIdx.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+/*!
+ * Return queued slot
+ * Must only be called from the consumer thread
+ * \param offset    Index of slot from oldest queued slot, must be lower than size()
+ * \return Pointer to stride() elements
+ */
+template <typename T>
+const T* SpscRing<T>::peek(quint32 offset) const
+{
+    return _storage.data() + slotOffset(_readIdx.load(std::memory_order_relaxed) + offset);
+}
+
+/*!
+ * Release oldest slots to the producer
+ * Must only be called from the consumer thread
+ * \param count     Number of slots, must not be higher than size()
+ */
+template <typename T>
+void SpscRing<T>::commitPop(quint32 count)
+{
+    _readIdx.store(_readIdx.load(std::memory_order_relaxed) + count, std::memory_order_release);
+}
+
+/*!
+ * Return number of queued slots
+ * Can be called from any thread, the result is only a snapshot.
+ */
+template <typename T>
+quint32 SpscRing<T>::size() const
+{
+    const quint64 readIdx = _readIdx.load(std::memory_order_acquire);
+    const quint64 writeIdx = _writeIdx.load(std::memory_order_acquire);
+
+    return static_cast<quint32>(writeIdx - readIdx);
+}
+
+template <typename T>
+quint32 SpscRing<T>::capacity() const
+{
+    return _capacity;
+}
+
+template <typename T>
+qint32 SpscRing<T>::stride() const
+{
+    return _stride;
+}
+
+template <typename T>
+std::size_t SpscRing<T>::slotOffset(quint64 idx) const
+{
+    const std::size_t row = static_cast<std::size_t>(static_cast<quint32>(idx) & _mask);
+    return row * static_cast<std::size_t>(_stride);
+}
+
+#endif // SPSCRING_H
@@ -294,16 +294,16 @@ void TestCommunication::disabledConnection()
 void TestCommunication::doHandleRegisterData(QList<QVariant>& actRawData)
 {
     GraphDataHandler dataHandler;
-    ModbusPoll modbusPoll(_pSettingsModel);
+    ModbusPoll modbusPoll;
     connect(&modbusPoll, &ModbusPoll::registerDataReady, &dataHandler, &GraphDataHandler::handleRegisterData);
 
     QList<ModbusRegister> registerList;
-    dataHandler.processActiveRegisters(_pGraphDataModel);
+    dataHandler.processActiveRegisters(GraphDataHandler::activeGraphs(_pGraphDataModel));
     dataHandler.modbusRegisterList(registerList);
 
     QSignalSpy spyDataReady(&dataHandler, &GraphDataHandler::graphDataReady);
 
-    modbusPoll.startCommunication(registerList);
+    modbusPoll.startCommunication(CommunicationSettings(_pSettingsModel), registerList);
 
     QVERIFY(spyDataReady.wait(static_cast<int>(_pSettingsModel->timeout(Connection::ID_1)) + 100));
     QCOMPARE(spyDataReady.count(), 1);
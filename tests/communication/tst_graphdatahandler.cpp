@@ -46,7 +46,7 @@ void TestGraphDataHandler::registerList()
 
     GraphDataHandler dataHandler;
     QList<ModbusRegister> registerList;
-    dataHandler.processActiveRegisters(_pGraphDataModel);
+    dataHandler.processActiveRegisters(GraphDataHandler::activeGraphs(_pGraphDataModel));
     dataHandler.modbusRegisterList(registerList);
 
     QCOMPARE(expModbusRegisters, registerList);
@@ -84,7 +84,7 @@ void TestGraphDataHandler::errorPosition()
 
     GraphDataHandler dataHandler;
     QList<ModbusRegister> registerList;
-    dataHandler.processActiveRegisters(_pGraphDataModel);
+    dataHandler.processActiveRegisters(GraphDataHandler::activeGraphs(_pGraphDataModel));
     dataHandler.modbusRegisterList(registerList);
 
     auto regResults = ResultDoubleList() << ResultDouble(1, State::SUCCESS);
@@ -117,7 +117,7 @@ void TestGraphDataHandler::manyInactiveRegisters()
 
     GraphDataHandler dataHandler;
     QList<ModbusRegister> registerList;
-    dataHandler.processActiveRegisters(_pGraphDataModel);
+    dataHandler.processActiveRegisters(GraphDataHandler::activeGraphs(_pGraphDataModel));
     dataHandler.modbusRegisterList(registerList);
 
     QCOMPARE(expModbusRegisters, registerList);
@@ -155,7 +155,7 @@ void TestGraphDataHandler::graphDataTwice()
     GraphDataHandler dataHandler;
 
     QList<ModbusRegister> registerList;
-    dataHandler.processActiveRegisters(_pGraphDataModel);
+    dataHandler.processActiveRegisters(GraphDataHandler::activeGraphs(_pGraphDataModel));
     dataHandler.modbusRegisterList(registerList);
 
     QSignalSpy spyDataReady(&dataHandler, &GraphDataHandler::graphDataReady);
@@ -192,11 +192,116 @@ void TestGraphDataHandler::graphData_fail()
     CommunicationHelpers::verifyReceivedDataSignal(rawRegData, resultList);
 }
 
+void TestGraphDataHandler::graphDataCarryForward()
+{
+    auto exprList = QStringList() << "${40001} + ${40002}";
+
+    CommunicationHelpers::addExpressionsToModel(_pGraphDataModel, exprList);
+
+    auto regResults_1 = ResultDoubleList() << ResultDouble(1, State::SUCCESS)
+                                                << ResultDouble(2, State::SUCCESS);
+
+    /* Second register isn't read in this cycle */
+    auto regResults_2 = ResultDoubleList() << ResultDouble(3, State::SUCCESS)
+                                                << ResultDouble(0, State::NO_VALUE);
+
+    QList<QVariant> rawRegData;
+    GraphDataHandler dataHandler;
+
+    QList<ModbusRegister> registerList;
+    dataHandler.processActiveRegisters(GraphDataHandler::activeGraphs(_pGraphDataModel));
+    dataHandler.modbusRegisterList(registerList);
+
+    QSignalSpy spyDataReady(&dataHandler, &GraphDataHandler::graphDataReady);
+
+    dataHandler.handleRegisterData(regResults_1);
+    dataHandler.handleRegisterData(regResults_2);
+
+    QCOMPARE(spyDataReady.count(), 2);
+
+    auto resultList = ResultDoubleList() << ResultDouble(3, State::SUCCESS);
+    rawRegData = spyDataReady.takeFirst();
+    CommunicationHelpers::verifyReceivedDataSignal(rawRegData, resultList);
+
+    resultList = ResultDoubleList() << ResultDouble(5, State::SUCCESS);
+    rawRegData = spyDataReady.takeFirst();
+    CommunicationHelpers::verifyReceivedDataSignal(rawRegData, resultList);
+}
+
+void TestGraphDataHandler::graphDataNotRead()
+{
+    auto exprList = QStringList() << "${40001}"
+                                  << "${40002}";
+
+    CommunicationHelpers::addExpressionsToModel(_pGraphDataModel, exprList);
+
+    auto regResults_1 = ResultDoubleList() << ResultDouble(1, State::SUCCESS)
+                                                << ResultDouble(2, State::SUCCESS);
+
+    /* Second register is read by another connection */
+    auto regResults_2 = ResultDoubleList() << ResultDouble(3, State::SUCCESS)
+                                                << ResultDouble(0, State::NO_VALUE);
+
+    /* Nothing is read */
+    auto regResults_3 = ResultDoubleList() << ResultDouble(0, State::NO_VALUE)
+                                                << ResultDouble(0, State::NO_VALUE);
+
+    QList<QVariant> rawRegData;
+    GraphDataHandler dataHandler;
+
+    QList<ModbusRegister> registerList;
+    dataHandler.processActiveRegisters(GraphDataHandler::activeGraphs(_pGraphDataModel));
+    dataHandler.modbusRegisterList(registerList);
+
+    QSignalSpy spyDataReady(&dataHandler, &GraphDataHandler::graphDataReady);
+
+    dataHandler.handleRegisterData(regResults_1);
+    dataHandler.handleRegisterData(regResults_2);
+    dataHandler.handleRegisterData(regResults_3);
+
+    /* Last value isn't repeated */
+    QCOMPARE(spyDataReady.count(), 2);
+
+    auto resultList = ResultDoubleList() << ResultDouble(1, State::SUCCESS)
+                                         << ResultDouble(2, State::SUCCESS);
+    rawRegData = spyDataReady.takeFirst();
+    CommunicationHelpers::verifyReceivedDataSignal(rawRegData, resultList);
+
+    resultList = ResultDoubleList() << ResultDouble(3, State::SUCCESS)
+                                    << ResultDouble(0, State::NO_VALUE);
+    rawRegData = spyDataReady.takeFirst();
+    CommunicationHelpers::verifyReceivedDataSignal(rawRegData, resultList);
+}
+
+void TestGraphDataHandler::pollIntervals()
+{
+    auto exprList = QStringList() << "${40001} + ${40002}"
+                                  << "${40002}"
+                                  << "${40003}"
+                                  << "${40004}";
+
+    CommunicationHelpers::addExpressionsToModel(_pGraphDataModel, exprList);
+
+    _pGraphDataModel->setPollInterval(0, 1000);
+    _pGraphDataModel->setPollInterval(1, 50);
+    _pGraphDataModel->setPollInterval(2, 0);
+    _pGraphDataModel->setPollInterval(3, 60000);
+
+    GraphDataHandler dataHandler;
+    dataHandler.processActiveRegisters(GraphDataHandler::activeGraphs(_pGraphDataModel));
+
+    QList<quint32> pollIntervalList;
+    dataHandler.pollIntervalList(pollIntervalList, 250);
+
+    auto expIntervals = QList<quint32>() << 1000 << 50 << 0 << 60000;
+    QCOMPARE(pollIntervalList, expIntervals);
+}
+
 void TestGraphDataHandler::doHandleRegisterData(ResultDoubleList& modbusResults, QList<QVariant>& actRawData)
 {
     GraphDataHandler dataHandler;
     QList<ModbusRegister> registerList;
-    dataHandler.processActiveRegisters(_pGraphDataModel);
+    dataHandler.processActiveRegisters(GraphDataHandler::activeGraphs(_pGraphDataModel));
     dataHandler.modbusRegisterList(registerList);
 
     QSignalSpy spyDataReady(&dataHandler, &GraphDataHandler::graphDataReady);
@@ -27,6 +27,10 @@ private slots:
     void graphData();
     void graphDataTwice();
     void graphData_fail();
+    void graphDataCarryForward();
+    void graphDataNotRead();
+
+    void pollIntervals();
 
 private:
 
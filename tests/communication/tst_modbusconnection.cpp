@@ -148,7 +148,7 @@ void TestModbusConnection::readRequestSuccess()
     QCOMPARE(spyResultError.count(), 0);
 
     QList<QVariant> arguments = spyResultSuccess.takeFirst();
-    QCOMPARE(arguments.count(), 2);
+    QCOMPARE(arguments.count(), 3);
 
 
     /* Check start address */
@@ -163,6 +163,8 @@ void TestModbusConnection::readRequestSuccess()
     QCOMPARE(resultList[0], static_cast<quint16>(0));
     QCOMPARE(resultList[1], static_cast<quint16>(1));
 
+    /* Check reply timestamp */
+    QVERIFY(arguments[2].value<qint64>() > 0);
 }
 
 void TestModbusConnection::readRequestProtocolError()
@@ -199,10 +201,15 @@ void TestModbusConnection::readRequestProtocolError()
     QCOMPARE(spyResultError.count(), 0);
 
     QList<QVariant> arguments = spyResultProtocolError.takeFirst();
-    QCOMPARE(arguments.count(), 1);
+    QCOMPARE(arguments.count(), 2);
+
+    /* Check start address */
+    QVERIFY((arguments[0].canConvert<ModbusAddress>()));
+    auto resultAddr = arguments[0].value<ModbusAddress>();
+    QCOMPARE(resultAddr.address(ModbusAddress::Offset::WITH_OFFSET), 40001);
 
     /* Check modbus exception */
-    QCOMPARE(static_cast<QModbusPdu::ExceptionCode>(arguments.first().toInt()), QModbusPdu::IllegalDataAddress);
+    QCOMPARE(static_cast<QModbusPdu::ExceptionCode>(arguments[1].toInt()), QModbusPdu::IllegalDataAddress);
 
 }
 
@@ -20,6 +20,10 @@ void TestModbusMaster::init()
     _settingsModel.setPort(Connection::ID_1, 5020);
     _settingsModel.setTimeout(Connection::ID_1, 500);
     _settingsModel.setSlaveId(Connection::ID_1, 1);
+    _settingsModel.setPipelineDepth(Connection::ID_1, 1);
+
+    /* Every test uses a new device */
+    _settingsModel.setReadCapability(Connection::ID_1, ReadCapability());
 
     _serverConnectionData.setPort(_settingsModel.port(Connection::ID_1));
     _serverConnectionData.setHost(_settingsModel.ipAddress(Connection::ID_1));
@@ -57,7 +61,8 @@ void TestModbusMaster::singleRequestSuccess()
 {
     _testSlaveData[QModbusDataUnit::HoldingRegisters]->setRegisterState(0, true);
 
-    ModbusMaster modbusMaster(&_settingsModel, Connection::ID_1);
+    ModbusMaster modbusMaster(Connection::ID_1);
+    modbusMaster.startCommunication(CommunicationSettings(&_settingsModel));
 
     auto registerList = QList<ModbusAddress>() << 40001;
     QSignalSpy spyModbusPollDone(&modbusMaster, &ModbusMaster::modbusPollDone);
@@ -86,7 +91,8 @@ void TestModbusMaster::singleRequestEmpty()
 {
     _testSlaveData[QModbusDataUnit::HoldingRegisters]->setRegisterState(0, true);
 
-    ModbusMaster modbusMaster(&_settingsModel, Connection::ID_1);
+    ModbusMaster modbusMaster(Connection::ID_1);
+    modbusMaster.startCommunication(CommunicationSettings(&_settingsModel));
 
     QList<ModbusAddress> registerList;
     QSignalSpy spyModbusPollDone(&modbusMaster, &ModbusMaster::modbusPollDone);
@@ -108,7 +114,8 @@ void TestModbusMaster::singleRequestGatewayNotAvailable()
 {
     _pTestSlaveModbus->setException(QModbusPdu::GatewayTargetDeviceFailedToRespond, true);
 
-    ModbusMaster modbusMaster(&_settingsModel, Connection::ID_1);
+    ModbusMaster modbusMaster(Connection::ID_1);
+    modbusMaster.startCommunication(CommunicationSettings(&_settingsModel));
     QSignalSpy spyModbusPollDone(&modbusMaster, &ModbusMaster::modbusPollDone);
     auto registerList = QList<ModbusAddress>() << 40001;
 
@@ -135,7 +142,8 @@ void TestModbusMaster::singleRequestNoResponse()
 {
     _pTestSlaveModbus->disconnectDevice();
 
-    ModbusMaster modbusMaster(&_settingsModel, Connection::ID_1);
+    ModbusMaster modbusMaster(Connection::ID_1);
+    modbusMaster.startCommunication(CommunicationSettings(&_settingsModel));
 
     auto registerList = QList<ModbusAddress>() << 40001;
     QSignalSpy spyModbusPollDone(&modbusMaster, &ModbusMaster::modbusPollDone);
@@ -161,7 +169,8 @@ void TestModbusMaster::singleRequestNoResponse()
 
 void TestModbusMaster::singleRequestInvalidAddressOnce()
 {
-    ModbusMaster modbusMaster(&_settingsModel, Connection::ID_1);
+    ModbusMaster modbusMaster(Connection::ID_1);
+    modbusMaster.startCommunication(CommunicationSettings(&_settingsModel));
     QSignalSpy spyModbusPollDone(&modbusMaster, &ModbusMaster::modbusPollDone);
 
     auto registerList = QList<ModbusAddress>() << 40001 << 40002 << 40003;
@@ -203,7 +212,8 @@ void TestModbusMaster::singleRequestInvalidAddressPersistent()
 {
     _pTestSlaveModbus->setException(QModbusPdu::IllegalDataAddress, true);
 
-    ModbusMaster modbusMaster(&_settingsModel, Connection::ID_1);
+    ModbusMaster modbusMaster(Connection::ID_1);
+    modbusMaster.startCommunication(CommunicationSettings(&_settingsModel));
     QSignalSpy spyModbusPollDone(&modbusMaster, &ModbusMaster::modbusPollDone);
 
     auto registerList = QList<ModbusAddress>() << 40001;
@@ -239,7 +249,8 @@ void TestModbusMaster::multiRequestSuccess()
     _testSlaveData[QModbusDataUnit::HoldingRegisters]->setRegisterValue(1, 1);
     _testSlaveData[QModbusDataUnit::HoldingRegisters]->setRegisterValue(3, 3);
 
-    ModbusMaster modbusMaster(&_settingsModel, Connection::ID_1);
+    ModbusMaster modbusMaster(Connection::ID_1);
+    modbusMaster.startCommunication(CommunicationSettings(&_settingsModel));
 
     auto registerList = QList<ModbusAddress>() << 40001 << 40002 << 40004;
     QSignalSpy spyModbusPollDone(&modbusMaster, &ModbusMaster::modbusPollDone);
@@ -282,7 +293,8 @@ void TestModbusMaster::multiRequestGatewayNotAvailable()
     _testSlaveData[QModbusDataUnit::HoldingRegisters]->setRegisterValue(1, 1);
     _testSlaveData[QModbusDataUnit::HoldingRegisters]->setRegisterValue(3, 3);
 
-    ModbusMaster modbusMaster(&_settingsModel, Connection::ID_1);
+    ModbusMaster modbusMaster(Connection::ID_1);
+    modbusMaster.startCommunication(CommunicationSettings(&_settingsModel));
 
     auto registerList = QList<ModbusAddress>() << 40001 << 40002 << 40004;
     QSignalSpy spyModbusPollDone(&modbusMaster, &ModbusMaster::modbusPollDone);
@@ -321,7 +333,8 @@ void TestModbusMaster::multiRequestNoResponse()
     _testSlaveData[QModbusDataUnit::HoldingRegisters]->setRegisterValue(1, 1);
     _testSlaveData[QModbusDataUnit::HoldingRegisters]->setRegisterValue(3, 3);
 
-    ModbusMaster modbusMaster(&_settingsModel, Connection::ID_1);
+    ModbusMaster modbusMaster(Connection::ID_1);
+    modbusMaster.startCommunication(CommunicationSettings(&_settingsModel));
 
     auto registerList = QList<ModbusAddress>() << 40001 << 40002 << 40004;
     QSignalSpy spyModbusPollDone(&modbusMaster, &ModbusMaster::modbusPollDone);
@@ -359,7 +372,8 @@ void TestModbusMaster::multiRequestInvalidAddress()
     _testSlaveData[QModbusDataUnit::HoldingRegisters]->setRegisterValue(1, 1);
     _testSlaveData[QModbusDataUnit::HoldingRegisters]->setRegisterValue(3, 3);
 
-    ModbusMaster modbusMaster(&_settingsModel, Connection::ID_1);
+    ModbusMaster modbusMaster(Connection::ID_1);
+    modbusMaster.startCommunication(CommunicationSettings(&_settingsModel));
 
     auto registerList = QList<ModbusAddress>() << 40001 << 40002 << 40004;
     QSignalSpy spyModbusPollDone(&modbusMaster, &ModbusMaster::modbusPollDone);
@@ -385,6 +399,54 @@ void TestModbusMaster::multiRequestInvalidAddress()
     }
 }
 
+void TestModbusMaster::multiRequestPipelinedSuccess()
+{
+    _settingsModel.setPipelineDepth(Connection::ID_1, 4);
+
+    _testSlaveData[QModbusDataUnit::HoldingRegisters]->setRegisterState(0, true);
+    _testSlaveData[QModbusDataUnit::HoldingRegisters]->setRegisterState(1, true);
+    _testSlaveData[QModbusDataUnit::HoldingRegisters]->setRegisterState(3, true);
+    _testSlaveData[QModbusDataUnit::HoldingRegisters]->setRegisterState(5, true);
+
+    _testSlaveData[QModbusDataUnit::HoldingRegisters]->setRegisterValue(0, 0);
+    _testSlaveData[QModbusDataUnit::HoldingRegisters]->setRegisterValue(1, 1);
+    _testSlaveData[QModbusDataUnit::HoldingRegisters]->setRegisterValue(3, 3);
+    _testSlaveData[QModbusDataUnit::HoldingRegisters]->setRegisterValue(5, 5);
+
+    ModbusMaster modbusMaster(Connection::ID_1);
+    modbusMaster.startCommunication(CommunicationSettings(&_settingsModel));
+
+    auto registerList = QList<ModbusAddress>() << 40001 << 40002 << 40004 << 40006;
+    QSignalSpy spyModbusPollDone(&modbusMaster, &ModbusMaster::modbusPollDone);
+
+    for (uint i = 0; i < _cReadCount; i++)
+    {
+        modbusMaster.readRegisterList(registerList);
+
+        QVERIFY(spyModbusPollDone.wait(static_cast<int>(_settingsModel.timeout(Connection::ID_1))));
+        QCOMPARE(spyModbusPollDone.count(), 1);
+
+        QList<QVariant> arguments = spyModbusPollDone.takeFirst();
+        QVERIFY(arguments.count() > 0);
+
+        QVariant varResultList = arguments.first();
+        QVERIFY(varResultList.canConvert<ModbusResultMap>());
+        ModbusResultMap result = varResultList.value<ModbusResultMap >();
+        QCOMPARE(result.size(), 4);
+
+        QVERIFY(result[40001].isValid());
+        QCOMPARE(result[40001].value(), static_cast<quint16>(0));
+
+        QVERIFY(result[40002].isValid());
+        QCOMPARE(result[40002].value(), static_cast<quint16>(1));
+
+        QVERIFY(result[40004].isValid());
+        QCOMPARE(result[40004].value(), static_cast<quint16>(3));
+
+        QVERIFY(result[40006].isValid());
+        QCOMPARE(result[40006].value(), static_cast<quint16>(5));
+    }
+}
 
 /* TODO:
  * Add extra test with actual timeout of no response
@@ -25,6 +25,7 @@ private slots:
     void multiRequestGatewayNotAvailable();
     void multiRequestNoResponse();
     void multiRequestInvalidAddress();
+    void multiRequestPipelinedSuccess();
 
 private:
 
@@ -93,14 +93,14 @@ void TestModbusPoll::singleSlaveSuccess()
     dataMap(Connection::ID_1, QModbusDataUnit::HoldingRegisters)->setRegisterState(1, true);
     dataMap(Connection::ID_1, QModbusDataUnit::HoldingRegisters)->setRegisterValue(1, 65000);
 
-    ModbusPoll modbusPoll(_pSettingsModel);
+    ModbusPoll modbusPoll;
     QSignalSpy spyDataReady(&modbusPoll, &ModbusPoll::registerDataReady);
 
     auto modbusRegisters = QList<ModbusRegister>() << ModbusRegister(40001, Connection::ID_1, Type::UNSIGNED_16)
                                                    << ModbusRegister(40002, Connection::ID_1, Type::UNSIGNED_16);
 
     /*-- Start communication --*/
-    modbusPoll.startCommunication(modbusRegisters);
+    modbusPoll.startCommunication(CommunicationSettings(_pSettingsModel), modbusRegisters);
 
     QVERIFY(spyDataReady.wait(50));
     QCOMPARE(spyDataReady.count(), 1);
@@ -120,14 +120,14 @@ void TestModbusPoll::singleSlaveFail()
         _testSlaveModbusList[idx]->disconnectDevice();
     }
 
-    ModbusPoll modbusPoll(_pSettingsModel);
+    ModbusPoll modbusPoll;
     QSignalSpy spyDataReady(&modbusPoll, &ModbusPoll::registerDataReady);
 
     auto modbusRegisters = QList<ModbusRegister>() << ModbusRegister(40001, Connection::ID_1, Type::UNSIGNED_16)
                                                    << ModbusRegister(40002, Connection::ID_1, Type::UNSIGNED_16);
 
     /*-- Start communication --*/
-    modbusPoll.startCommunication(modbusRegisters);
+    modbusPoll.startCommunication(CommunicationSettings(_pSettingsModel), modbusRegisters);
 
     QVERIFY(spyDataReady.wait(static_cast<int>(_pSettingsModel->timeout(Connection::ID_1)) + 100));
     QCOMPARE(spyDataReady.count(), 1);
@@ -143,13 +143,13 @@ void TestModbusPoll::singleSlaveFail()
 
 void TestModbusPoll::singleOnlyConstantDataPoll()
 {
-    ModbusPoll modbusPoll(_pSettingsModel);
+    ModbusPoll modbusPoll;
     QSignalSpy spyDataReady(&modbusPoll, &ModbusPoll::registerDataReady);
 
     auto modbusRegisters = QList<ModbusRegister>(); /* No registers to poll */
 
     /*-- Start communication --*/
-    modbusPoll.startCommunication(modbusRegisters);
+    modbusPoll.startCommunication(CommunicationSettings(_pSettingsModel), modbusRegisters);
 
     QVERIFY(spyDataReady.wait(50));
     QCOMPARE(spyDataReady.count(), 1);
@@ -169,14 +169,14 @@ void TestModbusPoll::singleSlaveCoil()
     dataMap(Connection::ID_1, QModbusDataUnit::Coils)->setRegisterState(2, true);
     dataMap(Connection::ID_1, QModbusDataUnit::Coils)->setRegisterValue(2, 1);
 
-    ModbusPoll modbusPoll(_pSettingsModel);
+    ModbusPoll modbusPoll;
     QSignalSpy spyDataReady(&modbusPoll, &ModbusPoll::registerDataReady);
 
     auto modbusRegisters = QList<ModbusRegister>() << ModbusRegister(0, Connection::ID_1, Type::UNSIGNED_16)
                                                    << ModbusRegister(2, Connection::ID_1, Type::UNSIGNED_16);
 
     /*-- Start communication --*/
-    modbusPoll.startCommunication(modbusRegisters);
+    modbusPoll.startCommunication(CommunicationSettings(_pSettingsModel), modbusRegisters);
 
     QVERIFY(spyDataReady.wait(50));
     QCOMPARE(spyDataReady.count(), 1);
@@ -203,7 +203,7 @@ void TestModbusPoll::singleSlaveMixedObjects()
     dataMap(Connection::ID_1, QModbusDataUnit::HoldingRegisters)->setRegisterState(0, true);
     dataMap(Connection::ID_1, QModbusDataUnit::HoldingRegisters)->setRegisterValue(0, 101);
 
-    ModbusPoll modbusPoll(_pSettingsModel);
+    ModbusPoll modbusPoll;
     QSignalSpy spyDataReady(&modbusPoll, &ModbusPoll::registerDataReady);
 
     auto modbusRegisters = QList<ModbusRegister>() << ModbusRegister(0, Connection::ID_1, Type::UNSIGNED_16)
@@ -212,7 +212,7 @@ void TestModbusPoll::singleSlaveMixedObjects()
                                                    << ModbusRegister(40001, Connection::ID_1, Type::UNSIGNED_16);
 
     /*-- Start communication --*/
-    modbusPoll.startCommunication(modbusRegisters);
+    modbusPoll.startCommunication(CommunicationSettings(_pSettingsModel), modbusRegisters);
 
     QVERIFY(spyDataReady.wait(50));
     QCOMPARE(spyDataReady.count(), 1);
@@ -235,14 +235,14 @@ void TestModbusPoll::verifyRestartAfterStop()
     dataMap(Connection::ID_1, QModbusDataUnit::HoldingRegisters)->setRegisterState(1, true);
     dataMap(Connection::ID_1, QModbusDataUnit::HoldingRegisters)->setRegisterValue(1, 65000);
 
-    ModbusPoll modbusPoll(_pSettingsModel);
+    ModbusPoll modbusPoll;
     QSignalSpy spyDataReady(&modbusPoll, &ModbusPoll::registerDataReady);
 
     auto modbusRegisters = QList<ModbusRegister>() << ModbusRegister(40001, Connection::ID_1, Type::UNSIGNED_16)
                                                    << ModbusRegister(40002, Connection::ID_1, Type::UNSIGNED_16);
 
     /*-- Start communication --*/
-    modbusPoll.startCommunication(modbusRegisters);
+    modbusPoll.startCommunication(CommunicationSettings(_pSettingsModel), modbusRegisters);
 
     QVERIFY(modbusPoll.isActive());
 
@@ -263,7 +263,7 @@ void TestModbusPoll::verifyRestartAfterStop()
 
 
     /*-- Restart communication --*/
-    modbusPoll.startCommunication(modbusRegisters);
+    modbusPoll.startCommunication(CommunicationSettings(_pSettingsModel), modbusRegisters);
 
     QVERIFY(spyDataReady.wait(50));
     QCOMPARE(spyDataReady.count(), 1);
@@ -282,14 +282,14 @@ void TestModbusPoll::multiSlaveSuccess()
     dataMap(Connection::ID_2, QModbusDataUnit::HoldingRegisters)->setRegisterState(0, true);
     dataMap(Connection::ID_2, QModbusDataUnit::HoldingRegisters)->setRegisterValue(0, 5021);
 
-    ModbusPoll modbusPoll(_pSettingsModel);
+    ModbusPoll modbusPoll;
     QSignalSpy spyDataReady(&modbusPoll, &ModbusPoll::registerDataReady);
 
     auto modbusRegisters = QList<ModbusRegister>() << ModbusRegister(40001, Connection::ID_1, Type::UNSIGNED_16)
                                                    << ModbusRegister(40001, Connection::ID_2, Type::UNSIGNED_16);
 
     /*-- Start communication --*/
-    modbusPoll.startCommunication(modbusRegisters);
+    modbusPoll.startCommunication(CommunicationSettings(_pSettingsModel), modbusRegisters);
 
     QVERIFY(spyDataReady.wait(50));
     QCOMPARE(spyDataReady.count(), 1);
@@ -310,14 +310,14 @@ void TestModbusPoll::multiSlaveSuccess_2()
     dataMap(Connection::ID_2, QModbusDataUnit::HoldingRegisters)->setRegisterState(1, true);
     dataMap(Connection::ID_2, QModbusDataUnit::HoldingRegisters)->setRegisterValue(1, 5021);
 
-    ModbusPoll modbusPoll(_pSettingsModel);
+    ModbusPoll modbusPoll;
     QSignalSpy spyDataReady(&modbusPoll, &ModbusPoll::registerDataReady);
 
     auto modbusRegisters = QList<ModbusRegister>() << ModbusRegister(40001, Connection::ID_1, Type::UNSIGNED_16)
                                                    << ModbusRegister(40002, Connection::ID_2, Type::UNSIGNED_16);
 
     /*-- Start communication --*/
-    modbusPoll.startCommunication(modbusRegisters);
+    modbusPoll.startCommunication(CommunicationSettings(_pSettingsModel), modbusRegisters);
 
     QVERIFY(spyDataReady.wait(50));
     QCOMPARE(spyDataReady.count(), 1);
@@ -341,7 +341,7 @@ void TestModbusPoll::multiSlaveSuccess_3()
     dataMap(Connection::ID_2, QModbusDataUnit::HoldingRegisters)->setRegisterState(1, true);
     dataMap(Connection::ID_2, QModbusDataUnit::HoldingRegisters)->setRegisterValue(1, 5022);
 
-    ModbusPoll modbusPoll(_pSettingsModel);
+    ModbusPoll modbusPoll;
     QSignalSpy spyDataReady(&modbusPoll, &ModbusPoll::registerDataReady);
 
     auto modbusRegisters = QList<ModbusRegister>() << ModbusRegister(40001, Connection::ID_1, Type::UNSIGNED_16)
@@ -349,7 +349,7 @@ void TestModbusPoll::multiSlaveSuccess_3()
                                                    << ModbusRegister(40002, Connection::ID_1, Type::UNSIGNED_16);
 
     /*-- Start communication --*/
-    modbusPoll.startCommunication(modbusRegisters);
+    modbusPoll.startCommunication(CommunicationSettings(_pSettingsModel), modbusRegisters);
 
     QVERIFY(spyDataReady.wait(50));
     QCOMPARE(spyDataReady.count(), 1);
@@ -370,14 +370,14 @@ void TestModbusPoll::multiSlaveSingleFail()
     dataMap(Connection::ID_2, QModbusDataUnit::HoldingRegisters)->setRegisterState(0, true);
     dataMap(Connection::ID_2, QModbusDataUnit::HoldingRegisters)->setRegisterValue(0, 5021);
 
-    ModbusPoll modbusPoll(_pSettingsModel);
+    ModbusPoll modbusPoll;
     QSignalSpy spyDataReady(&modbusPoll, &ModbusPoll::registerDataReady);
 
     auto modbusRegisters = QList<ModbusRegister>() << ModbusRegister(40001, Connection::ID_1, Type::UNSIGNED_16)
                                                    << ModbusRegister(40001, Connection::ID_2, Type::UNSIGNED_16);
 
     /*-- Start communication --*/
-    modbusPoll.startCommunication(modbusRegisters);
+    modbusPoll.startCommunication(CommunicationSettings(_pSettingsModel), modbusRegisters);
 
     QVERIFY(spyDataReady.wait(static_cast<int>(_pSettingsModel->timeout(Connection::ID_1)) + 100));
     QCOMPARE(spyDataReady.count(), 1);
@@ -397,14 +397,14 @@ void TestModbusPoll::multiSlaveAllFail()
         _testSlaveModbusList[idx]->disconnectDevice();
     }
 
-    ModbusPoll modbusPoll(_pSettingsModel);
+    ModbusPoll modbusPoll;
     QSignalSpy spyDataReady(&modbusPoll, &ModbusPoll::registerDataReady);
 
     auto modbusRegisters = QList<ModbusRegister>() << ModbusRegister(40001, Connection::ID_1, Type::UNSIGNED_16)
                                                    << ModbusRegister(40001, Connection::ID_2, Type::UNSIGNED_16);
 
     /*-- Start communication --*/
-    modbusPoll.startCommunication(modbusRegisters);
+    modbusPoll.startCommunication(CommunicationSettings(_pSettingsModel), modbusRegisters);
 
     QVERIFY(spyDataReady.wait(static_cast<int>(_pSettingsModel->timeout(Connection::ID_1)) + 100));
     QCOMPARE(spyDataReady.count(), 1);
@@ -428,14 +428,14 @@ void TestModbusPoll::multiSlaveDisabledConnection()
     /* Disable connection */
     _pSettingsModel->setConnectionState(Connection::ID_2, false);
 
-    ModbusPoll modbusPoll(_pSettingsModel);
+    ModbusPoll modbusPoll;
     QSignalSpy spyDataReady(&modbusPoll, &ModbusPoll::registerDataReady);
 
     auto modbusRegisters = QList<ModbusRegister>() << ModbusRegister(40001, Connection::ID_1, Type::UNSIGNED_16)
                                                    << ModbusRegister(40001, Connection::ID_2, Type::UNSIGNED_16);
 
     /*-- Start communication --*/
-    modbusPoll.startCommunication(modbusRegisters);
+    modbusPoll.startCommunication(CommunicationSettings(_pSettingsModel), modbusRegisters);
 
     QVERIFY(spyDataReady.wait(50));
     QCOMPARE(spyDataReady.count(), 1);
@@ -450,6 +450,52 @@ void TestModbusPoll::multiSlaveDisabledConnection()
     CommunicationHelpers::verifyReceivedDataSignal(arguments, expResults);
 }
 
+void TestModbusPoll::multiSlaveIndependentPolling()
+{
+    dataMap(Connection::ID_1, QModbusDataUnit::HoldingRegisters)->setRegisterState(0, true);
+    dataMap(Connection::ID_1, QModbusDataUnit::HoldingRegisters)->setRegisterValue(0, 5020);
+
+    dataMap(Connection::ID_2, QModbusDataUnit::HoldingRegisters)->setRegisterState(0, true);
+    dataMap(Connection::ID_2, QModbusDataUnit::HoldingRegisters)->setRegisterValue(0, 5021);
+
+    _pSettingsModel->setIndependentPolling(true);
+
+    ModbusPoll modbusPoll;
+    QSignalSpy spyDataReady(&modbusPoll, &ModbusPoll::registerDataReady);
+
+    auto modbusRegisters = QList<ModbusRegister>() << ModbusRegister(40001, Connection::ID_1, Type::UNSIGNED_16)
+                                                   << ModbusRegister(40001, Connection::ID_2, Type::UNSIGNED_16);
+
+    /*-- Start communication --*/
+    modbusPoll.startCommunication(CommunicationSettings(_pSettingsModel), modbusRegisters);
+
+    QTRY_VERIFY_WITH_TIMEOUT(spyDataReady.count() >= 2, 100);
+
+    /* Every connection reports its own partial sample, other registers have no value */
+    QList<ResultDoubleList> resultLists;
+    resultLists.append(spyDataReady.at(0).first().value<ResultDoubleList>());
+    resultLists.append(spyDataReady.at(1).first().value<ResultDoubleList>());
+
+    if (resultLists[0][0].state() == State::NO_VALUE)
+    {
+        resultLists.swapItemsAt(0, 1);
+    }
+    else
+    {
+        /* Already in connection order */
+    }
+
+    QCOMPARE(resultLists[0].size(), 2);
+    QCOMPARE(resultLists[0][0].state(), State::SUCCESS);
+    QCOMPARE(resultLists[0][0].value(), 5020.0);
+    QCOMPARE(resultLists[0][1].state(), State::NO_VALUE);
+
+    QCOMPARE(resultLists[1].size(), 2);
+    QCOMPARE(resultLists[1][0].state(), State::NO_VALUE);
+    QCOMPARE(resultLists[1][1].state(), State::SUCCESS);
+    QCOMPARE(resultLists[1][1].value(), 5021.0);
+}
+
 TestSlaveData* TestModbusPoll::dataMap(uint32_t connId, QModbusDataUnit::RegisterType type)
 {
     return (_testSlaveDataList[connId])->value(type);
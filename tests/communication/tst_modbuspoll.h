@@ -29,6 +29,7 @@ private slots:
     void multiSlaveSingleFail();
     void multiSlaveAllFail();
     void multiSlaveDisabledConnection();
+    void multiSlaveIndependentPolling();
 
 private:
 
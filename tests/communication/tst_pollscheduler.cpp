@@ -0,0 +1,154 @@
+
+#include <QtTest/QtTest>
+
+#include "tst_pollscheduler.h"
+
+#include "pollscheduler.h"
+
+static qint32 gIntervalWarningCount = 0;
+
+static void countIntervalWarnings(QtMsgType type, const QMessageLogContext& context, const QString& msg)
+{
+    Q_UNUSED(context);
+
+    if (
+        (type == QtWarningMsg)
+        && msg.contains("is not a multiple of poll cycle")
+    )
+    {
+        gIntervalWarningCount++;
+    }
+}
+
+void TestPollScheduler::init()
+{
+
+}
+
+void TestPollScheduler::cleanup()
+{
+
+}
+
+void TestPollScheduler::defaultInterval()
+{
+    PollScheduler pollScheduler;
+
+    pollScheduler.setPollIntervals(QList<quint32>() << 0 << 0);
+
+    QCOMPARE(pollScheduler.cycleTime(250), static_cast<quint32>(250));
+
+    for (int idx = 0; idx < 3; idx++)
+    {
+        QCOMPARE(pollScheduler.nextCycle(250), QList<bool>() << true << true);
+    }
+}
+
+void TestPollScheduler::cycleTime()
+{
+    PollScheduler pollScheduler;
+
+    /* No registers: default poll time */
+    QCOMPARE(pollScheduler.cycleTime(250), static_cast<quint32>(250));
+
+    pollScheduler.setPollIntervals(QList<quint32>() << 1000 << 0);
+    QCOMPARE(pollScheduler.cycleTime(250), static_cast<quint32>(250));
+
+    pollScheduler.setPollIntervals(QList<quint32>() << 1000 << 0 << 50);
+    QCOMPARE(pollScheduler.cycleTime(250), static_cast<quint32>(50));
+
+    /* Only slow registers */
+    pollScheduler.setPollIntervals(QList<quint32>() << 1000 << 60000);
+    QCOMPARE(pollScheduler.cycleTime(250), static_cast<quint32>(1000));
+}
+
+void TestPollScheduler::dueCycles()
+{
+    PollScheduler pollScheduler;
+
+    pollScheduler.setPollIntervals(QList<quint32>() << 0 << 1000 << 500);
+
+    QCOMPARE(pollScheduler.nextCycle(250), QList<bool>() << true << true << true);
+    QCOMPARE(pollScheduler.nextCycle(250), QList<bool>() << true << false << false);
+    QCOMPARE(pollScheduler.nextCycle(250), QList<bool>() << true << false << true);
+    QCOMPARE(pollScheduler.nextCycle(250), QList<bool>() << true << false << false);
+    QCOMPARE(pollScheduler.nextCycle(250), QList<bool>() << true << true << true);
+}
+
+void TestPollScheduler::reset()
+{
+    PollScheduler pollScheduler;
+
+    pollScheduler.setPollIntervals(QList<quint32>() << 0 << 1000);
+
+    QCOMPARE(pollScheduler.nextCycle(250), QList<bool>() << true << true);
+    QCOMPARE(pollScheduler.nextCycle(250), QList<bool>() << true << false);
+
+    pollScheduler.reset();
+
+    QCOMPARE(pollScheduler.nextCycle(250), QList<bool>() << true << true);
+}
+
+void TestPollScheduler::commonDivisor()
+{
+    PollScheduler pollScheduler;
+
+    /* Intervals aren't multiples of the fastest interval */
+    pollScheduler.setPollIntervals(QList<quint32>() << 75 << 50);
+    QCOMPARE(pollScheduler.cycleTime(250), static_cast<quint32>(25));
+
+    QCOMPARE(pollScheduler.nextCycle(250), QList<bool>() << true << true);
+    QCOMPARE(pollScheduler.nextCycle(250), QList<bool>() << false << false);
+    QCOMPARE(pollScheduler.nextCycle(250), QList<bool>() << false << true);
+    QCOMPARE(pollScheduler.nextCycle(250), QList<bool>() << true << false);
+    QCOMPARE(pollScheduler.nextCycle(250), QList<bool>() << false << true);
+    QCOMPARE(pollScheduler.nextCycle(250), QList<bool>() << false << false);
+    QCOMPARE(pollScheduler.nextCycle(250), QList<bool>() << true << true);
+}
+
+void TestPollScheduler::unrelatedIntervals()
+{
+    PollScheduler pollScheduler;
+
+    /* Common divisor is too short, fastest interval is used */
+    pollScheduler.setPollIntervals(QList<quint32>() << 1000 << 2501);
+    QCOMPARE(pollScheduler.cycleTime(250), static_cast<quint32>(1000));
+
+    /* Rounded down, so never slower than requested */
+    QCOMPARE(pollScheduler.nextCycle(250), QList<bool>() << true << true);
+    QCOMPARE(pollScheduler.nextCycle(250), QList<bool>() << true << false);
+    QCOMPARE(pollScheduler.nextCycle(250), QList<bool>() << true << true);
+}
+
+void TestPollScheduler::warnOncePerInterval()
+{
+    PollScheduler pollScheduler;
+
+    QList<quint32> pollIntervalList;
+    for (qint32 idx = 0; idx < 50; idx++)
+    {
+        pollIntervalList << 1000 << 2501 << 3500;
+    }
+
+    gIntervalWarningCount = 0;
+    QtMessageHandler previousHandler = qInstallMessageHandler(countIntervalWarnings);
+
+    pollScheduler.setPollIntervals(pollIntervalList);
+    const quint32 cycleTime = pollScheduler.cycleTime(250);
+
+    QList<qsizetype> dueCountList;
+    for (qint32 idx = 0; idx < 5; idx++)
+    {
+        dueCountList.append(pollScheduler.nextCycle(250).count(true));
+    }
+
+    qInstallMessageHandler(previousHandler);
+
+    QCOMPARE(cycleTime, static_cast<quint32>(1000));
+    QCOMPARE(dueCountList, QList<qsizetype>() << 150 << 50 << 100 << 100 << 100);
+
+    /* One warning per distinct interval (2501 and 3500), not per register or cycle */
+    QCOMPARE(gIntervalWarningCount, 2);
+}
+
+QTEST_GUILESS_MAIN(TestPollScheduler)
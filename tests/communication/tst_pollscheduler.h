@@ -0,0 +1,23 @@
+#ifndef TEST_POLLSCHEDULER_H__
+#define TEST_POLLSCHEDULER_H__
+
+#include <QObject>
+
+class TestPollScheduler: public QObject
+{
+    Q_OBJECT
+private slots:
+    void init();
+    void cleanup();
+
+    void defaultInterval();
+    void cycleTime();
+    void dueCycles();
+    void reset();
+    void commonDivisor();
+    void unrelatedIntervals();
+    void warnOncePerInterval();
+
+};
+
+#endif /* TEST_POLLSCHEDULER_H__ */
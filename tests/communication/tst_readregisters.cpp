@@ -28,6 +28,43 @@ void TestReadRegisters::verifyAndAddErrorResult(ReadRegisters& readRegister, Mod
     readRegister.addError();
 }
 
+/* Device refuses read of 8 registers, but accepts both halves */
+void TestReadRegisters::readRefusedBlock(ReadRegisters& readRegister, QList<ModbusAddress> registerList)
+{
+    readRegister.resetRead(registerList, 100);
+
+    auto item = readRegister.takeNext();
+    QCOMPARE(item.address(), 0);
+    QCOMPARE(item.count(), 8);
+    readRegister.bisectRead(0);
+
+    readRegister.takeNext();
+    readRegister.addSuccess(0, QList<quint16>() << 0 << 1 << 2 << 3);
+
+    readRegister.takeNext();
+    readRegister.addSuccess(4, QList<quint16>() << 4 << 5 << 6 << 7);
+
+    QVERIFY(!readRegister.hasNext());
+}
+
+/* Read of 8 registers is limited to two reads of 4 registers */
+void TestReadRegisters::readLimitedBlocks(ReadRegisters& readRegister, QList<ModbusAddress> registerList)
+{
+    readRegister.resetRead(registerList, 100);
+
+    auto item = readRegister.takeNext();
+    QCOMPARE(item.address(), 0);
+    QCOMPARE(item.count(), 4);
+    readRegister.addSuccess(0, QList<quint16>() << 0 << 1 << 2 << 3);
+
+    item = readRegister.takeNext();
+    QCOMPARE(item.address(), 4);
+    QCOMPARE(item.count(), 4);
+    readRegister.addSuccess(4, QList<quint16>() << 4 << 5 << 6 << 7);
+
+    QVERIFY(!readRegister.hasNext());
+}
+
 void TestReadRegisters::resetRead_1()
 {
     ReadRegisters readRegister;
@@ -321,4 +358,551 @@ void TestReadRegisters::addSuccessAndErrors()
     QVERIFY(resultMap.value(8).isValid());
 }
 
+void TestReadRegisters::inFlightOutOfOrder()
+{
+    ReadRegisters readRegister;
+    auto registerList = QList<ModbusAddress>() << 0 << 1 << 5 << 8;
+
+    readRegister.resetRead(registerList, 100);
+
+    auto item = readRegister.takeNext();
+    QCOMPARE(item.address(), 0);
+    QCOMPARE(item.count(), 2);
+
+    item = readRegister.takeNext();
+    QCOMPARE(item.address(), 5);
+    QCOMPARE(item.count(), 1);
+
+    item = readRegister.takeNext();
+    QCOMPARE(item.address(), 8);
+    QCOMPARE(item.count(), 1);
+
+    QVERIFY(!readRegister.hasNext());
+    QCOMPARE(readRegister.inFlightCount(), 3);
+    QVERIFY(readRegister.isInFlight(5));
+    QVERIFY(!readRegister.isInFlight(1));
+
+    /* Replies in different order */
+    readRegister.addSuccess(8, QList<quint16>() << 1008);
+    readRegister.addError(5);
+    readRegister.addSuccess(0, QList<quint16>() << 1000 << 1001);
+
+    QCOMPARE(readRegister.inFlightCount(), 0);
+
+    auto resultMap = readRegister.resultMap();
+
+    QCOMPARE(resultMap.size(), registerList.size());
+
+    QCOMPARE(resultMap.value(0).value(), 1000);
+    QVERIFY(resultMap.value(0).isValid());
+
+    QCOMPARE(resultMap.value(1).value(), 1001);
+    QVERIFY(resultMap.value(1).isValid());
+
+    QVERIFY(!resultMap.value(5).isValid());
+
+    QCOMPARE(resultMap.value(8).value(), 1008);
+    QVERIFY(resultMap.value(8).isValid());
+}
+
+void TestReadRegisters::inFlightSplitToSingleReads()
+{
+    ReadRegisters readRegister;
+    auto registerList = QList<ModbusAddress>() << 0 << 1 << 5;
+
+    readRegister.resetRead(registerList, 100);
+
+    readRegister.takeNext();
+    readRegister.takeNext();
+
+    readRegister.splitToSingleReads(0);
+
+    QCOMPARE(readRegister.inFlightCount(), 1);
+
+    verifyAndAddErrorResult(readRegister, 0, 1);
+    verifyAndAddErrorResult(readRegister, 1, 1);
+
+    QVERIFY(!readRegister.hasNext());
+
+    /* Single read can't be split further */
+    readRegister.splitToSingleReads(5);
+
+    QVERIFY(!readRegister.hasNext());
+    QCOMPARE(readRegister.inFlightCount(), 0);
+    QVERIFY(!readRegister.resultMap().value(5).isValid());
+}
+
+void TestReadRegisters::inFlightAddAllErrors()
+{
+    ReadRegisters readRegister;
+    auto registerList = QList<ModbusAddress>() << 0 << 1 << 5 << 8;
+
+    readRegister.resetRead(registerList, 100);
+
+    readRegister.takeNext();
+    readRegister.addAllErrors();
+
+    QVERIFY(!readRegister.hasNext());
+    QCOMPARE(readRegister.inFlightCount(), 0);
+
+    auto resultMap = readRegister.resultMap();
+
+    QCOMPARE(resultMap.size(), registerList.size());
+
+    for(quint16 idx = 0; idx < static_cast<quint16>(registerList.size()); idx++)
+    {
+        QVERIFY(!resultMap.value(registerList[idx]).isValid());
+    }
+}
+
+void TestReadRegisters::gap_1()
+{
+    ReadRegisters readRegister;
+    auto registerList = QList<ModbusAddress>() << 0 << 2 << 4 << 7;
+
+    readRegister.resetRead(registerList, 100, 1);
+
+    verifyAndAddErrorResult(readRegister, 0, 5);
+    verifyAndAddErrorResult(readRegister, 7, 1);
+
+    QVERIFY(!readRegister.hasNext());
+}
+
+void TestReadRegisters::gap_2()
+{
+    ReadRegisters readRegister;
+    auto registerList = QList<ModbusAddress>() << 0 << 2 << 4 << 7;
+
+    readRegister.resetRead(registerList, 100, 2);
+
+    verifyAndAddErrorResult(readRegister, 0, 8);
+
+    QVERIFY(!readRegister.hasNext());
+}
+
+void TestReadRegisters::gapConsecutiveMax()
+{
+    ReadRegisters readRegister;
+    auto registerList = QList<ModbusAddress>() << 0 << 2 << 4;
+
+    readRegister.resetRead(registerList, 4, 2);
+
+    verifyAndAddErrorResult(readRegister, 0, 3);
+    verifyAndAddErrorResult(readRegister, 4, 1);
+
+    QVERIFY(!readRegister.hasNext());
+}
+
+void TestReadRegisters::gapAddSuccess()
+{
+    ReadRegisters readRegister;
+    auto registerList = QList<ModbusAddress>() << 0 << 2 << 3;
+
+    readRegister.resetRead(registerList, 100, 1);
+
+    auto item = readRegister.takeNext();
+    QCOMPARE(item.address(), 0);
+    QCOMPARE(item.count(), 4);
+
+    readRegister.addSuccess(0, QList<quint16>() << 1000 << 1001 << 1002 << 1003);
+
+    auto resultMap = readRegister.resultMap();
+
+    /* Gap register isn't part of result */
+    QCOMPARE(resultMap.size(), registerList.size());
+    QVERIFY(!resultMap.contains(1));
+
+    QCOMPARE(resultMap.value(0).value(), 1000);
+    QCOMPARE(resultMap.value(2).value(), 1002);
+    QCOMPARE(resultMap.value(3).value(), 1003);
+}
+
+void TestReadRegisters::gapUnbridgeable()
+{
+    ReadRegisters readRegister;
+    auto registerList = QList<ModbusAddress>() << 0 << 2 << 3;
+
+    readRegister.resetRead(registerList, 100, 1);
+
+    readRegister.takeNext();
+
+    /* Device refuses gap register */
+    readRegister.bisectRead(0);
+
+    readRegister.takeNext();
+    readRegister.addSuccess(0, QList<quint16>() << 1000);
+    readRegister.takeNext();
+    readRegister.addSuccess(2, QList<quint16>() << 1002 << 1003);
+
+    QVERIFY(!readRegister.hasNext());
+    QVERIFY(readRegister.learnCapability());
+
+    /* Gap isn't bridged in next reads, also not when learned limits are probed */
+    for (quint32 idx = 0; idx < 20; idx++)
+    {
+        readRegister.resetRead(registerList, 100, 1);
+
+        verifyAndAddErrorResult(readRegister, 0, 1);
+        verifyAndAddErrorResult(readRegister, 2, 2);
+
+        QVERIFY(!readRegister.hasNext());
+        QVERIFY(!readRegister.learnCapability());
+    }
+
+    /* Until gaps are cleared */
+    readRegister.clearUnbridgeableGaps();
+    readRegister.resetRead(registerList, 100, 1);
+
+    verifyAndAddErrorResult(readRegister, 0, 4);
+
+    QVERIFY(!readRegister.hasNext());
+}
+
+void TestReadRegisters::gapBridgeableRegisterError()
+{
+    ReadRegisters readRegister;
+    auto registerList = QList<ModbusAddress>() << 0 << 2 << 3;
+
+    readRegister.resetRead(registerList, 100, 1);
+
+    readRegister.takeNext();
+    readRegister.bisectRead(0);
+
+    /* Requested register itself is refused */
+    auto item = readRegister.takeNext();
+    QCOMPARE(item.address(), 0);
+    QCOMPARE(item.count(), 1);
+    readRegister.bisectRead(0);
+
+    readRegister.takeNext();
+    readRegister.addSuccess(2, QList<quint16>() << 1002 << 1003);
+
+    QVERIFY(readRegister.learnCapability());
+
+    /* Unreadable register isn't read until it is probed */
+    for (quint32 idx = 1; idx < 8; idx++)
+    {
+        readRegister.resetRead(registerList, 100, 1);
+
+        verifyAndAddErrorResult(readRegister, 2, 2);
+
+        QVERIFY(!readRegister.hasNext());
+        QVERIFY(!readRegister.learnCapability());
+    }
+
+    /* Gap isn't blamed, so probe read bridges it */
+    readRegister.resetRead(registerList, 100, 1);
+
+    verifyAndAddErrorResult(readRegister, 0, 4);
+
+    QVERIFY(!readRegister.hasNext());
+}
+
+void TestReadRegisters::gapBridgeableOtherError()
+{
+    ReadRegisters readRegister;
+    auto registerList = QList<ModbusAddress>() << 0 << 2 << 3;
+
+    readRegister.resetRead(registerList, 100, 1);
+
+    readRegister.takeNext();
+
+    /* Not an illegal address exception, so read isn't bisected */
+    readRegister.addError(0);
+
+    QVERIFY(!readRegister.hasNext());
+    QVERIFY(!readRegister.learnCapability());
+
+    readRegister.resetRead(registerList, 100, 1);
+
+    verifyAndAddErrorResult(readRegister, 0, 4);
+
+    QVERIFY(!readRegister.hasNext());
+}
+
+void TestReadRegisters::bisectLearnBlockSize()
+{
+    ReadRegisters readRegister;
+    auto registerList = QList<ModbusAddress>() << 0 << 1 << 2 << 3 << 4 << 5 << 6 << 7;
+
+    readRegister.resetRead(registerList, 100);
+
+    auto item = readRegister.takeNext();
+    QCOMPARE(item.address(), 0);
+    QCOMPARE(item.count(), 8);
+
+    /* Device refuses read */
+    readRegister.bisectRead(0);
+
+    item = readRegister.takeNext();
+    QCOMPARE(item.address(), 0);
+    QCOMPARE(item.count(), 4);
+    readRegister.addSuccess(0, QList<quint16>() << 0 << 1 << 2 << 3);
+
+    item = readRegister.takeNext();
+    QCOMPARE(item.address(), 4);
+    QCOMPARE(item.count(), 4);
+    readRegister.addSuccess(4, QList<quint16>() << 4 << 5 << 6 << 7);
+
+    QVERIFY(!readRegister.hasNext());
+    QCOMPARE(readRegister.resultMap().size(), registerList.size());
+
+    /* No larger read succeeded */
+    QVERIFY(readRegister.learnCapability());
+    QCOMPARE(readRegister.capability().maxBlockSize(), 4);
+    QVERIFY(readRegister.capability().boundaryList().isEmpty());
+    QVERIFY(readRegister.capability().unreadableList().isEmpty());
+
+    /* Next read respects learned size */
+    readRegister.resetRead(registerList, 100, 0);
+
+    verifyAndAddErrorResult(readRegister, 0, 4);
+    verifyAndAddErrorResult(readRegister, 4, 4);
+
+    QVERIFY(!readRegister.hasNext());
+    QVERIFY(!readRegister.learnCapability());
+}
+
+void TestReadRegisters::bisectLearnBoundary()
+{
+    ReadRegisters readRegister;
+    auto registerList = QList<ModbusAddress>() << 0 << 1 << 2 << 3 << 4 << 5 << 6 << 7
+                                               << 20 << 21 << 22 << 23 << 24 << 25 << 26 << 27 << 28 << 29;
+
+    readRegister.resetRead(registerList, 100);
+
+    readRegister.takeNext();
+    auto item = readRegister.takeNext();
+    QCOMPARE(item.address(), 20);
+    QCOMPARE(item.count(), 10);
+
+    readRegister.addSuccess(20, QList<quint16>() << 20 << 21 << 22 << 23 << 24 << 25 << 26 << 27 << 28 << 29);
+
+    /* Device refuses smaller read */
+    readRegister.bisectRead(0);
+
+    readRegister.takeNext();
+    readRegister.addSuccess(0, QList<quint16>() << 0 << 1 << 2 << 3);
+
+    readRegister.takeNext();
+    readRegister.addSuccess(4, QList<quint16>() << 4 << 5 << 6 << 7);
+
+    QVERIFY(!readRegister.hasNext());
+
+    QVERIFY(readRegister.learnCapability());
+    QCOMPARE(readRegister.capability().maxBlockSize(), 0);
+    QCOMPARE(readRegister.capability().boundaryList(), QList<ModbusAddress>() << 4);
+
+    /* Next read doesn't cross boundary */
+    readRegister.resetRead(registerList, 100, 0);
+
+    verifyAndAddErrorResult(readRegister, 0, 4);
+    verifyAndAddErrorResult(readRegister, 4, 4);
+    verifyAndAddErrorResult(readRegister, 20, 10);
+
+    QVERIFY(!readRegister.hasNext());
+}
+
+void TestReadRegisters::bisectLearnUnreadable()
+{
+    ReadRegisters readRegister;
+    auto registerList = QList<ModbusAddress>() << 0 << 1 << 2;
+
+    readRegister.resetRead(registerList, 100);
+
+    readRegister.takeNext();
+    readRegister.bisectRead(0);
+
+    auto item = readRegister.takeNext();
+    QCOMPARE(item.address(), 0);
+    QCOMPARE(item.count(), 1);
+
+    /* Single register is refused */
+    readRegister.bisectRead(0);
+
+    item = readRegister.takeNext();
+    QCOMPARE(item.address(), 1);
+    QCOMPARE(item.count(), 2);
+    readRegister.addSuccess(1, QList<quint16>() << 1 << 2);
+
+    QVERIFY(!readRegister.hasNext());
+
+    auto resultMap = readRegister.resultMap();
+    QCOMPARE(resultMap.size(), registerList.size());
+    QVERIFY(!resultMap.value(0).isValid());
+    QVERIFY(resultMap.value(1).isValid());
+
+    QVERIFY(readRegister.learnCapability());
+    QCOMPARE(readRegister.capability().unreadableList(), QList<ModbusAddress>() << 0);
+    QCOMPARE(readRegister.capability().maxBlockSize(), 0);
+
+    /* Unreadable register isn't read, but has error result */
+    readRegister.resetRead(registerList, 100, 0);
+
+    resultMap = readRegister.resultMap();
+    QVERIFY(resultMap.contains(0));
+    QVERIFY(!resultMap.value(0).isValid());
+
+    verifyAndAddErrorResult(readRegister, 1, 2);
+
+    QVERIFY(!readRegister.hasNext());
+    QCOMPARE(readRegister.resultMap().size(), registerList.size());
+}
+
+void TestReadRegisters::bisectLearnGap()
+{
+    ReadRegisters readRegister;
+    auto registerList = QList<ModbusAddress>() << 0 << 2;
+
+    readRegister.resetRead(registerList, 100, 1);
+
+    auto item = readRegister.takeNext();
+    QCOMPARE(item.address(), 0);
+    QCOMPARE(item.count(), 3);
+
+    /* Device refuses gap register */
+    readRegister.bisectRead(0);
+
+    item = readRegister.takeNext();
+    QCOMPARE(item.address(), 0);
+    QCOMPARE(item.count(), 1);
+    readRegister.addSuccess(0, QList<quint16>() << 0);
+
+    item = readRegister.takeNext();
+    QCOMPARE(item.address(), 2);
+    QCOMPARE(item.count(), 1);
+    readRegister.addSuccess(2, QList<quint16>() << 2);
+
+    QVERIFY(readRegister.learnCapability());
+
+    /* Gap register isn't remembered as unreadable, the gap is unbridgeable instead */
+    QVERIFY(readRegister.capability().isEmpty());
+
+    /* Gap isn't bridged in next read */
+    readRegister.resetRead(registerList, 100, 1);
+
+    verifyAndAddErrorResult(readRegister, 0, 1);
+    verifyAndAddErrorResult(readRegister, 2, 1);
+
+    QVERIFY(!readRegister.hasNext());
+}
+
+void TestReadRegisters::probeUnreadable()
+{
+    ReadRegisters readRegister;
+    auto registerList = QList<ModbusAddress>() << 0 << 1 << 2;
+
+    readRegister.resetRead(registerList, 100);
+
+    readRegister.takeNext();
+    readRegister.bisectRead(0);
+
+    /* Single register is refused */
+    readRegister.takeNext();
+    readRegister.bisectRead(0);
+
+    readRegister.takeNext();
+    readRegister.addSuccess(1, QList<quint16>() << 1 << 2);
+
+    QVERIFY(readRegister.learnCapability());
+    QCOMPARE(readRegister.capability().unreadableList(), QList<ModbusAddress>() << 0);
+
+    /* Unreadable register is never stored */
+    QVERIFY(readRegister.persistentCapability().isEmpty());
+
+    /* Unreadable register isn't read until it is probed */
+    for (quint32 idx = 1; idx < 8; idx++)
+    {
+        readRegister.resetRead(registerList, 100);
+
+        auto item = readRegister.takeNext();
+        QCOMPARE(item.address(), 1);
+        QCOMPARE(item.count(), 2);
+        readRegister.addSuccess(1, QList<quint16>() << 1 << 2);
+
+        QVERIFY(!readRegister.hasNext());
+        QVERIFY(!readRegister.learnCapability());
+    }
+
+    /* Probe succeeds, so register is forgotten */
+    readRegister.resetRead(registerList, 100);
+
+    auto item = readRegister.takeNext();
+    QCOMPARE(item.address(), 0);
+    QCOMPARE(item.count(), 3);
+    readRegister.addSuccess(0, QList<quint16>() << 0 << 1 << 2);
+
+    QVERIFY(readRegister.resultMap().value(0).isValid());
+
+    QVERIFY(readRegister.learnCapability());
+    QVERIFY(readRegister.capability().isEmpty());
+}
+
+void TestReadRegisters::probeConfirmBlockSize()
+{
+    ReadRegisters readRegister;
+    auto registerList = QList<ModbusAddress>() << 0 << 1 << 2 << 3 << 4 << 5 << 6 << 7;
+
+    readRefusedBlock(readRegister, registerList);
+    QVERIFY(readRegister.learnCapability());
+    QCOMPARE(readRegister.capability().maxBlockSize(), 4);
+
+    /* Learned once, so not stored yet */
+    QVERIFY(readRegister.persistentCapability().isEmpty());
+
+    for (quint32 idx = 1; idx < 8; idx++)
+    {
+        readLimitedBlocks(readRegister, registerList);
+        QVERIFY(!readRegister.learnCapability());
+    }
+
+    /* First probe confirms limit, back-off is doubled */
+    readRefusedBlock(readRegister, registerList);
+    QVERIFY(!readRegister.learnCapability());
+    QCOMPARE(readRegister.capability().maxBlockSize(), 4);
+    QVERIFY(readRegister.persistentCapability().isEmpty());
+
+    for (quint32 idx = 1; idx < 16; idx++)
+    {
+        readLimitedBlocks(readRegister, registerList);
+        QVERIFY(!readRegister.learnCapability());
+    }
+
+    /* Second probe confirms limit again, now it is stored */
+    readRefusedBlock(readRegister, registerList);
+    QVERIFY(!readRegister.learnCapability());
+    QCOMPARE(readRegister.persistentCapability().maxBlockSize(), 4);
+    QVERIFY(readRegister.persistentCapability().unreadableList().isEmpty());
+}
+
+void TestReadRegisters::seedCapability()
+{
+    ReadRegisters readRegister;
+    auto registerList = QList<ModbusAddress>() << 0 << 1 << 2 << 3 << 4 << 5 << 6 << 7;
+
+    ReadCapability capability;
+    capability.limitBlockSize(4);
+    capability.addBoundary(2);
+
+    readRegister.setCapability(capability);
+
+    QCOMPARE(readRegister.capability(), capability);
+
+    /* Known limits are confirmed */
+    QCOMPARE(readRegister.persistentCapability(), capability);
+
+    readRegister.resetRead(registerList, 100);
+
+    verifyAndAddErrorResult(readRegister, 0, 2);
+    verifyAndAddErrorResult(readRegister, 2, 4);
+    verifyAndAddErrorResult(readRegister, 6, 2);
+
+    QVERIFY(!readRegister.hasNext());
+
+    /* Seeding again forgets learned limits */
+    readRegister.setCapability(ReadCapability());
+    QVERIFY(readRegister.capability().isEmpty());
+    QVERIFY(readRegister.persistentCapability().isEmpty());
+}
+
 QTEST_GUILESS_MAIN(TestReadRegisters)
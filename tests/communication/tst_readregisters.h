@@ -36,9 +36,31 @@ private slots:
     void addSuccess();
     void addSuccessAndErrors();
 
+    void inFlightOutOfOrder();
+    void inFlightSplitToSingleReads();
+    void inFlightAddAllErrors();
+
+    void gap_1();
+    void gap_2();
+    void gapConsecutiveMax();
+    void gapAddSuccess();
+    void gapUnbridgeable();
+    void gapBridgeableRegisterError();
+    void gapBridgeableOtherError();
+
+    void bisectLearnBlockSize();
+    void bisectLearnBoundary();
+    void bisectLearnUnreadable();
+    void bisectLearnGap();
+    void probeUnreadable();
+    void probeConfirmBlockSize();
+    void seedCapability();
+
 private:
 
     void verifyAndAddErrorResult(ReadRegisters& readRegister, ModbusAddress addr, quint16 cnt);
+    void readRefusedBlock(ReadRegisters& readRegister, QList<ModbusAddress> registerList);
+    void readLimitedBlocks(ReadRegisters& readRegister, QList<ModbusAddress> registerList);
 
 };
 
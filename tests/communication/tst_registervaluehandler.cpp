@@ -32,8 +32,8 @@ void TestRegisterValueHandler::addressList_16()
     auto modbusRegisters = QList<ModbusRegister>() << ModbusRegister(40001, Connection::ID_1, Type::UNSIGNED_16);
     auto expRegisterList = QList<ModbusAddress>() << 40001;
 
-    RegisterValueHandler regHandler(_pSettingsModel);
-    regHandler.setRegisters(modbusRegisters);
+    RegisterValueHandler regHandler;
+    regHandler.setRegisters(modbusRegisters, CommunicationSettings(_pSettingsModel));
 
     QList<ModbusAddress> actualRegisterList;
     regHandler.registerAddresList(actualRegisterList, Connection::ID_1);
@@ -47,8 +47,8 @@ void TestRegisterValueHandler::addressList_16_multiple()
                                                    << ModbusRegister(40002, Connection::ID_1, Type::UNSIGNED_16);
     auto expRegisterList = QList<ModbusAddress>() << 40001 << 40002;
 
-    RegisterValueHandler regHandler(_pSettingsModel);
-    regHandler.setRegisters(modbusRegisters);
+    RegisterValueHandler regHandler;
+    regHandler.setRegisters(modbusRegisters, CommunicationSettings(_pSettingsModel));
 
     QList<ModbusAddress> actualRegisterList;
     regHandler.registerAddresList(actualRegisterList, Connection::ID_1);
@@ -61,8 +61,8 @@ void TestRegisterValueHandler::addressList_32()
     auto modbusRegisters = QList<ModbusRegister>() << ModbusRegister(40001, Connection::ID_1, Type::UNSIGNED_32);
     auto expRegisterList = QList<ModbusAddress>() << 40001 << 40002;
 
-    RegisterValueHandler regHandler(_pSettingsModel);
-    regHandler.setRegisters(modbusRegisters);
+    RegisterValueHandler regHandler;
+    regHandler.setRegisters(modbusRegisters, CommunicationSettings(_pSettingsModel));
 
     QList<ModbusAddress> actualRegisterList;
     regHandler.registerAddresList(actualRegisterList, Connection::ID_1);
@@ -76,8 +76,8 @@ void TestRegisterValueHandler::addressList_32_multiple()
                                                    << ModbusRegister(40005, Connection::ID_1, Type::UNSIGNED_32);
     auto expRegisterList = QList<ModbusAddress>() << 40001 << 40002 << 40005 << 40006;
 
-    RegisterValueHandler regHandler(_pSettingsModel);
-    regHandler.setRegisters(modbusRegisters);
+    RegisterValueHandler regHandler;
+    regHandler.setRegisters(modbusRegisters, CommunicationSettings(_pSettingsModel));
 
     QList<ModbusAddress> actualRegisterList;
     regHandler.registerAddresList(actualRegisterList, Connection::ID_1);
@@ -90,8 +90,8 @@ void TestRegisterValueHandler::addressList_float32()
     auto modbusRegisters = QList<ModbusRegister>() << ModbusRegister(40001, Connection::ID_1, Type::FLOAT_32);
     auto expRegisterList = QList<ModbusAddress>() << 40001 << 40002;
 
-    RegisterValueHandler regHandler(_pSettingsModel);
-    regHandler.setRegisters(modbusRegisters);
+    RegisterValueHandler regHandler;
+    regHandler.setRegisters(modbusRegisters, CommunicationSettings(_pSettingsModel));
 
     QList<ModbusAddress> actualRegisterList;
     regHandler.registerAddresList(actualRegisterList, Connection::ID_1);
@@ -105,8 +105,8 @@ void TestRegisterValueHandler::addressList_float32_multiple()
                                                    << ModbusRegister(40005, Connection::ID_1, Type::FLOAT_32);
     auto expRegisterList = QList<ModbusAddress>() << 40001 << 40002 << 40005 << 40006;
 
-    RegisterValueHandler regHandler(_pSettingsModel);
-    regHandler.setRegisters(modbusRegisters);
+    RegisterValueHandler regHandler;
+    regHandler.setRegisters(modbusRegisters, CommunicationSettings(_pSettingsModel));
 
     QList<ModbusAddress> actualRegisterList;
     regHandler.registerAddresList(actualRegisterList, Connection::ID_1);
@@ -122,8 +122,8 @@ void TestRegisterValueHandler::addressListCombinations()
                                                    << ModbusRegister(40008, Connection::ID_1, Type::UNSIGNED_32);
     auto expRegisterList = QList<ModbusAddress>() << 40001 << 40005 << 40006 << 40008 << 40009;
 
-    RegisterValueHandler regHandler(_pSettingsModel);
-    regHandler.setRegisters(modbusRegisters);
+    RegisterValueHandler regHandler;
+    regHandler.setRegisters(modbusRegisters, CommunicationSettings(_pSettingsModel));
 
     QList<ModbusAddress> actualRegisterList;
     regHandler.registerAddresList(actualRegisterList, Connection::ID_1);
@@ -139,8 +139,8 @@ void TestRegisterValueHandler::addressListMultipleConnections()
     auto expRegisterList0 = QList<ModbusAddress>() << 40001 << 40002 << 40010 << 40011;
     auto expRegisterList1 = QList<ModbusAddress>() << 40005 << 40006;
 
-    RegisterValueHandler regHandler(_pSettingsModel);
-    regHandler.setRegisters(modbusRegisters);
+    RegisterValueHandler regHandler;
+    regHandler.setRegisters(modbusRegisters, CommunicationSettings(_pSettingsModel));
 
     QList<ModbusAddress> actualRegisterList0;
     QList<ModbusAddress> actualRegisterList1;
@@ -158,8 +158,8 @@ void TestRegisterValueHandler::addressListMixedObjects()
                                                    << ModbusRegister(40002, Connection::ID_1, Type::UNSIGNED_16)   ;
     auto expRegisterList = QList<ModbusAddress>() << 0 << 30002 << 40002;
 
-    RegisterValueHandler regHandler(_pSettingsModel);
-    regHandler.setRegisters(modbusRegisters);
+    RegisterValueHandler regHandler;
+    regHandler.setRegisters(modbusRegisters, CommunicationSettings(_pSettingsModel));
 
     QList<ModbusAddress> actualRegisterList;
     regHandler.registerAddresList(actualRegisterList, Connection::ID_1);
@@ -241,8 +241,8 @@ void TestRegisterValueHandler::readConnections()
                                             << ResultDouble(100, State::SUCCESS);
 
 
-    RegisterValueHandler regHandler(_pSettingsModel);
-    regHandler.setRegisters(modbusRegisters);
+    RegisterValueHandler regHandler;
+    regHandler.setRegisters(modbusRegisters, CommunicationSettings(_pSettingsModel));
 
     QSignalSpy spyDataReady(&regHandler, &RegisterValueHandler::registerDataReady);
 
@@ -275,8 +275,8 @@ void TestRegisterValueHandler::readFail()
                                             << ResultDouble(100, State::SUCCESS);
 
 
-    RegisterValueHandler regHandler(_pSettingsModel);
-    regHandler.setRegisters(modbusRegisters);
+    RegisterValueHandler regHandler;
+    regHandler.setRegisters(modbusRegisters, CommunicationSettings(_pSettingsModel));
 
     QSignalSpy spyDataReady(&regHandler, &RegisterValueHandler::registerDataReady);
 
@@ -296,12 +296,83 @@ void TestRegisterValueHandler::readFail()
     QCOMPARE(result, expResults);
 }
 
+void TestRegisterValueHandler::readNotDue()
+{
+    auto modbusRegisters = QList<ModbusRegister>() << ModbusRegister(40001, Connection::ID_1, Type::UNSIGNED_16)
+                                                   << ModbusRegister(40002, Connection::ID_1, Type::UNSIGNED_16);
+    auto dueList = QList<bool>() << true << false;
+
+    ModbusResultMap partialResultMap;
+    addToResultMap(partialResultMap, 40001, false, 256, State::SUCCESS);
+
+    auto expRegisterList = QList<ModbusAddress>() << 40001;
+    auto expResults = ResultDoubleList() << ResultDouble(256, State::SUCCESS)
+                                            << ResultDouble(0, State::NO_VALUE);
+
+    RegisterValueHandler regHandler;
+    regHandler.setRegisters(modbusRegisters, CommunicationSettings(_pSettingsModel));
+
+    QSignalSpy spyDataReady(&regHandler, &RegisterValueHandler::registerDataReady);
+
+    regHandler.startRead(dueList);
+
+    /* Only due registers are read */
+    QList<ModbusAddress> actualRegisterList;
+    regHandler.registerAddresList(actualRegisterList, Connection::ID_1);
+    QVERIFY(actualRegisterList == expRegisterList);
+
+    regHandler.processPartialResult(partialResultMap, Connection::ID_1);
+    regHandler.finishRead();
+
+    QCOMPARE(spyDataReady.count(), 1);
+
+    QList<QVariant> arguments = spyDataReady.takeFirst();
+    QVERIFY(arguments.count() > 0);
+
+    QVariant varResultList = arguments.first();
+    QVERIFY(varResultList.canConvert<ResultDoubleList >());
+    ResultDoubleList result = varResultList.value<ResultDoubleList >();
+
+    QCOMPARE(result, expResults);
+}
+
+void TestRegisterValueHandler::readGaps()
+{
+    auto modbusRegisters = QList<ModbusRegister>() << ModbusRegister(40010, Connection::ID_1, Type::UNSIGNED_16)
+                                                   << ModbusRegister(40003, Connection::ID_1, Type::UNSIGNED_32)
+                                                   << ModbusRegister(40001, Connection::ID_1, Type::UNSIGNED_16)
+                                                   << ModbusRegister(40001, Connection::ID_1, Type::SIGNED_16);
+
+    /* Bridged gap (40002, 40005) and missing upper word of 32 bit register */
+    ModbusResultMap partialResultMap;
+    addToResultMap(partialResultMap, 40001, false, 65535, State::SUCCESS);
+    addToResultMap(partialResultMap, 40002, false, 7, State::SUCCESS);
+    addToResultMap(partialResultMap, 40003, false, 1, State::SUCCESS);
+    addToResultMap(partialResultMap, 40005, false, 3, State::SUCCESS);
+    addToResultMap(partialResultMap, 40010, false, 9, State::SUCCESS);
+
+    auto expRegisterList = QList<ModbusAddress>() << 40001 << 40003 << 40004 << 40010;
+    auto expResults = ResultDoubleList() << ResultDouble(9, State::SUCCESS)
+                                            << ResultDouble(0, State::INVALID)
+                                            << ResultDouble(65535, State::SUCCESS)
+                                            << ResultDouble(-1, State::SUCCESS);
+
+    RegisterValueHandler regHandler;
+    regHandler.setRegisters(modbusRegisters, CommunicationSettings(_pSettingsModel));
+
+    QList<ModbusAddress> actualRegisterList;
+    regHandler.registerAddresList(actualRegisterList, Connection::ID_1);
+    QVERIFY(actualRegisterList == expRegisterList);
+
+    verifyRegisterResult(modbusRegisters, partialResultMap, expResults);
+}
+
 void TestRegisterValueHandler::verifyRegisterResult(QList<ModbusRegister>& regList,
                                                     ModbusResultMap &regData,
                                                     ResultDoubleList expResults)
 {
-    RegisterValueHandler regHandler(_pSettingsModel);
-    regHandler.setRegisters(regList);
+    RegisterValueHandler regHandler;
+    regHandler.setRegisters(regList, CommunicationSettings(_pSettingsModel));
 
     QSignalSpy spyDataReady(&regHandler, &RegisterValueHandler::registerDataReady);
 
@@ -31,6 +31,8 @@ private slots:
 
     void readConnections();
     void readFail();
+    void readNotDue();
+    void readGaps();
 
 private:
 
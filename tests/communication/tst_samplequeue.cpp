@@ -0,0 +1,158 @@
+
+#include <QtTest/QtTest>
+#include <QThread>
+
+#include "tst_samplequeue.h"
+
+#include "samplequeue.h"
+#include "sampleclock.h"
+
+using State = ResultState::State;
+
+void TestSampleQueue::init()
+{
+    qRegisterMetaType<ResultDoubleList>("ResultDoubleList");
+}
+
+void TestSampleQueue::cleanup()
+{
+
+}
+
+void TestSampleQueue::takeSamples()
+{
+    SampleQueue sampleQueue;
+
+    sampleQueue.addTimedSample(100, ResultDoubleList() << ResultDouble(1, State::SUCCESS));
+    sampleQueue.addTimedSample(200, ResultDoubleList() << ResultDouble(2, State::INVALID));
+
+    QCOMPARE(sampleQueue.count(), 2);
+
+    QList<double> timestampList;
+    QList<ResultDoubleList> resultLists;
+    sampleQueue.takeSamples(timestampList, resultLists);
+
+    QCOMPARE(timestampList, QList<double>() << 100 << 200);
+    QCOMPARE(resultLists.size(), 2);
+    QCOMPARE(resultLists[0], ResultDoubleList() << ResultDouble(1, State::SUCCESS));
+    QCOMPARE(resultLists[1], ResultDoubleList() << ResultDouble(2, State::INVALID));
+
+    QCOMPARE(sampleQueue.count(), 0);
+
+    sampleQueue.takeSamples(timestampList, resultLists);
+    QVERIFY(timestampList.isEmpty());
+    QVERIFY(resultLists.isEmpty());
+}
+
+void TestSampleQueue::notifyOnlyWhenEmpty()
+{
+    SampleQueue sampleQueue;
+    QSignalSpy spyAvailable(&sampleQueue, &SampleQueue::samplesAvailable);
+
+    sampleQueue.addSample(ResultDoubleList() << ResultDouble(1, State::SUCCESS));
+    sampleQueue.addSample(ResultDoubleList() << ResultDouble(2, State::SUCCESS));
+    sampleQueue.addSample(ResultDoubleList() << ResultDouble(3, State::SUCCESS));
+
+    QCOMPARE(spyAvailable.count(), 1);
+
+    QList<double> timestampList;
+    QList<ResultDoubleList> resultLists;
+    sampleQueue.takeSamples(timestampList, resultLists);
+    QCOMPARE(resultLists.size(), 3);
+
+    sampleQueue.addSample(ResultDoubleList() << ResultDouble(4, State::SUCCESS));
+    QCOMPARE(spyAvailable.count(), 2);
+}
+
+void TestSampleQueue::addFromOtherThread()
+{
+    SampleQueue sampleQueue;
+    QSignalSpy spyAvailable(&sampleQueue, &SampleQueue::samplesAvailable);
+
+    const qint32 sampleCount = 1000;
+
+    QThread * pThread = QThread::create([&sampleQueue, sampleCount]() {
+        for (qint32 idx = 0; idx < sampleCount; idx++)
+        {
+            sampleQueue.addTimedSample(idx, ResultDoubleList() << ResultDouble(idx, State::SUCCESS));
+        }
+    });
+
+    QList<double> timestampList;
+    QList<ResultDoubleList> resultLists;
+    QList<double> receivedTimestamps;
+
+    pThread->start();
+    while (!pThread->isFinished())
+    {
+        sampleQueue.takeSamples(timestampList, resultLists);
+        receivedTimestamps.append(timestampList);
+    }
+    pThread->wait();
+    delete pThread;
+
+    sampleQueue.takeSamples(timestampList, resultLists);
+    receivedTimestamps.append(timestampList);
+
+    /* All samples are received in order */
+    QCOMPARE(receivedTimestamps.size(), sampleCount);
+    for (qint32 idx = 0; idx < sampleCount; idx++)
+    {
+        QCOMPARE(receivedTimestamps[idx], static_cast<double>(idx));
+    }
+}
+
+void TestSampleQueue::sampleTimestamp()
+{
+    SampleQueue sampleQueue;
+
+    auto first = ResultDouble(1, State::SUCCESS);
+    first.setTimestamp(1000000);
+
+    auto second = ResultDouble(2, State::SUCCESS);
+    second.setTimestamp(3000000);
+
+    /* Sample is time stamped with most recent reply */
+    sampleQueue.addSample(ResultDoubleList() << second << first << ResultDouble(0, State::INVALID));
+
+    QList<double> timestampList;
+    QList<ResultDoubleList> resultLists;
+    sampleQueue.takeSamples(timestampList, resultLists);
+
+    QCOMPARE(timestampList.size(), 1);
+    QCOMPARE(timestampList[0], SampleClock::toEpochMsecs(3000000));
+    QCOMPARE(timestampList[0] - SampleClock::toEpochMsecs(1000000), 2.0);
+}
+
+void TestSampleQueue::reportDroppedSamples()
+{
+    SampleQueue sampleQueue(4);
+
+    for (qint32 idx = 0; idx < 10; idx++)
+    {
+        sampleQueue.addTimedSample(idx, ResultDoubleList() << ResultDouble(idx, State::SUCCESS));
+    }
+
+    QCOMPARE(sampleQueue.droppedCount(), static_cast<quint64>(6));
+
+    QList<double> timestampList;
+    QList<ResultDoubleList> resultLists;
+
+    /* All drops are reported in single message */
+    QTest::ignoreMessage(QtWarningMsg, QRegularExpression("6 samples dropped.*total: 6"));
+    sampleQueue.takeSamples(timestampList, resultLists);
+    QCOMPARE(resultLists.size(), 4);
+
+    for (qint32 idx = 0; idx < 10; idx++)
+    {
+        sampleQueue.addTimedSample(idx, ResultDoubleList() << ResultDouble(idx, State::SUCCESS));
+    }
+
+    /* Next drops are reported after interval or when forced */
+    sampleQueue.takeSamples(timestampList, resultLists);
+
+    QTest::ignoreMessage(QtWarningMsg, QRegularExpression("6 samples dropped.*total: 12"));
+    sampleQueue.reportDroppedSamples(true);
+}
+
+QTEST_GUILESS_MAIN(TestSampleQueue)
@@ -0,0 +1,22 @@
+
+#ifndef TEST_SAMPLEQUEUE_H__
+#define TEST_SAMPLEQUEUE_H__
+
+#include <QObject>
+
+class TestSampleQueue: public QObject
+{
+    Q_OBJECT
+private slots:
+    void init();
+    void cleanup();
+
+    void takeSamples();
+    void notifyOnlyWhenEmpty();
+    void addFromOtherThread();
+    void sampleTimestamp();
+    void reportDroppedSamples();
+
+};
+
+#endif /* TEST_SAMPLEQUEUE_H__ */
@@ -0,0 +1,154 @@
+
+#include <QtTest/QtTest>
+#include <QThread>
+
+#include "tst_sampleringbuffer.h"
+
+#include "sampleringbuffer.h"
+
+using State = ResultState::State;
+
+void TestSampleRingBuffer::init()
+{
+
+}
+
+void TestSampleRingBuffer::cleanup()
+{
+
+}
+
+void TestSampleRingBuffer::pushPop()
+{
+    SampleRingBuffer ringBuffer(8);
+
+    QVERIFY(ringBuffer.push(100, ResultDoubleList() << ResultDouble(1, State::SUCCESS) << ResultDouble(2, State::INVALID)));
+    QVERIFY(ringBuffer.push(200, ResultDoubleList() << ResultDouble(3, State::NO_VALUE) << ResultDouble(4, State::SUCCESS)));
+
+    QCOMPARE(ringBuffer.size(), 2u);
+
+    QList<double> timestampList;
+    QList<ResultDoubleList> resultLists;
+    QCOMPARE(ringBuffer.pop(timestampList, resultLists), 2);
+
+    QCOMPARE(timestampList, QList<double>() << 100 << 200);
+    QCOMPARE(resultLists.size(), 2);
+    QCOMPARE(resultLists[0], ResultDoubleList() << ResultDouble(1, State::SUCCESS) << ResultDouble(2, State::INVALID));
+    QCOMPARE(resultLists[1], ResultDoubleList() << ResultDouble(3, State::NO_VALUE) << ResultDouble(4, State::SUCCESS));
+
+    QCOMPARE(ringBuffer.size(), 0u);
+    QCOMPARE(ringBuffer.pop(timestampList, resultLists), 0);
+    QCOMPARE(resultLists.size(), 2);
+}
+
+void TestSampleRingBuffer::capacity()
+{
+    QCOMPARE(SampleRingBuffer(8).capacity(), 8u);
+    QCOMPARE(SampleRingBuffer(9).capacity(), 16u);
+    QCOMPARE(SampleRingBuffer(0).capacity(), 2u);
+}
+
+void TestSampleRingBuffer::dropWhenFull()
+{
+    SampleRingBuffer ringBuffer(4);
+
+    for (qint32 idx = 0; idx < 4; idx++)
+    {
+        QVERIFY(ringBuffer.push(idx, ResultDoubleList() << ResultDouble(idx, State::SUCCESS)));
+    }
+
+    QVERIFY(!ringBuffer.push(4, ResultDoubleList() << ResultDouble(4, State::SUCCESS)));
+    QCOMPARE(ringBuffer.droppedCount(), static_cast<quint64>(1));
+
+    QList<double> timestampList;
+    QList<ResultDoubleList> resultLists;
+    QCOMPARE(ringBuffer.pop(timestampList, resultLists), 4);
+    QCOMPARE(timestampList, QList<double>() << 0 << 1 << 2 << 3);
+
+    QVERIFY(ringBuffer.push(5, ResultDoubleList() << ResultDouble(5, State::SUCCESS)));
+}
+
+void TestSampleRingBuffer::wrapAround()
+{
+    SampleRingBuffer ringBuffer(4);
+
+    QList<double> timestampList;
+    QList<ResultDoubleList> resultLists;
+
+    for (qint32 idx = 0; idx < 10; idx++)
+    {
+        QVERIFY(ringBuffer.push(idx, ResultDoubleList() << ResultDouble(idx, State::SUCCESS)));
+        QVERIFY(ringBuffer.push(idx + 0.5, ResultDoubleList() << ResultDouble(-idx, State::INVALID)));
+
+        timestampList.clear();
+        resultLists.clear();
+        QCOMPARE(ringBuffer.pop(timestampList, resultLists), 2);
+
+        QCOMPARE(timestampList, QList<double>() << idx << idx + 0.5);
+        QCOMPARE(resultLists[0], ResultDoubleList() << ResultDouble(idx, State::SUCCESS));
+        QCOMPARE(resultLists[1], ResultDoubleList() << ResultDouble(-idx, State::INVALID));
+    }
+}
+
+void TestSampleRingBuffer::columnCountChange()
+{
+    SampleRingBuffer ringBuffer(4);
+
+    QVERIFY(ringBuffer.push(1, ResultDoubleList() << ResultDouble(1, State::SUCCESS)));
+
+    /* Column count can't change while samples are queued */
+    QVERIFY(!ringBuffer.push(2, ResultDoubleList() << ResultDouble(1, State::SUCCESS) << ResultDouble(2, State::SUCCESS)));
+
+    QList<double> timestampList;
+    QList<ResultDoubleList> resultLists;
+    QCOMPARE(ringBuffer.pop(timestampList, resultLists), 1);
+
+    QVERIFY(ringBuffer.push(3, ResultDoubleList() << ResultDouble(1, State::SUCCESS) << ResultDouble(2, State::SUCCESS)));
+
+    timestampList.clear();
+    resultLists.clear();
+    QCOMPARE(ringBuffer.pop(timestampList, resultLists), 1);
+    QCOMPARE(resultLists[0], ResultDoubleList() << ResultDouble(1, State::SUCCESS) << ResultDouble(2, State::SUCCESS));
+}
+
+void TestSampleRingBuffer::concurrent()
+{
+    SampleRingBuffer ringBuffer(64);
+
+    const qint32 sampleCount = 100000;
+
+    QThread * pThread = QThread::create([&ringBuffer, sampleCount]() {
+        for (qint32 idx = 0; idx < sampleCount; idx++)
+        {
+            const ResultDoubleList resultList = ResultDoubleList() << ResultDouble(idx, State::SUCCESS) << ResultDouble(-idx, State::SUCCESS);
+            while (!ringBuffer.push(idx, resultList))
+            {
+                QThread::yieldCurrentThread();
+            }
+        }
+    });
+
+    QList<double> timestampList;
+    QList<ResultDoubleList> resultLists;
+
+    pThread->start();
+    while (!pThread->isFinished())
+    {
+        ringBuffer.pop(timestampList, resultLists);
+    }
+    pThread->wait();
+    delete pThread;
+
+    ringBuffer.pop(timestampList, resultLists);
+
+    /* All samples are received in order and intact */
+    QCOMPARE(timestampList.size(), sampleCount);
+    for (qint32 idx = 0; idx < sampleCount; idx++)
+    {
+        QCOMPARE(timestampList[idx], static_cast<double>(idx));
+        QCOMPARE(resultLists[idx][0].value(), static_cast<double>(idx));
+        QCOMPARE(resultLists[idx][1].value(), static_cast<double>(-idx));
+    }
+}
+
+QTEST_GUILESS_MAIN(TestSampleRingBuffer)
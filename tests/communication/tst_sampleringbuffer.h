@@ -0,0 +1,23 @@
+
+#ifndef TEST_SAMPLERINGBUFFER_H__
+#define TEST_SAMPLERINGBUFFER_H__
+
+#include <QObject>
+
+class TestSampleRingBuffer: public QObject
+{
+    Q_OBJECT
+private slots:
+    void init();
+    void cleanup();
+
+    void pushPop();
+    void capacity();
+    void dropWhenFull();
+    void wrapAround();
+    void columnCountChange();
+    void concurrent();
+
+};
+
+#endif /* TEST_SAMPLERINGBUFFER_H__ */
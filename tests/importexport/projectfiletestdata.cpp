@@ -129,6 +129,23 @@ QString ProjectFileTestData::cConnEmpty = QString(
     "</modbusscope>                                                    \n"
 );
 
+QString ProjectFileTestData::cConnReadCapability = QString(
+    "<?xml version=\"1.0\"?>                                           \n"\
+    "<modbusscope datalevel=\"3\">                                     \n"\
+    " <modbus>                                                         \n"\
+    "  <connection>                                                    \n"\
+    "   <connectionid>0</connectionid>                                 \n"\
+    "   <readcapability>                                               \n"\
+    "    <maxreadsize>32</maxreadsize>                                 \n"\
+    "    <unreadable objecttype=\"3\">12</unreadable>                  \n"\
+    "    <unreadable objecttype=\"3\">10</unreadable>                  \n"\
+    "    <readboundary objecttype=\"2\">100</readboundary>             \n"\
+    "   </readcapability>                                              \n"\
+    "  </connection>                                                   \n"\
+    " </modbus>                                                        \n"\
+    "</modbusscope>                                                    \n"
+);
+
 QString ProjectFileTestData::cScaleDouble = QString(
     "<?xml version=\"1.0\"?>                                    \n"\
     "<modbusscope datalevel=\"3\">                              \n"\
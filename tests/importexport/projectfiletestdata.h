@@ -13,6 +13,7 @@ public:
     static QString cConnSerial;
     static QString cConnMixedMulti;
     static QString cConnEmpty;
+    static QString cConnReadCapability;
 
     static QString cScaleDouble;
     static QString cValueAxis;
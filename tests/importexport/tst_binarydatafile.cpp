@@ -0,0 +1,185 @@
+
+#include <QtTest/QtTest>
+
+#include "binarydatareader.h"
+#include "binarydatawriter.h"
+
+#include "tst_binarydatafile.h"
+
+static QString testFilePath()
+{
+    return QDir::temp().filePath("tst_binarydatafile.mbsd");
+}
+
+void TestBinaryDataFile::init()
+{
+    QFile::remove(testFilePath());
+}
+
+void TestBinaryDataFile::cleanup()
+{
+    QFile::remove(testFilePath());
+}
+
+void TestBinaryDataFile::metadata()
+{
+    BinaryDataWriter writer;
+    QVERIFY(writer.open(testFilePath(), createMetadata()));
+    writer.close();
+
+    BinaryDataReader reader;
+    QVERIFY(reader.open(testFilePath()));
+
+    const BinaryDataFile::Metadata& metadata = reader.metadata();
+    QCOMPARE(metadata.version, QString("3.8.0"));
+    QCOMPARE(metadata.startTime, static_cast<qint64>(1700000000123));
+    QCOMPARE(metadata.endTime, static_cast<qint64>(1700000100456));
+    QCOMPARE(metadata.pollTime, static_cast<quint32>(250));
+    QCOMPARE(metadata.bAbsoluteTimes, true);
+    QCOMPARE(metadata.bDuringLog, false);
+
+    QCOMPARE(metadata.graphs.size(), 2);
+    QCOMPARE(metadata.graphs[0].label, QString("Voltage"));
+    QCOMPARE(metadata.graphs[0].color, QColor("#ff0000"));
+    QCOMPARE(metadata.graphs[0].expression, QString("${40001}/10"));
+    QCOMPARE(metadata.graphs[0].axis, static_cast<quint32>(0));
+    QCOMPARE(metadata.graphs[1].label, QString("Current, \"A\""));
+    QCOMPARE(metadata.graphs[1].axis, static_cast<quint32>(1));
+
+    QCOMPARE(metadata.notes.size(), 1);
+    QCOMPARE(metadata.notes[0].text(), QString("Start of test"));
+    QCOMPARE(metadata.notes[0].notePosition(), QPointF(10.5, -3));
+
+    QCOMPARE(reader.chunkCount(), 0);
+    QCOMPARE(reader.sampleCount(), static_cast<qint64>(0));
+
+    DataFileParser::FileData fileData;
+    BinaryDataReader::metadataToFileData(metadata, &fileData);
+    QCOMPARE(fileData.axisLabel, QString("Time"));
+    QCOMPARE(fileData.bAbsoluteTimes, true);
+    QCOMPARE(fileData.dataLabel, QStringList() << "Voltage" << "Current, \"A\"");
+}
+
+void TestBinaryDataFile::readBack_data()
+{
+    QTest::addColumn<qint32>("count");
+    QTest::addColumn<bool>("bCompress");
+
+    QTest::newRow("partial chunk") << 100 << true;
+    QTest::newRow("multiple chunks") << static_cast<qint32>(3 * BinaryDataWriter::cChunkSampleCount + 17) << true;
+    QTest::newRow("uncompressed") << static_cast<qint32>(2 * BinaryDataWriter::cChunkSampleCount + 5) << false;
+}
+
+void TestBinaryDataFile::readBack()
+{
+    QFETCH(qint32, count);
+    QFETCH(bool, bCompress);
+
+    writeSamples(testFilePath(), count, bCompress);
+
+    BinaryDataReader reader;
+    QVERIFY(reader.open(testFilePath()));
+    QCOMPARE(reader.sampleCount(), static_cast<qint64>(count));
+
+    DataFileParser::FileData data;
+    QVERIFY(reader.readData(&data));
+
+    QCOMPARE(data.dataLabel, QStringList() << "Voltage" << "Current, \"A\"");
+    QCOMPARE(data.colors, QList<QColor>() << QColor("#ff0000") << QColor("#0000ff"));
+    QCOMPARE(data.axis, QList<quint32>() << 0 << 1);
+    QCOMPARE(data.notes.size(), 1);
+
+    QCOMPARE(data.timeRow.size(), count);
+    QCOMPARE(data.dataRows.size(), 2);
+    QCOMPARE(data.dataRows[0].size(), count);
+    QCOMPARE(data.dataRows[1].size(), count);
+
+    for (qint32 idx = 0; idx < count; idx++)
+    {
+        QCOMPARE(data.timeRow[idx], idx * 10.5);
+        QCOMPARE(data.dataRows[0][idx], static_cast<double>(idx % 100));
+        QCOMPARE(data.dataRows[1][idx], -0.001 * idx);
+    }
+}
+
+void TestBinaryDataFile::emptyFile()
+{
+    QFile file(testFilePath());
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.close();
+
+    BinaryDataReader reader;
+    QVERIFY(!reader.open(testFilePath()));
+    QVERIFY(!BinaryDataReader::isBinaryDataFile(testFilePath()));
+}
+
+void TestBinaryDataFile::incompleteChunk()
+{
+    const qint32 count = static_cast<qint32>(BinaryDataWriter::cChunkSampleCount) + 10;
+    writeSamples(testFilePath(), count, false);
+
+    /* Simulate crash during write of last chunk */
+    QFile file(testFilePath());
+    QVERIFY(file.open(QIODevice::ReadWrite));
+    QVERIFY(file.resize(file.size() - 8));
+    file.close();
+
+    BinaryDataReader reader;
+    QVERIFY(reader.open(testFilePath()));
+    QCOMPARE(reader.chunkCount(), 1);
+    QCOMPARE(reader.sampleCount(), static_cast<qint64>(BinaryDataWriter::cChunkSampleCount));
+
+    DataFileParser::FileData data;
+    QVERIFY(reader.readData(&data));
+    QCOMPARE(data.timeRow.size(), static_cast<qint32>(BinaryDataWriter::cChunkSampleCount));
+}
+
+void TestBinaryDataFile::noBinaryFile()
+{
+    QFile file(testFilePath());
+    QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Text));
+    file.write("//ModbusScope version;3.8.0\nTime (ms);Voltage\n0;1\n");
+    file.close();
+
+    QVERIFY(!BinaryDataReader::isBinaryDataFile(testFilePath()));
+
+    BinaryDataReader reader;
+    QVERIFY(!reader.open(testFilePath()));
+    QVERIFY(!reader.errorString().isEmpty());
+}
+
+BinaryDataFile::Metadata TestBinaryDataFile::createMetadata()
+{
+    BinaryDataFile::Metadata metadata;
+
+    metadata.version = "3.8.0";
+    metadata.startTime = 1700000000123;
+    metadata.endTime = 1700000100456;
+    metadata.pollTime = 250;
+    metadata.bAbsoluteTimes = true;
+    metadata.bDuringLog = false;
+
+    metadata.graphs.append({ "Voltage", QColor("#ff0000"), "${40001}/10", 0 });
+    metadata.graphs.append({ "Current, \"A\"", QColor("#0000ff"), "${40002}", 1 });
+
+    metadata.notes.append(Note("Start of test", QPointF(10.5, -3)));
+
+    return metadata;
+}
+
+void TestBinaryDataFile::writeSamples(QString filePath, qint32 count, bool bCompress)
+{
+    BinaryDataWriter writer(bCompress);
+    QVERIFY(writer.open(filePath, createMetadata()));
+
+    for (qint32 idx = 0; idx < count; idx++)
+    {
+        QVERIFY(writer.append(idx * 10.5, QList<double>() << static_cast<double>(idx % 100) << -0.001 * idx));
+    }
+
+    QVERIFY(!writer.append(0, QList<double>() << 1));
+
+    writer.close();
+}
+
+QTEST_GUILESS_MAIN(TestBinaryDataFile)
@@ -0,0 +1,26 @@
+
+#include <QObject>
+
+#include "binarydatafile.h"
+
+class TestBinaryDataFile: public QObject
+{
+    Q_OBJECT
+
+private slots:
+
+    void init();
+    void cleanup();
+
+    void metadata();
+    void readBack();
+    void readBack_data();
+    void emptyFile();
+    void incompleteChunk();
+    void noBinaryFile();
+
+private:
+    BinaryDataFile::Metadata createMetadata();
+    void writeSamples(QString filePath, qint32 count, bool bCompress);
+
+};
@@ -6,6 +6,50 @@
 
 #include "datafileparser.h"
 
+static bool parseFromFile(const QString& content, DataParserModel* pDataParserModel, DataFileParser::FileData* pFileData, qint32* pErrorCount = nullptr)
+{
+    QTemporaryFile file;
+    if (!file.open())
+    {
+        return false;
+    }
+
+    file.write(content.toUtf8());
+    file.close();
+
+    QFile dataFile(file.fileName());
+    if (!dataFile.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        return false;
+    }
+
+    QTextStream dataStream(&dataFile);
+    DataFileParser dataFileParser(pDataParserModel);
+    QSignalSpy spyParseError(&dataFileParser, &DataFileParser::parseErrorOccurred);
+
+    const bool bRet = dataFileParser.processDataFile(&dataStream, pFileData);
+
+    if (pErrorCount != nullptr)
+    {
+        *pErrorCount = spyParseError.count();
+    }
+
+    return bRet;
+}
+
+static void prepareDataParserModel(DataParserModel* pDataParserModel, QString fieldSeparator, QString decimalSeparator, QString commentSequence, quint32 labelRow, quint32 column, bool bTimeInMilliSeconds)
+{
+    pDataParserModel->setFieldSeparator(fieldSeparator);
+    pDataParserModel->setGroupSeparator(QChar(' '));
+    pDataParserModel->setDecimalSeparator(decimalSeparator);
+    pDataParserModel->setCommentSequence(commentSequence);
+    pDataParserModel->setLabelRow(labelRow);
+    pDataParserModel->setDataRow(labelRow + 1);
+    pDataParserModel->setColumn(column);
+    pDataParserModel->setTimeInMilliSeconds(bTimeInMilliSeconds);
+    pDataParserModel->setStmStudioCorrection(false);
+}
+
 void TestDataFileParser::init()
 {
 
@@ -546,4 +590,291 @@ void TestDataFileParser::checkProgressSignal()
     QVERIFY(arguments.first().toInt()> 90);
 }
 
+void TestDataFileParser::parseMappedFile_data()
+{
+    QTest::addColumn<QString>("content");
+    QTest::addColumn<QString>("fieldSeparator");
+    QTest::addColumn<QString>("decimalSeparator");
+    QTest::addColumn<QString>("commentSequence");
+    QTest::addColumn<quint32>("labelRow");
+    QTest::addColumn<quint32>("column");
+    QTest::addColumn<bool>("bTimeInMilliSeconds");
+
+    QTest::newRow("OldFormat") << CsvData::cModbusScopeOldFormat << ";" << "," << "//" << 10u << 0u << true;
+    QTest::newRow("NewFormat") << CsvData::cModbusScopeNewFormat << "," << "." << "//" << 22u << 0u << true;
+    QTest::newRow("Be") << CsvData::cDatasetBe << ";" << "," << "" << 0u << 0u << true;
+    QTest::newRow("Us") << CsvData::cDatasetUs << "," << "." << "" << 0u << 0u << true;
+    QTest::newRow("Column2") << CsvData::cDatasetColumn2 << ";" << "," << "" << 0u << 1u << true;
+    QTest::newRow("Comment") << CsvData::cDatasetComment << ";" << "," << "--" << 0u << 0u << true;
+    QTest::newRow("Signed") << CsvData::cDatasetSigned << ";" << "," << "--" << 0u << 0u << true;
+    QTest::newRow("AbsoluteDate") << CsvData::cDatasetAbsoluteDate << ";" << "," << "" << 0u << 0u << true;
+    QTest::newRow("TimeInSecond") << CsvData::cDatasetTimeInSecond << ";" << "," << "" << 0u << 0u << false;
+    QTest::newRow("EmptyLastColumn") << CsvData::cDatasetEmptyLastColumn << ";" << "," << "" << 0u << 0u << true;
+}
+
+void TestDataFileParser::parseMappedFile()
+{
+    QFETCH(QString, content);
+    QFETCH(QString, fieldSeparator);
+    QFETCH(QString, decimalSeparator);
+    QFETCH(QString, commentSequence);
+    QFETCH(quint32, labelRow);
+    QFETCH(quint32, column);
+    QFETCH(bool, bTimeInMilliSeconds);
+
+    DataParserModel dataParserModel;
+    prepareDataParserModel(&dataParserModel, fieldSeparator, decimalSeparator, commentSequence, labelRow, column, bTimeInMilliSeconds);
+
+    /* Reference: parse from string stream */
+    QTextStream dataStream(&content);
+    DataFileParser::FileData expectedData;
+    DataFileParser dataFileParser(&dataParserModel);
+    QVERIFY(dataFileParser.processDataFile(&dataStream, &expectedData));
+
+    /* Parse from memory mapped file */
+    DataFileParser::FileData fileData;
+    qint32 errorCount = -1;
+    QVERIFY(parseFromFile(content, &dataParserModel, &fileData, &errorCount));
+    QCOMPARE(errorCount, 0);
+
+    QCOMPARE(fileData.axisLabel, expectedData.axisLabel);
+    QCOMPARE(fileData.dataLabel, expectedData.dataLabel);
+    QCOMPARE(fileData.timeRow, expectedData.timeRow);
+    QCOMPARE(fileData.dataRows, expectedData.dataRows);
+    QCOMPARE(fileData.colors, expectedData.colors);
+    QCOMPARE(fileData.notes.size(), expectedData.notes.size());
+}
+
+void TestDataFileParser::parseMappedFileChunks()
+{
+    /* Large enough to be split in multiple chunks */
+    const qint32 lineCount = 200000;
+
+    QString content = QString("Time (ms);Register 40001;Register 40002\n");
+    for (qint32 idx = 0; idx < lineCount; idx++)
+    {
+        content.append(QString("%1;%2;-%3,25\n").arg(idx * 10).arg(idx % 1000).arg(idx));
+
+        if (idx % 1000 == 0)
+        {
+            content.append("\n--comment\n");
+        }
+    }
+
+    DataParserModel dataParserModel;
+    prepareDataParserModel(&dataParserModel, ";", ",", "--", 0, 0, true);
+
+    DataFileParser::FileData fileData;
+    qint32 errorCount = -1;
+    QVERIFY(parseFromFile(content, &dataParserModel, &fileData, &errorCount));
+    QCOMPARE(errorCount, 0);
+
+    QCOMPARE(fileData.timeRow.size(), lineCount);
+    QCOMPARE(fileData.dataRows.size(), 2);
+    QCOMPARE(fileData.dataRows[0].size(), lineCount);
+    QCOMPARE(fileData.dataRows[1].size(), lineCount);
+
+    for (qint32 idx = 0; idx < lineCount; idx++)
+    {
+        QCOMPARE(fileData.timeRow[idx], static_cast<double>(idx * 10));
+        QCOMPARE(fileData.dataRows[0][idx], static_cast<double>(idx % 1000));
+        QCOMPARE(fileData.dataRows[1][idx], -idx - 0.25);
+    }
+}
+
+void TestDataFileParser::parseMappedFileError()
+{
+    QString content = QString("Time (ms);Register 40001\n");
+    for (qint32 idx = 0; idx < 100000; idx++)
+    {
+        if (idx == 75000)
+        {
+            content.append("10;20;30\n");
+        }
+        else
+        {
+            content.append(QString("%1;%2\n").arg(idx).arg(idx));
+        }
+    }
+
+    DataParserModel dataParserModel;
+    prepareDataParserModel(&dataParserModel, ";", ",", "", 0, 0, true);
+
+    DataFileParser dataFileParser(&dataParserModel);
+    QSignalSpy spyParseError(&dataFileParser, &DataFileParser::parseErrorOccurred);
+
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    file.write(content.toUtf8());
+    QVERIFY(file.seek(0));
+
+    QTextStream dataStream(&file);
+    DataFileParser::FileData fileData;
+    QVERIFY(!dataFileParser.processDataFile(&dataStream, &fileData));
+
+    QCOMPARE(spyParseError.count(), 1);
+    QVERIFY(spyParseError.takeFirst().first().toString().contains("Line number: 75002"));
+}
+
+void TestDataFileParser::parseMappedBatches()
+{
+    const qint32 lineCount = 20000;
+
+    QString content = QString("Time (ms);Register 40001;Register 40002\n");
+    for (qint32 idx = 0; idx < lineCount; idx++)
+    {
+        content.append(QString("%1;%2;%3,5\n").arg(idx * 10).arg(idx % 100).arg(idx));
+
+        if (idx % 500 == 0)
+        {
+            content.append("--comment\n\n");
+        }
+    }
+
+    DataParserModel dataParserModel;
+    prepareDataParserModel(&dataParserModel, ";", ",", "--", 0, 0, true);
+
+    DataFileParser::FileData expectedData;
+    QVERIFY(parseFromFile(content, &dataParserModel, &expectedData));
+
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    file.write(content.toUtf8());
+    QVERIFY(file.seek(0));
+
+    QTextStream dataStream(&file);
+    DataFileParser dataFileParser(&dataParserModel);
+    QSignalSpy spyParseError(&dataFileParser, &DataFileParser::parseErrorOccurred);
+
+    DataFileParser::FileData fileData;
+    QVERIFY(dataFileParser.processDataFileHeader(&dataStream, &fileData));
+    QVERIFY(dataFileParser.startMappedData(&dataStream));
+
+    QList<double> timeRow;
+    QList<QList<double> > dataRows(2);
+    qint32 batchCount = 0;
+    while (!dataFileParser.mappedDataAtEnd())
+    {
+        QList<double> batchTimeRow;
+        QList<QList<double> > batchDataRows;
+        QVERIFY(dataFileParser.parseNextMappedData(4096, batchTimeRow, batchDataRows));
+        QCOMPARE(batchDataRows.size(), 2);
+
+        timeRow.append(batchTimeRow);
+        dataRows[0].append(batchDataRows[0]);
+        dataRows[1].append(batchDataRows[1]);
+
+        batchCount++;
+    }
+
+    QCOMPARE(spyParseError.count(), 0);
+    QVERIFY(batchCount > 1);
+
+    QCOMPARE(fileData.dataLabel, expectedData.dataLabel);
+    QCOMPARE(timeRow, expectedData.timeRow);
+    QCOMPARE(dataRows, expectedData.dataRows);
+}
+
+void TestDataFileParser::parseMappedBatchesError()
+{
+    QString content = QString("Time (ms);Register 40001\n");
+    for (qint32 idx = 0; idx < 10000; idx++)
+    {
+        if (idx == 7500)
+        {
+            content.append("10;20;30\n");
+        }
+        else
+        {
+            content.append(QString("%1;%2\n").arg(idx).arg(idx));
+        }
+    }
+
+    DataParserModel dataParserModel;
+    prepareDataParserModel(&dataParserModel, ";", ",", "", 0, 0, true);
+
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    file.write(content.toUtf8());
+    QVERIFY(file.seek(0));
+
+    QTextStream dataStream(&file);
+    DataFileParser dataFileParser(&dataParserModel);
+    QSignalSpy spyParseError(&dataFileParser, &DataFileParser::parseErrorOccurred);
+
+    DataFileParser::FileData fileData;
+    QVERIFY(dataFileParser.processDataFileHeader(&dataStream, &fileData));
+    QVERIFY(dataFileParser.startMappedData(&dataStream));
+
+    bool bRet = true;
+    while (bRet && !dataFileParser.mappedDataAtEnd())
+    {
+        QList<double> timeRow;
+        QList<QList<double> > dataRows;
+        bRet = dataFileParser.parseNextMappedData(1000, timeRow, dataRows);
+    }
+
+    QVERIFY(!bRet);
+    QCOMPARE(spyParseError.count(), 1);
+    QVERIFY(spyParseError.takeFirst().first().toString().contains("Line number: 7502"));
+}
+
+void TestDataFileParser::previewMappedFile()
+{
+    const qint32 lineCount = 50000;
+    const qint32 sampleCount = 100;
+
+    QString content = QString("Time (ms);Register 40001\n");
+    for (qint32 idx = 0; idx < lineCount; idx++)
+    {
+        content.append(QString("%1;%2\n").arg(idx * 10).arg(idx % 100));
+
+        if (idx % 333 == 0)
+        {
+            content.append("--comment\n");
+        }
+    }
+
+    DataParserModel dataParserModel;
+    prepareDataParserModel(&dataParserModel, ";", ",", "--", 0, 0, true);
+
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    file.write(content.toUtf8());
+    QVERIFY(file.seek(0));
+
+    QTextStream dataStream(&file);
+    DataFileParser dataFileParser(&dataParserModel);
+
+    DataFileParser::FileData fileData;
+    QVERIFY(dataFileParser.processDataFileHeader(&dataStream, &fileData));
+    QVERIFY(dataFileParser.startMappedData(&dataStream));
+
+    QList<double> timeRow;
+    QList<QList<double> > dataRows;
+    dataFileParser.previewMappedData(sampleCount, timeRow, dataRows);
+
+    QVERIFY(timeRow.size() > sampleCount / 2);
+    QVERIFY(timeRow.size() <= sampleCount + 1);
+    QCOMPARE(dataRows.size(), 1);
+    QCOMPARE(dataRows[0].size(), timeRow.size());
+
+    QCOMPARE(timeRow.first(), 0.0);
+    QCOMPARE(timeRow.last(), static_cast<double>((lineCount - 1) * 10));
+
+    for (qint32 idx = 0; idx < timeRow.size(); idx++)
+    {
+        if (idx > 0)
+        {
+            QVERIFY(timeRow[idx] > timeRow[idx - 1]);
+        }
+
+        /* Value matches time of sample */
+        QCOMPARE(dataRows[0][idx], static_cast<double>(static_cast<qint32>(timeRow[idx] / 10) % 100));
+    }
+
+    /* Preview doesn't consume data */
+    QVERIFY(!dataFileParser.mappedDataAtEnd());
+}
+
 QTEST_GUILESS_MAIN(TestDataFileParser)
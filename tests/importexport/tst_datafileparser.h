@@ -27,6 +27,15 @@ private slots:
 
     void checkProgressSignal();
 
+    void parseMappedFile_data();
+    void parseMappedFile();
+    void parseMappedFileChunks();
+    void parseMappedFileError();
+
+    void parseMappedBatches();
+    void parseMappedBatchesError();
+    void previewMappedFile();
+
 private:
 
 };
@@ -0,0 +1,450 @@
+
+#include <QtTest/QtTest>
+
+#include "binarydatareader.h"
+#include "datalogwriter.h"
+
+#include "tst_datalogwriter.h"
+
+static QString csvFilePath()
+{
+    return QDir::temp().filePath("tst_datalogwriter.csv");
+}
+
+static QString binaryFilePath()
+{
+    return QDir::temp().filePath("tst_datalogwriter.mbsd");
+}
+
+static double sampleValue(qint32 column, qint32 idx)
+{
+    return column == 0 ? static_cast<double>(idx % 100) : -0.5 * idx;
+}
+
+static QList<double> sampleValues(qint32 idx)
+{
+    return QList<double>() << sampleValue(0, idx) << sampleValue(1, idx);
+}
+
+void TestDataLogWriter::init()
+{
+    QFile::remove(csvFilePath());
+    QFile::remove(binaryFilePath());
+}
+
+void TestDataLogWriter::cleanup()
+{
+    QFile::remove(csvFilePath());
+    QFile::remove(binaryFilePath());
+}
+
+void TestDataLogWriter::csvLog()
+{
+    DataLogWriter writer;
+    QVERIFY(writer.open(csvSettings()));
+    QVERIFY(writer.isOpen());
+
+    for (qint32 idx = 0; idx < 10; idx++)
+    {
+        QVERIFY(writer.push(idx * 100, sampleValues(idx)));
+    }
+
+    writer.processQueue();
+
+    /* Data is written before the log is closed */
+    QStringList lines = readLines(csvFilePath());
+    QCOMPARE(lines.size(), 3 + 10);
+
+    writer.close();
+    QVERIFY(!writer.isOpen());
+
+    lines = readLines(csvFilePath());
+    QCOMPARE(lines.size(), 3 + 10);
+
+    QCOMPARE(lines[0], QString("//ModbusScope version;3.8.0"));
+
+    /* Reserved space is added to comment line */
+    QVERIFY(lines[1].size() > static_cast<qint32>(DataLogWriter::cHeaderReserve));
+    QCOMPARE(lines[1].trimmed(), QString("//"));
+
+    QCOMPARE(lines[2], QString("Time (ms);Voltage;Current"));
+
+    verifyCsvData(lines, 3, 10);
+}
+
+void TestDataLogWriter::csvHeaderInPlace()
+{
+    DataLogWriter writer;
+    QVERIFY(writer.open(csvSettings()));
+
+    for (qint32 idx = 0; idx < 10; idx++)
+    {
+        QVERIFY(writer.push(idx * 100, sampleValues(idx)));
+    }
+    writer.processQueue();
+
+    const qint64 fileSize = QFileInfo(csvFilePath()).size();
+
+    DataLogWriter::Settings settings = csvSettings();
+    settings.headerLines.insert(1, "//Color;#ff0000;#00ff00");
+    QVERIFY(writer.updateHeader(settings));
+
+    /* Samples aren't rewritten */
+    QCOMPARE(QFileInfo(csvFilePath()).size(), fileSize);
+
+    for (qint32 idx = 10; idx < 20; idx++)
+    {
+        QVERIFY(writer.push(idx * 100, sampleValues(idx)));
+    }
+    writer.close();
+
+    const QStringList lines = readLines(csvFilePath());
+    QCOMPARE(lines.size(), 4 + 20);
+    QCOMPARE(lines[0], QString("//ModbusScope version;3.8.0"));
+    QCOMPARE(lines[1], QString("//Color;#ff0000;#00ff00"));
+    QCOMPARE(lines[2].trimmed(), QString("//"));
+    QCOMPARE(lines[3], QString("Time (ms);Voltage;Current"));
+
+    verifyCsvData(lines, 4, 20);
+}
+
+void TestDataLogWriter::csvHeaderGrows()
+{
+    DataLogWriter writer;
+    QVERIFY(writer.open(csvSettings()));
+
+    for (qint32 idx = 0; idx < 10; idx++)
+    {
+        QVERIFY(writer.push(idx * 100, sampleValues(idx)));
+    }
+    writer.processQueue();
+
+    /* Header doesn't fit in reserved space */
+    const QString longNote = QString("//Note;0;0;\"%1\"").arg(QString(2 * DataLogWriter::cHeaderReserve, 'x'));
+    DataLogWriter::Settings settings = csvSettings();
+    settings.headerLines.insert(1, longNote);
+    QVERIFY(writer.updateHeader(settings));
+    QVERIFY(writer.isOpen());
+
+    for (qint32 idx = 10; idx < 20; idx++)
+    {
+        QVERIFY(writer.push(idx * 100, sampleValues(idx)));
+    }
+    writer.processQueue();
+
+    /* Header is updated in place again */
+    settings.headerLines[1] = "//Note;0;0;\"short\"";
+    QVERIFY(writer.updateHeader(settings));
+
+    writer.close();
+
+    const QStringList lines = readLines(csvFilePath());
+    QCOMPARE(lines.size(), 4 + 20);
+    QCOMPARE(lines[1], QString("//Note;0;0;\"short\""));
+    QCOMPARE(lines[2].trimmed(), QString("//"));
+    QCOMPARE(lines[3], QString("Time (ms);Voltage;Current"));
+
+    verifyCsvData(lines, 4, 20);
+}
+
+void TestDataLogWriter::binaryLog()
+{
+    const qint32 count = 2 * static_cast<qint32>(BinaryDataWriter::cChunkSampleCount) + 10;
+
+    DataLogWriter writer;
+    QVERIFY(writer.open(binarySettings()));
+
+    for (qint32 idx = 0; idx < count; idx++)
+    {
+        QVERIFY(writer.push(idx * 100, sampleValues(idx)));
+    }
+    writer.close();
+
+    BinaryDataReader reader;
+    QVERIFY(reader.open(binaryFilePath()));
+    QCOMPARE(reader.metadata().graphs.size(), 2);
+    QCOMPARE(reader.metadata().bDuringLog, true);
+
+    DataFileParser::FileData data;
+    QVERIFY(reader.readData(&data));
+    QCOMPARE(data.timeRow.size(), count);
+
+    for (qint32 idx = 0; idx < count; idx++)
+    {
+        QCOMPARE(data.timeRow[idx], idx * 100.0);
+        QCOMPARE(data.dataRows[0][idx], sampleValue(0, idx));
+        QCOMPARE(data.dataRows[1][idx], sampleValue(1, idx));
+    }
+}
+
+void TestDataLogWriter::binaryHeaderInPlace()
+{
+    DataLogWriter writer;
+    QVERIFY(writer.open(binarySettings()));
+
+    for (qint32 idx = 0; idx < 100; idx++)
+    {
+        QVERIFY(writer.push(idx * 100, sampleValues(idx)));
+    }
+    writer.processQueue();
+
+    const qint64 fileSize = QFileInfo(binaryFilePath()).size();
+
+    DataLogWriter::Settings settings = binarySettings();
+    settings.metadata.graphs[1].color = QColor("#00ff00");
+    QVERIFY(writer.updateHeader(settings));
+
+    QCOMPARE(QFileInfo(binaryFilePath()).size(), fileSize);
+
+    for (qint32 idx = 100; idx < 200; idx++)
+    {
+        QVERIFY(writer.push(idx * 100, sampleValues(idx)));
+    }
+    writer.close();
+
+    BinaryDataReader reader;
+    QVERIFY(reader.open(binaryFilePath()));
+    QCOMPARE(reader.metadata().graphs[1].color, QColor("#00ff00"));
+    QCOMPARE(reader.sampleCount(), static_cast<qint64>(200));
+}
+
+void TestDataLogWriter::binaryHeaderGrows()
+{
+    DataLogWriter writer;
+    QVERIFY(writer.open(binarySettings()));
+
+    for (qint32 idx = 0; idx < 100; idx++)
+    {
+        QVERIFY(writer.push(idx * 100, sampleValues(idx)));
+    }
+    writer.processQueue();
+
+    DataLogWriter::Settings settings = binarySettings();
+    settings.metadata.notes.append(Note(QString(2 * DataLogWriter::cHeaderReserve, 'x'), QPointF(1, 2)));
+    QVERIFY(writer.updateHeader(settings));
+    QVERIFY(writer.isOpen());
+
+    for (qint32 idx = 100; idx < 200; idx++)
+    {
+        QVERIFY(writer.push(idx * 100, sampleValues(idx)));
+    }
+    writer.close();
+
+    BinaryDataReader reader;
+    QVERIFY(reader.open(binaryFilePath()));
+    QCOMPARE(reader.metadata().notes.size(), 1);
+    QCOMPARE(reader.metadata().notes[0].text().size(), static_cast<qsizetype>(2 * DataLogWriter::cHeaderReserve));
+
+    DataFileParser::FileData data;
+    QVERIFY(reader.readData(&data));
+    QCOMPARE(data.timeRow.size(), 200);
+    for (qint32 idx = 0; idx < 200; idx++)
+    {
+        QCOMPARE(data.timeRow[idx], idx * 100.0);
+        QCOMPARE(data.dataRows[1][idx], sampleValue(1, idx));
+    }
+}
+
+void TestDataLogWriter::binaryFullChunks()
+{
+    const qint32 chunkSize = static_cast<qint32>(BinaryDataWriter::cChunkSampleCount);
+
+    DataLogWriter writer;
+    QVERIFY(writer.open(binarySettings()));
+
+    const qint64 headerSize = QFileInfo(binaryFilePath()).size();
+
+    /* Batches smaller than a chunk aren't written yet */
+    qint32 count = 0;
+    for (qint32 batch = 0; batch < 10; batch++)
+    {
+        for (qint32 idx = 0; idx < 100; idx++)
+        {
+            QVERIFY(writer.push(count * 100, sampleValues(count)));
+            count++;
+        }
+        writer.processQueue();
+
+        QCOMPARE(QFileInfo(binaryFilePath()).size(), headerSize);
+    }
+
+    /* Complete chunk is written */
+    while (count < chunkSize + 10)
+    {
+        QVERIFY(writer.push(count * 100, sampleValues(count)));
+        count++;
+    }
+    writer.processQueue();
+
+    QVERIFY(QFileInfo(binaryFilePath()).size() > headerSize);
+
+    /* Partial chunk is written on close */
+    writer.close();
+
+    BinaryDataReader reader;
+    QVERIFY(reader.open(binaryFilePath()));
+    QCOMPARE(reader.chunkCount(), 2);
+    QCOMPARE(reader.sampleCount(), static_cast<qint64>(count));
+}
+
+void TestDataLogWriter::closeWritesQueued()
+{
+    DataLogWriter writer;
+    QVERIFY(writer.open(csvSettings()));
+
+    for (qint32 idx = 0; idx < 3 * DataLogWriter::cBatchSize; idx++)
+    {
+        QVERIFY(writer.push(idx * 100, sampleValues(idx)));
+    }
+
+    writer.close();
+
+    const QStringList lines = readLines(csvFilePath());
+    QCOMPARE(lines.size(), 3 + 3 * DataLogWriter::cBatchSize);
+    verifyCsvData(lines, 3, 3 * DataLogWriter::cBatchSize);
+}
+
+void TestDataLogWriter::reopenDiscardsQueued()
+{
+    DataLogWriter writer;
+    QVERIFY(writer.open(csvSettings()));
+
+    for (qint32 idx = 0; idx < 10; idx++)
+    {
+        QVERIFY(writer.push(idx * 100, sampleValues(idx)));
+    }
+    writer.processQueue();
+
+    QVERIFY(writer.push(1000, sampleValues(10)));
+
+    /* Restart of log, for example after clearing data */
+    QVERIFY(writer.open(csvSettings()));
+    QVERIFY(writer.push(0, sampleValues(0)));
+    writer.close();
+
+    const QStringList lines = readLines(csvFilePath());
+    QCOMPARE(lines.size(), 3 + 1);
+    verifyCsvData(lines, 3, 1);
+}
+
+void TestDataLogWriter::pushNotOpen()
+{
+    DataLogWriter writer;
+    QVERIFY(!writer.isOpen());
+    QVERIFY(!writer.push(0, sampleValues(0)));
+
+    QVERIFY(writer.open(csvSettings()));
+
+    /* Column count doesn't match */
+    QVERIFY(!writer.push(0, QList<double>() << 1));
+
+    writer.close();
+    QVERIFY(!writer.push(0, sampleValues(0)));
+
+    DataLogWriter::Settings settings = csvSettings();
+    QVERIFY(!writer.updateHeader(settings));
+}
+
+void TestDataLogWriter::pushQueueFull()
+{
+    DataLogWriter::Settings settings = csvSettings();
+    settings.syncPolicy = DataLogWriter::SYNC_NONE;
+
+    DataLogWriter writer;
+    QVERIFY(writer.open(settings));
+
+    /* Writer thread isn't running yet, so nothing takes records from the queue */
+    QThread writerThread;
+    writer.moveToThread(&writerThread);
+
+    qint32 count = 0;
+    while (
+        (count < static_cast<qint32>(LogRecordQueue::cValueCapacity))
+        && writer.push(count * 100, sampleValues(count))
+    )
+    {
+        count++;
+    }
+
+    /* Producer doesn't wait when queue is full */
+    QVERIFY(count < static_cast<qint32>(LogRecordQueue::cValueCapacity));
+    QVERIFY(!writer.push(count * 100, sampleValues(count)));
+    QCOMPARE(writer.droppedCount(), static_cast<quint64>(2));
+
+    QTest::ignoreMessage(QtWarningMsg, QRegularExpression("2 samples are missing"));
+
+    writerThread.start();
+    QMetaObject::invokeMethod(&writer, [&writer]() {
+        writer.close();
+    }, Qt::BlockingQueuedConnection);
+    writerThread.quit();
+    writerThread.wait();
+
+    /* Queued records are written */
+    QStringList lines = readLines(csvFilePath());
+    QCOMPARE(lines.size(), 3 + count);
+    verifyCsvData(lines, 3, 10);
+}
+
+DataLogWriter::Settings TestDataLogWriter::csvSettings()
+{
+    DataLogWriter::Settings settings;
+
+    settings.filePath = csvFilePath();
+    settings.bBinary = false;
+    settings.columnCount = 2;
+    settings.syncPolicy = DataLogWriter::SYNC_EVERY_BATCH;
+    settings.headerLines = QStringList() << "//ModbusScope version;3.8.0" << "//" << "Time (ms);Voltage;Current";
+    settings.bAbsoluteTimes = false;
+
+    return settings;
+}
+
+DataLogWriter::Settings TestDataLogWriter::binarySettings()
+{
+    DataLogWriter::Settings settings;
+
+    settings.filePath = binaryFilePath();
+    settings.bBinary = true;
+    settings.columnCount = 2;
+    settings.syncPolicy = DataLogWriter::SYNC_PERIODIC;
+    settings.bAbsoluteTimes = false;
+
+    settings.metadata.version = "3.8.0";
+    settings.metadata.startTime = 1700000000123;
+    settings.metadata.endTime = 0;
+    settings.metadata.pollTime = 250;
+    settings.metadata.bAbsoluteTimes = false;
+    settings.metadata.bDuringLog = true;
+    settings.metadata.graphs.append({ "Voltage", QColor("#ff0000"), "${40001}", 0 });
+    settings.metadata.graphs.append({ "Current", QColor("#0000ff"), "${40002}", 1 });
+
+    return settings;
+}
+
+QStringList TestDataLogWriter::readLines(QString filePath)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        return QStringList();
+    }
+
+    QStringList lines = QString::fromUtf8(file.readAll()).split('\n');
+    if (!lines.isEmpty() && lines.last().isEmpty())
+    {
+        lines.removeLast();
+    }
+
+    return lines;
+}
+
+void TestDataLogWriter::verifyCsvData(const QStringList& lines, qint32 firstLine, qint32 count)
+{
+    for (qint32 idx = 0; idx < count; idx++)
+    {
+        QCOMPARE(lines[firstLine + idx], DataLogWriter::formatDataLine(idx * 100, sampleValues(idx), false));
+    }
+}
+
+QTEST_GUILESS_MAIN(TestDataLogWriter)
@@ -0,0 +1,33 @@
+
+#include <QObject>
+
+#include "datalogwriter.h"
+
+class TestDataLogWriter: public QObject
+{
+    Q_OBJECT
+
+private slots:
+
+    void init();
+    void cleanup();
+
+    void csvLog();
+    void csvHeaderInPlace();
+    void csvHeaderGrows();
+    void binaryLog();
+    void binaryHeaderInPlace();
+    void binaryHeaderGrows();
+    void binaryFullChunks();
+    void closeWritesQueued();
+    void reopenDiscardsQueued();
+    void pushNotOpen();
+    void pushQueueFull();
+
+private:
+    DataLogWriter::Settings csvSettings();
+    DataLogWriter::Settings binarySettings();
+    QStringList readLines(QString filePath);
+    void verifyCsvData(const QStringList& lines, qint32 firstLine, qint32 count);
+
+};
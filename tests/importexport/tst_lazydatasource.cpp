@@ -0,0 +1,432 @@
+
+#include <QtTest/QtTest>
+
+#include "binarydatawriter.h"
+#include "datafileindex.h"
+#include "graphdataindex.h"
+#include "lazydatasource.h"
+
+#include "tst_lazydatasource.h"
+
+/* More blocks than are decoded for a window */
+static const qint32 cSampleCount = 40 * BinaryDataWriter::cChunkSampleCount + 17;
+static const qint32 cBlockCount = 41;
+
+static QString testFilePath()
+{
+    return QDir::temp().filePath("tst_lazydatasource.mbsd");
+}
+
+static double sampleKey(qint32 idx)
+{
+    return idx * 10.5;
+}
+
+static double sampleValue(qint32 graphIdx, qint32 idx)
+{
+    return graphIdx == 0 ? static_cast<double>(idx % 100) : -0.001 * idx;
+}
+
+/* Graph 0 isn't polled during second block, graph 1 only every other sample */
+static double absentValue(qint32 graphIdx, qint32 idx)
+{
+    const qint32 chunkSize = static_cast<qint32>(BinaryDataWriter::cChunkSampleCount);
+
+    if (
+        ((graphIdx == 0) && (idx / chunkSize == 1))
+        || ((graphIdx == 1) && (idx % 2 == 1))
+    )
+    {
+        return qQNaN();
+    }
+
+    return sampleValue(graphIdx, idx);
+}
+
+static bool fuzzyCompare(double actual, double expected)
+{
+    return qAbs(actual - expected) <= 1e-9 * qMax(1.0, qAbs(expected));
+}
+
+void TestLazyDataSource::init()
+{
+    QFile::remove(testFilePath());
+    QFile::remove(DataFileIndex::indexFilePath(testFilePath()));
+}
+
+void TestLazyDataSource::cleanup()
+{
+    QFile::remove(testFilePath());
+    QFile::remove(DataFileIndex::indexFilePath(testFilePath()));
+}
+
+void TestLazyDataSource::indexCache()
+{
+    writeSamples(testFilePath(), cSampleCount);
+
+    QList<int> progress;
+    auto progressCallback = [&progress](int percentage) { progress.append(percentage); };
+
+    LazyDataSource source;
+    QVERIFY(source.open(testFilePath(), progressCallback));
+    QVERIFY(!source.isIndexCached());
+    QVERIFY(QFile::exists(DataFileIndex::indexFilePath(testFilePath())));
+    QVERIFY(!progress.isEmpty());
+    QCOMPARE(progress.last(), 100);
+
+    QCOMPARE(source.graphCount(), 2);
+    QCOMPARE(source.blockCount(), cBlockCount);
+    QCOMPARE(source.sampleCount(), static_cast<qint64>(cSampleCount));
+
+    bool bFoundRange = false;
+    const QCPRange range = source.keyRange(bFoundRange);
+    QVERIFY(bFoundRange);
+    QCOMPARE(range.lower, sampleKey(0));
+    QCOMPARE(range.upper, sampleKey(cSampleCount - 1));
+
+    /* Second open uses cache */
+    progress.clear();
+
+    LazyDataSource cachedSource;
+    QVERIFY(cachedSource.open(testFilePath(), progressCallback));
+    QVERIFY(cachedSource.isIndexCached());
+    QVERIFY(progress.isEmpty());
+    QCOMPARE(cachedSource.blockCount(), cBlockCount);
+    QCOMPARE(cachedSource.sampleCount(), static_cast<qint64>(cSampleCount));
+
+    const GraphDataIndex::Statistics stats = source.statistics(1, range.lower, range.upper);
+    const GraphDataIndex::Statistics cachedStats = cachedSource.statistics(1, range.lower, range.upper);
+    QCOMPARE(cachedStats.count, stats.count);
+    QCOMPARE(cachedStats.average, stats.average);
+    QCOMPARE(cachedStats.integral, stats.integral);
+}
+
+void TestLazyDataSource::staleIndexCache()
+{
+    writeSamples(testFilePath(), cSampleCount);
+
+    {
+        LazyDataSource source;
+        QVERIFY(source.open(testFilePath(), [](int) {}));
+        QVERIFY(!source.isIndexCached());
+    }
+
+    /* Data file changes, so cache is outdated */
+    const qint32 newCount = cSampleCount - static_cast<qint32>(BinaryDataWriter::cChunkSampleCount);
+    writeSamples(testFilePath(), newCount);
+
+    LazyDataSource source;
+    QVERIFY(source.open(testFilePath(), [](int) {}));
+    QVERIFY(!source.isIndexCached());
+    QCOMPARE(source.sampleCount(), static_cast<qint64>(newCount));
+
+    /* Corrupt cache is rebuilt */
+    QFile indexFile(DataFileIndex::indexFilePath(testFilePath()));
+    QVERIFY(indexFile.open(QIODevice::ReadWrite));
+    QVERIFY(indexFile.resize(indexFile.size() / 2));
+    indexFile.close();
+
+    LazyDataSource rebuiltSource;
+    QVERIFY(rebuiltSource.open(testFilePath(), [](int) {}));
+    QVERIFY(!rebuiltSource.isIndexCached());
+    QCOMPARE(rebuiltSource.sampleCount(), static_cast<qint64>(newCount));
+}
+
+void TestLazyDataSource::rawWindow()
+{
+    writeSamples(testFilePath(), cSampleCount);
+
+    LazyDataSource source;
+    QVERIFY(source.open(testFilePath(), [](int) {}));
+
+    /* Range in second block, neighbouring blocks are included */
+    const qint32 chunkSize = static_cast<qint32>(BinaryDataWriter::cChunkSampleCount);
+    QList<double> timeRow;
+    QList<QList<double> > dataRows;
+    source.window(QCPRange(sampleKey(chunkSize + 100), sampleKey(chunkSize + 200)), 100000, timeRow, dataRows);
+
+    QCOMPARE(timeRow.size(), 3 * chunkSize);
+    QCOMPARE(dataRows.size(), 2);
+    QCOMPARE(dataRows[0].size(), 3 * chunkSize);
+
+    for (qint32 idx = 0; idx < timeRow.size(); idx++)
+    {
+        QCOMPARE(timeRow[idx], sampleKey(idx));
+        QCOMPARE(dataRows[0][idx], sampleValue(0, idx));
+        QCOMPARE(dataRows[1][idx], sampleValue(1, idx));
+    }
+}
+
+void TestLazyDataSource::envelopeWindow()
+{
+    writeSamples(testFilePath(), cSampleCount);
+
+    LazyDataSource source;
+    QVERIFY(source.open(testFilePath(), [](int) {}));
+
+    bool bFoundRange = false;
+    const QCPRange range = source.keyRange(bFoundRange);
+
+    /* Index envelope has enough detail for the number of buckets */
+    const qint32 envelopeBucketCount = cSampleCount / DataFileIndex::cEnvelopeBucketSize;
+    QList<double> timeRow;
+    QList<QList<double> > dataRows;
+    source.window(range, envelopeBucketCount, timeRow, dataRows);
+
+    const qint32 bucketsPerBlock = static_cast<qint32>(BinaryDataWriter::cChunkSampleCount) / DataFileIndex::cEnvelopeBucketSize;
+    const qint32 expectedCount = 2 * ((cBlockCount - 1) * bucketsPerBlock + 1);
+    QCOMPARE(timeRow.size(), expectedCount);
+    QCOMPARE(dataRows[0].size(), expectedCount);
+    QCOMPARE(dataRows[1].size(), expectedCount);
+
+    QCOMPARE(timeRow.first(), sampleKey(0));
+    QCOMPARE(timeRow.last(), sampleKey(cSampleCount - 1));
+
+    /* Every bucket of 256 samples contains a complete period of graph 0 */
+    for (qint32 idx = 0; idx + 2 < timeRow.size(); idx += 2)
+    {
+        QVERIFY(timeRow[idx] <= timeRow[idx + 1]);
+        QCOMPARE(qMin(dataRows[0][idx], dataRows[0][idx + 1]), 0.0);
+        QCOMPARE(qMax(dataRows[0][idx], dataRows[0][idx + 1]), 99.0);
+
+        /* Decreasing graph: maximum comes first */
+        QCOMPARE(dataRows[1][idx], sampleValue(1, idx / 2 * DataFileIndex::cEnvelopeBucketSize));
+    }
+}
+
+void TestLazyDataSource::summaryWindow()
+{
+    writeSamples(testFilePath(), cSampleCount);
+
+    LazyDataSource source;
+    QVERIFY(source.open(testFilePath(), [](int) {}));
+
+    bool bFoundRange = false;
+    const QCPRange range = source.keyRange(bFoundRange);
+
+    QList<double> timeRow;
+    QList<QList<double> > dataRows;
+    const qint32 maxBuckets = 10;
+    source.window(range, maxBuckets, timeRow, dataRows);
+
+    /* Minimum and maximum per bucket of 5 blocks, number of points doesn't depend on file size */
+    const qint32 blocksPerBucket = 5;
+    const qint32 bucketCount = (cBlockCount + blocksPerBucket - 1) / blocksPerBucket;
+    QVERIFY(bucketCount <= maxBuckets);
+    QCOMPARE(timeRow.size(), 2 * bucketCount);
+    QCOMPARE(dataRows[0].size(), 2 * bucketCount);
+    QCOMPARE(dataRows[1].size(), 2 * bucketCount);
+
+    const qint32 chunkSize = static_cast<qint32>(BinaryDataWriter::cChunkSampleCount);
+    for (qint32 bucketIdx = 0; bucketIdx < bucketCount; bucketIdx++)
+    {
+        const qint32 firstIdx = bucketIdx * blocksPerBucket * chunkSize;
+        const qint32 lastIdx = qMin(firstIdx + blocksPerBucket * chunkSize, cSampleCount) - 1;
+
+        QCOMPARE(timeRow[2 * bucketIdx], sampleKey(firstIdx));
+        QCOMPARE(timeRow[2 * bucketIdx + 1], sampleKey(lastIdx));
+
+        /* Decreasing graph: maximum comes first */
+        QCOMPARE(dataRows[1][2 * bucketIdx], sampleValue(1, firstIdx));
+        QCOMPARE(dataRows[1][2 * bucketIdx + 1], sampleValue(1, lastIdx));
+
+        QCOMPARE(qMin(dataRows[0][2 * bucketIdx], dataRows[0][2 * bucketIdx + 1]), 0.0);
+        QCOMPARE(qMax(dataRows[0][2 * bucketIdx], dataRows[0][2 * bucketIdx + 1]), 99.0);
+    }
+}
+
+void TestLazyDataSource::statistics_data()
+{
+    QTest::addColumn<qint32>("graphIdx");
+    QTest::addColumn<qint32>("startIdx");
+    QTest::addColumn<qint32>("endIdx");
+
+    const qint32 chunkSize = static_cast<qint32>(BinaryDataWriter::cChunkSampleCount);
+
+    QTest::newRow("complete file") << 0 << 0 << cSampleCount - 1;
+    QTest::newRow("inside block") << 1 << 10 << 200;
+    QTest::newRow("partial blocks") << 1 << chunkSize / 2 << 30 * chunkSize + 7;
+    QTest::newRow("block boundaries") << 0 << chunkSize << 20 * chunkSize - 1;
+}
+
+void TestLazyDataSource::statistics()
+{
+    QFETCH(qint32, graphIdx);
+    QFETCH(qint32, startIdx);
+    QFETCH(qint32, endIdx);
+
+    writeSamples(testFilePath(), cSampleCount);
+
+    LazyDataSource source;
+    QVERIFY(source.open(testFilePath(), [](int) {}));
+
+    /* Same result as statistics of completely loaded graph */
+    QVector<double> keys;
+    QVector<double> values;
+    for (qint32 idx = 0; idx < cSampleCount; idx++)
+    {
+        keys.append(sampleKey(idx));
+        values.append(sampleValue(graphIdx, idx));
+    }
+
+    GraphDataIndex::Samples samples;
+    samples.pKeys = keys.constData();
+    samples.pValues = values.constData();
+    samples.count = keys.size();
+    samples.pValidity = nullptr;
+    samples.validityOffset = 0;
+
+    GraphDataIndex dataIndex;
+    const GraphDataIndex::Statistics expected = dataIndex.statistics(samples, startIdx, endIdx + 1);
+    const GraphDataIndex::Statistics actual = source.statistics(graphIdx, sampleKey(startIdx), sampleKey(endIdx));
+
+    QCOMPARE(actual.count, expected.count);
+    QCOMPARE(actual.minimum, expected.minimum);
+    QCOMPARE(actual.maximum, expected.maximum);
+    QVERIFY(fuzzyCompare(actual.average, expected.average));
+    QVERIFY(fuzzyCompare(actual.standardDeviation, expected.standardDeviation));
+    QVERIFY(fuzzyCompare(actual.rms, expected.rms));
+    QVERIFY(fuzzyCompare(actual.integral, expected.integral));
+}
+
+void TestLazyDataSource::valueAt()
+{
+    writeSamples(testFilePath(), cSampleCount);
+
+    LazyDataSource source;
+    QVERIFY(source.open(testFilePath(), [](int) {}));
+
+    QCOMPARE(source.valueAt(0, sampleKey(1000)), sampleValue(0, 1000));
+    QCOMPARE(source.valueAt(0, sampleKey(1000) + 1), sampleValue(0, 1001));
+    QCOMPARE(source.valueAt(1, sampleKey(0) - 100), sampleValue(1, 0));
+    QCOMPARE(source.valueAt(1, sampleKey(cSampleCount - 1) + 100), sampleValue(1, cSampleCount - 1));
+
+    /* Last sample of block, next sample is in next block */
+    const qint32 lastOfBlock = static_cast<qint32>(BinaryDataWriter::cChunkSampleCount) - 1;
+    QCOMPARE(source.valueAt(1, sampleKey(lastOfBlock) + 1), sampleValue(1, lastOfBlock + 1));
+
+    QCOMPARE(source.valueAt(2, sampleKey(0)), 0.0);
+}
+
+void TestLazyDataSource::absentSamples()
+{
+    writeSamples(testFilePath(), cSampleCount, true);
+
+    LazyDataSource source;
+    QVERIFY(source.open(testFilePath(), [](int) {}));
+
+    const qint32 chunkSize = static_cast<qint32>(BinaryDataWriter::cChunkSampleCount);
+
+    /* Statistics only use samples with a value, edges of range are in partial blocks */
+    for (qint32 graphIdx = 0; graphIdx < 2; graphIdx++)
+    {
+        const qint32 startIdx = chunkSize - 10;
+        const qint32 endIdx = 3 * chunkSize + 7;
+
+        qint64 count = 0;
+        double minimum = 0;
+        double maximum = 0;
+        double sum = 0;
+        double area = 0;
+        for (qint32 idx = startIdx; idx <= endIdx; idx++)
+        {
+            const double value = absentValue(graphIdx, idx);
+            if (qIsNaN(value))
+            {
+                continue;
+            }
+
+            minimum = count == 0 ? value : qMin(minimum, value);
+            maximum = count == 0 ? value : qMax(maximum, value);
+            sum += value;
+            count++;
+
+            if (
+                (idx < endIdx)
+                && !qIsNaN(absentValue(graphIdx, idx + 1))
+            )
+            {
+                area += (sampleKey(idx + 1) - sampleKey(idx)) * (value + absentValue(graphIdx, idx + 1)) / 2;
+            }
+        }
+
+        const GraphDataIndex::Statistics stats = source.statistics(graphIdx, sampleKey(startIdx), sampleKey(endIdx));
+
+        QCOMPARE(stats.count, count);
+        QCOMPARE(stats.minimum, minimum);
+        QCOMPARE(stats.maximum, maximum);
+        QVERIFY(fuzzyCompare(stats.average, sum / static_cast<double>(count)));
+        QVERIFY(fuzzyCompare(stats.integral, area / 1000));
+        QVERIFY(!qIsNaN(stats.standardDeviation));
+    }
+
+    QList<double> timeRow;
+    QList<QList<double> > dataRows;
+
+    /* Decoded samples of three blocks, reduced to buckets of 16 samples */
+    source.window(QCPRange(sampleKey(chunkSize + 100), sampleKey(chunkSize + 200)), 768, timeRow, dataRows);
+    QVERIFY(timeRow.size() < 3 * chunkSize);
+    verifyAbsentWindow(timeRow, dataRows);
+
+    bool bFoundRange = false;
+    const QCPRange range = source.keyRange(bFoundRange);
+
+    /* Envelope of index */
+    source.window(range, cSampleCount / DataFileIndex::cEnvelopeBucketSize, timeRow, dataRows);
+    verifyAbsentWindow(timeRow, dataRows);
+
+    /* Summaries of index, a bucket per block */
+    source.window(range, cBlockCount, timeRow, dataRows);
+    verifyAbsentWindow(timeRow, dataRows);
+}
+
+/* Graph 0 only has NaN in the second block, graph 1 always has a value in a bucket */
+void TestLazyDataSource::verifyAbsentWindow(const QList<double> &timeRow, const QList<QList<double> > &dataRows)
+{
+    const qint32 chunkSize = static_cast<qint32>(BinaryDataWriter::cChunkSampleCount);
+
+    QVERIFY(!timeRow.isEmpty());
+    QCOMPARE(dataRows.size(), 2);
+    QCOMPARE(dataRows[0].size(), timeRow.size());
+    QCOMPARE(dataRows[1].size(), timeRow.size());
+
+    for (qint32 idx = 0; idx < timeRow.size(); idx++)
+    {
+        const bool bSecondBlock = (timeRow[idx] >= sampleKey(chunkSize)) && (timeRow[idx] <= sampleKey(2 * chunkSize - 1));
+
+        QCOMPARE(qIsNaN(dataRows[0][idx]), bSecondBlock);
+        QVERIFY(!qIsNaN(dataRows[1][idx]));
+    }
+}
+
+void TestLazyDataSource::writeSamples(QString filePath, qint32 count, bool bAbsent)
+{
+    BinaryDataFile::Metadata metadata;
+    metadata.version = "3.8.0";
+    metadata.startTime = 1700000000123;
+    metadata.endTime = 1700000100456;
+    metadata.pollTime = 250;
+    metadata.bAbsoluteTimes = false;
+    metadata.bDuringLog = false;
+    metadata.graphs.append({ "Sawtooth", QColor("#ff0000"), "${40001}", 0 });
+    metadata.graphs.append({ "Ramp", QColor("#0000ff"), "${40002}", 1 });
+
+    BinaryDataWriter writer;
+    QVERIFY(writer.open(filePath, metadata));
+
+    for (qint32 idx = 0; idx < count; idx++)
+    {
+        if (bAbsent)
+        {
+            QVERIFY(writer.append(sampleKey(idx), QList<double>() << absentValue(0, idx) << absentValue(1, idx)));
+        }
+        else
+        {
+            QVERIFY(writer.append(sampleKey(idx), QList<double>() << sampleValue(0, idx) << sampleValue(1, idx)));
+        }
+    }
+
+    writer.close();
+}
+
+QTEST_GUILESS_MAIN(TestLazyDataSource)
@@ -0,0 +1,29 @@
+
+#include <QObject>
+
+#include "binarydatafile.h"
+
+class TestLazyDataSource: public QObject
+{
+    Q_OBJECT
+
+private slots:
+
+    void init();
+    void cleanup();
+
+    void indexCache();
+    void staleIndexCache();
+    void rawWindow();
+    void envelopeWindow();
+    void summaryWindow();
+    void statistics();
+    void statistics_data();
+    void valueAt();
+    void absentSamples();
+
+private:
+    void writeSamples(QString filePath, qint32 count, bool bAbsent = false);
+    void verifyAbsentWindow(const QList<double> &timeRow, const QList<QList<double> > &dataRows);
+
+};
@@ -0,0 +1,153 @@
+
+#include <QtTest/QtTest>
+#include <QThread>
+
+#include "tst_logrecordqueue.h"
+
+#include "logrecordqueue.h"
+
+void TestLogRecordQueue::init()
+{
+
+}
+
+void TestLogRecordQueue::cleanup()
+{
+
+}
+
+void TestLogRecordQueue::pushPop()
+{
+    LogRecordQueue queue;
+    queue.reset(2);
+
+    QVERIFY(queue.push(100, QList<double>() << 1 << 2));
+    QVERIFY(queue.push(200, QList<double>() << 3 << 4));
+    QVERIFY(queue.push(300, QList<double>() << 5 << 6));
+
+    QCOMPARE(queue.size(), 3u);
+
+    QVector<double> timestamps;
+    QVector<double> values;
+    QCOMPARE(queue.pop(2, timestamps, values), 2);
+
+    QCOMPARE(timestamps, QVector<double>() << 100 << 200);
+    QCOMPARE(values, QVector<double>() << 1 << 2 << 3 << 4);
+    QCOMPARE(queue.size(), 1u);
+
+    /* Appended to lists */
+    QCOMPARE(queue.pop(10, timestamps, values), 1);
+    QCOMPARE(timestamps, QVector<double>() << 100 << 200 << 300);
+    QCOMPARE(values, QVector<double>() << 1 << 2 << 3 << 4 << 5 << 6);
+
+    QCOMPARE(queue.pop(10, timestamps, values), 0);
+}
+
+void TestLogRecordQueue::capacity()
+{
+    LogRecordQueue queue;
+
+    /* Not usable before reset */
+    QCOMPARE(queue.capacity(), 0u);
+    QVERIFY(!queue.push(0, QList<double>()));
+
+    queue.reset(1);
+    QCOMPARE(queue.capacity(), LogRecordQueue::cValueCapacity / 2);
+
+    /* Memory doesn't depend on number of columns, with a minimum number of records */
+    queue.reset(2000);
+    QCOMPARE(queue.capacity(), static_cast<quint32>(LogRecordQueue::cMinCapacity));
+}
+
+void TestLogRecordQueue::rejectWhenFull()
+{
+    LogRecordQueue queue;
+    queue.reset(2000);
+
+    const QList<double> values(2000, 1.5);
+    for (quint32 idx = 0; idx < queue.capacity(); idx++)
+    {
+        QVERIFY(queue.push(idx, values));
+    }
+
+    QVERIFY(!queue.push(0, values));
+
+    QVector<double> timestamps;
+    QVector<double> poppedValues;
+    QCOMPARE(queue.pop(1, timestamps, poppedValues), 1);
+    QCOMPARE(timestamps.first(), 0.0);
+
+    QVERIFY(queue.push(0, values));
+}
+
+void TestLogRecordQueue::columnMismatch()
+{
+    LogRecordQueue queue;
+    queue.reset(2);
+
+    QVERIFY(!queue.push(0, QList<double>() << 1));
+    QVERIFY(!queue.push(0, QList<double>() << 1 << 2 << 3));
+    QCOMPARE(queue.size(), 0u);
+}
+
+void TestLogRecordQueue::resetDiscards()
+{
+    LogRecordQueue queue;
+    queue.reset(1);
+
+    QVERIFY(queue.push(1, QList<double>() << 10));
+    QVERIFY(queue.push(2, QList<double>() << 20));
+
+    queue.reset(3);
+    QCOMPARE(queue.size(), 0u);
+    QCOMPARE(queue.columnCount(), 3);
+
+    QVERIFY(queue.push(3, QList<double>() << 1 << 2 << 3));
+
+    QVector<double> timestamps;
+    QVector<double> values;
+    QCOMPARE(queue.pop(10, timestamps, values), 1);
+    QCOMPARE(values, QVector<double>() << 1 << 2 << 3);
+}
+
+void TestLogRecordQueue::concurrent()
+{
+    LogRecordQueue queue;
+    queue.reset(2);
+
+    const qint32 recordCount = 200000;
+
+    QThread* pProducer = QThread::create([&queue, recordCount]() {
+        for (qint32 idx = 0; idx < recordCount; idx++)
+        {
+            while (!queue.push(idx, QList<double>() << idx << -idx))
+            {
+                QThread::yieldCurrentThread();
+            }
+        }
+    });
+
+    pProducer->start();
+
+    QVector<double> timestamps;
+    QVector<double> values;
+    while (timestamps.size() < recordCount)
+    {
+        if (queue.pop(1000, timestamps, values) == 0)
+        {
+            QThread::yieldCurrentThread();
+        }
+    }
+
+    pProducer->wait();
+    delete pProducer;
+
+    for (qint32 idx = 0; idx < recordCount; idx++)
+    {
+        QCOMPARE(timestamps[idx], static_cast<double>(idx));
+        QCOMPARE(values[2 * idx], static_cast<double>(idx));
+        QCOMPARE(values[2 * idx + 1], static_cast<double>(-idx));
+    }
+}
+
+QTEST_GUILESS_MAIN(TestLogRecordQueue)
@@ -0,0 +1,22 @@
+#ifndef TEST_LOGRECORDQUEUE_H__
+#define TEST_LOGRECORDQUEUE_H__
+
+#include <QObject>
+
+class TestLogRecordQueue: public QObject
+{
+    Q_OBJECT
+private slots:
+    void init();
+    void cleanup();
+
+    void pushPop();
+    void capacity();
+    void rejectWhenFull();
+    void columnMismatch();
+    void resetDiscards();
+    void concurrent();
+
+};
+
+#endif /* TEST_LOGRECORDQUEUE_H__ */
@@ -284,6 +284,25 @@ void TestProjectFileParser::connEmpty()
     QVERIFY(settings.general.connectionSettings[0].bPersistentConnection);
 }
 
+void TestProjectFileParser::connReadCapability()
+{
+    ProjectFileParser projectParser;
+    ProjectFileData::ProjectSettings settings;
+
+    GeneralError parseError = projectParser.parseFile(ProjectFileTestData::cConnReadCapability, &settings);
+    QVERIFY(parseError.result());
+
+    const ReadCapability capability = settings.general.connectionSettings[0].readCapability;
+
+    QCOMPARE(capability.maxBlockSize(), 32);
+
+    /* Unreadable registers of older project files aren't loaded */
+    QVERIFY(capability.unreadableList().isEmpty());
+
+    auto boundaryList = QList<ModbusAddress>() << ModbusAddress(100, ModbusAddress::ObjectType::INPUT_REGISTER);
+    QCOMPARE(capability.boundaryList(), boundaryList);
+}
+
 void TestProjectFileParser::scaleDouble()
 {
     ProjectFileParser projectParser;
@@ -17,6 +17,7 @@ private slots:
     void connSerial();
     void connMixedMulti();
     void connEmpty();
+    void connReadCapability();
 
     void scaleDouble();
     void valueAxis();
@@ -128,4 +128,42 @@ void TestDiagnostic::toExportString_2()
 }
 
 
+void TestDiagnostic::eventConstructor()
+{
+    DiagnosticEvent event(DiagnosticEvent::TYPE_READ_EXCEPTION, 1, ModbusAddress(40011), 0, 2);
+    event.setTimeOffset(25);
+
+    Diagnostic log(event);
+    QCOMPARE(log.category(), QStringLiteral("scope.comm.connection"));
+    QCOMPARE(log.severity(), Diagnostic::LOG_WARNING);
+    QCOMPARE(log.timeOffset(), 25);
+
+    event = DiagnosticEvent(DiagnosticEvent::TYPE_READ_PARTIAL, 0, ModbusAddress(40001), 5);
+    QCOMPARE(Diagnostic(event).severity(), Diagnostic::LOG_DEBUG);
+}
+
+void TestDiagnostic::eventMessage()
+{
+    DiagnosticEvent event(DiagnosticEvent::TYPE_READ_PARTIAL, 1, ModbusAddress(40011), 5);
+
+    QCOMPARE(Diagnostic(event).message(), QString("[Conn 2] Partial list read: Start address (%1) and count (5)").arg(ModbusAddress(40011).toString()));
+
+    event = DiagnosticEvent(DiagnosticEvent::TYPE_READ_EXCEPTION, 0, ModbusAddress(40011), 0, 2);
+    QCOMPARE(Diagnostic(event).message(), QString("[Conn 1] Modbus Exception: 2 at start address (%1)").arg(ModbusAddress(40011).toString()));
+
+    event = DiagnosticEvent(DiagnosticEvent::TYPE_READ_RESULTS, 2, ModbusAddress(), 10, 3);
+    QCOMPARE(Diagnostic(event).message(), QString("[Conn 3] Result map: 10 registers, 3 invalid"));
+
+    event = DiagnosticEvent(DiagnosticEvent::TYPE_CONNECTION_DISABLED, 0);
+    QCOMPARE(Diagnostic(event).toString(), QString("00000000 - WARNING [scope.comm.connection]: [Conn 1] Read failed because connection is disabled"));
+}
+
+void TestDiagnostic::eventSetMessage()
+{
+    Diagnostic log(DiagnosticEvent(DiagnosticEvent::TYPE_READ_SUCCESS, 0, ModbusAddress(40001), 2));
+
+    log.setMessage(QString("Test"));
+    QCOMPARE(log.message(), QString("Test"));
+}
+
 QTEST_GUILESS_MAIN(TestDiagnostic)
@@ -26,6 +26,10 @@ private slots:
     void toExportString_1();
     void toExportString_2();
 
+    void eventConstructor();
+    void eventMessage();
+    void eventSetMessage();
+
 private:
 
 };
@@ -23,11 +23,13 @@ void TestDiagnosticModel::addClear()
     QCOMPARE(diagModel.rowCount(), 0);
 
     diagModel.addLog(_category, Diagnostic::LOG_INFO, 0, QStringLiteral("Test"));
+    diagModel.flush();
 
     QCOMPARE(diagModel.size(), 1);
     QCOMPARE(diagModel.rowCount(), 1);
 
     diagModel.addLog(_category, Diagnostic::LOG_INFO, 10, QStringLiteral("Test"));
+    diagModel.flush();
 
     QCOMPARE(diagModel.size(), 2);
     QCOMPARE(diagModel.rowCount(), 2);
@@ -57,9 +59,11 @@ void TestDiagnosticModel::data()
 
     Diagnostic logErr(_category, Diagnostic::LOG_WARNING, 0, QString("Error"));
     diagModel.addLog(logErr.category(), logErr.severity(), logErr.timeOffset(), logErr.message());
+    diagModel.flush();
 
     Diagnostic logInfo(_category, Diagnostic::LOG_INFO, 10, QString("Info"));
     diagModel.addLog(logInfo.category(), logInfo.severity(), logInfo.timeOffset(), logInfo.message());
+    diagModel.flush();
 
     QModelIndex index = diagModel.index(0);
     QCOMPARE(diagModel.data(index), logErr.toString());
@@ -77,9 +81,11 @@ void TestDiagnosticModel::dataSeverity()
 
     Diagnostic logErr(_category, Diagnostic::LOG_WARNING, 0, QString("Error"));
     diagModel.addLog(logErr.category(), logErr.severity(), logErr.timeOffset(), logErr.message());
+    diagModel.flush();
 
     Diagnostic logInfo(_category, Diagnostic::LOG_INFO, 10, QString("Info"));
     diagModel.addLog(logInfo.category(), logInfo.severity(), logErr.timeOffset(), logInfo.message());
+    diagModel.flush();
 
     QCOMPARE(diagModel.dataSeverity(0), logErr.severity());
     QCOMPARE(diagModel.dataSeverity(1), logInfo.severity());
@@ -105,6 +111,7 @@ void TestDiagnosticModel::addLog()
 
     Diagnostic logErr(_category, Diagnostic::LOG_WARNING, 10, QString("Error"));
     diagModel.addLog(logErr.category(), logErr.severity(), logErr.timeOffset(), logErr.message());
+    diagModel.flush();
 
     QCOMPARE(spy.count(), 1);
 
@@ -125,6 +132,7 @@ void TestDiagnosticModel::addLogLowerSeverity()
 
     Diagnostic logErr(_category, Diagnostic::LOG_DEBUG, 10, QString("Debug"));
     diagModel.addLog(logErr.category(), logErr.severity(), logErr.timeOffset(), logErr.message());
+    diagModel.flush();
 
     QCOMPARE(spy.count(), 0);
     QCOMPARE(diagModel.size(), 0);
@@ -139,6 +147,7 @@ void TestDiagnosticModel::addLogSameSeverity()
 
     Diagnostic logErr(_category, Diagnostic::LOG_INFO, 10, QString("Info"));
     diagModel.addLog(logErr.category(), logErr.severity(), logErr.timeOffset(), logErr.message());
+    diagModel.flush();
 
     QCOMPARE(spy.count(), 1);
 
@@ -150,4 +159,197 @@ void TestDiagnosticModel::addLogSameSeverity()
     QCOMPARE(qvariant_cast<QModelIndex>(arguments.at(1)).row(), changedIndex.row());
 }
 
+void TestDiagnosticModel::addEvents()
+{
+    DiagnosticModel diagModel;
+    diagModel.setMinimumSeverityLevel(Diagnostic::LOG_DEBUG);
+
+    QSignalSpy spy(&diagModel, SIGNAL(rowsInserted(QModelIndex,int,int)));
+
+    QList<DiagnosticEvent> eventList;
+    eventList.append(DiagnosticEvent(DiagnosticEvent::TYPE_READ_PARTIAL, 0, ModbusAddress(40001), 2));
+    eventList.append(DiagnosticEvent(DiagnosticEvent::TYPE_READ_SUCCESS, 0, ModbusAddress(40001), 2));
+    eventList.append(DiagnosticEvent(DiagnosticEvent::TYPE_READ_EXCEPTION, 0, ModbusAddress(40003), 0, 2));
+
+    diagModel.addEvents(eventList);
+    diagModel.flush();
+
+    /* Single insert for batch */
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(diagModel.size(), 3);
+
+    QCOMPARE(diagModel.dataSeverity(0), Diagnostic::LOG_DEBUG);
+    QCOMPARE(diagModel.dataSeverity(2), Diagnostic::LOG_WARNING);
+    QCOMPARE(diagModel.data(diagModel.index(2)), Diagnostic(eventList[2]).toString());
+    QCOMPARE(diagModel.toExportString(1), Diagnostic(eventList[1]).toExportString());
+}
+
+void TestDiagnosticModel::addEventsLowerSeverity()
+{
+    DiagnosticModel diagModel;
+    diagModel.setMinimumSeverityLevel(Diagnostic::LOG_INFO);
+
+    QList<DiagnosticEvent> eventList;
+    eventList.append(DiagnosticEvent(DiagnosticEvent::TYPE_READ_PARTIAL, 0, ModbusAddress(40001), 2));
+    eventList.append(DiagnosticEvent(DiagnosticEvent::TYPE_CONNECTION_DISABLED, 1));
+
+    diagModel.addEvents(eventList);
+    diagModel.flush();
+
+    QCOMPARE(diagModel.size(), 1);
+    QCOMPARE(diagModel.dataSeverity(0), Diagnostic::LOG_WARNING);
+
+    /* Nothing is kept */
+    QSignalSpy spy(&diagModel, SIGNAL(rowsInserted(QModelIndex,int,int)));
+    diagModel.addEvents(QList<DiagnosticEvent>() << eventList[0]);
+    diagModel.flush();
+
+    QCOMPARE(spy.count(), 0);
+    QCOMPARE(diagModel.size(), 1);
+}
+
+void TestDiagnosticModel::batchedInsert()
+{
+    DiagnosticModel diagModel;
+
+    QSignalSpy spy(&diagModel, SIGNAL(rowsInserted(QModelIndex,int,int)));
+
+    for (qint32 idx = 0; idx < 10; idx++)
+    {
+        diagModel.addLog(_category, Diagnostic::LOG_INFO, idx, QString("Log %1").arg(idx));
+    }
+
+    /* Not inserted before flush */
+    QCOMPARE(diagModel.size(), 0);
+    QCOMPARE(spy.count(), 0);
+
+    diagModel.flush();
+
+    QCOMPARE(diagModel.size(), 10);
+    QCOMPARE(spy.count(), 1);
+
+    QList<QVariant> arguments = spy.takeFirst();
+    QCOMPARE(arguments.at(1).toInt(), 0);
+    QCOMPARE(arguments.at(2).toInt(), 9);
+}
+
+void TestDiagnosticModel::flushTimer()
+{
+    DiagnosticModel diagModel;
+
+    diagModel.addLog(_category, Diagnostic::LOG_INFO, 0, QStringLiteral("Test"));
+
+    QTRY_COMPARE(diagModel.size(), 1);
+}
+
+void TestDiagnosticModel::capacity()
+{
+    DiagnosticModel diagModel(4);
+
+    QSignalSpy removeSpy(&diagModel, SIGNAL(rowsRemoved(QModelIndex,int,int)));
+
+    for (qint32 idx = 0; idx < 3; idx++)
+    {
+        diagModel.addLog(_category, Diagnostic::LOG_INFO, idx, QString("Log %1").arg(idx));
+    }
+    diagModel.flush();
+
+    for (qint32 idx = 3; idx < 10; idx++)
+    {
+        diagModel.addLog(_category, Diagnostic::LOG_INFO, idx, QString("Log %1").arg(idx));
+        diagModel.flush();
+    }
+
+    QCOMPARE(diagModel.size(), 4);
+    QCOMPARE(removeSpy.count(), 6);
+
+    /* Oldest logs are removed */
+    for (quint32 idx = 0; idx < 4; idx++)
+    {
+        QCOMPARE(diagModel.toString(idx), Diagnostic(_category, Diagnostic::LOG_INFO, idx + 6, QString("Log %1").arg(idx + 6)).toString());
+    }
+}
+
+void TestDiagnosticModel::capacityLargeBatch()
+{
+    DiagnosticModel diagModel(4);
+
+    for (qint32 idx = 0; idx < 3; idx++)
+    {
+        diagModel.addLog(_category, Diagnostic::LOG_INFO, idx, QString("Log %1").arg(idx));
+    }
+    diagModel.flush();
+
+    /* Batch is larger than capacity */
+    for (qint32 idx = 3; idx < 9; idx++)
+    {
+        diagModel.addLog(_category, Diagnostic::LOG_INFO, idx, QString("Log %1").arg(idx));
+    }
+    diagModel.flush();
+
+    QCOMPARE(diagModel.size(), 4);
+    QCOMPARE(diagModel.toString(0), Diagnostic(_category, Diagnostic::LOG_INFO, 5, QString("Log 5")).toString());
+    QCOMPARE(diagModel.toString(3), Diagnostic(_category, Diagnostic::LOG_INFO, 8, QString("Log 8")).toString());
+}
+
+void TestDiagnosticModel::spill()
+{
+    DiagnosticModel diagModel(4);
+    diagModel.setSpillEnabled(true);
+
+    QString expected;
+    for (qint32 idx = 0; idx < 10; idx++)
+    {
+        diagModel.addLog(_category, Diagnostic::LOG_INFO, idx, QString("Log %1").arg(idx));
+        diagModel.flush();
+
+        if (idx < 6)
+        {
+            expected.append(Diagnostic(_category, Diagnostic::LOG_INFO, idx, QString("Log %1").arg(idx)).toExportString() + "\n");
+        }
+    }
+
+    QCOMPARE(diagModel.spilledCount(), static_cast<qint64>(6));
+
+    QString exported;
+    QTextStream stream(&exported);
+    diagModel.exportSpilled(stream);
+    stream.flush();
+
+    QCOMPARE(exported, expected);
+
+    /* Clear also removes spilled logs */
+    diagModel.clear();
+    QCOMPARE(diagModel.spilledCount(), static_cast<qint64>(0));
+}
+
+void TestDiagnosticModel::spillMultiByte()
+{
+    DiagnosticModel diagModel(1);
+    diagModel.setSpillEnabled(true);
+
+    /* Characters of 4 bytes in UTF-8, spill file is exported in blocks of 64 KiB */
+    const QString text = QStringLiteral("\U0001F600").repeated(10000);
+
+    QString expected;
+    for (qint32 idx = 0; idx < 21; idx++)
+    {
+        diagModel.addLog(_category, Diagnostic::LOG_INFO, idx, QString("Log %1 %2").arg(idx).arg(text));
+        diagModel.flush();
+
+        if (idx < 20)
+        {
+            expected.append(Diagnostic(_category, Diagnostic::LOG_INFO, idx, QString("Log %1 %2").arg(idx).arg(text)).toExportString() + "\n");
+        }
+    }
+
+    QString exported;
+    QTextStream stream(&exported);
+    diagModel.exportSpilled(stream);
+    stream.flush();
+
+    QVERIFY(!exported.contains(QChar::ReplacementCharacter));
+    QCOMPARE(exported, expected);
+}
+
 QTEST_GUILESS_MAIN(TestDiagnosticModel)
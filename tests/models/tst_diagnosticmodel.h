@@ -21,6 +21,16 @@ private slots:
     void addLogLowerSeverity();
     void addLogSameSeverity();
 
+    void addEvents();
+    void addEventsLowerSeverity();
+
+    void batchedInsert();
+    void flushTimer();
+    void capacity();
+    void capacityLargeBatch();
+    void spill();
+    void spillMultiByte();
+
 private:
 
         QString _category;
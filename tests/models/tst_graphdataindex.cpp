@@ -0,0 +1,203 @@
+
+#include <QtTest/QtTest>
+#include <algorithm>
+#include <cmath>
+
+#include "tst_graphdataindex.h"
+
+#include "graphdataindex.h"
+
+static double sampleValue(qint32 idx)
+{
+    return std::sin(idx * 0.01) * 100 + ((idx * 7919) % 101) - 50 + 1000;
+}
+
+static void addSamples(QVector<double> &keys, QVector<double> &values, qint32 begin, qint32 end)
+{
+    for (qint32 idx = begin; idx < end; idx++)
+    {
+        keys.append(idx * 10.0);
+        values.append(sampleValue(idx));
+    }
+}
+
+static GraphDataIndex::Samples toSamples(const QVector<double> &keys, const QVector<double> &values, qint32 first = 0)
+{
+    GraphDataIndex::Samples samples;
+
+    samples.pKeys = keys.constData() + first;
+    samples.pValues = values.constData() + first;
+    samples.count = keys.size() - first;
+    samples.pValidity = nullptr;
+    samples.validityOffset = 0;
+
+    return samples;
+}
+
+static void compareStatistics(GraphDataIndex &index, const GraphDataIndex::Samples &samples, qint64 begin, qint64 end)
+{
+    const GraphDataIndex::Statistics stats = index.statistics(samples, begin, end);
+
+    const double* pKeys = samples.pKeys;
+    const double* pValues = samples.pValues;
+
+    double sum = 0;
+    double sumSquares = 0;
+    double min = pValues[begin];
+    double max = pValues[begin];
+    double integral = 0;
+    for (qint64 idx = begin; idx < end; idx++)
+    {
+        sum += pValues[idx];
+        sumSquares += pValues[idx] * pValues[idx];
+        min = qMin(min, pValues[idx]);
+        max = qMax(max, pValues[idx]);
+        if (idx != begin)
+        {
+            integral += (pKeys[idx] - pKeys[idx - 1]) * (pValues[idx] + pValues[idx - 1]) / 2;
+        }
+    }
+
+    const double count = static_cast<double>(end - begin);
+    const double average = sum / count;
+    double m2 = 0;
+    for (qint64 idx = begin; idx < end; idx++)
+    {
+        m2 += (pValues[idx] - average) * (pValues[idx] - average);
+    }
+
+    QCOMPARE(stats.count, end - begin);
+    QCOMPARE(stats.minimum, min);
+    QCOMPARE(stats.maximum, max);
+    QVERIFY(qAbs(stats.average - average) < 1e-9);
+    QVERIFY(qAbs(stats.standardDeviation - std::sqrt(m2 / count)) < 1e-6);
+    QVERIFY(qAbs(stats.rms - std::sqrt(sumSquares / count)) < 1e-6);
+    QVERIFY(qAbs(stats.integral - integral / 1000) < 1e-6);
+}
+
+void TestGraphDataIndex::init()
+{
+
+}
+
+void TestGraphDataIndex::cleanup()
+{
+
+}
+
+void TestGraphDataIndex::statistics()
+{
+    QVector<double> keys;
+    QVector<double> values;
+    addSamples(keys, values, 0, 50000);
+
+    GraphDataIndex index;
+    const GraphDataIndex::Samples samples = toSamples(keys, values);
+
+    compareStatistics(index, samples, 0, samples.count);
+    compareStatistics(index, samples, 17, samples.count - 1001);
+    compareStatistics(index, samples, 4096, 8192);
+}
+
+void TestGraphDataIndex::statisticsSmallRange()
+{
+    QVector<double> keys;
+    QVector<double> values;
+    addSamples(keys, values, 0, 100);
+
+    GraphDataIndex index;
+    const GraphDataIndex::Samples samples = toSamples(keys, values);
+
+    compareStatistics(index, samples, 5, 6);
+    compareStatistics(index, samples, 5, 9);
+
+    const GraphDataIndex::Statistics stats = index.statistics(samples, 5, 5);
+    QCOMPARE(stats.count, static_cast<qint64>(0));
+}
+
+void TestGraphDataIndex::statisticsAppend()
+{
+    QVector<double> keys;
+    QVector<double> values;
+    addSamples(keys, values, 0, 1000);
+
+    GraphDataIndex index;
+    compareStatistics(index, toSamples(keys, values), 0, keys.size());
+
+    /* Appended samples are picked up */
+    addSamples(keys, values, 1000, 30000);
+    compareStatistics(index, toSamples(keys, values), 0, keys.size());
+    compareStatistics(index, toSamples(keys, values), 999, 1001);
+}
+
+void TestGraphDataIndex::statisticsRemoveFront()
+{
+    QVector<double> keys;
+    QVector<double> values;
+    addSamples(keys, values, 0, 20000);
+
+    GraphDataIndex index;
+    compareStatistics(index, toSamples(keys, values), 0, keys.size());
+
+    /* Retention removes oldest samples */
+    const qint32 removed = 5003;
+    index.removeFront(removed);
+    addSamples(keys, values, 20000, 25000);
+
+    const GraphDataIndex::Samples samples = toSamples(keys, values, removed);
+    compareStatistics(index, samples, 0, samples.count);
+    compareStatistics(index, samples, 3, samples.count - 3);
+}
+
+void TestGraphDataIndex::invalidate()
+{
+    QVector<double> keys;
+    QVector<double> values;
+    addSamples(keys, values, 0, 5000);
+
+    GraphDataIndex index;
+    compareStatistics(index, toSamples(keys, values), 0, keys.size());
+
+    values.fill(0);
+    index.invalidate();
+
+    const GraphDataIndex::Statistics stats = index.statistics(toSamples(keys, values), 0, keys.size());
+    QCOMPARE(stats.maximum, 0.0);
+    QCOMPARE(stats.integral, 0.0);
+}
+
+void TestGraphDataIndex::envelope()
+{
+    QVector<double> keys;
+    QVector<double> values;
+    addSamples(keys, values, 0, 100000);
+
+    GraphDataIndex index;
+
+    QVector<qint64> indexes;
+    index.envelope(toSamples(keys, values), 0, keys.size(), 500, indexes);
+
+    QVERIFY(!indexes.isEmpty());
+    QVERIFY(indexes.size() <= 2 * 500);
+
+    const double min = *std::min_element(values.constBegin(), values.constEnd());
+    const double max = *std::max_element(values.constBegin(), values.constEnd());
+
+    double envelopeMin = values[indexes[0]];
+    double envelopeMax = values[indexes[0]];
+    for (qint32 idx = 0; idx < indexes.size(); idx++)
+    {
+        envelopeMin = qMin(envelopeMin, values[indexes[idx]]);
+        envelopeMax = qMax(envelopeMax, values[indexes[idx]]);
+
+        if (idx > 0)
+        {
+            QVERIFY(indexes[idx] > indexes[idx - 1]);
+        }
+    }
+
+    QCOMPARE(envelopeMin, min);
+    QCOMPARE(envelopeMax, max);
+}
+
+QTEST_GUILESS_MAIN(TestGraphDataIndex)
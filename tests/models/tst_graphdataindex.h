@@ -0,0 +1,25 @@
+
+#ifndef TEST_GRAPHDATAINDEX_H__
+#define TEST_GRAPHDATAINDEX_H__
+
+#include <QObject>
+
+class TestGraphDataIndex: public QObject
+{
+    Q_OBJECT
+private slots:
+    void init();
+    void cleanup();
+
+    void statistics();
+    void statisticsSmallRange();
+    void statisticsAppend();
+    void statisticsRemoveFront();
+    void invalidate();
+    void envelope();
+
+private:
+
+};
+
+#endif /* TEST_GRAPHDATAINDEX_H__ */
@@ -0,0 +1,528 @@
+
+#include <QtTest/QtTest>
+#include <cmath>
+
+#include "tst_graphsamplestore.h"
+
+#include "graphsamplestore.h"
+
+static double sampleValue(qint32 graphIdx, qint32 idx)
+{
+    return std::sin(idx * 0.01) * 100 + ((idx * 7919) % 101) - 50 + graphIdx * 1000;
+}
+
+static void fillStore(GraphSampleStore &store, qint32 graphCount, qint32 begin, qint32 end)
+{
+    while (store.graphCount() < graphCount)
+    {
+        store.insertGraph(store.graphCount());
+    }
+
+    QList<double> keys;
+    QList<QList<double> > values;
+    for (qint32 graphIdx = 0; graphIdx < graphCount; graphIdx++)
+    {
+        values.append(QList<double>());
+    }
+
+    for (qint32 idx = begin; idx < end; idx++)
+    {
+        keys.append(idx * 10.0);
+        for (qint32 graphIdx = 0; graphIdx < graphCount; graphIdx++)
+        {
+            values[graphIdx].append(sampleValue(graphIdx, idx));
+        }
+    }
+
+    store.appendAll(keys, values);
+}
+
+void TestGraphSampleStore::init()
+{
+
+}
+
+void TestGraphSampleStore::cleanup()
+{
+
+}
+
+void TestGraphSampleStore::setAll()
+{
+    GraphSampleStore store;
+    store.insertGraph(0);
+    store.insertGraph(1);
+
+    store.setAll(QList<double>() << 1 << 2 << 3, QList<QList<double> >() << (QList<double>() << 10 << 20 << 30) << (QList<double>() << 4 << 5 << 6));
+
+    QCOMPARE(store.size(), 3);
+    QCOMPARE(store.key(2), 3.0);
+    QCOMPARE(store.value(0, 1), 20.0);
+    QCOMPARE(store.value(1, 2), 6.0);
+    QVERIFY(store.isValid(0, 0));
+    QVERIFY(store.isValid(1, 2));
+
+    /* Replaces existing samples */
+    store.setAll(QList<double>() << 5, QList<QList<double> >() << (QList<double>() << 50) << (QList<double>() << 7));
+
+    QCOMPARE(store.size(), 1);
+    QCOMPARE(store.key(0), 5.0);
+    QCOMPARE(store.value(1, 0), 7.0);
+}
+
+void TestGraphSampleStore::setAllSizeMismatch()
+{
+    GraphSampleStore store;
+    store.insertGraph(0);
+    store.insertGraph(1);
+
+    /* Missing graph */
+    store.appendAll(QList<double>() << 1 << 2, QList<QList<double> >() << (QList<double>() << 10 << 20));
+    QVERIFY(store.isEmpty());
+
+    /* Missing value */
+    store.appendAll(QList<double>() << 1 << 2, QList<QList<double> >() << (QList<double>() << 10 << 20) << (QList<double>() << 4));
+    QVERIFY(store.isEmpty());
+}
+
+void TestGraphSampleStore::appendValidity()
+{
+    GraphSampleStore store;
+    store.insertGraph(0);
+    store.insertGraph(1);
+
+    for (qint32 idx = 0; idx < 200; idx++)
+    {
+        const bool bValid = (idx % 3) != 0;
+        store.append(idx, QList<double>() << idx << (bValid ? idx * 2 : 0), QList<bool>() << true << bValid);
+    }
+
+    QCOMPARE(store.size(), 200);
+
+    for (qint32 idx = 0; idx < 200; idx++)
+    {
+        QVERIFY(store.isValid(0, idx));
+        QCOMPARE(store.isValid(1, idx), (idx % 3) != 0);
+    }
+
+    QCOMPARE(store.value(1, 3), 0.0);
+    QCOMPARE(store.value(1, 4), 8.0);
+}
+
+void TestGraphSampleStore::insertGraph()
+{
+    GraphSampleStore store;
+    fillStore(store, 1, 0, 100);
+
+    store.insertGraph(0);
+
+    QCOMPARE(store.graphCount(), 2);
+    QCOMPARE(store.size(), 100);
+
+    /* New graph has no valid values for existing samples */
+    QCOMPARE(store.value(0, 50), 0.0);
+    QVERIFY(!store.isValid(0, 50));
+
+    QCOMPARE(store.value(1, 50), sampleValue(0, 50));
+    QVERIFY(store.isValid(1, 50));
+}
+
+void TestGraphSampleStore::removeGraph()
+{
+    GraphSampleStore store;
+    fillStore(store, 3, 0, 100);
+
+    store.removeGraph(1);
+
+    QCOMPARE(store.graphCount(), 2);
+    QCOMPARE(store.value(1, 10), sampleValue(2, 10));
+
+    /* Samples are removed together with last graph */
+    store.removeGraph(0);
+    QCOMPARE(store.size(), 100);
+
+    store.removeGraph(0);
+    QCOMPARE(store.graphCount(), 0);
+    QVERIFY(store.isEmpty());
+}
+
+void TestGraphSampleStore::moveGraph()
+{
+    GraphSampleStore store;
+    fillStore(store, 3, 0, 100);
+
+    store.moveGraph(0, 2);
+
+    QCOMPARE(store.value(0, 10), sampleValue(1, 10));
+    QCOMPARE(store.value(1, 10), sampleValue(2, 10));
+    QCOMPARE(store.value(2, 10), sampleValue(0, 10));
+
+    /* Statistics follow the graph */
+    const GraphDataIndex::Statistics stats = store.statistics(2, 0, 990);
+    QCOMPARE(stats.count, static_cast<qint64>(100));
+    QVERIFY(stats.maximum < 1000);
+}
+
+void TestGraphSampleStore::clearValues()
+{
+    GraphSampleStore store;
+    fillStore(store, 2, 0, 100);
+
+    /* Fill index */
+    store.statistics(0, 0, 990);
+
+    store.clearValues(0);
+
+    QCOMPARE(store.size(), 100);
+    QCOMPARE(store.value(0, 10), 0.0);
+    QVERIFY(!store.isValid(0, 10));
+    QCOMPARE(store.value(1, 10), sampleValue(1, 10));
+
+    const GraphDataIndex::Statistics stats = store.statistics(0, 0, 990);
+    QCOMPARE(stats.maximum, 0.0);
+
+    /* Clear keeps graphs */
+    store.clear();
+    QVERIFY(store.isEmpty());
+    QCOMPARE(store.graphCount(), 2);
+}
+
+void TestGraphSampleStore::removeBefore()
+{
+    GraphSampleStore store;
+    fillStore(store, 2, 0, 1000);
+
+    /* Fill index */
+    store.statistics(1, 0, 10000);
+
+    store.removeBefore(5005);
+
+    QCOMPARE(store.size(), 499);
+    QCOMPARE(store.key(0), 5010.0);
+    QCOMPARE(store.value(1, 0), sampleValue(1, 501));
+
+    /* Index follows removed samples */
+    const GraphDataIndex::Statistics stats = store.statistics(1, 5010, 5020);
+    QCOMPARE(stats.count, static_cast<qint64>(2));
+    QCOMPARE(stats.minimum, qMin(sampleValue(1, 501), sampleValue(1, 502)));
+}
+
+void TestGraphSampleStore::removeBeforeCompact()
+{
+    GraphSampleStore store;
+    store.insertGraph(0);
+    store.insertGraph(1);
+
+    const qint32 sampleCount = 20000;
+    for (qint32 idx = 0; idx < sampleCount; idx++)
+    {
+        const bool bValid = (idx % 7) != 0;
+        store.append(idx * 10.0, QList<double>() << sampleValue(0, idx) << sampleValue(1, idx), QList<bool>() << true << bValid);
+    }
+
+    /* Compaction shifts validity bits, remove odd number of samples */
+    const qint32 removed = 15003;
+    store.removeBefore(removed * 10.0);
+
+    QCOMPARE(store.size(), sampleCount - removed);
+
+    for (qint32 idx = 0; idx < store.size(); idx++)
+    {
+        QCOMPARE(store.key(idx), (removed + idx) * 10.0);
+        QCOMPARE(store.value(1, idx), sampleValue(1, removed + idx));
+        QCOMPARE(store.isValid(1, idx), ((removed + idx) % 7) != 0);
+    }
+
+    /* Appending continues after compaction */
+    store.append(sampleCount * 10.0, QList<double>() << 1 << 2, QList<bool>() << true << false);
+    QCOMPARE(store.key(store.size() - 1), sampleCount * 10.0);
+    QVERIFY(!store.isValid(1, store.size() - 1));
+}
+
+void TestGraphSampleStore::findSamples()
+{
+    GraphSampleStore store;
+    fillStore(store, 1, 0, 100);
+
+    QCOMPARE(store.findBegin(-5), 0);
+    QCOMPARE(store.findBegin(100), 10);
+    QCOMPARE(store.findBegin(101), 11);
+    QCOMPARE(store.findBegin(5000), 100);
+
+    QCOMPARE(store.findEnd(100), 11);
+    QCOMPARE(store.findEnd(99), 10);
+
+    bool bFound;
+    const QCPRange range = store.keyRange(bFound);
+    QVERIFY(bFound);
+    QCOMPARE(range.lower, 0.0);
+    QCOMPARE(range.upper, 990.0);
+
+    store.clear();
+    store.keyRange(bFound);
+    QVERIFY(!bFound);
+}
+
+void TestGraphSampleStore::closestSample()
+{
+    GraphSampleStore store;
+    QCOMPARE(store.closestSample(10), -1);
+
+    fillStore(store, 1, 0, 100);
+
+    QCOMPARE(store.closestSample(-100), 0);
+    QCOMPARE(store.closestSample(14), 1);
+    QCOMPARE(store.closestSample(15), 1);
+    QCOMPARE(store.closestSample(16), 2);
+    QCOMPARE(store.closestSample(5000), 99);
+}
+
+void TestGraphSampleStore::valueAt()
+{
+    GraphSampleStore store;
+    fillStore(store, 2, 0, 100);
+
+    QCOMPARE(store.valueAt(1, 100), sampleValue(1, 10));
+    QCOMPARE(store.valueAt(1, 101), sampleValue(1, 11));
+    QCOMPARE(store.valueAt(0, 5000), sampleValue(0, 99));
+    QCOMPARE(store.valueAt(2, 100), 0.0);
+}
+
+void TestGraphSampleStore::statistics()
+{
+    GraphSampleStore store;
+    fillStore(store, 2, 0, 10000);
+
+    const qint32 startIdx = 1234;
+    const qint32 endIdx = 8765;
+
+    double min = sampleValue(1, startIdx);
+    double max = min;
+    double sum = 0;
+    for (qint32 idx = startIdx; idx <= endIdx; idx++)
+    {
+        min = qMin(min, sampleValue(1, idx));
+        max = qMax(max, sampleValue(1, idx));
+        sum += sampleValue(1, idx);
+    }
+
+    /* Marker positions are keys of first and last sample */
+    const GraphDataIndex::Statistics stats = store.statistics(1, startIdx * 10.0, endIdx * 10.0);
+
+    QCOMPARE(stats.count, static_cast<qint64>(endIdx - startIdx + 1));
+    QCOMPARE(stats.minimum, min);
+    QCOMPARE(stats.maximum, max);
+    QVERIFY(qAbs(stats.average - sum / (endIdx - startIdx + 1)) < 1e-6);
+
+    /* Invalid graph */
+    QCOMPARE(store.statistics(5, 0, 100).count, static_cast<qint64>(0));
+}
+
+void TestGraphSampleStore::valueRange()
+{
+    GraphSampleStore store;
+    fillStore(store, 1, 0, 40000);
+
+    bool bFoundRange;
+
+    /* Complete range */
+    double min = sampleValue(0, 0);
+    double max = min;
+    for (qint32 idx = 0; idx < store.size(); idx++)
+    {
+        min = qMin(min, store.value(0, idx));
+        max = qMax(max, store.value(0, idx));
+    }
+
+    QCPRange range = store.valueRange(0, bFoundRange);
+    QVERIFY(bFoundRange);
+    QCOMPARE(range.lower, min);
+    QCOMPARE(range.upper, max);
+
+    /* Key window (sliding/window auto scale) */
+    const QCPRange keyRange(12345.5, 300000);
+    min = store.value(0, store.findBegin(keyRange.lower));
+    max = min;
+    for (qint32 idx = store.findBegin(keyRange.lower); idx < store.findEnd(keyRange.upper); idx++)
+    {
+        min = qMin(min, store.value(0, idx));
+        max = qMax(max, store.value(0, idx));
+    }
+
+    range = store.valueRange(0, bFoundRange, keyRange);
+    QVERIFY(bFoundRange);
+    QCOMPARE(range.lower, min);
+    QCOMPARE(range.upper, max);
+
+    /* Window after last sample */
+    store.valueRange(0, bFoundRange, QCPRange(1e7, 2e7));
+    QVERIFY(!bFoundRange);
+}
+
+void TestGraphSampleStore::windowRaw()
+{
+    GraphSampleStore store;
+    fillStore(store, 2, 0, 1000);
+
+    QVector<QCPGraphData> lineData;
+    store.window(1, QCPRange(1000, 2000), 500, lineData);
+
+    /* One sample on both sides of the range */
+    QCOMPARE(lineData.size(), 103);
+    QCOMPARE(lineData.first().key, 990.0);
+    QCOMPARE(lineData.last().key, 2010.0);
+    QCOMPARE(lineData[1].value, sampleValue(1, 100));
+
+    /* Range before first sample */
+    store.window(1, QCPRange(-100, -50), 500, lineData);
+    QCOMPARE(lineData.size(), 1);
+}
+
+void TestGraphSampleStore::windowEnvelope()
+{
+    GraphSampleStore store;
+    fillStore(store, 1, 0, 100000);
+
+    const qint32 buckets = 100;
+
+    QVector<QCPGraphData> lineData;
+    store.window(0, QCPRange(0, 1e6), buckets, lineData);
+
+    QVERIFY(!lineData.isEmpty());
+    QVERIFY(lineData.size() <= 2 * (buckets + EnvelopePyramid::cLevelCount));
+
+    bool bFoundRange;
+    const QCPRange range = store.valueRange(0, bFoundRange);
+
+    double min = lineData[0].value;
+    double max = lineData[0].value;
+    for (qint32 idx = 0; idx < lineData.size(); idx++)
+    {
+        min = qMin(min, lineData[idx].value);
+        max = qMax(max, lineData[idx].value);
+
+        if (idx > 0)
+        {
+            QVERIFY(lineData[idx].key > lineData[idx - 1].key);
+        }
+    }
+
+    QCOMPARE(min, range.lower);
+    QCOMPARE(max, range.upper);
+}
+
+void TestGraphSampleStore::invalidSamples()
+{
+    GraphSampleStore store;
+    store.insertGraph(0);
+
+    /* Every tenth sample is invalid and keeps a value that is out of range of the valid samples */
+    const qint32 sampleCount = 10000;
+    double min = sampleValue(0, 1);
+    double max = min;
+    qint64 validCount = 0;
+    for (qint32 idx = 0; idx < sampleCount; idx++)
+    {
+        const bool bValid = (idx % 10) != 0;
+        store.append(idx * 10.0, QList<double>() << (bValid ? sampleValue(0, idx) : 1e6), QList<bool>() << bValid);
+
+        if (bValid)
+        {
+            min = qMin(min, sampleValue(0, idx));
+            max = qMax(max, sampleValue(0, idx));
+            validCount++;
+        }
+    }
+
+    /* Statistics and value range skip invalid samples */
+    const GraphDataIndex::Statistics stats = store.statistics(0, 0, sampleCount * 10.0);
+    QCOMPARE(stats.count, validCount);
+    QCOMPARE(stats.minimum, min);
+    QCOMPARE(stats.maximum, max);
+
+    bool bFoundRange;
+    const QCPRange range = store.valueRange(0, bFoundRange);
+    QVERIFY(bFoundRange);
+    QCOMPARE(range.lower, min);
+    QCOMPARE(range.upper, max);
+
+    /* Invalid samples are a gap in the window */
+    QVector<QCPGraphData> lineData;
+    store.window(0, QCPRange(1000, 2000), 500, lineData);
+
+    QCOMPARE(lineData.size(), 103);
+    QVERIFY(qIsNaN(lineData[1].value));
+    QCOMPARE(lineData[2].value, sampleValue(0, 101));
+    QCOMPARE(store.validValue(0, 100), lineData[1].value);
+    QVERIFY(qIsNaN(store.validValue(0, 100)));
+
+    /* Envelope keeps the gaps and ignores the value of invalid samples */
+    store.window(0, QCPRange(0, sampleCount * 10.0), 50, lineData);
+
+    qint32 gapCount = 0;
+    for (const QCPGraphData &data : qAsConst(lineData))
+    {
+        if (qIsNaN(data.value))
+        {
+            gapCount++;
+        }
+        else
+        {
+            QVERIFY(data.value <= max);
+        }
+    }
+    QVERIFY(gapCount > 0);
+}
+
+void TestGraphSampleStore::absentSamples()
+{
+    GraphSampleStore store;
+    store.insertGraph(0);
+    store.insertGraph(1);
+
+    /* Graphs alternate, like independently polled connections */
+    const qint32 sampleCount = 1000;
+    for (qint32 idx = 0; idx < sampleCount; idx++)
+    {
+        const bool bFirst = (idx % 2) == 0;
+        store.append(idx * 10.0,
+                     QList<double>() << (bFirst ? 5.0 : qQNaN()) << (bFirst ? qQNaN() : 7.0),
+                     QList<bool>() << bFirst << !bFirst);
+    }
+
+    QVERIFY(store.isAbsent(0, 1));
+    QVERIFY(!store.isAbsent(0, 2));
+
+    /* Statistics only use samples of the graph itself */
+    const GraphDataIndex::Statistics stats = store.statistics(0, 0, (sampleCount - 1) * 10.0);
+    QCOMPARE(stats.count, static_cast<qint64>(sampleCount / 2));
+    QCOMPARE(stats.minimum, 5.0);
+    QCOMPARE(stats.maximum, 5.0);
+
+    /* Integral continues over absent samples: 5 over (sampleCount - 2) * 10 ms */
+    QCOMPARE(stats.integral, 5.0 * (sampleCount - 2) * 10 / 1000);
+
+    /* Absent samples aren't part of the line, so it doesn't have gaps */
+    QVector<QCPGraphData> lineData;
+    store.window(1, QCPRange(1000, 2000), 500, lineData);
+
+    QCOMPARE(lineData.size(), 52);
+    for (const QCPGraphData &data : qAsConst(lineData))
+    {
+        QCOMPARE(data.value, 7.0);
+    }
+
+    store.window(1, QCPRange(0, sampleCount * 10.0), 10, lineData);
+    QVERIFY(!lineData.isEmpty());
+    for (const QCPGraphData &data : qAsConst(lineData))
+    {
+        QCOMPARE(data.value, 7.0);
+    }
+
+    /* Value of graph is taken from its own samples */
+    QCOMPARE(store.valueAt(0, 10), 5.0);
+    QCOMPARE(store.valueAt(1, 20), 7.0);
+    QCOMPARE(store.valueAt(1, sampleCount * 10.0), 7.0);
+}
+
+QTEST_GUILESS_MAIN(TestGraphSampleStore)
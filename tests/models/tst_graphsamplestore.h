@@ -0,0 +1,37 @@
+
+#ifndef TEST_GRAPHSAMPLESTORE_H__
+#define TEST_GRAPHSAMPLESTORE_H__
+
+#include <QObject>
+
+class TestGraphSampleStore: public QObject
+{
+    Q_OBJECT
+private slots:
+    void init();
+    void cleanup();
+
+    void setAll();
+    void setAllSizeMismatch();
+    void appendValidity();
+    void insertGraph();
+    void removeGraph();
+    void moveGraph();
+    void clearValues();
+    void removeBefore();
+    void removeBeforeCompact();
+    void findSamples();
+    void closestSample();
+    void valueAt();
+    void statistics();
+    void valueRange();
+    void windowRaw();
+    void windowEnvelope();
+    void invalidSamples();
+    void absentSamples();
+
+private:
+
+};
+
+#endif /* TEST_GRAPHSAMPLESTORE_H__ */
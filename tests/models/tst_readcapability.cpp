@@ -0,0 +1,127 @@
+
+#include <QtTest/QtTest>
+
+#include "tst_readcapability.h"
+
+#include "readcapability.h"
+
+using ObjectType = ModbusAddress::ObjectType;
+
+void TestReadCapability::init()
+{
+
+}
+
+void TestReadCapability::cleanup()
+{
+
+}
+
+void TestReadCapability::empty()
+{
+    ReadCapability capability;
+
+    QVERIFY(capability.isEmpty());
+    QCOMPARE(capability.maxBlockSize(), 0);
+
+    capability.addUnreadable(ModbusAddress(5, ObjectType::HOLDING_REGISTER));
+    QVERIFY(!capability.isEmpty());
+
+    capability.clear();
+    QVERIFY(capability.isEmpty());
+    QVERIFY(capability.unreadableList().isEmpty());
+}
+
+void TestReadCapability::limitBlockSize()
+{
+    ReadCapability capability;
+
+    capability.limitBlockSize(0);
+    QCOMPARE(capability.maxBlockSize(), 0);
+
+    capability.limitBlockSize(50);
+    QCOMPARE(capability.maxBlockSize(), 50);
+
+    /* Only lower */
+    capability.limitBlockSize(60);
+    QCOMPARE(capability.maxBlockSize(), 50);
+
+    capability.limitBlockSize(25);
+    QCOMPARE(capability.maxBlockSize(), 25);
+}
+
+void TestReadCapability::unreadableSorted()
+{
+    ReadCapability capability;
+
+    capability.addUnreadable(ModbusAddress(10, ObjectType::HOLDING_REGISTER));
+    capability.addUnreadable(ModbusAddress(2, ObjectType::HOLDING_REGISTER));
+    capability.addUnreadable(ModbusAddress(10, ObjectType::HOLDING_REGISTER));
+    capability.addUnreadable(ModbusAddress(5, ObjectType::COIL));
+
+    auto expList = QList<ModbusAddress>() << ModbusAddress(5, ObjectType::COIL)
+                                          << ModbusAddress(2, ObjectType::HOLDING_REGISTER)
+                                          << ModbusAddress(10, ObjectType::HOLDING_REGISTER);
+    QCOMPARE(capability.unreadableList(), expList);
+
+    QVERIFY(capability.isUnreadable(ModbusAddress(2, ObjectType::HOLDING_REGISTER)));
+    QVERIFY(!capability.isUnreadable(ModbusAddress(2, ObjectType::COIL)));
+    QVERIFY(!capability.isUnreadable(ModbusAddress(3, ObjectType::HOLDING_REGISTER)));
+}
+
+void TestReadCapability::splitBoundary()
+{
+    ReadCapability capability;
+
+    capability.addBoundary(ModbusAddress(10, ObjectType::HOLDING_REGISTER));
+
+    QVERIFY(capability.isSplit(ModbusAddress(9, ObjectType::HOLDING_REGISTER), ModbusAddress(10, ObjectType::HOLDING_REGISTER)));
+    QVERIFY(capability.isSplit(ModbusAddress(5, ObjectType::HOLDING_REGISTER), ModbusAddress(12, ObjectType::HOLDING_REGISTER)));
+
+    QVERIFY(!capability.isSplit(ModbusAddress(10, ObjectType::HOLDING_REGISTER), ModbusAddress(11, ObjectType::HOLDING_REGISTER)));
+    QVERIFY(!capability.isSplit(ModbusAddress(5, ObjectType::HOLDING_REGISTER), ModbusAddress(9, ObjectType::HOLDING_REGISTER)));
+}
+
+void TestReadCapability::splitUnreadable()
+{
+    ReadCapability capability;
+
+    capability.addUnreadable(ModbusAddress(10, ObjectType::HOLDING_REGISTER));
+
+    QVERIFY(capability.isSplit(ModbusAddress(9, ObjectType::HOLDING_REGISTER), ModbusAddress(11, ObjectType::HOLDING_REGISTER)));
+
+    /* Unreadable register itself isn't part of the range */
+    QVERIFY(!capability.isSplit(ModbusAddress(9, ObjectType::HOLDING_REGISTER), ModbusAddress(10, ObjectType::HOLDING_REGISTER)));
+    QVERIFY(!capability.isSplit(ModbusAddress(10, ObjectType::HOLDING_REGISTER), ModbusAddress(11, ObjectType::HOLDING_REGISTER)));
+}
+
+void TestReadCapability::splitObjectTypes()
+{
+    ReadCapability capability;
+
+    capability.addBoundary(ModbusAddress(4, ObjectType::HOLDING_REGISTER));
+    capability.addUnreadable(ModbusAddress(4, ObjectType::INPUT_REGISTER));
+
+    QVERIFY(!capability.isSplit(ModbusAddress(3, ObjectType::COIL), ModbusAddress(5, ObjectType::COIL)));
+    QVERIFY(capability.isSplit(ModbusAddress(3, ObjectType::INPUT_REGISTER), ModbusAddress(5, ObjectType::INPUT_REGISTER)));
+    QVERIFY(capability.isSplit(ModbusAddress(3, ObjectType::HOLDING_REGISTER), ModbusAddress(5, ObjectType::HOLDING_REGISTER)));
+}
+
+void TestReadCapability::compare()
+{
+    ReadCapability capability1;
+    ReadCapability capability2;
+
+    QVERIFY(capability1 == capability2);
+
+    capability1.limitBlockSize(10);
+    QVERIFY(capability1 != capability2);
+
+    capability2.limitBlockSize(10);
+    QVERIFY(capability1 == capability2);
+
+    capability2.addBoundary(ModbusAddress(4, ObjectType::HOLDING_REGISTER));
+    QVERIFY(capability1 != capability2);
+}
+
+QTEST_GUILESS_MAIN(TestReadCapability)
@@ -0,0 +1,24 @@
+
+#ifndef TEST_READCAPABILITY_H__
+#define TEST_READCAPABILITY_H__
+
+#include <QObject>
+
+class TestReadCapability: public QObject
+{
+    Q_OBJECT
+private slots:
+    void init();
+    void cleanup();
+
+    void empty();
+    void limitBlockSize();
+    void unreadableSorted();
+    void splitBoundary();
+    void splitUnreadable();
+    void splitObjectTypes();
+    void compare();
+
+};
+
+#endif /* TEST_READCAPABILITY_H__ */
@@ -0,0 +1,90 @@
+
+#include <QtTest/QtTest>
+
+#include "tst_diagnosticeventring.h"
+
+#include "diagnosticeventring.h"
+
+static DiagnosticEvent partialReadEvent(quint16 count)
+{
+    return DiagnosticEvent(DiagnosticEvent::TYPE_READ_PARTIAL, 0, ModbusAddress(40001), count);
+}
+
+void TestDiagnosticEventRing::init()
+{
+
+}
+
+void TestDiagnosticEventRing::cleanup()
+{
+
+}
+
+void TestDiagnosticEventRing::pushPop()
+{
+    DiagnosticEventRing ring(8);
+
+    QVERIFY(ring.push(partialReadEvent(1)));
+    QVERIFY(ring.push(DiagnosticEvent(DiagnosticEvent::TYPE_READ_EXCEPTION, 1, ModbusAddress(30005), 0, 2)));
+
+    QCOMPARE(ring.size(), 2u);
+
+    QList<DiagnosticEvent> eventList;
+    QCOMPARE(ring.pop(eventList), 2);
+
+    QCOMPARE(eventList.size(), 2);
+    QCOMPARE(eventList[0].type(), DiagnosticEvent::TYPE_READ_PARTIAL);
+    QCOMPARE(eventList[0].count(), static_cast<quint16>(1));
+    QCOMPARE(eventList[1].type(), DiagnosticEvent::TYPE_READ_EXCEPTION);
+    QCOMPARE(eventList[1].connectionId(), static_cast<quint8>(1));
+    QCOMPARE(eventList[1].address(), ModbusAddress(30005));
+    QCOMPARE(eventList[1].code(), static_cast<quint16>(2));
+
+    QCOMPARE(ring.size(), 0u);
+    QCOMPARE(ring.pop(eventList), 0);
+    QCOMPARE(eventList.size(), 2);
+}
+
+void TestDiagnosticEventRing::capacity()
+{
+    QCOMPARE(DiagnosticEventRing(8).capacity(), 8u);
+    QCOMPARE(DiagnosticEventRing(9).capacity(), 16u);
+    QCOMPARE(DiagnosticEventRing(0).capacity(), 2u);
+}
+
+void TestDiagnosticEventRing::dropWhenFull()
+{
+    DiagnosticEventRing ring(4);
+
+    for (quint16 idx = 0; idx < 4; idx++)
+    {
+        QVERIFY(ring.push(partialReadEvent(idx)));
+    }
+
+    QVERIFY(!ring.push(partialReadEvent(4)));
+    QCOMPARE(ring.droppedCount(), static_cast<quint64>(1));
+
+    QList<DiagnosticEvent> eventList;
+    QCOMPARE(ring.pop(eventList), 4);
+    QCOMPARE(eventList.last().count(), static_cast<quint16>(3));
+
+    QVERIFY(ring.push(partialReadEvent(5)));
+}
+
+void TestDiagnosticEventRing::wrapAround()
+{
+    DiagnosticEventRing ring(4);
+
+    QList<DiagnosticEvent> eventList;
+
+    for (quint16 idx = 0; idx < 10; idx++)
+    {
+        QVERIFY(ring.push(partialReadEvent(idx)));
+
+        eventList.clear();
+        QCOMPARE(ring.pop(eventList), 1);
+        QCOMPARE(eventList[0].count(), idx);
+    }
+}
+
+QTEST_GUILESS_MAIN(TestDiagnosticEventRing)
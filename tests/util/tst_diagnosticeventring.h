@@ -0,0 +1,21 @@
+
+#ifndef TEST_DIAGNOSTICEVENTRING_H__
+#define TEST_DIAGNOSTICEVENTRING_H__
+
+#include <QObject>
+
+class TestDiagnosticEventRing: public QObject
+{
+    Q_OBJECT
+private slots:
+    void init();
+    void cleanup();
+
+    void pushPop();
+    void capacity();
+    void dropWhenFull();
+    void wrapAround();
+
+};
+
+#endif /* TEST_DIAGNOSTICEVENTRING_H__ */
@@ -0,0 +1,175 @@
+
+#include <QtTest/QtTest>
+#include <cmath>
+
+#include "envelopepyramid.h"
+
+#include "tst_envelopepyramid.h"
+
+/* Deterministic, noisy test signal */
+static double sampleValue(qint64 idx)
+{
+    return std::sin(static_cast<double>(idx) * 0.01) * 100 + static_cast<double>((idx * 7919) % 101) - 50;
+}
+
+static void checkEnvelope(const EnvelopePyramid &pyramid, qint64 begin, qint64 end, qint32 level)
+{
+    QVector<qint64> indexes;
+    pyramid.envelope(begin, end, level, indexes);
+
+    QVERIFY(!indexes.isEmpty());
+
+    qint64 minIdx = begin;
+    qint64 maxIdx = begin;
+    for (qint64 idx = begin; idx < end; idx++)
+    {
+        if (sampleValue(idx) < sampleValue(minIdx))
+        {
+            minIdx = idx;
+        }
+        if (sampleValue(idx) > sampleValue(maxIdx))
+        {
+            maxIdx = idx;
+        }
+    }
+
+    /* Indexes are increasing and within range */
+    for (qint32 i = 0; i < indexes.size(); i++)
+    {
+        QVERIFY(indexes[i] >= begin);
+        QVERIFY(indexes[i] < end);
+        if (i > 0)
+        {
+            QVERIFY(indexes[i] > indexes[i - 1]);
+        }
+    }
+
+    /* Extremes of range are always part of the envelope */
+    double envelopeMin = sampleValue(indexes[0]);
+    double envelopeMax = sampleValue(indexes[0]);
+    for (const qint64 idx : qAsConst(indexes))
+    {
+        envelopeMin = qMin(envelopeMin, sampleValue(idx));
+        envelopeMax = qMax(envelopeMax, sampleValue(idx));
+    }
+    QCOMPARE(envelopeMin, sampleValue(minIdx));
+    QCOMPARE(envelopeMax, sampleValue(maxIdx));
+}
+
+void TestEnvelopePyramid::init()
+{
+
+}
+
+void TestEnvelopePyramid::cleanup()
+{
+
+}
+
+void TestEnvelopePyramid::smallRange()
+{
+    EnvelopePyramid pyramid;
+    for (qint64 idx = 0; idx < 10; idx++)
+    {
+        pyramid.append(sampleValue(idx));
+    }
+
+    QCOMPARE(pyramid.firstIndex(), static_cast<qint64>(0));
+    QCOMPARE(pyramid.endIndex(), static_cast<qint64>(10));
+
+    /* Less samples than smallest bucket: every sample is used */
+    QVector<qint64> indexes;
+    pyramid.envelope(2, 8, 0, indexes);
+    QCOMPARE(indexes, QVector<qint64>() << 2 << 3 << 4 << 5 << 6 << 7);
+}
+
+void TestEnvelopePyramid::levelFor()
+{
+    EnvelopePyramid pyramid;
+
+    QCOMPARE(pyramid.levelFor(1000, 1000), 0);
+    QCOMPARE(pyramid.levelFor(16 * 1000, 1000), 0);
+    QCOMPARE(pyramid.levelFor(16 * 1000 + 1, 1000), 1);
+    QCOMPARE(pyramid.levelFor(1000000, 1000), 6);
+    QCOMPARE(pyramid.levelFor(std::numeric_limits<qint32>::max(), 1), 17);
+}
+
+void TestEnvelopePyramid::envelopeMinMax()
+{
+    const qint64 sampleCount = 100000;
+    const qint64 pixelCount = 500;
+
+    EnvelopePyramid pyramid;
+    for (qint64 idx = 0; idx < sampleCount; idx++)
+    {
+        pyramid.append(sampleValue(idx));
+    }
+
+    const qint32 level = pyramid.levelFor(sampleCount, pixelCount);
+
+    QVector<qint64> indexes;
+    pyramid.envelope(0, sampleCount, level, indexes);
+
+    /* Two points per bucket */
+    QVERIFY(indexes.size() <= 2 * pixelCount);
+
+    checkEnvelope(pyramid, 0, sampleCount, level);
+}
+
+void TestEnvelopePyramid::envelopeUnaligned()
+{
+    const qint64 sampleCount = 50000;
+
+    EnvelopePyramid pyramid;
+    for (qint64 idx = 0; idx < sampleCount; idx++)
+    {
+        pyramid.append(sampleValue(idx));
+    }
+
+    checkEnvelope(pyramid, 13, 40007, pyramid.levelFor(40007 - 13, 300));
+    checkEnvelope(pyramid, 1023, 1025, 5);
+    checkEnvelope(pyramid, 4095, 20481, 3);
+
+    /* Number of points stays close to bucket count */
+    QVector<qint64> indexes;
+    pyramid.envelope(13, 40007, pyramid.levelFor(40007 - 13, 300), indexes);
+    QVERIFY(indexes.size() <= 2 * 300 + 2 * 2 * EnvelopePyramid::cLevelCount + 2 * 16);
+}
+
+void TestEnvelopePyramid::removeFront()
+{
+    const qint64 sampleCount = 20000;
+
+    EnvelopePyramid pyramid;
+    for (qint64 idx = 0; idx < sampleCount; idx++)
+    {
+        pyramid.append(sampleValue(idx));
+    }
+
+    pyramid.removeFront(5003);
+    QCOMPARE(pyramid.firstIndex(), static_cast<qint64>(5003));
+    QCOMPARE(pyramid.endIndex(), sampleCount);
+
+    /* Removed samples are never part of the envelope */
+    QVector<qint64> indexes;
+    pyramid.envelope(0, sampleCount, 8, indexes);
+    QVERIFY(indexes.first() >= 5003);
+
+    checkEnvelope(pyramid, 5003, sampleCount, 8);
+
+    /* Append after remove */
+    for (qint64 idx = sampleCount; idx < 2 * sampleCount; idx++)
+    {
+        pyramid.append(sampleValue(idx));
+    }
+    checkEnvelope(pyramid, 5003, 2 * sampleCount, 8);
+
+    pyramid.removeFront(3 * sampleCount);
+    QCOMPARE(pyramid.firstIndex(), 2 * sampleCount);
+
+    indexes.clear();
+    pyramid.envelope(0, 2 * sampleCount, 8, indexes);
+    QVERIFY(indexes.isEmpty());
+}
+
+QTEST_GUILESS_MAIN(TestEnvelopePyramid)
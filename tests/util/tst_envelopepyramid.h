@@ -0,0 +1,21 @@
+
+#include <QObject>
+
+class TestEnvelopePyramid: public QObject
+{
+    Q_OBJECT
+
+private slots:
+
+    void init();
+    void cleanup();
+
+    void smallRange();
+    void levelFor();
+    void envelopeMinMax();
+    void envelopeUnaligned();
+    void removeFront();
+
+private:
+
+};
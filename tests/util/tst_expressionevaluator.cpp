@@ -0,0 +1,156 @@
+#include <QtTest/QtTest>
+
+#include "expressionevaluator.h"
+
+#include "tst_expressionevaluator.h"
+
+using State = ResultState::State;
+
+void TestExpressionEvaluator::init()
+{
+
+}
+
+void TestExpressionEvaluator::cleanup()
+{
+
+}
+
+void TestExpressionEvaluator::evaluateSingle()
+{
+    ExpressionEvaluator evaluator;
+    evaluator.setExpressions(QStringList() << "r(0) * 2");
+
+    QCOMPARE(evaluator.count(), 1);
+
+    ResultDoubleList results;
+    evaluator.evaluate(ResultDoubleList() << ResultDouble(4.5, State::SUCCESS), results);
+
+    QCOMPARE(results.size(), 1);
+    QCOMPARE(results[0], ResultDouble(9, State::SUCCESS));
+}
+
+void TestExpressionEvaluator::evaluateMultiple()
+{
+    ExpressionEvaluator evaluator;
+    evaluator.setExpressions(QStringList() << "r(0)" << "r(1) + r(0)" << "r(2) & 0xFF" << "10");
+
+    auto input = ResultDoubleList() << ResultDouble(1, State::SUCCESS)
+                                    << ResultDouble(2, State::SUCCESS)
+                                    << ResultDouble(257, State::SUCCESS);
+
+    ResultDoubleList results;
+    evaluator.evaluate(input, results);
+
+    auto expResults = ResultDoubleList() << ResultDouble(1, State::SUCCESS)
+                                         << ResultDouble(3, State::SUCCESS)
+                                         << ResultDouble(1, State::SUCCESS)
+                                         << ResultDouble(10, State::SUCCESS);
+    QCOMPARE(results, expResults);
+}
+
+void TestExpressionEvaluator::evaluateSubsequent()
+{
+    ExpressionEvaluator evaluator;
+    evaluator.setExpressions(QStringList() << "r(0) + 1");
+
+    for (int idx = 0; idx < 10; idx++)
+    {
+        ResultDoubleList results;
+        evaluator.evaluate(ResultDoubleList() << ResultDouble(idx, State::SUCCESS), results);
+
+        QCOMPARE(results[0], ResultDouble(idx + 1, State::SUCCESS));
+    }
+}
+
+void TestExpressionEvaluator::evaluateInvalidInput()
+{
+    ExpressionEvaluator evaluator;
+    evaluator.setExpressions(QStringList() << "r(0)" << "r(1) * 2" << "r(0) + r(1)");
+
+    auto input = ResultDoubleList() << ResultDouble(5, State::INVALID)
+                                    << ResultDouble(3, State::SUCCESS);
+
+    ResultDoubleList results;
+    evaluator.evaluate(input, results);
+
+    /* Only expressions that use the invalid register fail */
+    QCOMPARE(results.size(), 3);
+    QCOMPARE(results[0], ResultDouble(0, State::INVALID));
+    QCOMPARE(results[1], ResultDouble(6, State::SUCCESS));
+    QCOMPARE(results[2], ResultDouble(0, State::INVALID));
+
+    QCOMPARE(evaluator.msg(0), QStringLiteral("Invalid data error"));
+    QCOMPARE(evaluator.msg(1), QStringLiteral("Success"));
+    QCOMPARE(evaluator.errorPos(0), -1);
+
+    /* Register is valid again */
+    input[0] = ResultDouble(5, State::SUCCESS);
+    evaluator.evaluate(input, results);
+    QCOMPARE(results[0], ResultDouble(5, State::SUCCESS));
+    QCOMPARE(results[2], ResultDouble(8, State::SUCCESS));
+}
+
+void TestExpressionEvaluator::evaluateMissingRegister()
+{
+    ExpressionEvaluator evaluator;
+    evaluator.setExpressions(QStringList() << "r(1)");
+
+    ResultDoubleList results;
+    evaluator.evaluate(ResultDoubleList() << ResultDouble(1, State::SUCCESS), results);
+
+    QCOMPARE(results[0], ResultDouble(0, State::INVALID));
+}
+
+void TestExpressionEvaluator::evaluateInvalidExpr()
+{
+    ExpressionEvaluator evaluator;
+    evaluator.setExpressions(QStringList() << "r(0) +" << "r(0)");
+
+    ResultDoubleList results;
+    evaluator.evaluate(ResultDoubleList() << ResultDouble(1, State::SUCCESS), results);
+
+    QCOMPARE(results[0], ResultDouble(0, State::INVALID));
+    QCOMPARE(results[1], ResultDouble(1, State::SUCCESS));
+    QVERIFY(!evaluator.msg(0).isEmpty());
+}
+
+void TestExpressionEvaluator::evaluateUnknownIdentifier()
+{
+    ExpressionEvaluator evaluator;
+    evaluator.setExpressions(QStringList() << "x11");
+
+    ResultDoubleList results;
+    evaluator.evaluate(ResultDoubleList(), results);
+
+    QCOMPARE(results[0], ResultDouble(0, State::INVALID));
+    QCOMPARE(evaluator.errorPos(0), 0);
+}
+
+void TestExpressionEvaluator::evaluateDivByZero()
+{
+    ExpressionEvaluator evaluator;
+    evaluator.setExpressions(QStringList() << "1 / r(0)");
+
+    ResultDoubleList results;
+    evaluator.evaluate(ResultDoubleList() << ResultDouble(0, State::SUCCESS), results);
+
+    QCOMPARE(results[0], ResultDouble(0, State::INVALID));
+}
+
+void TestExpressionEvaluator::evaluatePaddedRegister()
+{
+    /* Padding keeps positions equal to the visible expression */
+    ExpressionEvaluator evaluator;
+    evaluator.setExpressions(QStringList() << "r(0      ) + r(1   )");
+
+    auto input = ResultDoubleList() << ResultDouble(1, State::SUCCESS)
+                                    << ResultDouble(2, State::SUCCESS);
+
+    ResultDoubleList results;
+    evaluator.evaluate(input, results);
+
+    QCOMPARE(results[0], ResultDouble(3, State::SUCCESS));
+}
+
+QTEST_GUILESS_MAIN(TestExpressionEvaluator)
@@ -0,0 +1,25 @@
+
+#include <QObject>
+
+class TestExpressionEvaluator: public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+
+    void evaluateSingle();
+    void evaluateMultiple();
+    void evaluateSubsequent();
+    void evaluateInvalidInput();
+    void evaluateMissingRegister();
+    void evaluateInvalidExpr();
+    void evaluateUnknownIdentifier();
+    void evaluateDivByZero();
+    void evaluatePaddedRegister();
+
+private:
+
+
+};
@@ -0,0 +1,142 @@
+
+#include <QtTest/QtTest>
+
+#include "tst_modbusresultmap.h"
+
+#include "modbusresultmap.h"
+
+using State = ResultState::State;
+using ObjectType = ModbusAddress::ObjectType;
+
+void TestModbusResultMap::init()
+{
+
+}
+
+void TestModbusResultMap::cleanup()
+{
+
+}
+
+void TestModbusResultMap::addValues()
+{
+    const quint16 values[] = { 10, 11, 12 };
+
+    ModbusResultMap resultMap;
+    resultMap.addValues(ModbusAddress(40001), values, 3, 500);
+
+    QCOMPARE(resultMap.size(), 3);
+    QCOMPARE(resultMap.blocks().size(), 1);
+
+    for (quint32 idx = 0; idx < 3; idx++)
+    {
+        const auto result = resultMap.value(ModbusAddress(40001 + idx));
+
+        QVERIFY(result.isValid());
+        QCOMPARE(result.value(), values[idx]);
+        QCOMPARE(result.timestamp(), 500);
+    }
+
+    QVERIFY(!resultMap.contains(ModbusAddress(40000)));
+    QVERIFY(!resultMap.contains(ModbusAddress(40004)));
+    QCOMPARE(resultMap.value(ModbusAddress(40004)).state(), State::NO_VALUE);
+}
+
+void TestModbusResultMap::addErrors()
+{
+    ModbusResultMap resultMap;
+    resultMap.addErrors(ModbusAddress(40010), 2);
+
+    QCOMPARE(resultMap.size(), 2);
+
+    const auto result = resultMap[ModbusAddress(40011)];
+    QCOMPARE(result.state(), State::INVALID);
+    QCOMPARE(result.value(), 0);
+}
+
+void TestModbusResultMap::sortedBlocks()
+{
+    const quint16 values[] = { 1, 2 };
+
+    /* Results of pipelined requests can arrive out of order */
+    ModbusResultMap resultMap;
+    resultMap.addValues(ModbusAddress(40020), values, 2, 100);
+    resultMap.addErrors(ModbusAddress(40005), 1);
+    resultMap.addValues(ModbusAddress(40001), values, 2, 200);
+
+    const QList<ModbusResultMap::Block>& blocks = resultMap.blocks();
+    QCOMPARE(blocks.size(), 3);
+    QCOMPARE(blocks[0].address, ModbusAddress(40001));
+    QCOMPARE(blocks[1].address, ModbusAddress(40005));
+    QCOMPARE(blocks[2].address, ModbusAddress(40020));
+
+    QCOMPARE(resultMap.blockValue(blocks[2], 1), 2);
+    QVERIFY(resultMap.isBlockValueValid(blocks[2], 1));
+    QVERIFY(!resultMap.isBlockValueValid(blocks[1], 0));
+    QCOMPARE(resultMap.value(ModbusAddress(40002)).timestamp(), 200);
+}
+
+void TestModbusResultMap::insertMerge()
+{
+    ModbusResultMap resultMap;
+    resultMap.insert(ModbusAddress(40001), Result<quint16>(1, State::SUCCESS));
+    resultMap.insert(ModbusAddress(40002), Result<quint16>(2, State::INVALID));
+    resultMap.insert(ModbusAddress(40004), Result<quint16>(4, State::SUCCESS));
+
+    /* Consecutive registers share a block */
+    QCOMPARE(resultMap.size(), 3);
+    QCOMPARE(resultMap.blocks().size(), 2);
+
+    QVERIFY(resultMap.value(ModbusAddress(40001)).isValid());
+    QVERIFY(!resultMap.value(ModbusAddress(40002)).isValid());
+    QVERIFY(!resultMap.contains(ModbusAddress(40003)));
+    QCOMPARE(resultMap.value(ModbusAddress(40004)).value(), 4);
+}
+
+void TestModbusResultMap::insertReplace()
+{
+    ModbusResultMap resultMap;
+    resultMap.addErrors(ModbusAddress(40001), 3);
+    resultMap.insert(ModbusAddress(40002), Result<quint16>(7, State::SUCCESS));
+
+    QCOMPARE(resultMap.size(), 3);
+    QCOMPARE(resultMap.blocks().size(), 1);
+
+    QVERIFY(!resultMap.value(ModbusAddress(40001)).isValid());
+    QVERIFY(resultMap.value(ModbusAddress(40002)).isValid());
+    QCOMPARE(resultMap.value(ModbusAddress(40002)).value(), 7);
+}
+
+void TestModbusResultMap::objectTypes()
+{
+    const quint16 values[] = { 1, 2 };
+
+    ModbusResultMap resultMap;
+    resultMap.addValues(ModbusAddress(0, ObjectType::HOLDING_REGISTER), values, 2);
+    resultMap.addValues(ModbusAddress(0, ObjectType::COIL), values, 1);
+
+    QCOMPARE(resultMap.size(), 3);
+    QCOMPARE(resultMap.blocks().size(), 2);
+
+    QVERIFY(resultMap.contains(ModbusAddress(1, ObjectType::HOLDING_REGISTER)));
+    QVERIFY(!resultMap.contains(ModbusAddress(1, ObjectType::COIL)));
+}
+
+void TestModbusResultMap::sharedCopy()
+{
+    const quint16 values[] = { 1 };
+
+    ModbusResultMap resultMap;
+    resultMap.addValues(ModbusAddress(40001), values, 1);
+
+    ModbusResultMap copy = resultMap;
+
+    resultMap.insert(ModbusAddress(40001), Result<quint16>(5, State::SUCCESS));
+    resultMap.addErrors(ModbusAddress(40002), 1);
+
+    QCOMPARE(copy.size(), 1);
+    QCOMPARE(copy.value(ModbusAddress(40001)).value(), 1);
+    QCOMPARE(resultMap.value(ModbusAddress(40001)).value(), 5);
+}
+
+QTEST_GUILESS_MAIN(TestModbusResultMap)
@@ -0,0 +1,24 @@
+
+#ifndef TEST_MODBUSRESULTMAP_H__
+#define TEST_MODBUSRESULTMAP_H__
+
+#include <QObject>
+
+class TestModbusResultMap: public QObject
+{
+    Q_OBJECT
+private slots:
+    void init();
+    void cleanup();
+
+    void addValues();
+    void addErrors();
+    void sortedBlocks();
+    void insertMerge();
+    void insertReplace();
+    void objectTypes();
+    void sharedCopy();
+
+};
+
+#endif /* TEST_MODBUSRESULTMAP_H__ */
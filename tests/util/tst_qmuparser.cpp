@@ -1,5 +1,6 @@
 
 #include <QtTest/QtTest>
+#include <QThread>
 
 #include "qmuparser.h"
 
@@ -347,4 +348,82 @@ void TestQMuParser::expressionUpdate()
     QVERIFY(bSuccess);
 }
 
+void TestQMuParser::evaluateIndependentContext()
+{
+    QMuParser parser_1("r(0)");
+    QMuParser parser_2("r(0)");
+
+    parser_1.setRegistersData(ResultDoubleList() << ResultDouble(1, State::SUCCESS));
+    parser_2.setRegistersData(ResultDoubleList() << ResultDouble(2, State::SUCCESS));
+
+    QVERIFY(parser_1.evaluate());
+    QVERIFY(parser_2.evaluate());
+
+    /* Register data isn't shared between parsers */
+    QCOMPARE(parser_1.value(), 1);
+    QCOMPARE(parser_2.value(), 2);
+}
+
+void TestQMuParser::evaluateCopyContext()
+{
+    QMuParser parser("r(0) * 2");
+    parser.setRegistersData(ResultDoubleList() << ResultDouble(1, State::SUCCESS));
+
+    QMuParser parserCopy(parser);
+    parserCopy.setRegistersData(ResultDoubleList() << ResultDouble(5, State::SUCCESS));
+
+    QVERIFY(parser.evaluate());
+    QVERIFY(parserCopy.evaluate());
+
+    QCOMPARE(parser.value(), 2);
+    QCOMPARE(parserCopy.value(), 10);
+
+    QMuParser parserAssigned("1");
+    parserAssigned = parserCopy;
+    parserCopy.setRegistersData(ResultDoubleList() << ResultDouble(7, State::SUCCESS));
+
+    QVERIFY(parserAssigned.evaluate());
+    QCOMPARE(parserAssigned.value(), 10);
+}
+
+void TestQMuParser::evaluateConcurrent()
+{
+    const int threadCount = 4;
+    const int count = 10000;
+
+    QList<QThread *> threads;
+    QList<int> failCount(threadCount, 0);
+
+    for (int threadIdx = 0; threadIdx < threadCount; threadIdx++)
+    {
+        threads.append(QThread::create([threadIdx, &failCount]() {
+            QMuParser parser("r(0) + r(1)");
+
+            for (int idx = 0; idx < count; idx++)
+            {
+                parser.setRegistersData(ResultDoubleList() << ResultDouble(idx, State::SUCCESS)
+                                                           << ResultDouble(threadIdx, State::SUCCESS));
+
+                if (!parser.evaluate() || (parser.value() != idx + threadIdx))
+                {
+                    failCount[threadIdx]++;
+                }
+            }
+        }));
+    }
+
+    for (QThread * pThread: qAsConst(threads))
+    {
+        pThread->start();
+    }
+
+    for (QThread * pThread: qAsConst(threads))
+    {
+        pThread->wait();
+    }
+    qDeleteAll(threads);
+
+    QCOMPARE(failCount, QList<int>(threadCount, 0));
+}
+
 QTEST_GUILESS_MAIN(TestQMuParser)
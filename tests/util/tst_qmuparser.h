@@ -33,6 +33,10 @@ private slots:
     void expressionGet();
     void expressionUpdate();
 
+    void evaluateIndependentContext();
+    void evaluateCopyContext();
+    void evaluateConcurrent();
+
 private:
 
 